@@ -0,0 +1,64 @@
+# Copyright (c) 2019 CNES
+#
+# All rights reserved. Use of this source code is governed by a
+# BSD-style license that can be found in the LICENSE file.
+"""
+Measures the bytes copied and the time taken by a pickle round trip of the
+interpolators, with the protocol 4 (arrays copied into the pickle stream)
+and the protocol 5 (arrays transmitted out of band).
+"""
+import pickle
+import timeit
+import numpy as np
+import pyinterp.bivariate
+import pyinterp.core
+import pyinterp.rtree
+
+
+def round_trip(instance, protocol):
+    """Pickle and unpickle an instance, returning the number of bytes copied
+    into the pickle stream and the number of bytes transmitted out of band"""
+    buffers = []
+    if protocol < 5:
+        data = pickle.dumps(instance, protocol=protocol)
+        pickle.loads(data)
+    else:
+        data = pickle.dumps(instance,
+                            protocol=protocol,
+                            buffer_callback=buffers.append)
+        pickle.loads(data, buffers=buffers)
+    return len(data), sum(item.raw().nbytes for item in buffers)
+
+
+def measure(name, instance, repeat=10):
+    for protocol in [4, 5]:
+        if protocol > pickle.HIGHEST_PROTOCOL:
+            continue
+        copied, out_of_band = round_trip(instance, protocol)
+        elapsed = timeit.timeit(lambda: round_trip(instance, protocol),
+                                number=repeat) / repeat
+        print(f"{name:<10} protocol {protocol}: "
+              f"{copied / 2**20:10.3f} MiB copied, "
+              f"{out_of_band / 2**20:10.3f} MiB out of band, "
+              f"{elapsed * 1e3:10.3f} ms")
+
+
+def main():
+    x = pyinterp.core.Axis(np.arange(-180, 180, 1 / 12), is_circle=True)
+    y = pyinterp.core.Axis(np.arange(-90, 90, 1 / 12))
+    measure(
+        "Bivariate",
+        pyinterp.bivariate.Bivariate(x, y,
+                                     np.random.random((len(x), len(y)))))
+
+    size = 1_000_000
+    mesh = pyinterp.rtree.RTree()
+    mesh.packing(
+        np.vstack((np.random.uniform(-180, 180, size),
+                   np.random.uniform(-90, 90, size))).T,
+        np.random.random(size))
+    measure("RTree", mesh)
+
+
+if __name__ == "__main__":
+    main()
@@ -6,7 +6,7 @@
 Common classes
 --------------
 """
-from typing import Tuple
+from typing import Optional, Tuple
 import numpy as np
 from . import core
 from . import interface
@@ -17,6 +17,19 @@ class GridInterpolator:
 
     Args:
         *args (tuple): Constructor's arguments.
+        dtype (numpy.dtype, optional): Type of the coordinates and of the
+            values interpolated: ``float64`` or ``float32``. Defaults to
+            ``float64``.
+        scale_factor (float, optional): Factor applied to the values of a
+            grid of packed integers. Defaults to ``1``.
+        add_offset (float, optional): Offset added to the values of a grid
+            of packed integers, multiplied by the scale factor. Defaults to
+            ``0``.
+        fill_value (int, optional): Integer representing the undefined
+            values of a grid of packed integers. Defaults to ``None``.
+        axes (tuple, optional): Dimension of the array holding each axis of
+            the grid, if the array is not stored in the order of the axes.
+            Defaults to ``None``.
 
     .. warning::
 
@@ -25,19 +38,41 @@ class GridInterpolator:
     _CLASS = None
     _INTEROLATOR = None
 
-    def __init__(self, *args):
-        self._class = self._CLASS + interface._core_suffix(args[-1])
-        self._instance = getattr(core, self._class)(*args)
-
-    @classmethod
-    def _n_variate_interpolator(cls, interpolator: str, **kwargs):
+    def __init__(self,
+                 *args,
+                 dtype: Optional[np.dtype] = None,
+                 scale_factor: Optional[float] = None,
+                 add_offset: Optional[float] = None,
+                 fill_value: Optional[int] = None,
+                 axes: Optional[Tuple[int, ...]] = None):
+        suffix = interface._core_suffix(args[-1])
+        self._class = self._CLASS + suffix + interface._core_compute_suffix(
+            suffix, dtype)
+        # The grids of 8 or 16-bit integers are interpolated without being
+        # converted, their values being decoded on the fly.
+        packing = interface._core_packing(suffix, scale_factor, add_offset,
+                                          fill_value)
+        # The array is read through its strides: a transposed array is not
+        # copied.
+        if axes is not None:
+            packing["axes"] = tuple(axes)
+        self._instance = getattr(core, self._class)(*args, **packing)
+
+    def _n_variate_interpolator(self, interpolator, **kwargs):
+        # The interpolators calculating in single precision are suffixed by
+        # the type of their coordinates.
+        suffix = self._INTEROLATOR + ("Float32" if self.dtype == np.float32
+                                      else "")
+        # Interpolators written in Python are used as they are.
+        if isinstance(interpolator,
+                      getattr(core, "BivariateInterpolator" + suffix)):
+            return interpolator
         if interpolator == "bilinear":
-            return getattr(core, "Bilinear" + cls._INTEROLATOR)(**kwargs)
+            return getattr(core, "Bilinear" + suffix)(**kwargs)
         elif interpolator == "nearest":
-            return getattr(core, "Nearest" + cls._INTEROLATOR)(**kwargs)
+            return getattr(core, "Nearest" + suffix)(**kwargs)
         elif interpolator == "inverse_distance_weighting":
-            return getattr(core, "InverseDistanceWeighting" +
-                           cls._INTEROLATOR)(**kwargs)
+            return getattr(core, "InverseDistanceWeighting" + suffix)(**kwargs)
 
         raise ValueError(f"interpolator {interpolator!r} is not defined")
 
@@ -71,6 +106,17 @@ class GridInterpolator:
         """
         return self._instance.array
 
+    @property
+    def dtype(self) -> np.dtype:
+        """
+        Gets the type of the coordinates and of the values interpolated
+
+        Returns:
+            numpy.dtype: ``float64``, or ``float32`` if the interpolation is
+            calculated in single precision
+        """
+        return self._instance.dtype
+
     def __getstate__(self) -> Tuple:
         return (self._class, self._instance.__getstate__())
 
@@ -78,3 +124,8 @@ class GridInterpolator:
         self._class, state = state
         self._instance = getattr(getattr(core, self._class),
                                  "_setstate")(state)
+
+    def __reduce_ex__(self, protocol: int) -> Tuple:
+        # With the protocol 5, the grid values are transmitted out of band.
+        return interface._reduce_ex(self, protocol) or super(
+            GridInterpolator, self).__reduce_ex__(protocol)
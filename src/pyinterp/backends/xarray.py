@@ -3,8 +3,14 @@ XArray
 ------
 
 Build interpolation objects from XArray Dataset instances
+
+The variables of 8 or 16-bit integers read without being decoded (dataset
+opened with ``mask_and_scale=False``) are interpolated without conversion,
+their attributes ``scale_factor``, ``add_offset`` and ``_FillValue``
+describing the decoding of their values.
 """
 from typing import Iterable, Optional, Tuple
+import numpy as np
 import xarray as xr
 from .. import cf
 from .. import core
@@ -128,20 +134,70 @@ def _coords(coords: dict, dims: Iterable):
     return tuple(coords[dim] for dim in dims)
 
 
+def _axes(variable: xr.Variable, dims: Iterable) -> Tuple[int, ...]:
+    """
+    Get the dimension of the variable holding each axis of the grid. The
+    interpolators read the values of the variable in their native order,
+    which avoids a transposed copy.
+
+    Args:
+        variable (xarray.Variable): Variable to interpolate
+        dims (iterable): Names of the axes of the grid
+
+    Returns:
+        tuple: The index of each axis in the dimensions of the variable.
+    """
+    return tuple(variable.dims.index(dim) for dim in dims)
+
+
+def _packing(variable: xr.Variable) -> dict:
+    """
+    Get the decoding of the values of a variable storing packed integers.
+    The interpolators decode these values on the fly instead of working on a
+    decoded copy.
+
+    Args:
+        variable (xarray.Variable): Variable to interpolate
+
+    Returns:
+        dict: The keyword arguments describing the decoding, empty if the
+        variable is not packed.
+    """
+    if variable.dtype.kind not in "iu" or variable.dtype.itemsize > 2:
+        return dict()
+    attrs = variable.attrs
+    packing = dict()
+    if "scale_factor" in attrs:
+        packing["scale_factor"] = float(attrs["scale_factor"])
+    if "add_offset" in attrs:
+        packing["add_offset"] = float(attrs["add_offset"])
+    if "_FillValue" in attrs:
+        packing["fill_value"] = int(attrs["_FillValue"])
+    return packing
+
+
 class Bivariate(bivariate.Bivariate):
     """Builds the Bivariate interpolator from the provided dataset.
 
     Args:
         dataset (xarray.Dataset): Provided dataset
         name (str): Variable to interpolate
+        dtype (numpy.dtype, optional): Type of the coordinates and of the
+            values interpolated, see :py:class:`pyinterp.bivariate.Bivariate`.
     """
 
-    def __init__(self, dataset: xr.Dataset, variable: str):
+    def __init__(self,
+                 dataset: xr.Dataset,
+                 variable: str,
+                 dtype: Optional[np.dtype] = None):
         self._dims = _lon_lat_from_dataset(dataset, variable)
         super(Bivariate, self).__init__(
             core.Axis(dataset.variables[self._dims[0]].values, is_circle=True),
             core.Axis(dataset.variables[self._dims[1]].values),
-            dataset.variables[variable].transpose(*self._dims).values)
+            dataset.variables[variable].values,
+            dtype=dtype,
+            axes=_axes(dataset.variables[variable], self._dims),
+            **_packing(dataset.variables[variable]))
 
     def evaluate(self, coords: dict, *args, **kwargs):
         """Evaluate the interpolation defined for the given coordinates
@@ -174,14 +230,22 @@ class Bicubic(bicubic.Bicubic):
     Args:
         dataset (xarray.Dataset): Provided dataset
         name (str): Variable to interpolate
+        dtype (numpy.dtype, optional): Type of the coordinates and of the
+            values interpolated, see :py:class:`pyinterp.bicubic.Bicubic`.
     """
 
-    def __init__(self, dataset: xr.Dataset, variable: str):
+    def __init__(self,
+                 dataset: xr.Dataset,
+                 variable: str,
+                 dtype: Optional[np.dtype] = None):
         self._dims = _lon_lat_from_dataset(dataset, variable)
         super(Bicubic, self).__init__(
             core.Axis(dataset.variables[self._dims[0]].values, is_circle=True),
             core.Axis(dataset.variables[self._dims[1]].values),
-            dataset.variables[variable].transpose(*self._dims).values)
+            dataset.variables[variable].values,
+            dtype=dtype,
+            axes=_axes(dataset.variables[variable], self._dims),
+            **_packing(dataset.variables[variable]))
 
     def evaluate(self, coords: dict, *args, **kwargs):
         """Evaluate the interpolation defined for the given coordinates
@@ -214,9 +278,15 @@ class Trivariate(trivariate.Trivariate):
     Args:
         dataset (xarray.Dataset): Provided dataset
         name (str): Variable to interpolate
+        dtype (numpy.dtype, optional): Type of the coordinates and of the
+            values interpolated, see
+            :py:class:`pyinterp.trivariate.Trivariate`.
     """
 
-    def __init__(self, dataset: xr.Dataset, variable: str):
+    def __init__(self,
+                 dataset: xr.Dataset,
+                 variable: str,
+                 dtype: Optional[np.dtype] = None):
         x, y = _lon_lat_from_dataset(dataset, variable, ndims=3)
         z = (set(dataset.coords) - {x, y}).pop()
         self._dims = (x, y, z)
@@ -224,7 +294,10 @@ class Trivariate(trivariate.Trivariate):
             core.Axis(dataset.variables[x].values, is_circle=True),
             core.Axis(dataset.variables[y].values),
             core.Axis(dataset.variables[z].values),
-            dataset.variables[variable].transpose(x, y, z).values)
+            dataset.variables[variable].values,
+            dtype=dtype,
+            axes=_axes(dataset.variables[variable], self._dims),
+            **_packing(dataset.variables[variable]))
 
     def evaluate(self, coords: dict, *args, **kwargs):
         """Evaluate the interpolation defined for the given coordinates
@@ -6,9 +6,10 @@
 Bicubic interpolation
 =====================
 """
-from typing import Optional
+from typing import Optional, Tuple
 import numpy as np
 from . import core
+from . import interface
 from . import GridInterpolator
 
 
@@ -22,11 +23,42 @@ class Bicubic(GridInterpolator):
         x (pyinterp.core.Axis): X-Axis
         y (pyinterp.core.Axis): Y-Axis
         array (numpy.ndarray): Bivariate function
+        dtype (numpy.dtype, optional): Type of the coordinates and of the
+            values interpolated: ``float64`` or ``float32``, the latter
+            requiring a grid of type ``float32``. The splines are fitted in
+            double precision in both cases. Defaults to ``float64``.
+        scale_factor (float, optional): Factor applied to the values of a
+            grid of packed integers (``int8``, ``uint8``, ``int16`` or
+            ``uint16``), which are decoded on the fly instead of being
+            converted. Defaults to ``1``.
+        add_offset (float, optional): Offset added to the packed integers
+            multiplied by the scale factor. Defaults to ``0``.
+        fill_value (int, optional): Packed integer representing the
+            undefined values. Defaults to ``None``.
+        axes (tuple, optional): Dimension of the array holding each axis of
+            the grid, if the array is not stored in the order of the axes.
+            The array is then interpolated without being copied. Defaults to
+            ``None``.
     """
     _CLASS = "Bicubic"
 
-    def __init__(self, x: core.Axis, y: core.Axis, values: np.ndarray):
-        super(Bicubic, self).__init__(x, y, values)
+    def __init__(self,
+                 x: core.Axis,
+                 y: core.Axis,
+                 values: np.ndarray,
+                 dtype: Optional[np.dtype] = None,
+                 scale_factor: Optional[float] = None,
+                 add_offset: Optional[float] = None,
+                 fill_value: Optional[int] = None,
+                 axes: Optional[Tuple[int, ...]] = None):
+        super(Bicubic, self).__init__(x,
+                                      y,
+                                      values,
+                                      dtype=dtype,
+                                      scale_factor=scale_factor,
+                                      add_offset=add_offset,
+                                      fill_value=fill_value,
+                                      axes=axes)
 
     def evaluate(self,
                  x: np.ndarray,
@@ -36,9 +68,17 @@ class Bicubic(GridInterpolator):
                  fitting_model: Optional[str] = "c_spline",
                  boundary: Optional[str] = "undef",
                  bounds_error: Optional[bool] = False,
-                 num_threads: Optional[int] = 0) -> np.ndarray:
+                 num_threads: Optional[int] = 0,
+                 schedule: Optional[str] = "static",
+                 chunk_size: Optional[int] = 0,
+                 reorder: Optional[bool] = False,
+                 out: Optional[np.ndarray] = None) -> np.ndarray:
         """Evaluate the interpolation.
 
+        The coordinates can be arrays of any shape, broadcast together
+        following the NumPy rules, and are read in place whatever their memory
+        layout.
+
         Args:
             x (numpy.ndarray): X-values
             y (numpy.ndarray): Y-values
@@ -75,9 +115,141 @@ class Bicubic(GridInterpolator):
                 computation. If 0 all CPUs are used. If 1 is given, no parallel
                 computing code is used at all, which is useful for debugging.
                 Defaults to ``0``.
+            schedule (str, optional): ``static`` or ``dynamic`` distribution
+                of the values between the threads. Defaults to ``static``.
+            chunk_size (int, optional): Number of values claimed at once by a
+                thread with the ``dynamic`` schedule, 0 for an automatic size.
+                Defaults to ``0``.
+            reorder (bool, optional): If True, the values are processed in
+                the order of a space-filling curve (Morton order), which
+                improves the cache efficiency for large numbers of randomly
+                scattered values, at the cost of sorting them. Defaults to
+                ``False``.
+            out (numpy.ndarray, optional): Array, of the shape of the
+                coordinates broadcast together and of type :py:attr:`dtype`, in
+                which the values interpolated are written. The array may be
+                a non-contiguous view. Defaults to ``None``: a new array is
+                allocated.
+        Return:
+            numpy.ndarray: Values interpolated, of the shape of the
+            coordinates broadcast together (``out`` if provided).
+        """
+        fitting_model, boundary = self._core_options(
+            fitting_model, boundary, bounds_error)
+        return self._instance.evaluate(
+            np.asarray(x), np.asarray(y), nx, ny,
+            fitting_model, boundary, bounds_error, num_threads,
+            interface._core_schedule(schedule), chunk_size, reorder, out)
+
+    def evaluate_gradient(self,
+                          x: np.ndarray,
+                          y: np.ndarray,
+                          nx: Optional[int] = 3,
+                          ny: Optional[int] = 3,
+                          fitting_model: Optional[str] = "c_spline",
+                          boundary: Optional[str] = "undef",
+                          bounds_error: Optional[bool] = False,
+                          num_threads: Optional[int] = 0,
+                          schedule: Optional[str] = "static",
+                          chunk_size: Optional[int] = 0,
+                          reorder: Optional[bool] = False) -> np.ndarray:
+        """Evaluate the interpolation and the partial derivatives of the
+        interpolated surface.
+
+        The value and its derivatives are calculated in a single pass: the
+        frame surrounding a value is loaded once, and the splines fitted
+        along the Y-axis provide both the values and the derivatives along
+        Y. The derivatives are expressed in units of the function per unit
+        of the axes (for example per degree for a longitude axis).
+
+        Args:
+            x (numpy.ndarray): X-values
+            y (numpy.ndarray): Y-values
+            nx (int, optional): The number of X coordinate values required to
+                perform the interpolation. Defaults to ``3``.
+            ny (int, optional): The number of Y coordinate values required to
+                perform the interpolation. Defaults to ``3``.
+            fitting_model (str, optional): Type of interpolation to be
+                performed. See :py:meth:`evaluate`. Default to ``c_spline``.
+            boundary (str, optional): A flag indicating how to handle
+                boundaries of the frame. See :py:meth:`evaluate`. Default
+                ``undef``
+            bounds_error (bool, optional): If True, when interpolated values
+                are requested outside of the domain of the input axes (x,y), a
+                :py:class:`ValueError` is raised. If False, then value is set
+                to Nan. Default to ``False``
+            num_threads (int, optional): The number of threads to use for the
+                computation. If 0 all CPUs are used. If 1 is given, no parallel
+                computing code is used at all, which is useful for debugging.
+                Defaults to ``0``.
+            schedule (str, optional): ``static`` or ``dynamic`` distribution
+                of the values between the threads. Defaults to ``static``.
+            chunk_size (int, optional): Number of values claimed at once by a
+                thread with the ``dynamic`` schedule, 0 for an automatic size.
+                Defaults to ``0``.
+            reorder (bool, optional): If True, the values are processed in
+                the order of a space-filling curve (Morton order). Defaults to
+                ``False``.
+        Return:
+            numpy.ndarray: Array of shape ``(x.size, 3)`` containing the
+            values interpolated, their derivatives with respect to x and
+            their derivatives with respect to y.
+        """
+        fitting_model, boundary = self._core_options(
+            fitting_model, boundary, bounds_error)
+        return self._instance.evaluate_gradient(
+            np.asarray(x), np.asarray(y), nx, ny, fitting_model, boundary,
+            bounds_error, num_threads, interface._core_schedule(schedule),
+            chunk_size, reorder)
+
+    def regrid(self,
+               x: core.Axis,
+               y: core.Axis,
+               nx: Optional[int] = 3,
+               ny: Optional[int] = 3,
+               fitting_model: Optional[str] = "c_spline",
+               boundary: Optional[str] = "undef",
+               bounds_error: Optional[bool] = False,
+               num_threads: Optional[int] = 0) -> np.ndarray:
+        """Interpolate the function on the grid defined by the target axes.
+
+        The result is identical to the evaluation of the function on the
+        points of the grid built by :py:func:`numpy.meshgrid` (with
+        ``indexing="ij"``), but the splines computed along the Y-axis are
+        shared by all the points of a target row.
+
+        Args:
+            x (pyinterp.core.Axis): X-Axis of the target grid
+            y (pyinterp.core.Axis): Y-Axis of the target grid
+            nx (int, optional): The number of X coordinate values required to
+                perform the interpolation. Defaults to ``3``.
+            ny (int, optional): The number of Y coordinate values required to
+                perform the interpolation. Defaults to ``3``.
+            fitting_model (str, optional): Type of interpolation to be
+                performed. See :py:meth:`evaluate`. Default to ``c_spline``.
+            boundary (str, optional): A flag indicating how to handle
+                boundaries of the frame. See :py:meth:`evaluate`. Default
+                ``undef``
+            bounds_error (bool, optional): If True, when interpolated values
+                are requested outside of the domain of the input axes (x,y), a
+                :py:class:`ValueError` is raised. If False, then value is set
+                to Nan. Default to ``False``
+            num_threads (int, optional): The number of threads to use for the
+                computation. If 0 all CPUs are used. If 1 is given, no parallel
+                computing code is used at all, which is useful for debugging.
+                Defaults to ``0``.
         Return:
-            numpy.ndarray: Values interpolated
+            numpy.ndarray: Values interpolated, of shape ``(x.size(),
+            y.size())``
         """
+        fitting_model, boundary = self._core_options(
+            fitting_model, boundary, bounds_error)
+        return self._instance.regrid(x, y, nx, ny, fitting_model, boundary,
+                                     bounds_error, num_threads)
+
+    @staticmethod
+    def _core_options(fitting_model: str, boundary: str, bounds_error: bool):
+        """Converts the options of the interpolation into their core values"""
         if bounds_error and boundary != "undef":
             raise ValueError(
                 "If the 'bounds_error' parameter is true, then the 'boundary' "
@@ -97,7 +269,5 @@ class Bicubic(GridInterpolator):
 
         boundary = boundary.capitalize()
 
-        return self._instance.evaluate(
-            np.asarray(x), np.asarray(y), nx, ny,
-            getattr(core.FittingModel, fitting_model),
-            getattr(core.Axis.Boundary, boundary), bounds_error, num_threads)
+        return (getattr(core.FittingModel, fitting_model),
+                getattr(core.Axis.Boundary, boundary))
@@ -6,10 +6,11 @@
 Bivariate interpolation
 =======================
 """
-from typing import Optional
+from typing import List, Optional, Tuple, Union
 import numpy as np
 from . import GridInterpolator
 from . import core
+from . import interface
 
 
 class Bivariate(GridInterpolator):
@@ -19,28 +20,72 @@ class Bivariate(GridInterpolator):
         x (pyinterp.core.Axis): X-Axis
         y (pyinterp.core.Axis): Y-Axis
         array (numpy.ndarray): Bivariate function
+        dtype (numpy.dtype, optional): Type of the coordinates and of the
+            values interpolated. ``float32`` calculates the interpolation in
+            single precision, which halves the memory used by the results,
+            and requires a grid of type ``float32``. Defaults to
+            ``float64``.
+        scale_factor (float, optional): Factor applied to the values of a
+            grid of packed integers (``int8``, ``uint8``, ``int16`` or
+            ``uint16``), which are decoded on the fly instead of being
+            converted. Defaults to ``1``.
+        add_offset (float, optional): Offset added to the packed integers
+            multiplied by the scale factor. Defaults to ``0``.
+        fill_value (int, optional): Packed integer representing the
+            undefined values. Defaults to ``None``.
+        axes (tuple, optional): Dimension of the array holding each axis of
+            the grid, if the array is not stored in the order of the axes.
+            The array is then interpolated without being copied. Defaults to
+            ``None``.
     """
     _CLASS = "Bivariate"
     _INTEROLATOR = "2D"
 
-    def __init__(self, x: core.Axis, y: core.Axis, values: np.ndarray):
-        super(Bivariate, self).__init__(x, y, values)
+    def __init__(self,
+                 x: core.Axis,
+                 y: core.Axis,
+                 values: np.ndarray,
+                 dtype: Optional[np.dtype] = None,
+                 scale_factor: Optional[float] = None,
+                 add_offset: Optional[float] = None,
+                 fill_value: Optional[int] = None,
+                 axes: Optional[Tuple[int, ...]] = None):
+        super(Bivariate, self).__init__(x,
+                                        y,
+                                        values,
+                                        dtype=dtype,
+                                        scale_factor=scale_factor,
+                                        add_offset=add_offset,
+                                        fill_value=fill_value,
+                                        axes=axes)
 
     def evaluate(self,
                  x: np.ndarray,
                  y: np.ndarray,
-                 interpolator: Optional[str] = "bilinear",
+                 interpolator: Optional[Union[
+                     str, core.BivariateInterpolator2D]] = "bilinear",
                  bounds_error: Optional[bool] = False,
                  num_threads: Optional[int] = 0,
+                 schedule: Optional[str] = "static",
+                 chunk_size: Optional[int] = 0,
+                 reorder: Optional[bool] = False,
+                 out: Optional[np.ndarray] = None,
                  **kwargs) -> np.ndarray:
         """Interpolate the values provided on the defined bivariate function.
 
+        The coordinates can be arrays of any shape, broadcast together
+        following the NumPy rules, and are read in place whatever their memory
+        layout.
+
         Args:
             x (numpy.ndarray): X-values
             y (numpy.ndarray): Y-values
             interpolator (str, optional): The method of interpolation to
                 perform. Supported are ``bilinear``, ``nearest``, and
                 ``inverse_distance_weighting``. Default to ``bilinear``.
+                An interpolator written in Python, deriving from
+                :py:class:`pyinterp.core.BivariateInterpolator2D` and
+                defining the method ``evaluate_batch``, can also be given.
             bounds_error (bool, optional): If True, when interpolated values
                 are requested outside of the domain of the input axes (x,y), a
                 :py:class:`ValueError` is raised. If False, then value is set
@@ -49,12 +94,229 @@ class Bivariate(GridInterpolator):
                 computation. If 0 all CPUs are used. If 1 is given, no parallel
                 computing code is used at all, which is useful for debugging.
                 Defaults to ``0``.
+            schedule (str, optional): ``static`` or ``dynamic`` distribution
+                of the values between the threads. Defaults to ``static``.
+            chunk_size (int, optional): Number of values claimed at once by a
+                thread with the ``dynamic`` schedule, 0 for an automatic size.
+                Defaults to ``0``.
+            reorder (bool, optional): If True, the values are processed in
+                the order of a space-filling curve (Morton order), which
+                improves the cache efficiency for large numbers of randomly
+                scattered values, at the cost of sorting them. Defaults to
+                ``False``.
+            out (numpy.ndarray, optional): Array, of the shape of the
+                coordinates broadcast together and of type :py:attr:`dtype`, in
+                which the values interpolated are written. The array may be
+                a non-contiguous view. Defaults to ``None``: a new array is
+                allocated.
             p (int, optional): The power to be used by the interpolator
                 inverse_distance_weighting. Default to ``2``.
+            min_valid (int, optional): The minimum number of defined corners
+                of the cell used by the interpolator bilinear, the undefined
+                corners being dropped and the weights of the others
+                renormalized. Default to ``4``: all the corners must be
+                defined.
         Return:
-            numpy.ndarray: Values interpolated
+            numpy.ndarray: Values interpolated, of the shape of the
+            coordinates broadcast together (``out`` if provided).
         """
         return self._instance.evaluate(
+            np.asarray(x), np.asarray(y),
+            self._n_variate_interpolator(interpolator, **kwargs), bounds_error,
+            num_threads, interface._core_schedule(schedule), chunk_size,
+            reorder, out)
+
+    def evaluate_fields(self,
+                        x: np.ndarray,
+                        y: np.ndarray,
+                        fields: List[np.ndarray],
+                        interpolator: Optional[Union[
+                            str, core.BivariateInterpolator2D]] = "bilinear",
+                        bounds_error: Optional[bool] = False,
+                        num_threads: Optional[int] = 0,
+                        schedule: Optional[str] = "static",
+                        chunk_size: Optional[int] = 0,
+                        reorder: Optional[bool] = False,
+                        **kwargs) -> np.ndarray:
+        """Interpolate the values provided on the defined bivariate function
+        and on other fields defined on the same axes.
+
+        The cells framing the values provided are searched once for all the
+        fields, so interpolating several fields together costs little more
+        than interpolating one of them.
+
+        Args:
+            x (numpy.ndarray): X-values
+            y (numpy.ndarray): Y-values
+            fields (list): Values of the other fields, arrays of the same
+                shape as the bivariate function.
+            interpolator (str, optional): The method of interpolation to
+                perform. See :py:meth:`evaluate`. Default to ``bilinear``.
+            bounds_error (bool, optional): If True, when interpolated values
+                are requested outside of the domain of the input axes (x,y), a
+                :py:class:`ValueError` is raised. If False, then value is set
+                to Nan. Default to ``False``
+            num_threads (int, optional): The number of threads to use for the
+                computation. If 0 all CPUs are used. If 1 is given, no parallel
+                computing code is used at all, which is useful for debugging.
+                Defaults to ``0``.
+            schedule (str, optional): ``static`` or ``dynamic`` distribution
+                of the values between the threads. Defaults to ``static``.
+            chunk_size (int, optional): Number of values claimed at once by a
+                thread with the ``dynamic`` schedule, 0 for an automatic size.
+                Defaults to ``0``.
+            reorder (bool, optional): If True, the values are processed in
+                the order of a space-filling curve (Morton order). Defaults to
+                ``False``.
+            p (int, optional): The power to be used by the interpolator
+                inverse_distance_weighting. Default to ``2``.
+            min_valid (int, optional): The minimum number of defined corners
+                of the cell used by the interpolator bilinear, the undefined
+                corners being dropped and the weights of the others
+                renormalized. Default to ``4``: all the corners must be
+                defined.
+        Return:
+            numpy.ndarray: Values interpolated, of shape ``(x.size, 1 +
+            len(fields))``. The first column contains the values of the
+            bivariate function, followed by a column for each field.
+        """
+        return self._instance.evaluate_fields(
+            np.asarray(x), np.asarray(y),
+            [np.asarray(item) for item in fields],
+            self._n_variate_interpolator(interpolator, **kwargs), bounds_error,
+            num_threads, interface._core_schedule(schedule), chunk_size,
+            reorder)
+
+    def evaluate_gradient(self,
+                          x: np.ndarray,
+                          y: np.ndarray,
+                          bounds_error: Optional[bool] = False,
+                          num_threads: Optional[int] = 0,
+                          schedule: Optional[str] = "static",
+                          chunk_size: Optional[int] = 0,
+                          reorder: Optional[bool] = False) -> np.ndarray:
+        """Interpolate the values provided with the bilinear interpolation,
+        and calculate the partial derivatives of the interpolated surface.
+
+        The value and its derivatives are calculated in a single pass, from
+        the same cell and the same weights. The derivatives are expressed in
+        units of the function per unit of the axes (for example per degree
+        for a longitude axis).
+
+        Args:
+            x (numpy.ndarray): X-values
+            y (numpy.ndarray): Y-values
+            bounds_error (bool, optional): If True, when interpolated values
+                are requested outside of the domain of the input axes (x,y), a
+                :py:class:`ValueError` is raised. If False, then value is set
+                to Nan. Default to ``False``
+            num_threads (int, optional): The number of threads to use for the
+                computation. If 0 all CPUs are used. If 1 is given, no parallel
+                computing code is used at all, which is useful for debugging.
+                Defaults to ``0``.
+            schedule (str, optional): ``static`` or ``dynamic`` distribution
+                of the values between the threads. Defaults to ``static``.
+            chunk_size (int, optional): Number of values claimed at once by a
+                thread with the ``dynamic`` schedule, 0 for an automatic size.
+                Defaults to ``0``.
+            reorder (bool, optional): If True, the values are processed in
+                the order of a space-filling curve (Morton order). Defaults to
+                ``False``.
+        Return:
+            numpy.ndarray: Array of shape ``(x.size, 3)`` containing the
+            values interpolated, their derivatives with respect to x and
+            their derivatives with respect to y.
+        """
+        return self._instance.evaluate_gradient(
+            np.asarray(x), np.asarray(y), bounds_error, num_threads,
+            interface._core_schedule(schedule), chunk_size, reorder)
+
+    def plan(self,
+             x: np.ndarray,
+             y: np.ndarray,
+             interpolator: Optional[Union[
+                 str, core.BivariateInterpolator2D]] = "bilinear",
+             bounds_error: Optional[bool] = False,
+             num_threads: Optional[int] = 0,
+             **kwargs) -> core.InterpolationPlan:
+        """Precompute the interpolation of the values provided, in order to
+        interpolate many arrays defined on the axes of this grid (e.g. the
+        time steps of a model) with :py:meth:`InterpolationPlan.apply
+        <pyinterp.core.InterpolationPlan.apply>`.
+
+        Args:
+            x (numpy.ndarray): X-values
+            y (numpy.ndarray): Y-values
+            interpolator (str, optional): The method of interpolation to
+                perform. Supported are ``bilinear``, ``nearest``, and
+                ``inverse_distance_weighting``. Default to ``bilinear``.
+            bounds_error (bool, optional): If True, when interpolated values
+                are requested outside of the domain of the input axes (x,y), a
+                :py:class:`ValueError` is raised. If False, then value is set
+                to Nan. Default to ``False``
+            num_threads (int, optional): The number of threads to use for the
+                computation. If 0 all CPUs are used. If 1 is given, no parallel
+                computing code is used at all, which is useful for debugging.
+                Defaults to ``0``.
+            p (int, optional): The power to be used by the interpolator
+                inverse_distance_weighting. Default to ``2``.
+            min_valid (int, optional): The minimum number of defined corners
+                of the cell used by the interpolator bilinear, the undefined
+                corners being dropped and the weights of the others
+                renormalized. Default to ``4``: all the corners must be
+                defined.
+        Return:
+            pyinterp.core.InterpolationPlan: The interpolation plan
+        """
+        return self._instance.plan(
             np.asarray(x), np.asarray(y),
             self._n_variate_interpolator(interpolator, **kwargs), bounds_error,
             num_threads)
+
+    def regrid(self,
+               x: core.Axis,
+               y: core.Axis,
+               interpolator: Optional[Union[
+                   str, core.BivariateInterpolator2D]] = "bilinear",
+               bounds_error: Optional[bool] = False,
+               num_threads: Optional[int] = 0,
+               **kwargs) -> np.ndarray:
+        """Interpolate the bivariate function on the grid defined by the
+        target axes.
+
+        The result is identical to the evaluation of the function on the
+        points of the grid built by :py:func:`numpy.meshgrid` (with
+        ``indexing="ij"``), but the cells of the grid containing the target
+        coordinates are searched only once per axis.
+
+        Args:
+            x (pyinterp.core.Axis): X-Axis of the target grid
+            y (pyinterp.core.Axis): Y-Axis of the target grid
+            interpolator (str, optional): The method of interpolation to
+                perform. Supported are ``bilinear``, ``nearest``, and
+                ``inverse_distance_weighting``. Default to ``bilinear``.
+                An interpolator written in Python, deriving from
+                :py:class:`pyinterp.core.BivariateInterpolator2D` and
+                defining the method ``evaluate_batch``, can also be given.
+            bounds_error (bool, optional): If True, when interpolated values
+                are requested outside of the domain of the input axes (x,y), a
+                :py:class:`ValueError` is raised. If False, then value is set
+                to Nan. Default to ``False``
+            num_threads (int, optional): The number of threads to use for the
+                computation. If 0 all CPUs are used. If 1 is given, no parallel
+                computing code is used at all, which is useful for debugging.
+                Defaults to ``0``.
+            p (int, optional): The power to be used by the interpolator
+                inverse_distance_weighting. Default to ``2``.
+            min_valid (int, optional): The minimum number of defined corners
+                of the cell used by the interpolator bilinear, the undefined
+                corners being dropped and the weights of the others
+                renormalized. Default to ``4``: all the corners must be
+                defined.
+        Return:
+            numpy.ndarray: Values interpolated, of shape ``(x.size(),
+            y.size())``
+        """
+        return self._instance.regrid(
+            x, y, self._n_variate_interpolator(interpolator, **kwargs),
+            bounds_error, num_threads)
@@ -0,0 +1,217 @@
+// Copyright (c) 2019 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "benchmark.hpp"
+#include "pyinterp/detail/axis.hpp"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace detail = pyinterp::detail;
+namespace container = pyinterp::detail::axis::container;
+
+/// Search for the indexes framing the coordinates provided.
+///
+/// @tparam X Type of container used to search the axis
+template <typename X>
+static int64_t search(const detail::Axis& axis, const std::vector<double>& x) {
+  auto result = int64_t(0);
+  for (auto&& item : x) {
+    auto indexes = axis.find_indexes<X>(item);
+    if (indexes) {
+      result += std::get<0>(*indexes);
+    }
+  }
+  return result;
+}
+
+/// Bilinear interpolation of a grid, as performed by the evaluation loop of
+/// the bivariate interpolator.
+///
+/// @tparam X Type of container used to search the X-Axis
+/// @tparam Y Type of container used to search the Y-Axis
+template <typename X, typename Y>
+static double bilinear(const detail::Axis& x_axis, const X& x_container,
+                       const detail::Axis& y_axis, const Y& y_container,
+                       const std::vector<double>& grid,
+                       const std::vector<double>& x,
+                       const std::vector<double>& y) {
+  auto ny = y_axis.size();
+  auto result = 0.0;
+  for (size_t ix = 0; ix < x.size(); ++ix) {
+    auto x_indexes = x_axis.find_indexes<X>(x[ix]);
+    auto y_indexes = y_axis.find_indexes<Y>(y[ix]);
+    if (x_indexes && y_indexes) {
+      int64_t ix0, ix1, iy0, iy1;
+      std::tie(ix0, ix1) = *x_indexes;
+      std::tie(iy0, iy1) = *y_indexes;
+      auto x0 = x_container.coordinate_value(ix0);
+      auto y0 = y_container.coordinate_value(iy0);
+      auto t = (x[ix] - x0) / (x_container.coordinate_value(ix1) - x0);
+      auto u = (y[ix] - y0) / (y_container.coordinate_value(iy1) - y0);
+      result += (1 - t) * (1 - u) * grid[ix0 * ny + iy0] +
+                t * (1 - u) * grid[ix1 * ny + iy0] +
+                (1 - t) * u * grid[ix0 * ny + iy1] +
+                t * u * grid[ix1 * ny + iy1];
+    }
+  }
+  return result;
+}
+
+/// Gets the container of an axis through its virtual interface.
+static const container::Abstract& abstract(const detail::Axis& axis) {
+  return axis.visit(
+      [](const auto& item) -> const container::Abstract& { return item; });
+}
+
+/// Compares the throughput of the search through the virtual interface of the
+/// containers with the search specialized for the actual containers.
+static void run(const std::string& name, const detail::Axis& x_axis,
+                const detail::Axis& y_axis, const std::vector<double>& x,
+                const std::vector<double>& y) {
+  auto grid = std::vector<double>(x_axis.size() * y_axis.size(), 1.0);
+  auto repeat = size_t(10);
+
+  auto before = benchmark::measure(name + " search (virtual)", y.size(),
+                                   repeat, [&] {
+                                     benchmark::do_not_optimize(
+                                         search<container::Abstract>(y_axis,
+                                                                     y));
+                                   });
+  auto after = y_axis.visit([&](const auto& y_container) {
+    using Y = std::decay_t<decltype(y_container)>;
+    return benchmark::measure(name + " search (specialized)", y.size(), repeat,
+                              [&] {
+                                benchmark::do_not_optimize(
+                                    search<Y>(y_axis, y));
+                              });
+  });
+  std::printf("%-48s %10.2fx\n", (name + " search speedup").c_str(),
+              after / before);
+
+  before = benchmark::measure(name + " bilinear (virtual)", x.size(), repeat,
+                              [&] {
+                                benchmark::do_not_optimize(bilinear(
+                                    x_axis, abstract(x_axis), y_axis,
+                                    abstract(y_axis), grid, x, y));
+                              });
+  after = x_axis.visit([&](const auto& x_container) {
+    return y_axis.visit([&](const auto& y_container) {
+      return benchmark::measure(
+          name + " bilinear (specialized)", x.size(), repeat, [&] {
+            benchmark::do_not_optimize(bilinear(
+                x_axis, x_container, y_axis, y_container, grid, x, y));
+          });
+    });
+  });
+  std::printf("%-48s %10.2fx\n", (name + " bilinear speedup").c_str(),
+              after / before);
+}
+
+/// Compares the throughput of the binary search over the edges of an
+/// irregular axis with the search accelerated by the lookup table.
+static void run_lookup_table(const std::string& name,
+                             const std::vector<double>& values,
+                             const std::vector<double>& y) {
+  auto find = [&](const container::Irregular& axis) {
+    auto result = int64_t(0);
+    for (auto&& item : y) {
+      result += axis.find_index(item, false);
+    }
+    return result;
+  };
+  auto repeat = size_t(10);
+
+  auto binary_search = container::Irregular(values, 0);
+  auto before = benchmark::measure(name + " (binary search)", y.size(), repeat,
+                                   [&] {
+                                     benchmark::do_not_optimize(
+                                         find(binary_search));
+                                   });
+  auto lookup_table = container::Irregular(values);
+  auto after = benchmark::measure(name + " (lookup table)", y.size(), repeat,
+                                  [&] {
+                                    benchmark::do_not_optimize(
+                                        find(lookup_table));
+                                  });
+  std::printf("%-48s %10.2fx (%zu buckets, %zu bytes)\n",
+              (name + " speedup").c_str(), after / before,
+              lookup_table.bucket_count(), lookup_table.lookup_table_size());
+}
+
+/// Compares the throughput of the search of positions sorted along a track,
+/// with and without a cursor keeping the result of the previous search.
+static void run_cursor(const std::string& name, const detail::Axis& axis,
+                       const std::vector<double>& track) {
+  auto repeat = size_t(10);
+  axis.visit([&](const auto& container) {
+    using Container = std::decay_t<decltype(container)>;
+    auto before = benchmark::measure(
+        name + " (no cursor)", track.size(), repeat, [&] {
+          benchmark::do_not_optimize(search<Container>(axis, track));
+        });
+    auto after = benchmark::measure(
+        name + " (cursor)", track.size(), repeat, [&] {
+          auto cursor = detail::axis::Cursor();
+          auto result = int64_t(0);
+          for (auto&& item : track) {
+            auto indexes = axis.find_indexes<Container>(item, cursor);
+            if (indexes) {
+              result += std::get<0>(*indexes);
+            }
+          }
+          benchmark::do_not_optimize(result);
+        });
+    std::printf("%-48s %10.2fx\n", (name + " speedup").c_str(),
+                after / before);
+  });
+}
+
+int main() {
+  const size_t size = 1000000;
+  auto generator = std::mt19937(0);
+  auto lon = std::uniform_real_distribution<double>(-180, 180);
+  auto lat = std::uniform_real_distribution<double>(-80, 80);
+
+  auto x = std::vector<double>(size);
+  auto y = std::vector<double>(size);
+  for (size_t ix = 0; ix < size; ++ix) {
+    x[ix] = lon(generator);
+    y[ix] = lat(generator);
+  }
+
+  // Stretched latitudes, to build an irregular axis.
+  auto values = std::vector<double>();
+  for (auto ix = -80.0; ix <= 80.0; ix += 0.25) {
+    values.push_back(ix + 0.1 * std::sin(ix));
+  }
+
+  auto x_axis = detail::Axis(-180, 179.75, 1440, 1e-6, true);
+  auto y_regular = detail::Axis(-80, 80, 641);
+  auto y_irregular = detail::Axis(values);
+
+  run("Regular x Regular", x_axis, y_regular, x, y);
+  run("Regular x Irregular", x_axis, y_irregular, x, y);
+
+  // Axis stretched as a depth axis
+  auto depth = std::vector<double>();
+  for (auto ix = 0; ix < 100000; ++ix) {
+    depth.push_back(std::expm1(ix * 1e-4));
+  }
+  auto z = std::vector<double>(size);
+  auto uniform = std::uniform_real_distribution<double>(0, depth.back());
+  for (auto& item : z) {
+    item = uniform(generator);
+  }
+  run_lookup_table("Irregular search", values, y);
+  run_lookup_table("Stretched irregular search", depth, z);
+
+  // Along-track positions
+  std::sort(y.begin(), y.end());
+  std::sort(z.begin(), z.end());
+  run_cursor("Irregular sorted track", y_irregular, y);
+  run_cursor("Stretched irregular sorted track", detail::Axis(depth), z);
+  run_cursor("Regular sorted track", y_regular, y);
+  return 0;
+}
@@ -0,0 +1,109 @@
+// Copyright (c) 2019 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "benchmark.hpp"
+#include "pyinterp/detail/axis.hpp"
+#include "pyinterp/detail/geometry/point.hpp"
+#include "pyinterp/detail/math/batch.hpp"
+#include "pyinterp/detail/math/bivariate.hpp"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace detail = pyinterp::detail;
+namespace math = pyinterp::detail::math;
+
+/// Scalar interpolation loop of a grid, as performed by the bivariate
+/// interpolator for irregular axes.
+template <typename T>
+static void scalar(const detail::Axis& x_axis, const detail::Axis& y_axis,
+                   const std::vector<T>& grid, const std::vector<double>& x,
+                   const std::vector<double>& y, std::vector<double>& result) {
+  auto kernel = math::Bilinear<detail::geometry::Point2D, double>();
+  auto ny = y_axis.size();
+  auto x_cursor = detail::axis::Cursor();
+  auto y_cursor = detail::axis::Cursor();
+  for (size_t ix = 0; ix < x.size(); ++ix) {
+    auto x_indexes = x_axis.find_indexes<detail::axis::container::Regular>(
+        x[ix], x_cursor);
+    auto y_indexes = y_axis.find_indexes<detail::axis::container::Regular>(
+        y[ix], y_cursor);
+    if (x_indexes && y_indexes) {
+      int64_t ix0, ix1, iy0, iy1;
+      std::tie(ix0, ix1) = *x_indexes;
+      std::tie(iy0, iy1) = *y_indexes;
+      result[ix] = kernel.evaluate(
+          detail::geometry::Point2D<double>(x[ix], y[ix]),
+          detail::geometry::Point2D<double>(x_axis.coordinate_value(ix0),
+                                            y_axis.coordinate_value(iy0)),
+          detail::geometry::Point2D<double>(x_axis.coordinate_value(ix1),
+                                            y_axis.coordinate_value(iy1)),
+          grid[ix0 * ny + iy0], grid[ix0 * ny + iy1], grid[ix1 * ny + iy0],
+          grid[ix1 * ny + iy1]);
+    }
+  }
+}
+
+/// Batch interpolation loop of a grid, as performed by the bivariate
+/// interpolator for regular axes.
+template <typename T>
+static void batch(const detail::Axis& x_axis, const detail::Axis& y_axis,
+                  const std::vector<T>& grid, const std::vector<double>& x,
+                  const std::vector<double>& y, std::vector<double>& result) {
+  auto regular = [](const detail::Axis& axis) {
+    return math::batch::Regular{axis.coordinate_value(0), axis.increment(),
+                                static_cast<double>(axis.size() - 1)};
+  };
+  auto strides = std::array<int64_t, 2>{
+      static_cast<int64_t>(y_axis.size() * sizeof(T)),
+      static_cast<int64_t>(sizeof(T))};
+  math::batch::bilinear(grid.data(), strides, regular(x_axis),
+                        regular(y_axis), x.data(), y.data(), x.size(),
+                        result.data());
+}
+
+/// Compares the throughput of the scalar interpolation of a regular grid with
+/// the batch kernels.
+int main() {
+  const size_t size = 1000000;
+  auto generator = std::mt19937(0);
+  auto lon = std::uniform_real_distribution<double>(0, 359.75);
+  auto lat = std::uniform_real_distribution<double>(-80, 80);
+
+  auto x = std::vector<double>(size);
+  auto y = std::vector<double>(size);
+  auto result = std::vector<double>(size);
+  for (size_t ix = 0; ix < size; ++ix) {
+    x[ix] = lon(generator);
+    y[ix] = lat(generator);
+  }
+  // Points sorted along a track, as with along-track satellite data.
+  std::sort(x.begin(), x.end());
+
+  auto x_axis = detail::Axis(0, 359.75, 1440);
+  auto y_axis = detail::Axis(-80, 80, 641);
+  auto values = std::uniform_real_distribution<double>(-1, 1);
+  auto grid = std::vector<double>(x_axis.size() * y_axis.size());
+  auto grid32 = std::vector<float>(grid.size());
+  for (size_t ix = 0; ix < grid.size(); ++ix) {
+    grid[ix] = values(generator);
+    grid32[ix] = static_cast<float>(grid[ix]);
+  }
+
+  auto run = [&](const std::string& name, const auto& grid) {
+    auto before = benchmark::measure(name + " (scalar)", size, 10, [&] {
+      scalar(x_axis, y_axis, grid, x, y, result);
+      benchmark::do_not_optimize(result[0]);
+    });
+    auto after = benchmark::measure(name + " (batch)", size, 10, [&] {
+      batch(x_axis, y_axis, grid, x, y, result);
+      benchmark::do_not_optimize(result[0]);
+    });
+    std::printf("%-48s %10.2fx\n", (name + " speedup").c_str(),
+                after / before);
+  };
+  run("bilinear float64", grid);
+  run("bilinear float32", grid32);
+  return 0;
+}
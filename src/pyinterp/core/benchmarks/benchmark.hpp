@@ -0,0 +1,47 @@
+// Copyright (c) 2019 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+namespace benchmark {
+
+/// Prevents the compiler from optimizing away a computed value.
+template <typename T>
+inline void do_not_optimize(const T& value) {
+  static volatile T sink;
+  sink = value;
+  static_cast<void>(sink);
+}
+
+/// Measures the time taken by the function provided, called "repeat" times,
+/// and displays the throughput obtained.
+///
+/// @param name Name of the measurement
+/// @param items Number of items processed by one call of the function
+/// @param repeat Number of calls to perform
+/// @param function Function to measure
+/// @return the number of items processed per second
+template <typename Function>
+double measure(const std::string& name, const size_t items,
+               const size_t repeat, Function&& function) {
+  // Warm up
+  function();
+
+  auto start = std::chrono::steady_clock::now();
+  for (size_t ix = 0; ix < repeat; ++ix) {
+    function();
+  }
+  auto elapsed = std::chrono::duration<double>(
+                     std::chrono::steady_clock::now() - start)
+                     .count();
+  auto throughput = static_cast<double>(items * repeat) / elapsed;
+  std::printf("%-48s %10.3f ms %12.3f Mitems/s\n", name.c_str(),
+              elapsed * 1e3 / static_cast<double>(repeat), throughput * 1e-6);
+  return throughput;
+}
+
+}  // namespace benchmark
@@ -0,0 +1,117 @@
+// Copyright (c) 2019 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "benchmark.hpp"
+#include "pyinterp/detail/axis.hpp"
+#include "pyinterp/detail/geometry/point.hpp"
+#include "pyinterp/detail/math/bivariate.hpp"
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace detail = pyinterp::detail;
+namespace math = pyinterp::detail::math;
+
+/// Interpolator of a cartesian space
+using Interpolator = math::Bivariate<detail::geometry::Point2D, double>;
+
+/// Interpolation loop of a grid, as performed by the bivariate interpolator.
+///
+/// @tparam Kernel Type of the interpolator: the abstract interface to call the
+/// interpolator through the virtual table, or its actual type to resolve the
+/// calls at compile time.
+template <typename Kernel, typename X, typename Y>
+static void interpolate(const detail::Axis& x_axis, const X& x_container,
+                        const detail::Axis& y_axis, const Y& y_container,
+                        const std::vector<double>& grid,
+                        const std::vector<double>& x,
+                        const std::vector<double>& y, const Kernel& kernel,
+                        std::vector<double>& result) {
+  auto ny = y_axis.size();
+  auto x_cursor = detail::axis::Cursor();
+  auto y_cursor = detail::axis::Cursor();
+  for (size_t ix = 0; ix < x.size(); ++ix) {
+    auto x_indexes = x_axis.find_indexes<X>(x[ix], x_cursor);
+    auto y_indexes = y_axis.find_indexes<Y>(y[ix], y_cursor);
+    if (x_indexes && y_indexes) {
+      int64_t ix0, ix1, iy0, iy1;
+      std::tie(ix0, ix1) = *x_indexes;
+      std::tie(iy0, iy1) = *y_indexes;
+      result[ix] = kernel.evaluate(
+          detail::geometry::Point2D<double>(x[ix], y[ix]),
+          detail::geometry::Point2D<double>(x_container.coordinate_value(ix0),
+                                            y_container.coordinate_value(iy0)),
+          detail::geometry::Point2D<double>(x_container.coordinate_value(ix1),
+                                            y_container.coordinate_value(iy1)),
+          grid[ix0 * ny + iy0], grid[ix0 * ny + iy1], grid[ix1 * ny + iy0],
+          grid[ix1 * ny + iy1]);
+    }
+  }
+}
+
+/// Creates the interpolator from its name, so that its actual type is not
+/// known by the compiler at the call site.
+static std::unique_ptr<Interpolator> make(const std::string& name) {
+  if (name == "bilinear") {
+    return std::make_unique<
+        math::Bilinear<detail::geometry::Point2D, double>>();
+  }
+  if (name == "nearest") {
+    return std::make_unique<math::Nearest<detail::geometry::Point2D, double>>();
+  }
+  return std::make_unique<
+      math::InverseDistanceWeighting<detail::geometry::Point2D, double>>();
+}
+
+/// Compares the throughput of the interpolation of a regular grid calling the
+/// interpolators through their virtual interface, as done for the
+/// interpolators defined in Python, with the loops instantiated for the
+/// actual types of the interpolators.
+int main() {
+  const size_t size = 1000000;
+  auto generator = std::mt19937(0);
+  auto lon = std::uniform_real_distribution<double>(0, 359.75);
+  auto lat = std::uniform_real_distribution<double>(-80, 80);
+
+  auto x = std::vector<double>(size);
+  auto y = std::vector<double>(size);
+  auto result = std::vector<double>(size);
+  for (size_t ix = 0; ix < size; ++ix) {
+    x[ix] = lon(generator);
+    y[ix] = lat(generator);
+  }
+  // Points sorted along a track, as with along-track satellite data.
+  std::sort(x.begin(), x.end());
+
+  auto x_axis = detail::Axis(0, 359.75, 1440);
+  auto y_axis = detail::Axis(-80, 80, 641);
+  auto grid = std::vector<double>(x_axis.size() * y_axis.size(), 1.0);
+
+  x_axis.visit([&](const auto& x_container) {
+    y_axis.visit([&](const auto& y_container) {
+      for (auto name : {"bilinear", "nearest", "idw"}) {
+        auto interpolator = make(name);
+        auto before = benchmark::measure(
+            std::string(name) + " (virtual)", size, 10, [&] {
+              interpolate(x_axis, x_container, y_axis, y_container, grid, x, y,
+                          *interpolator, result);
+              benchmark::do_not_optimize(result[0]);
+            });
+        auto after = math::visit(
+            interpolator.get(), [&](const auto& kernel) {
+              return benchmark::measure(
+                  std::string(name) + " (static)", size, 10, [&] {
+                    interpolate(x_axis, x_container, y_axis, y_container, grid,
+                                x, y, kernel, result);
+                    benchmark::do_not_optimize(result[0]);
+                  });
+            });
+        std::printf("%-48s %10.2fx\n", (std::string(name) + " speedup").c_str(),
+                    after / before);
+      }
+    });
+  });
+  return 0;
+}
@@ -0,0 +1,152 @@
+// Copyright (c) 2019 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "benchmark.hpp"
+#include "pyinterp/detail/axis.hpp"
+#include "pyinterp/detail/geodetic/rtree.hpp"
+#include "pyinterp/detail/morton.hpp"
+#include <random>
+#include <vector>
+
+namespace detail = pyinterp::detail;
+
+/// Bilinear interpolation of a grid, the points being processed in the order
+/// given by "indexes", or in their original order if "indexes" is empty.
+template <typename X, typename Y>
+static void bilinear(const detail::Axis& x_axis, const X& x_container,
+                     const detail::Axis& y_axis, const Y& y_container,
+                     const std::vector<double>& grid,
+                     const std::vector<double>& x,
+                     const std::vector<double>& y,
+                     const std::vector<size_t>& indexes,
+                     std::vector<double>& result) {
+  auto ny = y_axis.size();
+  auto x_cursor = detail::axis::Cursor();
+  auto y_cursor = detail::axis::Cursor();
+  for (size_t jx = 0; jx < x.size(); ++jx) {
+    auto ix = indexes.empty() ? jx : indexes[jx];
+    auto x_indexes = x_axis.find_indexes<X>(x[ix], x_cursor);
+    auto y_indexes = y_axis.find_indexes<Y>(y[ix], y_cursor);
+    if (x_indexes && y_indexes) {
+      int64_t ix0, ix1, iy0, iy1;
+      std::tie(ix0, ix1) = *x_indexes;
+      std::tie(iy0, iy1) = *y_indexes;
+      auto x0 = x_container.coordinate_value(ix0);
+      auto y0 = y_container.coordinate_value(iy0);
+      auto t = (x[ix] - x0) / (x_container.coordinate_value(ix1) - x0);
+      auto u = (y[ix] - y0) / (y_container.coordinate_value(iy1) - y0);
+      result[ix] = (1 - t) * (1 - u) * grid[ix0 * ny + iy0] +
+                   t * (1 - u) * grid[ix1 * ny + iy0] +
+                   (1 - t) * u * grid[ix0 * ny + iy1] +
+                   t * u * grid[ix1 * ny + iy1];
+    }
+  }
+}
+
+/// Searches the nearest neighbours of the points, processed in the order
+/// given by "indexes", or in their original order if "indexes" is empty.
+static double nearest(const detail::geodetic::RTree<double, double>& rtree,
+                      const std::vector<double>& x,
+                      const std::vector<double>& y,
+                      const std::vector<size_t>& indexes) {
+  auto result = 0.0;
+  for (size_t jx = 0; jx < x.size(); ++jx) {
+    auto ix = indexes.empty() ? jx : indexes[jx];
+    for (auto&& item : rtree.query({x[ix], y[ix], 0}, 4)) {
+      result += item.first;
+    }
+  }
+  return result;
+}
+
+/// Compares the throughput of the interpolation of random points on a global
+/// grid of 0.05 degree (about 200 MiB) in their original order, and sorted
+/// along the Morton curve, the cost of the sort being included. The sort pays
+/// off once the number of points is large enough for neighbouring points to
+/// share the grid cells kept in the CPU caches.
+/// The same comparison is performed for the search of the nearest
+/// neighbours in a RTree of one million points.
+int main() {
+  auto x_axis = detail::Axis(-180, 179.95, 7200, 1e-6, true);
+  auto y_axis = detail::Axis(-90, 90, 3601);
+  auto grid = std::vector<double>(x_axis.size() * y_axis.size(), 1.0);
+  auto generator = std::mt19937(0);
+  auto lon = std::uniform_real_distribution<double>(-180, 180);
+  auto lat = std::uniform_real_distribution<double>(-90, 90);
+
+  x_axis.visit([&](const auto& x_container) {
+    y_axis.visit([&](const auto& y_container) {
+      using X = std::decay_t<decltype(x_container)>;
+      using Y = std::decay_t<decltype(y_container)>;
+
+      for (auto size : {1000, 10000, 100000, 1000000, 4000000}) {
+        auto x = std::vector<double>(size);
+        auto y = std::vector<double>(size);
+        auto result = std::vector<double>(size);
+        for (auto ix = 0; ix < size; ++ix) {
+          x[ix] = lon(generator);
+          y[ix] = lat(generator);
+        }
+        auto repeat = std::max(size_t(4000000 / size), size_t(2));
+        auto name = std::to_string(size) + " points";
+
+        auto before = benchmark::measure(
+            name + " (original order)", size, repeat, [&] {
+              bilinear<X, Y>(x_axis, x_container, y_axis, y_container, grid,
+                             x, y, {}, result);
+              benchmark::do_not_optimize(result[0]);
+            });
+        auto after = benchmark::measure(
+            name + " (Morton order)", size, repeat, [&] {
+              auto indexes = detail::morton::order<2>(
+                  [&](size_t ix, size_t dim) { return dim ? y[ix] : x[ix]; },
+                  size, 0);
+              bilinear<X, Y>(x_axis, x_container, y_axis, y_container, grid,
+                             x, y, indexes, result);
+              benchmark::do_not_optimize(result[0]);
+            });
+        std::printf("%-48s %10.2fx\n", (name + " speedup").c_str(),
+                    after / before);
+      }
+    });
+  });
+
+  auto rtree = detail::geodetic::RTree<double, double>({});
+  auto coordinates = detail::geodetic::Coordinates();
+  auto points = std::vector<std::pair<detail::geometry::Point3D<double>,
+                                      double>>();
+  for (auto ix = 0; ix < 1000000; ++ix) {
+    auto lla = detail::geometry::EquatorialPoint3D<double>(lon(generator),
+                                                           lat(generator), 0);
+    points.emplace_back(coordinates.lla_to_ecef(lla), 1.0);
+  }
+  rtree.packing(points);
+
+  for (auto size : {1000, 10000, 100000, 1000000}) {
+    auto x = std::vector<double>(size);
+    auto y = std::vector<double>(size);
+    for (auto ix = 0; ix < size; ++ix) {
+      x[ix] = lon(generator);
+      y[ix] = lat(generator);
+    }
+    auto repeat = std::max(size_t(100000 / size), size_t(2));
+    auto name = std::to_string(size) + " queries";
+
+    auto before = benchmark::measure(name + " (original order)", size, repeat,
+                                     [&] {
+                                       benchmark::do_not_optimize(
+                                           nearest(rtree, x, y, {}));
+                                     });
+    auto after = benchmark::measure(
+        name + " (Morton order)", size, repeat, [&] {
+          auto indexes = detail::morton::order<2>(
+              [&](size_t ix, size_t dim) { return dim ? y[ix] : x[ix]; },
+              size, 0);
+          benchmark::do_not_optimize(nearest(rtree, x, y, indexes));
+        });
+    std::printf("%-48s %10.2fx\n", (name + " speedup").c_str(),
+                after / before);
+  }
+  return 0;
+}
@@ -0,0 +1,78 @@
+// Copyright (c) 2019 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "benchmark.hpp"
+#include "pyinterp/detail/thread.hpp"
+#include <cmath>
+#include <vector>
+
+namespace detail = pyinterp::detail;
+
+/// Dispatching performed by creating new threads for each call.
+template <typename Lambda>
+static void spawn(Lambda worker, size_t size, size_t num_threads) {
+  std::vector<std::thread> threads(num_threads);
+  size_t start = 0, shift = size / num_threads;
+  for (auto it = std::begin(threads); it != std::end(threads) - 1; ++it) {
+    *it = std::thread(worker, start, start + shift);
+    start += shift;
+  }
+  threads.back() = std::thread(worker, start, size);
+  for (auto&& item : threads) {
+    item.join();
+  }
+}
+
+/// Compares the latency of the dispatching of small batches through the
+/// thread pool with the creation of new threads for each batch, then the
+/// static and dynamic schedules on a skewed workload.
+int main() {
+  const size_t num_threads = 4;
+  const size_t repeat = 1000;
+
+  // The threads requested are used even if the host has fewer CPUs.
+  detail::set_max_threads(num_threads);
+
+  for (auto size : {64, 256, 1024, 4096, 16384}) {
+    auto x = std::vector<double>(size, 1.0);
+    auto y = std::vector<double>(size);
+    auto worker = [&](size_t start, size_t end) {
+      for (auto ix = start; ix < end; ++ix) {
+        y[ix] = std::sqrt(x[ix] + static_cast<double>(ix));
+      }
+    };
+    auto name = std::to_string(size) + " items";
+    auto before = benchmark::measure(name + " (new threads)", size, repeat,
+                                     [&] { spawn(worker, size, num_threads); });
+    auto after = benchmark::measure(name + " (pool)", size, repeat, [&] {
+      detail::dispatch(worker, size, num_threads);
+    });
+    std::printf("%-48s %10.2fx\n", (name + " speedup").c_str(),
+                after / before);
+  }
+
+  // Skewed workload: the last eighth of the items costs 100 times more than
+  // the others, as for points located inside the domain of a grid mostly
+  // covered by land.
+  const size_t size = 1 << 16;
+  auto y = std::vector<double>(size);
+  auto skewed = [&](size_t start, size_t end) {
+    for (auto ix = start; ix < end; ++ix) {
+      auto iterations = ix >= size - size / 8 ? 100 : 1;
+      auto value = static_cast<double>(ix);
+      for (auto jx = 0; jx < iterations; ++jx) {
+        value = std::sqrt(value + 1.0);
+      }
+      y[ix] = value;
+    }
+  };
+  auto before = benchmark::measure("Skewed (static)", size, 10, [&] {
+    detail::dispatch(skewed, size, num_threads, detail::kStatic);
+  });
+  auto after = benchmark::measure("Skewed (dynamic)", size, 10, [&] {
+    detail::dispatch(skewed, size, num_threads, detail::kDynamic);
+  });
+  std::printf("%-48s %10.2fx\n", "Skewed speedup", after / before);
+  return 0;
+}
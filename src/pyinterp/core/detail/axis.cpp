@@ -3,6 +3,10 @@
 // All rights reserved. Use of this source code is governed by a
 // BSD-style license that can be found in the LICENSE file.
 #include "pyinterp/detail/axis.hpp"
+#include "pyinterp/detail/math/batch.hpp"
+#include <algorithm>
+#include <array>
+#include <limits>
 
 namespace pyinterp {
 namespace detail {
@@ -55,6 +59,20 @@ std::optional<double> is_evenly_spaced(const std::vector<double>& points,
   return increment;
 }
 
+axis::container::Type Axis::get_container_type(
+    const axis::container::Abstract* const axis) {
+  if (dynamic_cast<const axis::container::Regular*>(axis) != nullptr) {
+    return axis::container::kRegular;
+  }
+  if (dynamic_cast<const axis::container::Irregular*>(axis) != nullptr) {
+    return axis::container::kIrregular;
+  }
+  if (dynamic_cast<const axis::container::Undefined*>(axis) != nullptr) {
+    return axis::container::kUndefined;
+  }
+  throw std::invalid_argument("unknown axis container");
+}
+
 void Axis::compute_properties(const double epsilon) {
   // An axis can be represented by an empty set of values
   if (axis_->size() == 0) {
@@ -67,9 +85,8 @@ void Axis::compute_properties(const double epsilon) {
   // If this axis represents an angle, determine if it represents the entire
   // trigonometric circle.
   if (is_angle()) {
-    auto ptr = dynamic_cast<axis::container::Regular*>(axis_.get());
-    if (ptr != nullptr) {
-      is_circle_ = math::is_same<double>(std::fabs(ptr->step() * size()),
+    if (is_regular()) {
+      is_circle_ = math::is_same<double>(std::fabs(increment() * size()),
                                          circle_, epsilon);
     } else {
       auto increment = (axis_->back() - axis_->front()) / (axis_->size() - 1);
@@ -80,7 +97,8 @@ void Axis::compute_properties(const double epsilon) {
 }
 
 Axis::Axis(std::vector<double> values, const double epsilon,
-           const bool is_circle, const bool is_radian)
+           const bool is_circle, const bool is_radian,
+           const size_t bucket_factor)
     : circle_(Axis::set_circle(is_circle, is_radian)) {
   // Axis size control
   if (values.size() >
@@ -98,80 +116,43 @@ Axis::Axis(std::vector<double> values, const double epsilon,
   // interval.
   auto increment = is_evenly_spaced(values, epsilon);
   if (increment) {
+    type_ = axis::container::kRegular;
     axis_ = std::make_shared<axis::container::Regular>(axis::container::Regular(
         values.front(), values.back(), static_cast<double>(values.size())));
   } else {
+    type_ = axis::container::kIrregular;
     axis_ = std::make_shared<axis::container::Irregular>(
-        axis::container::Irregular(std::move(values)));
+        axis::container::Irregular(std::move(values), bucket_factor));
   }
   compute_properties(epsilon);
 }
 
 std::optional<std::tuple<int64_t, int64_t>> Axis::find_indexes(
     double coordinate) const {
-  coordinate = normalize_coordinate(coordinate);
-  auto length = size();
-  auto i0 = find_index(coordinate);
-
-  /// If the value is outside the circle, then the value is between the last and
-  /// first index.
-  if (i0 == -1) {
-    return is_circle_ ? std::make_tuple(static_cast<int64_t>(length - 1), 0LL)
-                      : std::optional<std::tuple<int64_t, int64_t>>();
-  }
-
-  // Given the delta between the found coordinate and the given coordinate,
-  // chose the other index that frames the coordinate
-  auto delta = coordinate - (*this)(i0);
-  auto i1 = i0;
-  if (delta == 0) {
-    // The requested coordinate is located on an element of the axis.
-    i1 == length - 1 ? --i0 : ++i1;
-  } else {
-    if (delta < 0) {
-      // The found point is located after the coordinate provided.
-      is_ascending() ? --i0 : ++i0;
-      if (is_circle_) {
-        i0 = math::remainder(i0, length);
-      }
-    } else {
-      // The found point is located before the coordinate provided.
-      is_ascending() ? ++i1 : --i1;
-      if (is_circle_) {
-        i1 = math::remainder(i1, length);
-      }
-    }
-  }
-
-  if (i0 >= 0 && i0 < length && i1 >= 0 && i1 < length) {
-    return std::make_tuple(i0, i1);
-  }
-  return std::optional<std::tuple<int64_t, int64_t>>{};
+  return visit([&](const auto& container) {
+    return find_indexes<std::decay_t<decltype(container)>>(coordinate);
+  });
 }
 
 std::vector<int64_t> Axis::find_indexes(double coordinate, uint32_t size,
                                         Boundary boundary) const {
-  if (size == 0) {
-    throw std::invalid_argument("The size must not be zero.");
-  }
-
-  // Axis size
-  auto len = this->size();
+  return visit([&](const auto& container) {
+    return find_indexes<std::decay_t<decltype(container)>>(coordinate, size,
+                                                           boundary);
+  });
+}
 
-  // Searches the initial indexes and populate the result
-  auto indexes = find_indexes(coordinate);
-  if (!indexes) {
-    return {};
-  }
-  auto result = std::vector<int64_t>(size << 1U);
-  std::tie(result[size - 1], result[size]) = *indexes;
+bool Axis::make_window(const std::tuple<int64_t, int64_t>& indexes,
+                       const int64_t len, const uint32_t size,
+                       const Boundary boundary, int64_t* const result) const {
+  std::tie(result[size - 1], result[size]) = indexes;
 
   // Offset in relation to the first indexes found
   uint32_t shift = 1;
 
   // Construction of window indexes based on the initial indexes found
   while (shift < size) {
-    int64_t before = std::get<0>(*indexes) - shift;
+    int64_t before = std::get<0>(indexes) - shift;
     if (before < 0) {
       if (!is_circle_) {
         switch (boundary) {
@@ -185,13 +166,13 @@ std::vector<int64_t> Axis::find_indexes(double coordinate, uint32_t size,
             before = math::remainder(-before, len);
             break;
           default:
-            return {};
+            return false;
         }
       } else {
         before = math::remainder(before, len);
       }
     }
-    int64_t after = std::get<1>(*indexes) + shift;
+    int64_t after = std::get<1>(indexes) + shift;
     if (after >= len) {
       if (!is_circle_) {
         switch (boundary) {
@@ -205,7 +186,7 @@ std::vector<int64_t> Axis::find_indexes(double coordinate, uint32_t size,
             after = len - 2 - math::remainder(after - len, len);
             break;
           default:
-            return {};
+            return false;
         }
       } else {
         after = math::remainder(after, len);
@@ -215,8 +196,90 @@ std::vector<int64_t> Axis::find_indexes(double coordinate, uint32_t size,
     result[size + shift] = after;
     ++shift;
   }
+  return true;
+}
+
+std::vector<int64_t> Axis::make_window(
+    const std::optional<std::tuple<int64_t, int64_t>>& indexes,
+    const int64_t len, const uint32_t size, const Boundary boundary) const {
+  if (!indexes) {
+    return {};
+  }
+  auto result = std::vector<int64_t>(size << 1U);
+  if (!make_window(*indexes, len, size, boundary, result.data())) {
+    return {};
+  }
   return result;
 }
 
+void Axis::find_regular_indexes(const double* const coordinates,
+                                const size_t size, int64_t* const i0,
+                                int64_t* const i1, double* const weight,
+                                bool* const mask) const {
+  const auto& container = static_cast<const axis::container::Regular&>(*axis_);
+  const auto start = container.front();
+  const auto step = container.step();
+  const auto min = container.min_value();
+  const auto length = static_cast<int32_t>(container.size());
+  const auto circle = is_angle() ? circle_ : 0.0;
+  auto buffer = std::array<double, math::batch::kSize>();
+
+  // The angles are normalized by a scalar loop, the vectorized search being
+  // carried out by blocks of positions.
+  for (size_t offset = 0; offset < size; offset += math::batch::kSize) {
+    const auto count = std::min(math::batch::kSize, size - offset);
+    const auto* block = coordinates + offset;
+    if (is_angle()) {
+      for (size_t ix = 0; ix < count; ++ix) {
+        auto coordinate = block[ix];
+        buffer[ix] = (coordinate >= min + circle || coordinate < min)
+                         ? math::normalize_angle(coordinate, min, circle)
+                         : coordinate;
+      }
+      block = buffer.data();
+    }
+    math::batch::find_indexes(start, step, length, is_circle_, circle, block,
+                              count, i0 + offset, i1 + offset,
+                              weight + offset, mask + offset);
+  }
+}
+
+void Axis::find_indexes(const double* const coordinates, const size_t size,
+                        int64_t* const i0, int64_t* const i1,
+                        double* const weight, bool* const mask) const {
+  if (type_ == axis::container::kRegular &&
+      this->size() <= std::numeric_limits<int32_t>::max()) {
+    find_regular_indexes(coordinates, size, i0, i1, weight, mask);
+    return;
+  }
+
+  visit([&](const auto& container) {
+    using Container = std::decay_t<decltype(container)>;
+    auto cursor = axis::Cursor();
+
+    for (size_t ix = 0; ix < size; ++ix) {
+      auto coordinate =
+          normalize_coordinate(coordinates[ix], container.min_value());
+      auto indexes = find_indexes<Container>(coordinate, cursor);
+      if (!indexes) {
+        i0[ix] = i1[ix] = -1;
+        weight[ix] = std::numeric_limits<double>::quiet_NaN();
+        mask[ix] = true;
+        continue;
+      }
+      std::tie(i0[ix], i1[ix]) = *indexes;
+      auto x0 = container.coordinate_value(i0[ix]);
+      auto dx = container.coordinate_value(i1[ix]) - x0;
+      auto dc = coordinate - x0;
+      if (is_angle()) {
+        dx -= circle_ * std::round(dx / circle_);
+        dc -= circle_ * std::round(dc / circle_);
+      }
+      weight[ix] = dc / dx;
+      mask[ix] = false;
+    }
+  });
+}
+
 }  // namespace detail
 }  // namespace pyinterp
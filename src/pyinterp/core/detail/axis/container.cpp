@@ -21,58 +21,47 @@ void Irregular::make_edges() {
   edges_[n] = 2 * points_[n - 1] - edges_[n - 1];
 }
 
-Irregular::Irregular(std::vector<double> points) : points_(std::move(points)) {
-  if (points_.empty()) {
-    throw std::invalid_argument("unable to create an empty container.");
+void Irregular::make_buckets() {
+  auto n = points_.size();
+  if (bucket_factor_ == 0 || n < 2) {
+    return;
   }
-  is_ascending_ = calculate_is_ascending();
-  make_edges();
-}
-
-int64_t Irregular::find_index(double coordinate, bool bounded) const {
-  int64_t low = 0;
-  int64_t mid = 0;
-  int64_t high = size();
-
-  if (is_ascending_) {
-    if (coordinate < edges_.front()) {
-      return bounded ? 0 : -1;
-    }
-
-    if (coordinate > edges_.back()) {
-      return bounded ? high - 1 : -1;
-    }
 
-    while (high > low + 1) {
-      mid = (low + high) >> 1;  // NOLINT (low and high are strictly positive)
-      auto value = edges_[mid];
-
-      if (value == coordinate) {
-        return mid;
-      }
-      value < coordinate ? low = mid : high = mid;
-    }
-    return low;
+  auto min = std::min(edges_.front(), edges_.back());
+  auto max = std::max(edges_.front(), edges_.back());
+  auto step = std::numeric_limits<double>::max();
+  for (size_t ix = 0; ix < n; ++ix) {
+    step = std::min(step, std::fabs(edges_[ix + 1] - edges_[ix]));
   }
-
-  if (coordinate < edges_.back()) {
-    return bounded ? high - 1 : -1;
+  if (!std::isfinite(max - min) || !(step > 0)) {
+    return;
   }
 
-  if (coordinate > edges_.front()) {
-    return bounded ? 0 : -1;
-  }
+  // The width of the buckets is, if possible, smaller than the smallest step
+  // of the axis so that a bucket overlaps at most two cells.
+  auto count = static_cast<size_t>(
+      std::min(std::ceil((max - min) / step), static_cast<double>(n) *
+                                                  bucket_factor_));
+  count = std::max(count, size_t(1));
 
-  while (high > low + 1) {
-    mid = (low + high) >> 1;  // NOLINT (low and high are strictly positive)
-    auto value = edges_[mid];
+  bucket_min_ = min;
+  bucket_scale_ = static_cast<double>(count) / (max - min);
+  buckets_.resize(count + 1);
+  for (size_t ix = 0; ix <= count; ++ix) {
+    auto value =
+        ix == count ? max : min + static_cast<double>(ix) / bucket_scale_;
+    buckets_[ix] = search(value, 0, static_cast<int64_t>(n));
+  }
+}
 
-    if (value == coordinate) {
-      return mid;
-    }
-    value < coordinate ? high = mid : low = mid;
+Irregular::Irregular(std::vector<double> points, const size_t bucket_factor)
+    : points_(std::move(points)), bucket_factor_(bucket_factor) {
+  if (points_.empty()) {
+    throw std::invalid_argument("unable to create an empty container.");
   }
-  return low;
+  is_ascending_ = calculate_is_ascending();
+  make_edges();
+  make_buckets();
 }
 
 }  // namespace container
@@ -0,0 +1,821 @@
+// Copyright (c) 2019 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "pyinterp/detail/math/batch.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// On x86-64 Linux, the kernels are compiled for several instruction sets,
+// the dynamic loader selecting the version adapted to the CPU. The functions
+// called by the kernels must be inlined to be compiled for the same
+// instruction sets.
+#if defined(__linux__) && defined(__x86_64__) && defined(__has_attribute)
+#if __has_attribute(target_clones)
+#define PYINTERP_TARGET_CLONES \
+  __attribute__((target_clones("avx512f", "avx2", "default")))
+#endif
+#endif
+#ifndef PYINTERP_TARGET_CLONES
+#define PYINTERP_TARGET_CLONES
+#endif
+#if defined(__GNUC__)
+#define PYINTERP_ALWAYS_INLINE inline __attribute__((always_inline))
+#else
+#define PYINTERP_ALWAYS_INLINE inline
+#endif
+
+namespace pyinterp {
+namespace detail {
+namespace math {
+namespace batch {
+
+// The kernels are templates of the type of the grid values, T, and of the
+// type used for the calculations, C: the coordinates, the weights and the
+// results are in single precision for the single precision interpolators,
+// which process twice as many values per vector instruction. The values read
+// are converted to C by a decoder, which unpacks the grids of packed
+// integers.
+
+/// Gets the fractional index of a coordinate on an axis.
+template <typename C>
+PYINTERP_ALWAYS_INLINE
+C position(const Regular& axis, const C coordinate) {
+  return (coordinate - static_cast<C>(axis.start)) /
+         static_cast<C>(axis.step);
+}
+
+/// Projects the fractional index onto the axis.
+template <typename C>
+PYINTERP_ALWAYS_INLINE
+C clamp(const Regular& axis, const C position) {
+  return std::min(std::max(position, C(0)), static_cast<C>(axis.last));
+}
+
+/// Gets the index of the first element of the cell containing the fractional
+/// index, the last element of the axis belonging to the last cell.
+template <typename C>
+PYINTERP_ALWAYS_INLINE
+C cell(const Regular& axis, const C position) {
+  auto index = std::floor(position);
+  auto last = static_cast<C>(axis.last);
+  return index < last ? index : last - 1;
+}
+
+/// Gets the offset, in bytes, of an element along a dimension of the grid.
+/// The index is converted to a 32-bit integer, a conversion available on all
+/// vector instruction sets.
+template <typename C>
+PYINTERP_ALWAYS_INLINE
+int64_t offset(const C index, const int64_t stride) {
+  return static_cast<int64_t>(static_cast<int32_t>(index)) * stride;
+}
+
+/// Decoder converting the values of a grid of floating point numbers.
+template <typename C>
+struct Cast {
+  template <typename T>
+  PYINTERP_ALWAYS_INLINE C operator()(const T item) const {
+    return static_cast<C>(item);
+  }
+};
+
+/// Decoder unpacking the values of a grid of packed integers. The fill value
+/// is replaced by NaN with a select, so that the loops remain free of
+/// branches.
+template <typename C>
+struct Unpack {
+  explicit Unpack(const Packing& packing)
+      : scale_factor(static_cast<C>(packing.scale_factor)),
+        add_offset(static_cast<C>(packing.add_offset)),
+        fill_value(static_cast<C>(packing.fill_value)) {}
+
+  template <typename T>
+  PYINTERP_ALWAYS_INLINE C operator()(const T item) const {
+    auto value = static_cast<C>(item);
+    return value == fill_value ? std::numeric_limits<C>::quiet_NaN()
+                               : value * scale_factor + add_offset;
+  }
+
+  C scale_factor;
+  C add_offset;
+  C fill_value;
+};
+
+/// Reads the value of the grid located at the given offset, in bytes.
+template <typename T, typename Decoder>
+PYINTERP_ALWAYS_INLINE
+auto value(const char* const grid, const int64_t offset,
+           const Decoder& decode) {
+  return decode(*reinterpret_cast<const T*>(grid + offset));
+}
+
+/// Bilinear interpolation of a batch of positions. The loop contains no
+/// branch: the positions located outside the grid read the first value of
+/// the grid, then their result is replaced by NaN. The compiler can thus
+/// vectorize it.
+template <typename T, typename C, typename Decoder = Cast<C>>
+PYINTERP_ALWAYS_INLINE
+void bilinear_kernel(const T* const grid, const std::array<int64_t, 2>& strides,
+                     const Regular& x_axis, const Regular& y_axis,
+                     const C* __restrict x, const C* __restrict y,
+                     const size_t size, C* __restrict result,
+                     const Decoder& decode = Decoder()) {
+  const auto* const base = reinterpret_cast<const char*>(grid);
+  for (size_t ix = 0; ix < size; ++ix) {
+    auto px = position(x_axis, x[ix]);
+    auto py = position(y_axis, y[ix]);
+    // Distance between the position and the grid, NaN if one of the
+    // coordinates is undefined.
+    auto distance = std::fabs(px - clamp(x_axis, px)) +
+                    std::fabs(py - clamp(y_axis, py));
+    auto inside = distance == 0;
+    px = inside ? px : 0;
+    py = inside ? py : 0;
+
+    auto i0 = cell(x_axis, px);
+    auto j0 = cell(y_axis, py);
+    auto t = px - i0;
+    auto u = py - j0;
+    auto x0 = offset(i0, strides[0]);
+    auto x1 = x0 + strides[0];
+    auto y0 = offset(j0, strides[1]);
+    auto y1 = y0 + strides[1];
+
+    auto q = (1 - t) * (1 - u) * value<T>(base, x0 + y0, decode) +
+             t * (1 - u) * value<T>(base, x1 + y0, decode) +
+             (1 - t) * u * value<T>(base, x0 + y1, decode) +
+             t * u * value<T>(base, x1 + y1, decode);
+    result[ix] = inside ? q : std::numeric_limits<C>::quiet_NaN();
+  }
+}
+
+/// Bilinear interpolation of a batch of positions and partial derivatives
+/// of the interpolated surface.
+///
+/// @see bilinear_kernel
+template <typename T, typename C, typename Decoder = Cast<C>>
+PYINTERP_ALWAYS_INLINE
+void bilinear_gradient_kernel(const T* const grid,
+                              const std::array<int64_t, 2>& strides,
+                              const Regular& x_axis, const Regular& y_axis,
+                              const C* __restrict x, const C* __restrict y,
+                              const size_t size, C* __restrict result,
+                              const Decoder& decode = Decoder()) {
+  constexpr auto nan = std::numeric_limits<C>::quiet_NaN();
+  const auto* const base = reinterpret_cast<const char*>(grid);
+  auto* __restrict dx = result + size;
+  auto* __restrict dy = result + 2 * size;
+  for (size_t ix = 0; ix < size; ++ix) {
+    auto px = position(x_axis, x[ix]);
+    auto py = position(y_axis, y[ix]);
+    auto distance = std::fabs(px - clamp(x_axis, px)) +
+                    std::fabs(py - clamp(y_axis, py));
+    auto inside = distance == 0;
+    px = inside ? px : 0;
+    py = inside ? py : 0;
+
+    auto i0 = cell(x_axis, px);
+    auto j0 = cell(y_axis, py);
+    auto t = px - i0;
+    auto u = py - j0;
+    auto x0 = offset(i0, strides[0]);
+    auto x1 = x0 + strides[0];
+    auto y0 = offset(j0, strides[1]);
+    auto y1 = y0 + strides[1];
+
+    auto q00 = value<T>(base, x0 + y0, decode);
+    auto q10 = value<T>(base, x1 + y0, decode);
+    auto q01 = value<T>(base, x0 + y1, decode);
+    auto q11 = value<T>(base, x1 + y1, decode);
+    auto q = (1 - t) * (1 - u) * q00 + t * (1 - u) * q10 +
+             (1 - t) * u * q01 + t * u * q11;
+    result[ix] = inside ? q : nan;
+    dx[ix] = ((1 - u) * (q10 - q00) + u * (q11 - q01)) /
+             static_cast<C>(x_axis.step);
+    dy[ix] = ((1 - t) * (q01 - q00) + t * (q11 - q10)) /
+             static_cast<C>(y_axis.step);
+  }
+}
+
+/// Trilinear interpolation of a batch of positions.
+///
+/// @see bilinear_kernel
+template <typename T, typename C, typename Decoder = Cast<C>>
+PYINTERP_ALWAYS_INLINE
+void trilinear_kernel(const T* const grid,
+                      const std::array<int64_t, 3>& strides,
+                      const Regular& x_axis, const Regular& y_axis,
+                      const Regular& z_axis, const C* __restrict x,
+                      const C* __restrict y, const C* __restrict z,
+                      const size_t size, C* __restrict result,
+                      const Decoder& decode = Decoder()) {
+  const auto* const base = reinterpret_cast<const char*>(grid);
+  for (size_t ix = 0; ix < size; ++ix) {
+    auto px = position(x_axis, x[ix]);
+    auto py = position(y_axis, y[ix]);
+    auto pz = position(z_axis, z[ix]);
+    auto distance = std::fabs(px - clamp(x_axis, px)) +
+                    std::fabs(py - clamp(y_axis, py)) +
+                    std::fabs(pz - clamp(z_axis, pz));
+    auto inside = distance == 0;
+    px = inside ? px : 0;
+    py = inside ? py : 0;
+    pz = inside ? pz : 0;
+
+    auto i0 = cell(x_axis, px);
+    auto j0 = cell(y_axis, py);
+    auto k0 = cell(z_axis, pz);
+    auto t = px - i0;
+    auto u = py - j0;
+    auto v = pz - k0;
+    auto x0 = offset(i0, strides[0]);
+    auto x1 = x0 + strides[0];
+    auto y0 = offset(j0, strides[1]);
+    auto y1 = y0 + strides[1];
+    auto z0 = offset(k0, strides[2]);
+    auto z1 = z0 + strides[2];
+
+    auto w00 = (1 - t) * (1 - u);
+    auto w10 = t * (1 - u);
+    auto w01 = (1 - t) * u;
+    auto w11 = t * u;
+    auto q0 = w00 * value<T>(base, x0 + y0 + z0, decode) +
+              w10 * value<T>(base, x1 + y0 + z0, decode) +
+              w01 * value<T>(base, x0 + y1 + z0, decode) +
+              w11 * value<T>(base, x1 + y1 + z0, decode);
+    auto q1 = w00 * value<T>(base, x0 + y0 + z1, decode) +
+              w10 * value<T>(base, x1 + y0 + z1, decode) +
+              w01 * value<T>(base, x0 + y1 + z1, decode) +
+              w11 * value<T>(base, x1 + y1 + z1, decode);
+    auto q = (1 - v) * q0 + v * q1;
+    result[ix] = inside ? q : std::numeric_limits<C>::quiet_NaN();
+  }
+}
+
+/// Bilinear interpolation of a batch of positions on several fields. The
+/// cells framing the positions and the weights of the interpolation are
+/// calculated by a first loop, then the values of each field are blended by
+/// a second loop. The weights of the positions located outside the grid are
+/// set to NaN, so are the interpolated values.
+///
+/// @see bilinear_kernel
+template <typename T, typename C, typename Decoder = Cast<C>>
+PYINTERP_ALWAYS_INLINE
+void bilinear_fields_kernel(const T* const* grids,
+                            const std::array<int64_t, 2>* strides,
+                            const size_t fields, const Regular& x_axis,
+                            const Regular& y_axis, const C* __restrict x,
+                            const C* __restrict y, const size_t size,
+                            C* __restrict result,
+                            const Decoder& decode = Decoder()) {
+  constexpr auto nan = std::numeric_limits<C>::quiet_NaN();
+  C i0[kSize], j0[kSize];
+  C w00[kSize], w01[kSize], w10[kSize], w11[kSize];
+
+  for (size_t ix = 0; ix < size; ++ix) {
+    auto px = position(x_axis, x[ix]);
+    auto py = position(y_axis, y[ix]);
+    auto distance = std::fabs(px - clamp(x_axis, px)) +
+                    std::fabs(py - clamp(y_axis, py));
+    auto inside = distance == 0;
+    px = inside ? px : 0;
+    py = inside ? py : 0;
+
+    i0[ix] = cell(x_axis, px);
+    j0[ix] = cell(y_axis, py);
+    auto t = px - i0[ix];
+    auto u = py - j0[ix];
+    w00[ix] = inside ? (1 - t) * (1 - u) : nan;
+    w10[ix] = t * (1 - u);
+    w01[ix] = (1 - t) * u;
+    w11[ix] = t * u;
+  }
+
+  for (size_t kx = 0; kx < fields; ++kx) {
+    const auto* const base = reinterpret_cast<const char*>(grids[kx]);
+    const auto& stride = strides[kx];
+    auto* const values = result + kx * size;
+    for (size_t ix = 0; ix < size; ++ix) {
+      auto x0 = offset(i0[ix], stride[0]);
+      auto x1 = x0 + stride[0];
+      auto y0 = offset(j0[ix], stride[1]);
+      auto y1 = y0 + stride[1];
+      values[ix] = w00[ix] * value<T>(base, x0 + y0, decode) +
+                   w10[ix] * value<T>(base, x1 + y0, decode) +
+                   w01[ix] * value<T>(base, x0 + y1, decode) +
+                   w11[ix] * value<T>(base, x1 + y1, decode);
+    }
+  }
+}
+
+/// Trilinear interpolation of a batch of positions on several fields.
+///
+/// @see bilinear_fields_kernel
+template <typename T, typename C, typename Decoder = Cast<C>>
+PYINTERP_ALWAYS_INLINE
+void trilinear_fields_kernel(const T* const* grids,
+                             const std::array<int64_t, 3>* strides,
+                             const size_t fields, const Regular& x_axis,
+                             const Regular& y_axis, const Regular& z_axis,
+                             const C* __restrict x, const C* __restrict y,
+                             const C* __restrict z, const size_t size,
+                             C* __restrict result,
+                             const Decoder& decode = Decoder()) {
+  constexpr auto nan = std::numeric_limits<C>::quiet_NaN();
+  C i0[kSize], j0[kSize], k0[kSize], v[kSize];
+  C w00[kSize], w01[kSize], w10[kSize], w11[kSize];
+
+  for (size_t ix = 0; ix < size; ++ix) {
+    auto px = position(x_axis, x[ix]);
+    auto py = position(y_axis, y[ix]);
+    auto pz = position(z_axis, z[ix]);
+    auto distance = std::fabs(px - clamp(x_axis, px)) +
+                    std::fabs(py - clamp(y_axis, py)) +
+                    std::fabs(pz - clamp(z_axis, pz));
+    auto inside = distance == 0;
+    px = inside ? px : 0;
+    py = inside ? py : 0;
+    pz = inside ? pz : 0;
+
+    i0[ix] = cell(x_axis, px);
+    j0[ix] = cell(y_axis, py);
+    k0[ix] = cell(z_axis, pz);
+    auto t = px - i0[ix];
+    auto u = py - j0[ix];
+    v[ix] = pz - k0[ix];
+    w00[ix] = inside ? (1 - t) * (1 - u) : nan;
+    w10[ix] = t * (1 - u);
+    w01[ix] = (1 - t) * u;
+    w11[ix] = t * u;
+  }
+
+  for (size_t kx = 0; kx < fields; ++kx) {
+    const auto* const base = reinterpret_cast<const char*>(grids[kx]);
+    const auto& stride = strides[kx];
+    auto* const values = result + kx * size;
+    for (size_t ix = 0; ix < size; ++ix) {
+      auto x0 = offset(i0[ix], stride[0]);
+      auto x1 = x0 + stride[0];
+      auto y0 = offset(j0[ix], stride[1]);
+      auto y1 = y0 + stride[1];
+      auto z0 = offset(k0[ix], stride[2]);
+      auto z1 = z0 + stride[2];
+      auto q0 = w00[ix] * value<T>(base, x0 + y0 + z0, decode) +
+                w10[ix] * value<T>(base, x1 + y0 + z0, decode) +
+                w01[ix] * value<T>(base, x0 + y1 + z0, decode) +
+                w11[ix] * value<T>(base, x1 + y1 + z0, decode);
+      auto q1 = w00[ix] * value<T>(base, x0 + y0 + z1, decode) +
+                w10[ix] * value<T>(base, x1 + y0 + z1, decode) +
+                w01[ix] * value<T>(base, x0 + y1 + z1, decode) +
+                w11[ix] * value<T>(base, x1 + y1 + z1, decode);
+      values[ix] = (1 - v[ix]) * q0 + v[ix] * q1;
+    }
+  }
+}
+
+/// Search of the indexes framing a batch of positions on a regular axis. The
+/// branches of Axis::find_indexes(double) are replaced by selects computed
+/// on 32-bit integers, the conversion of a double to a 64-bit integer not
+/// being vectorized. The indexes are widened when stored.
+///
+/// @tparam Circle True if the axis represents a circle.
+/// @tparam Angle True if the axis represents an angle.
+template <bool Circle, bool Angle>
+PYINTERP_ALWAYS_INLINE
+void find_indexes_kernel(const double start, const double step,
+                         const int32_t length, const double circle,
+                         const double* __restrict coordinates,
+                         const size_t size, int64_t* __restrict i0,
+                         int64_t* __restrict i1, double* __restrict weight,
+                         bool* __restrict mask) {
+  const auto last = static_cast<double>(length);
+  const auto direction = step > 0 ? int32_t(1) : int32_t(-1);
+  for (size_t ix = 0; ix < size; ++ix) {
+    auto coordinate = coordinates[ix];
+    auto position = std::round((coordinate - start) / step);
+    // NaN positions are outside the axis.
+    auto outside = !((position >= 0) & (position < last));
+    auto index = static_cast<int32_t>(outside ? 0.0 : position);
+    auto delta = coordinate - (start + static_cast<double>(index) * step);
+    auto edge = index == length - 1;
+
+    // Index framing the position provided, if the found point is located
+    // after (delta < 0) or before (delta > 0) the position.
+    auto j0 = delta == 0 ? (edge ? index - 1 : index)
+                         : (delta < 0 ? index - direction : index);
+    auto j1 = delta == 0 ? (edge ? index : index + 1)
+                         : (delta < 0 ? index : index + direction);
+    if (Circle) {
+      j0 += j0 < 0 ? length : (j0 >= length ? -length : 0);
+      j1 += j1 < 0 ? length : (j1 >= length ? -length : 0);
+      // If the value is outside the circle, then the value is between the
+      // last and first index.
+      j0 = outside ? length - 1 : j0;
+      j1 = outside ? 0 : j1;
+    } else {
+      j0 = outside ? -1 : j0;
+      j1 = outside ? -1 : j1;
+    }
+
+    auto valid =
+        Circle || ((j0 >= 0) & (j0 < length) & (j1 >= 0) & (j1 < length));
+    auto x0 = start + static_cast<double>(j0) * step;
+    auto dx = static_cast<double>(j1 - j0) * step;
+    auto dc = coordinate - x0;
+    if (Angle) {
+      dx -= circle * std::round(dx / circle);
+      dc -= circle * std::round(dc / circle);
+    }
+    i0[ix] = valid ? j0 : -1;
+    i1[ix] = valid ? j1 : -1;
+    weight[ix] = valid ? dc / dx : std::numeric_limits<double>::quiet_NaN();
+  }
+  // The mask is stored apart: a boolean store in the previous loop prevents
+  // its vectorization.
+  for (size_t ix = 0; ix < size; ++ix) {
+    mask[ix] = i0[ix] < 0;
+  }
+}
+
+PYINTERP_TARGET_CLONES
+void bilinear(const double* const grid, const std::array<int64_t, 2>& strides,
+              const Regular& x_axis, const Regular& y_axis,
+              const double* const x, const double* const y, const size_t size,
+              double* const result) {
+  bilinear_kernel(grid, strides, x_axis, y_axis, x, y, size, result);
+}
+
+PYINTERP_TARGET_CLONES
+void bilinear(const float* const grid, const std::array<int64_t, 2>& strides,
+              const Regular& x_axis, const Regular& y_axis,
+              const double* const x, const double* const y, const size_t size,
+              double* const result) {
+  bilinear_kernel(grid, strides, x_axis, y_axis, x, y, size, result);
+}
+
+PYINTERP_TARGET_CLONES
+void bilinear_gradient(const double* const grid,
+                       const std::array<int64_t, 2>& strides,
+                       const Regular& x_axis, const Regular& y_axis,
+                       const double* const x, const double* const y,
+                       const size_t size, double* const result) {
+  bilinear_gradient_kernel(grid, strides, x_axis, y_axis, x, y, size, result);
+}
+
+PYINTERP_TARGET_CLONES
+void bilinear_gradient(const float* const grid,
+                       const std::array<int64_t, 2>& strides,
+                       const Regular& x_axis, const Regular& y_axis,
+                       const double* const x, const double* const y,
+                       const size_t size, double* const result) {
+  bilinear_gradient_kernel(grid, strides, x_axis, y_axis, x, y, size, result);
+}
+
+PYINTERP_TARGET_CLONES
+void trilinear(const double* const grid, const std::array<int64_t, 3>& strides,
+               const Regular& x_axis, const Regular& y_axis,
+               const Regular& z_axis, const double* const x,
+               const double* const y, const double* const z, const size_t size,
+               double* const result) {
+  trilinear_kernel(grid, strides, x_axis, y_axis, z_axis, x, y, z, size,
+                   result);
+}
+
+PYINTERP_TARGET_CLONES
+void trilinear(const float* const grid, const std::array<int64_t, 3>& strides,
+               const Regular& x_axis, const Regular& y_axis,
+               const Regular& z_axis, const double* const x,
+               const double* const y, const double* const z, const size_t size,
+               double* const result) {
+  trilinear_kernel(grid, strides, x_axis, y_axis, z_axis, x, y, z, size,
+                   result);
+}
+
+PYINTERP_TARGET_CLONES
+void bilinear(const double* const* grids,
+              const std::array<int64_t, 2>* strides, const size_t fields,
+              const Regular& x_axis, const Regular& y_axis,
+              const double* const x, const double* const y, const size_t size,
+              double* const result) {
+  bilinear_fields_kernel(grids, strides, fields, x_axis, y_axis, x, y, size,
+                         result);
+}
+
+PYINTERP_TARGET_CLONES
+void bilinear(const float* const* grids, const std::array<int64_t, 2>* strides,
+              const size_t fields, const Regular& x_axis,
+              const Regular& y_axis, const double* const x,
+              const double* const y, const size_t size, double* const result) {
+  bilinear_fields_kernel(grids, strides, fields, x_axis, y_axis, x, y, size,
+                         result);
+}
+
+PYINTERP_TARGET_CLONES
+void trilinear(const double* const* grids,
+               const std::array<int64_t, 3>* strides, const size_t fields,
+               const Regular& x_axis, const Regular& y_axis,
+               const Regular& z_axis, const double* const x,
+               const double* const y, const double* const z, const size_t size,
+               double* const result) {
+  trilinear_fields_kernel(grids, strides, fields, x_axis, y_axis, z_axis, x, y,
+                          z, size, result);
+}
+
+PYINTERP_TARGET_CLONES
+void trilinear(const float* const* grids,
+               const std::array<int64_t, 3>* strides, const size_t fields,
+               const Regular& x_axis, const Regular& y_axis,
+               const Regular& z_axis, const double* const x,
+               const double* const y, const double* const z, const size_t size,
+               double* const result) {
+  trilinear_fields_kernel(grids, strides, fields, x_axis, y_axis, z_axis, x, y,
+                          z, size, result);
+}
+
+PYINTERP_TARGET_CLONES
+void bilinear(const float* const grid, const std::array<int64_t, 2>& strides,
+              const Regular& x_axis, const Regular& y_axis,
+              const float* const x, const float* const y, const size_t size,
+              float* const result) {
+  bilinear_kernel(grid, strides, x_axis, y_axis, x, y, size, result);
+}
+
+PYINTERP_TARGET_CLONES
+void bilinear_gradient(const float* const grid,
+                       const std::array<int64_t, 2>& strides,
+                       const Regular& x_axis, const Regular& y_axis,
+                       const float* const x, const float* const y,
+                       const size_t size, float* const result) {
+  bilinear_gradient_kernel(grid, strides, x_axis, y_axis, x, y, size, result);
+}
+
+PYINTERP_TARGET_CLONES
+void trilinear(const float* const grid, const std::array<int64_t, 3>& strides,
+               const Regular& x_axis, const Regular& y_axis,
+               const Regular& z_axis, const float* const x,
+               const float* const y, const float* const z, const size_t size,
+               float* const result) {
+  trilinear_kernel(grid, strides, x_axis, y_axis, z_axis, x, y, z, size,
+                   result);
+}
+
+PYINTERP_TARGET_CLONES
+void bilinear(const float* const* grids, const std::array<int64_t, 2>* strides,
+              const size_t fields, const Regular& x_axis,
+              const Regular& y_axis, const float* const x,
+              const float* const y, const size_t size, float* const result) {
+  bilinear_fields_kernel(grids, strides, fields, x_axis, y_axis, x, y, size,
+                         result);
+}
+
+PYINTERP_TARGET_CLONES
+void trilinear(const float* const* grids,
+               const std::array<int64_t, 3>* strides, const size_t fields,
+               const Regular& x_axis, const Regular& y_axis,
+               const Regular& z_axis, const float* const x,
+               const float* const y, const float* const z, const size_t size,
+               float* const result) {
+  trilinear_fields_kernel(grids, strides, fields, x_axis, y_axis, z_axis, x, y,
+                          z, size, result);
+}
+
+PYINTERP_TARGET_CLONES
+void bilinear(const int8_t* const grid,
+              const std::array<int64_t, 2>& strides, const Packing& packing,
+              const Regular& x_axis, const Regular& y_axis,
+              const double* const x, const double* const y, const size_t size,
+              double* const result) {
+  bilinear_kernel(grid, strides, x_axis, y_axis, x, y, size, result,
+                  Unpack<double>(packing));
+}
+
+PYINTERP_TARGET_CLONES
+void bilinear_gradient(const int8_t* const grid,
+                       const std::array<int64_t, 2>& strides,
+                       const Packing& packing, const Regular& x_axis,
+                       const Regular& y_axis, const double* const x,
+                       const double* const y, const size_t size,
+                       double* const result) {
+  bilinear_gradient_kernel(grid, strides, x_axis, y_axis, x, y, size, result,
+                           Unpack<double>(packing));
+}
+
+PYINTERP_TARGET_CLONES
+void trilinear(const int8_t* const grid,
+               const std::array<int64_t, 3>& strides, const Packing& packing,
+               const Regular& x_axis, const Regular& y_axis,
+               const Regular& z_axis, const double* const x,
+               const double* const y, const double* const z, const size_t size,
+               double* const result) {
+  trilinear_kernel(grid, strides, x_axis, y_axis, z_axis, x, y, z, size,
+                   result, Unpack<double>(packing));
+}
+
+PYINTERP_TARGET_CLONES
+void bilinear(const int8_t* const* grids,
+              const std::array<int64_t, 2>* strides, const size_t fields,
+              const Packing& packing, const Regular& x_axis,
+              const Regular& y_axis, const double* const x,
+              const double* const y, const size_t size, double* const result) {
+  bilinear_fields_kernel(grids, strides, fields, x_axis, y_axis, x, y, size,
+                         result, Unpack<double>(packing));
+}
+
+PYINTERP_TARGET_CLONES
+void trilinear(const int8_t* const* grids,
+               const std::array<int64_t, 3>* strides, const size_t fields,
+               const Packing& packing, const Regular& x_axis,
+               const Regular& y_axis, const Regular& z_axis,
+               const double* const x, const double* const y,
+               const double* const z, const size_t size,
+               double* const result) {
+  trilinear_fields_kernel(grids, strides, fields, x_axis, y_axis, z_axis, x, y,
+                          z, size, result, Unpack<double>(packing));
+}
+
+PYINTERP_TARGET_CLONES
+void bilinear(const uint8_t* const grid,
+              const std::array<int64_t, 2>& strides, const Packing& packing,
+              const Regular& x_axis, const Regular& y_axis,
+              const double* const x, const double* const y, const size_t size,
+              double* const result) {
+  bilinear_kernel(grid, strides, x_axis, y_axis, x, y, size, result,
+                  Unpack<double>(packing));
+}
+
+PYINTERP_TARGET_CLONES
+void bilinear_gradient(const uint8_t* const grid,
+                       const std::array<int64_t, 2>& strides,
+                       const Packing& packing, const Regular& x_axis,
+                       const Regular& y_axis, const double* const x,
+                       const double* const y, const size_t size,
+                       double* const result) {
+  bilinear_gradient_kernel(grid, strides, x_axis, y_axis, x, y, size, result,
+                           Unpack<double>(packing));
+}
+
+PYINTERP_TARGET_CLONES
+void trilinear(const uint8_t* const grid,
+               const std::array<int64_t, 3>& strides, const Packing& packing,
+               const Regular& x_axis, const Regular& y_axis,
+               const Regular& z_axis, const double* const x,
+               const double* const y, const double* const z, const size_t size,
+               double* const result) {
+  trilinear_kernel(grid, strides, x_axis, y_axis, z_axis, x, y, z, size,
+                   result, Unpack<double>(packing));
+}
+
+PYINTERP_TARGET_CLONES
+void bilinear(const uint8_t* const* grids,
+              const std::array<int64_t, 2>* strides, const size_t fields,
+              const Packing& packing, const Regular& x_axis,
+              const Regular& y_axis, const double* const x,
+              const double* const y, const size_t size, double* const result) {
+  bilinear_fields_kernel(grids, strides, fields, x_axis, y_axis, x, y, size,
+                         result, Unpack<double>(packing));
+}
+
+PYINTERP_TARGET_CLONES
+void trilinear(const uint8_t* const* grids,
+               const std::array<int64_t, 3>* strides, const size_t fields,
+               const Packing& packing, const Regular& x_axis,
+               const Regular& y_axis, const Regular& z_axis,
+               const double* const x, const double* const y,
+               const double* const z, const size_t size,
+               double* const result) {
+  trilinear_fields_kernel(grids, strides, fields, x_axis, y_axis, z_axis, x, y,
+                          z, size, result, Unpack<double>(packing));
+}
+
+PYINTERP_TARGET_CLONES
+void bilinear(const int16_t* const grid,
+              const std::array<int64_t, 2>& strides, const Packing& packing,
+              const Regular& x_axis, const Regular& y_axis,
+              const double* const x, const double* const y, const size_t size,
+              double* const result) {
+  bilinear_kernel(grid, strides, x_axis, y_axis, x, y, size, result,
+                  Unpack<double>(packing));
+}
+
+PYINTERP_TARGET_CLONES
+void bilinear_gradient(const int16_t* const grid,
+                       const std::array<int64_t, 2>& strides,
+                       const Packing& packing, const Regular& x_axis,
+                       const Regular& y_axis, const double* const x,
+                       const double* const y, const size_t size,
+                       double* const result) {
+  bilinear_gradient_kernel(grid, strides, x_axis, y_axis, x, y, size, result,
+                           Unpack<double>(packing));
+}
+
+PYINTERP_TARGET_CLONES
+void trilinear(const int16_t* const grid,
+               const std::array<int64_t, 3>& strides, const Packing& packing,
+               const Regular& x_axis, const Regular& y_axis,
+               const Regular& z_axis, const double* const x,
+               const double* const y, const double* const z, const size_t size,
+               double* const result) {
+  trilinear_kernel(grid, strides, x_axis, y_axis, z_axis, x, y, z, size,
+                   result, Unpack<double>(packing));
+}
+
+PYINTERP_TARGET_CLONES
+void bilinear(const int16_t* const* grids,
+              const std::array<int64_t, 2>* strides, const size_t fields,
+              const Packing& packing, const Regular& x_axis,
+              const Regular& y_axis, const double* const x,
+              const double* const y, const size_t size, double* const result) {
+  bilinear_fields_kernel(grids, strides, fields, x_axis, y_axis, x, y, size,
+                         result, Unpack<double>(packing));
+}
+
+PYINTERP_TARGET_CLONES
+void trilinear(const int16_t* const* grids,
+               const std::array<int64_t, 3>* strides, const size_t fields,
+               const Packing& packing, const Regular& x_axis,
+               const Regular& y_axis, const Regular& z_axis,
+               const double* const x, const double* const y,
+               const double* const z, const size_t size,
+               double* const result) {
+  trilinear_fields_kernel(grids, strides, fields, x_axis, y_axis, z_axis, x, y,
+                          z, size, result, Unpack<double>(packing));
+}
+
+PYINTERP_TARGET_CLONES
+void bilinear(const uint16_t* const grid,
+              const std::array<int64_t, 2>& strides, const Packing& packing,
+              const Regular& x_axis, const Regular& y_axis,
+              const double* const x, const double* const y, const size_t size,
+              double* const result) {
+  bilinear_kernel(grid, strides, x_axis, y_axis, x, y, size, result,
+                  Unpack<double>(packing));
+}
+
+PYINTERP_TARGET_CLONES
+void bilinear_gradient(const uint16_t* const grid,
+                       const std::array<int64_t, 2>& strides,
+                       const Packing& packing, const Regular& x_axis,
+                       const Regular& y_axis, const double* const x,
+                       const double* const y, const size_t size,
+                       double* const result) {
+  bilinear_gradient_kernel(grid, strides, x_axis, y_axis, x, y, size, result,
+                           Unpack<double>(packing));
+}
+
+PYINTERP_TARGET_CLONES
+void trilinear(const uint16_t* const grid,
+               const std::array<int64_t, 3>& strides, const Packing& packing,
+               const Regular& x_axis, const Regular& y_axis,
+               const Regular& z_axis, const double* const x,
+               const double* const y, const double* const z, const size_t size,
+               double* const result) {
+  trilinear_kernel(grid, strides, x_axis, y_axis, z_axis, x, y, z, size,
+                   result, Unpack<double>(packing));
+}
+
+PYINTERP_TARGET_CLONES
+void bilinear(const uint16_t* const* grids,
+              const std::array<int64_t, 2>* strides, const size_t fields,
+              const Packing& packing, const Regular& x_axis,
+              const Regular& y_axis, const double* const x,
+              const double* const y, const size_t size, double* const result) {
+  bilinear_fields_kernel(grids, strides, fields, x_axis, y_axis, x, y, size,
+                         result, Unpack<double>(packing));
+}
+
+PYINTERP_TARGET_CLONES
+void trilinear(const uint16_t* const* grids,
+               const std::array<int64_t, 3>* strides, const size_t fields,
+               const Packing& packing, const Regular& x_axis,
+               const Regular& y_axis, const Regular& z_axis,
+               const double* const x, const double* const y,
+               const double* const z, const size_t size,
+               double* const result) {
+  trilinear_fields_kernel(grids, strides, fields, x_axis, y_axis, z_axis, x, y,
+                          z, size, result, Unpack<double>(packing));
+}
+
+PYINTERP_TARGET_CLONES
+void find_indexes(const double start, const double step, const int32_t length,
+                  const bool is_circle, const double circle,
+                  const double* const coordinates, const size_t size,
+                  int64_t* const i0, int64_t* const i1, double* const weight,
+                  bool* const mask) {
+  if (is_circle) {
+    find_indexes_kernel<true, true>(start, step, length, circle, coordinates,
+                                    size, i0, i1, weight, mask);
+  } else if (circle != 0) {
+    find_indexes_kernel<false, true>(start, step, length, circle, coordinates,
+                                     size, i0, i1, weight, mask);
+  } else {
+    find_indexes_kernel<false, false>(start, step, length, circle,
+                                      coordinates, size, i0, i1, weight, mask);
+  }
+}
+
+}  // namespace batch
+}  // namespace math
+}  // namespace detail
+}  // namespace pyinterp
@@ -0,0 +1,286 @@
+// Copyright (c) 2019 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "pyinterp/detail/thread.hpp"
+#include <atomic>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace pyinterp {
+namespace detail {
+
+/// Default minimum number of items processed by a thread.
+static constexpr size_t kDefaultGrainSize = 256;
+
+/// Minimum number of items processed by a thread.
+static std::atomic<size_t> grain_size_{kDefaultGrainSize};
+
+/// True if the current thread belongs to a pool.
+static thread_local bool is_worker_{false};
+
+/// The pool shared by the process. It's never destroyed: its threads may still
+/// be waiting for tasks when the process exits.
+static ThreadPool* instance_{nullptr};
+
+/// Protects the creation of the pool shared by the process.
+static std::mutex instance_mutex_;
+
+/// Maximum number of threads used simultaneously. Zero selects cpu_count().
+static std::atomic<size_t> max_threads_{0};
+
+/// Number of threads currently reserved by the calls to "dispatch".
+static std::atomic<size_t> reserved_threads_{0};
+
+#ifdef __linux__
+/// Root of the cgroup file systems.
+static constexpr const char* const kCGroupRoot = "/sys/fs/cgroup";
+
+/// Reads the first line of a file, or returns an empty string if the file
+/// does not exist.
+static auto read_line(const std::string& path) -> std::string {
+  auto stream = std::ifstream(path);
+  auto result = std::string();
+  std::getline(stream, result);
+  return result;
+}
+
+/// Gets the cgroup path of the process for the given hierarchy: the
+/// controllers "cpu" (cgroup v1), or the unified hierarchy (cgroup v2) if
+/// "controller" is empty.
+static auto cgroup_path(const std::string& controller) -> std::string {
+  auto stream = std::ifstream("/proc/self/cgroup");
+  auto line = std::string();
+  while (std::getline(stream, line)) {
+    // Each line is formatted as "hierarchy-ID:controller-list:cgroup-path"
+    auto first = line.find(':');
+    auto second = line.find(':', first + 1);
+    if (first == std::string::npos || second == std::string::npos) {
+      continue;
+    }
+    auto controllers = line.substr(first + 1, second - first - 1);
+    if (controller.empty()) {
+      if (controllers.empty()) {
+        return line.substr(second + 1);
+      }
+      continue;
+    }
+    auto items = std::istringstream(controllers);
+    auto item = std::string();
+    while (std::getline(items, item, ',')) {
+      if (item == controller) {
+        return line.substr(second + 1);
+      }
+    }
+  }
+  return {};
+}
+
+/// Calls the function on the given cgroup and each of its ancestors, up to
+/// the root of the hierarchy. The path seen from inside a container may
+/// designate a cgroup of the host which does not exist in the container's
+/// namespace: the ancestors, and the root, are then those visible.
+template <typename Lambda>
+static void walk_cgroup(std::string path, Lambda function) {
+  // The root of the hierarchy is designated by an empty path.
+  while (!path.empty() && path.back() == '/') {
+    path.pop_back();
+  }
+  while (true) {
+    function(path);
+    auto pos = path.rfind('/');
+    if (pos == std::string::npos) {
+      return;
+    }
+    path.resize(pos);
+  }
+}
+
+/// Gets the CPU quota, expressed in number of CPUs, of the cgroup of the
+/// process, or infinity if the process is not limited. The lowest limit
+/// defined by the cgroup or one of its ancestors applies.
+static auto cgroup_cpu_quota() -> double {
+  auto result = std::numeric_limits<double>::infinity();
+
+  // cgroup v2: the file "cpu.max" contains "$MAX $PERIOD", $MAX being "max"
+  // if the group is not limited.
+  walk_cgroup(cgroup_path({}), [&result](const std::string& path) {
+    auto stream = std::istringstream(
+        read_line(std::string(kCGroupRoot) + path + "/cpu.max"));
+    auto quota = std::string();
+    auto period = 0.0;
+    if (stream >> quota >> period && quota != "max" && period > 0) {
+      result = std::min(result, std::stod(quota) / period);
+    }
+  });
+
+  // cgroup v1: the files "cpu.cfs_quota_us" and "cpu.cfs_period_us", the
+  // quota being -1 if the group is not limited.
+  walk_cgroup(cgroup_path("cpu"), [&result](const std::string& path) {
+    auto root = std::string(kCGroupRoot) + "/cpu" + path;
+    auto quota = read_line(root + "/cpu.cfs_quota_us");
+    auto period = read_line(root + "/cpu.cfs_period_us");
+    if (!quota.empty() && !period.empty()) {
+      auto q = std::stod(quota);
+      auto p = std::stod(period);
+      if (q > 0 && p > 0) {
+        result = std::min(result, q / p);
+      }
+    }
+  });
+  return result;
+}
+
+/// Gets the number of CPUs of the affinity mask of the process, or zero if
+/// it is unknown.
+static auto affinity_cpu_count() -> size_t {
+  auto set = cpu_set_t();
+  CPU_ZERO(&set);
+  if (sched_getaffinity(0, sizeof(set), &set) != 0) {
+    return 0;
+  }
+  return static_cast<size_t>(CPU_COUNT(&set));
+}
+#endif
+
+/// Computes the number of CPUs usable by the process.
+static auto compute_cpu_count() -> size_t {
+  auto result = static_cast<size_t>(std::thread::hardware_concurrency());
+#ifdef __linux__
+  auto affinity = affinity_cpu_count();
+  if (affinity != 0) {
+    result = result == 0 ? affinity : std::min(result, affinity);
+  }
+  try {
+    auto quota = cgroup_cpu_quota();
+    if (std::isfinite(quota)) {
+      result = std::min(result, static_cast<size_t>(std::ceil(quota)));
+    }
+  } catch (...) {
+    // The cgroup files are malformed: the quota is ignored.
+  }
+#endif
+  return std::max(result, size_t(1));
+}
+
+size_t cpu_count() noexcept {
+  // The files describing the CPUs are read only once.
+  static const auto result = compute_cpu_count();
+  return result;
+}
+
+size_t max_threads() noexcept {
+  auto result = max_threads_.load();
+  return result == 0 ? cpu_count() : result;
+}
+
+void set_max_threads(const size_t value) noexcept { max_threads_.store(value); }
+
+size_t ThreadReservation::acquire(const size_t num_threads) noexcept {
+  auto limit = max_threads();
+  auto reserved = reserved_threads_.load();
+  auto result = size_t(0);
+  do {
+    auto available = limit > reserved ? limit - reserved : size_t(0);
+    result = std::max(std::min(num_threads, available), size_t(1));
+  } while (!reserved_threads_.compare_exchange_weak(reserved,
+                                                    reserved + result));
+  return result;
+}
+
+void ThreadReservation::release(const size_t num_threads) noexcept {
+  reserved_threads_.fetch_sub(num_threads);
+}
+
+size_t grain_size() noexcept { return grain_size_.load(); }
+
+void set_grain_size(const size_t value) noexcept {
+  grain_size_.store(value == 0 ? kDefaultGrainSize : value);
+}
+
+ThreadPool& ThreadPool::instance() {
+  auto lock = std::unique_lock<std::mutex>(instance_mutex_);
+  if (instance_ == nullptr) {
+#ifndef _WIN32
+    // After a fork, the child process only contains the thread that called
+    // fork: the pool inherited is unusable and a new one must be created.
+    // The threads reserved by the other threads of the parent are never
+    // released in the child.
+    static auto registered = false;
+    if (!registered) {
+      pthread_atfork([] { instance_mutex_.lock(); },
+                     [] { instance_mutex_.unlock(); },
+                     [] {
+                       instance_ = nullptr;
+                       reserved_threads_.store(0);
+                       instance_mutex_.unlock();
+                     });
+      registered = true;
+    }
+#endif
+    instance_ = new ThreadPool();
+  }
+  return *instance_;
+}
+
+bool ThreadPool::is_worker() noexcept { return is_worker_; }
+
+ThreadPool::~ThreadPool() {
+  {
+    auto lock = std::unique_lock<std::mutex>(mutex_);
+    stop_ = true;
+  }
+  condition_.notify_all();
+  for (auto&& item : threads_) {
+    item.join();
+  }
+}
+
+size_t ThreadPool::size() const {
+  auto lock = std::unique_lock<std::mutex>(mutex_);
+  return threads_.size();
+}
+
+void ThreadPool::reserve(const size_t num_threads) {
+  auto lock = std::unique_lock<std::mutex>(mutex_);
+  while (threads_.size() < num_threads) {
+    threads_.emplace_back([this] { run(); });
+  }
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+  {
+    auto lock = std::unique_lock<std::mutex>(mutex_);
+    tasks_.emplace(std::move(task));
+  }
+  condition_.notify_one();
+}
+
+void ThreadPool::run() {
+  is_worker_ = true;
+  while (true) {
+    auto task = std::function<void()>();
+    {
+      auto lock = std::unique_lock<std::mutex>(mutex_);
+      condition_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+      if (tasks_.empty()) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop();
+    }
+    task();
+  }
+}
+
+}  // namespace detail
+}  // namespace pyinterp
@@ -15,6 +15,7 @@ class Axis;
 class Axis : public detail::Axis, public std::enable_shared_from_this<Axis> {
  public:
   using detail::Axis::Axis;
+  using detail::Axis::find_indexes;
 
   /// Create a coordinate axis from values.
   ///
@@ -24,9 +25,11 @@ class Axis : public detail::Axis, public std::enable_shared_from_this<Axis> {
   /// @param is_circle True, if the axis can represent a circle. Be careful,
   /// the angle shown must be expressed in degrees.
   /// @param is_radian True, if the coordinate system is radian.
+  /// @param bucket_factor Maximum number of buckets, per axis value, of the
+  /// lookup table accelerating the searches on an irregular axis.
   explicit Axis(
       const pybind11::array_t<double, pybind11::array::c_style>& points,
-      double epsilon, bool is_circle, bool is_radian);
+      double epsilon, bool is_circle, bool is_radian, size_t bucket_factor);
 
   /// Get coordinate values.
   ///
@@ -47,6 +50,18 @@ class Axis : public detail::Axis, public std::enable_shared_from_this<Axis> {
   pybind11::array_t<int64_t> find_index(
       const pybind11::array_t<double>& coordinates, bool bounded) const;
 
+  /// Given coordinate positions, find grids elements around them.
+  ///
+  /// @param coordinates positions in this coordinate system
+  /// @return A tuple containing, for each position, the indexes i0 and i1 of
+  ///   the elements framing the position, the fractional position of the
+  ///   coordinate between these two elements and a mask set to true if the
+  ///   position is outside the axis definition domain.
+  pybind11::tuple find_indexes(
+      const pybind11::array_t<double, pybind11::array::c_style |
+                                          pybind11::array::forcecast>&
+          coordinates) const;
+
   /// Get a tuple that fully encodes the state of this instance
   pybind11::tuple getstate() const;
 
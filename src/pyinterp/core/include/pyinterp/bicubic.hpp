@@ -7,6 +7,7 @@
 #include "pyinterp/detail/math/bicubic.hpp"
 #include "pyinterp/detail/thread.hpp"
 #include "pyinterp/grid.hpp"
+#include <optional>
 
 namespace pyinterp {
 
@@ -30,8 +31,10 @@ enum FittingModel {
 /// corresponding surfaces obtained by bilinear interpolation or
 /// nearest-neighbor interpolation.
 ///
+/// @tparam Coordinate The type of the coordinates and of the values
+/// interpolated. The splines are always fitted in double precision.
 /// @tparam Type The type of data used by the numerical grid.
-template <typename Type>
+template <typename Coordinate, typename Type>
 class Bicubic : public Grid2D<Type> {
  public:
   /// Default constructor
@@ -43,17 +46,126 @@ class Bicubic : public Grid2D<Type> {
   }
 
   /// Evaluate the interpolation.
-  pybind11::array_t<double> evaluate(const pybind11::array_t<double>& x,
-                                     const pybind11::array_t<double>& y,
-                                     size_t nx, size_t ny,
-                                     FittingModel fitting_model,
-                                     Axis::Boundary boundary, bool bounds_error,
-                                     size_t num_threads) const;
+  pybind11::array_t<Coordinate> evaluate(
+      const pybind11::array_t<Coordinate>& x,
+      const pybind11::array_t<Coordinate>& y, size_t nx, size_t ny,
+      FittingModel fitting_model, Axis::Boundary boundary, bool bounds_error,
+      size_t num_threads, detail::Schedule schedule, size_t chunk_size,
+      bool reorder,
+      const std::optional<pybind11::array_t<Coordinate>>& out) const;
+
+  /// Evaluate the interpolation and the partial derivatives of the
+  /// interpolated surface.
+  ///
+  /// The frame framing a position is loaded once, and the splines fitted
+  /// along the Y-Axis provide both the values and the derivatives along Y
+  /// used by the splines fitted along the X-Axis.
+  ///
+  /// @return Array of shape (size, 3): the value, the derivative with
+  /// respect to x and the derivative with respect to y.
+  pybind11::array_t<Coordinate> evaluate_gradient(
+      const pybind11::array_t<Coordinate>& x,
+      const pybind11::array_t<Coordinate>& y, size_t nx, size_t ny,
+      FittingModel fitting_model, Axis::Boundary boundary, bool bounds_error,
+      size_t num_threads, detail::Schedule schedule, size_t chunk_size,
+      bool reorder) const;
+
+  /// Interpolates the grid onto the grid defined by the target axes.
+  ///
+  /// The bicubic interpolation is separable: the interpolation of a target
+  /// point first fits splines along the Y-Axis, on each column of the window
+  /// framing it, then fits a spline along the X-Axis on the values obtained.
+  /// The splines along the Y-Axis depend only on the target row and on the
+  /// column of the grid: they are calculated once and shared by all the
+  /// points of the target row.
+  pybind11::array_t<Coordinate> regrid(const Axis& x, const Axis& y,
+                                       size_t nx, size_t ny,
+                                       FittingModel fitting_model,
+                                       Axis::Boundary boundary,
+                                       bool bounds_error,
+                                       size_t num_threads) const;
 
  private:
+  /// Window of the grid framing a coordinate of a target axis
+  struct Window {
+    /// Indexes of the elements of the window, empty if the coordinate is
+    /// outside the grid.
+    std::vector<int64_t> indexes;
+    /// Coordinates of the elements of the window
+    Eigen::VectorXd coordinates;
+    /// Coordinate, normalized with respect to the first element of the
+    /// window if the axis is an angle
+    double value;
+  };
+
+  /// Searches the windows of the grid framing the coordinates of a target
+  /// axis.
+  ///
+  /// @tparam Container Type of the container handling the values of the
+  /// axis of the grid.
+  template <typename Container>
+  static std::vector<Window> windows(const Axis& axis,
+                                     const Container& container,
+                                     const Axis& target, size_t size,
+                                     Axis::Boundary boundary,
+                                     bool bounds_error,
+                                     const std::string& name);
+
+  /// Interpolates the grid onto the target grid for the actual types of the
+  /// axes containers.
+  template <typename X, typename Y>
+  void _regrid(
+      const X& x_axis, const Y& y_axis, const Axis& x, const Axis& y,
+      pybind11::detail::unchecked_mutable_reference<Coordinate, 2>& _result,
+      size_t nx, size_t ny, const gsl_interp_type* type,
+      Axis::Boundary boundary, bool bounds_error, size_t num_threads) const;
+
   /// Loads the interpolation frame into memory
-  bool load_frame(double x, double y, Axis::Boundary boundary,
-                  bool bounds_error, detail::math::XArray& frame) const;
+  ///
+  /// The cursors keep the cells found by the previous call, made by the same
+  /// thread, to accelerate the searches of successive positions. The buffers
+  /// x_indexes and y_indexes, sized like frame.x() and frame.y(), receive the
+  /// indexes of the frame: they are reused from one call to the next to avoid
+  /// memory allocations.
+  ///
+  /// @tparam X Type of the container handling the X-Axis values
+  /// @tparam Y Type of the container handling the Y-Axis values
+  template <typename X, typename Y>
+  bool load_frame(const X& x_axis, const Y& y_axis, double x, double y,
+                  Axis::Boundary boundary, bool bounds_error,
+                  detail::math::XArray& frame, detail::axis::Cursor& x_cursor,
+                  detail::axis::Cursor& y_cursor,
+                  std::vector<int64_t>& x_indexes,
+                  std::vector<int64_t>& y_indexes) const;
+
+  /// Evaluate the interpolation for the actual types of the axes containers.
+  ///
+  /// The values are processed in the order given by "indexes", or in their
+  /// original order if "indexes" is empty.
+  template <typename X, typename Y>
+  void _evaluate(const X& x_axis, const Y& y_axis,
+                 const detail::FlatView<const Coordinate>& _x,
+                 const detail::FlatView<const Coordinate>& _y,
+                 const detail::FlatView<Coordinate>& _result, size_t nx,
+                 size_t ny, const detail::math::Bicubic& interpolator,
+                 Axis::Boundary boundary, bool bounds_error, size_t size,
+                 size_t num_threads, detail::Schedule schedule,
+                 size_t chunk_size, const std::vector<size_t>& indexes) const;
+
+  /// Evaluate the interpolation and its derivatives for the actual types of
+  /// the axes containers.
+  ///
+  /// @see _evaluate
+  template <typename X, typename Y>
+  void _evaluate_gradient(
+      const X& x_axis, const Y& y_axis,
+      const pybind11::detail::unchecked_reference<Coordinate, 1>& _x,
+      const pybind11::detail::unchecked_reference<Coordinate, 1>& _y,
+      pybind11::detail::unchecked_mutable_reference<Coordinate, 2>& _result,
+      size_t nx, size_t ny, const detail::math::Bicubic& interpolator,
+      Axis::Boundary boundary, bool bounds_error, size_t size,
+      size_t num_threads, detail::Schedule schedule, size_t chunk_size,
+      const std::vector<size_t>& indexes) const;
 
   /// Returns the GSL interp type
   static const gsl_interp_type* interp_type(const FittingModel kind) {
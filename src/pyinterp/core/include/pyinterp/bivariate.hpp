@@ -4,12 +4,24 @@
 // BSD-style license that can be found in the LICENSE file.
 #pragma once
 #include "pyinterp/detail/geometry/point.hpp"
+#include "pyinterp/detail/math/batch.hpp"
 #include "pyinterp/detail/math/bivariate.hpp"
+#include "pyinterp/detail/morton.hpp"
 #include "pyinterp/detail/thread.hpp"
 #include "pyinterp/grid.hpp"
+#include "pyinterp/interpolation_plan.hpp"
 #include <pybind11/pybind11.h>
 #include <pybind11/numpy.h>
 #include <pybind11/stl.h>
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 namespace pyinterp {
 
@@ -21,10 +33,22 @@ using BivariateInterpolator = detail::math::Bivariate<Point, T>;
 template <template <class> class Point, typename T>
 class Bilinear : public detail::math::Bilinear<Point, T> {
  public:
-  pybind11::tuple getstate() const { return pybind11::make_tuple(); }
+  using detail::math::Bilinear<Point, T>::Bilinear;
+
+  pybind11::tuple getstate() const {
+    return pybind11::make_tuple(this->min_valid());
+  }
 
-  static Bilinear setstate(const pybind11::tuple& /*tuple*/) {
-    return Bilinear();
+  static Bilinear setstate(const pybind11::tuple& tuple) {
+    // The instances serialized before the introduction of the masked
+    // interpolation have an empty state.
+    if (tuple.size() == 0) {
+      return Bilinear();
+    }
+    if (tuple.size() != 1) {
+      throw std::runtime_error("invalid state");
+    }
+    return Bilinear(tuple[0].cast<int>());
   }
 };
 
@@ -58,6 +82,111 @@ class InverseDistanceWeighting
   }
 };
 
+/// Interpolator recording the problems submitted to it, in order to solve
+/// them all at once by calling the method "evaluate_batch" of an interpolator
+/// written in Python. The interpolation loops call this object in place of
+/// the interpolator, then solve the problems recorded for a chunk of values:
+/// the Python interpreter is called once per chunk instead of once per value.
+///
+/// The Python method receives the query points and the points framing them
+/// as arrays of shape (n, dimensions), followed by the four vectors of values
+/// q00, q01, q10 and q11, and returns the n interpolated values.
+template <template <class> class Point, typename T>
+class BatchInterpolator {
+ public:
+  /// Number of coordinates of a point
+  static constexpr size_t kDimensions =
+      boost::geometry::dimension<Point<T>>::value;
+
+  /// Default constructor
+  ///
+  /// @param function Python method solving the problems
+  explicit BatchInterpolator(const pybind11::function& function)
+      : function_(function) {}
+
+  /// Records an interpolation problem.
+  ///
+  /// @return NaN, the interpolated value being calculated by solve()
+  /// @see detail::math::Bivariate::evaluate
+  T evaluate(const Point<T>& p, const Point<T>& p0, const Point<T>& p1,
+             const T& q00, const T& q01, const T& q10, const T& q11) const {
+    push_back(p, p_, std::make_index_sequence<kDimensions>());
+    push_back(p0, p0_, std::make_index_sequence<kDimensions>());
+    push_back(p1, p1_, std::make_index_sequence<kDimensions>());
+    q00_.push_back(q00);
+    q01_.push_back(q01);
+    q10_.push_back(q10);
+    q11_.push_back(q11);
+    return std::numeric_limits<T>::quiet_NaN();
+  }
+
+  /// Gets the number of problems recorded
+  inline size_t size() const noexcept { return q00_.size(); }
+
+  /// Gets a coordinate of the query point and of the points framing it.
+  ///
+  /// @param index Index of the problem
+  /// @param dim Index of the coordinate
+  /// @return The tuple (p, p0, p1)
+  inline std::tuple<T, T, T> coordinates(const size_t index,
+                                         const size_t dim) const {
+    auto ix = index * kDimensions + dim;
+    return std::make_tuple(p_[ix], p0_[ix], p1_[ix]);
+  }
+
+  /// Solves the problems recorded with one call to the Python method. The GIL
+  /// is acquired during the call.
+  ///
+  /// @return The interpolated values, in the order of the problems
+  std::vector<T> solve() const {
+    auto size = this->size();
+    auto result = std::vector<T>(size);
+    if (size != 0) {
+      pybind11::gil_scoped_acquire acquire;
+
+      auto rows = static_cast<pybind11::ssize_t>(size);
+      auto points = [&](const std::vector<T>& values) {
+        return pybind11::array_t<T>(
+            pybind11::array::ShapeContainer{
+                rows, static_cast<pybind11::ssize_t>(kDimensions)},
+            values.data());
+      };
+      auto vector = [&](const std::vector<T>& values) {
+        return pybind11::array_t<T>(pybind11::array::ShapeContainer{rows},
+                                    values.data());
+      };
+      auto values = pybind11::array_t<T, pybind11::array::c_style |
+                                             pybind11::array::forcecast>(
+          function_(points(p_), points(p0_), points(p1_), vector(q00_),
+                    vector(q01_), vector(q10_), vector(q11_)));
+      if (values.ndim() != 1 || values.size() != rows) {
+        throw std::invalid_argument(
+            "evaluate_batch must return a vector of " + std::to_string(size) +
+            " values");
+      }
+      std::copy(values.data(), values.data() + size, result.begin());
+    }
+    return result;
+  }
+
+ private:
+  /// Python method solving the problems
+  const pybind11::function& function_;
+  /// Coordinates of the points, stored one after the other. The problems
+  /// are recorded by the constant method "evaluate", which is called in
+  /// place of the interpolator's one.
+  mutable std::vector<T> p_, p0_, p1_;
+  /// Values of the grid framing the query points
+  mutable std::vector<T> q00_, q01_, q10_, q11_;
+
+  /// Appends the coordinates of a point to a vector
+  template <size_t... Dim>
+  static void push_back(const Point<T>& point, std::vector<T>& coordinates,
+                        std::index_sequence<Dim...> /*unused*/) {
+    (coordinates.push_back(boost::geometry::get<Dim>(point)), ...);
+  }
+};
+
 /// Interpolation of bivariate function.
 ///
 /// @tparam Coordinate The type of data used by the interpolators.
@@ -72,74 +201,351 @@ class Bivariate : public Grid2D<Type> {
       const pybind11::array_t<Coordinate>& x,
       const pybind11::array_t<Coordinate>& y,
       const BivariateInterpolator<Point, Coordinate>* interpolator,
-      const bool bounds_error, const size_t num_threads) {
+      const bool bounds_error, const size_t num_threads,
+      const detail::Schedule schedule, const size_t chunk_size,
+      const bool reorder,
+      const std::optional<pybind11::array_t<Coordinate>>& out) {
+    auto shape = pyinterp::detail::broadcast_shape("x", x, "y", y);
+    if (out) {
+      pyinterp::detail::check_ndarray_shape("out", *out, shape);
+    }
+
+    auto result = out ? *out : pybind11::array_t<Coordinate>(shape);
+    auto size = static_cast<size_t>(result.size());
+    auto _x = detail::FlatView<const Coordinate>(x.data(), x, shape);
+    auto _y = detail::FlatView<const Coordinate>(y.data(), y, shape);
+    auto _result =
+        detail::FlatView<Coordinate>(result.mutable_data(), result, shape);
+
+    // Interpolators written in Python may process the values by batches.
+    auto evaluate_batch =
+        pybind11::get_overload(interpolator, "evaluate_batch");
+
+    {
+      pybind11::gil_scoped_release release;
+
+      // Order in which the values are processed, if they are reordered.
+      auto indexes =
+          reorder ? detail::morton::order<2>(
+                        [&](const size_t ix, const size_t dim) {
+                          return dim == 0 ? _x(ix) : _y(ix);
+                        },
+                        size, num_threads)
+                  : std::vector<size_t>();
+
+      if (evaluate_batch) {
+        this->x_->visit([&](const auto& x_axis) {
+          this->y_->visit([&](const auto& y_axis) {
+            this->_evaluate_python(x_axis, y_axis, _x, _y, _result,
+                                   evaluate_batch, bounds_error, size,
+                                   num_threads, schedule, chunk_size,
+                                   indexes);
+          });
+        });
+      } else {
+        // The evaluation loop is instantiated for the actual types of the
+        // interpolator and of the axes containers in order to resolve the
+        // interpolation and the index searches at compile time.
+        detail::math::visit(interpolator, [&](const auto& kernel) {
+          this->x_->visit([&](const auto& x_axis) {
+            this->y_->visit([&](const auto& y_axis) {
+              this->_evaluate(x_axis, y_axis, _x, _y, _result, kernel,
+                              bounds_error, size, num_threads, schedule,
+                              chunk_size, indexes);
+            });
+          });
+        });
+      }
+    }
+    return result;
+  }
+
+  /// Interpolates the values of the grid and of the fields sharing its axes.
+  ///
+  /// The cells framing the positions, and the weights of the bilinear
+  /// interpolation, are calculated once per position for all the fields.
+  ///
+  /// @return The values interpolated, array of shape (size, 1 + number of
+  /// fields): the first column contains the values of this grid.
+  pybind11::array_t<Coordinate> evaluate_fields(
+      const pybind11::array_t<Coordinate>& x,
+      const pybind11::array_t<Coordinate>& y,
+      const std::vector<pybind11::array_t<Type>>& fields,
+      const BivariateInterpolator<Point, Coordinate>* interpolator,
+      const bool bounds_error, const size_t num_threads,
+      const detail::Schedule schedule, const size_t chunk_size,
+      const bool reorder) {
     pyinterp::detail::check_array_ndim("x", 1, x, "y", 1, y);
     pyinterp::detail::check_ndarray_shape("x", x, "y", y);
+    // The fields are stored in the same order as the array of the grid.
+    auto arrays = this->transpose(fields);
+    auto grids = this->fields(arrays);
 
     auto size = x.size();
-    auto result =
-        pybind11::array_t<Coordinate>(pybind11::array::ShapeContainer{size});
+    auto result = pybind11::array_t<Coordinate>(
+        pybind11::array::ShapeContainer{
+            size, static_cast<pybind11::ssize_t>(grids.size())});
     auto _x = x.template unchecked<1>();
     auto _y = y.template unchecked<1>();
-    auto _result = result.template mutable_unchecked<1>();
+    auto _result = result.template mutable_unchecked<2>();
+
+    // Interpolators written in Python may process the values by batches.
+    auto evaluate_batch =
+        pybind11::get_overload(interpolator, "evaluate_batch");
 
     {
       pybind11::gil_scoped_release release;
 
-      // Captures the detected exceptions in the calculation function
-      // (only the last exception captured is kept)
-      auto except = std::exception_ptr(nullptr);
-
-      detail::dispatch(
-          [&](size_t start, size_t end) {
-            try {
-              for (size_t ix = start; ix < end; ++ix) {
-                auto x_indexes = this->x_->find_indexes(_x(ix));
-                auto y_indexes = this->y_->find_indexes(_y(ix));
-
-                if (x_indexes.has_value() && y_indexes.has_value()) {
-                  int64_t ix0, ix1, iy0, iy1;
-                  std::tie(ix0, ix1) = *x_indexes;
-                  std::tie(iy0, iy1) = *y_indexes;
-
-                  auto x0 = (*this->x_)(ix0);
-
-                  _result(ix) = interpolator->evaluate(
-                      Point<Coordinate>(
-                          this->x_->is_angle()
-                              ? detail::math::normalize_angle(_x(ix), x0)
-                              : _x(ix),
-                          _y(ix)),
-                      Point<Coordinate>((*this->x_)(ix0), (*this->y_)(iy0)),
-                      Point<Coordinate>((*this->x_)(ix1), (*this->y_)(iy1)),
-                      static_cast<Coordinate>(this->ptr_(ix0, iy0)),
-                      static_cast<Coordinate>(this->ptr_(ix0, iy1)),
-                      static_cast<Coordinate>(this->ptr_(ix1, iy0)),
-                      static_cast<Coordinate>(this->ptr_(ix1, iy1)));
-
-                } else {
-                  if (bounds_error) {
-                    if (!x_indexes.has_value()) {
-                      Bivariate::index_error(*this->x_, _x(ix), "x");
+      auto indexes =
+          reorder ? detail::morton::order<2>(
+                        [&](const size_t ix, const size_t dim) {
+                          return dim == 0 ? _x(ix) : _y(ix);
+                        },
+                        size, num_threads)
+                  : std::vector<size_t>();
+
+      if (evaluate_batch) {
+        this->x_->visit([&](const auto& x_axis) {
+          this->y_->visit([&](const auto& y_axis) {
+            detail::dispatch(
+                [&](size_t start, size_t end) {
+                  auto x_cursor = detail::axis::Cursor();
+                  auto y_cursor = detail::axis::Cursor();
+                  auto batch =
+                      BatchInterpolator<Point, Coordinate>(evaluate_batch);
+                  // Indexes of the values whose interpolation has been
+                  // recorded: one problem per field for each of them.
+                  auto recorded = std::vector<size_t>();
+
+                  for (size_t jx = start; jx < end; ++jx) {
+                    auto ix = indexes.empty() ? jx : indexes[jx];
+                    if (_interpolate_fields(x_axis, y_axis, _x(ix), _y(ix),
+                                            grids, batch, bounds_error,
+                                            x_cursor, y_cursor,
+                                            _result.mutable_data(ix, 0))) {
+                      recorded.push_back(ix);
                     }
-                    Bivariate::index_error(*this->y_, _y(ix), "y");
                   }
-                  _result(ix) = std::numeric_limits<Coordinate>::quiet_NaN();
+                  auto values = batch.solve();
+                  for (size_t jx = 0; jx < recorded.size(); ++jx) {
+                    for (size_t kx = 0; kx < grids.size(); ++kx) {
+                      _result(recorded[jx], kx) =
+                          values[jx * grids.size() + kx];
+                    }
+                  }
+                },
+                size, num_threads, schedule, chunk_size);
+          });
+        });
+      } else {
+        detail::math::visit(interpolator, [&](const auto& kernel) {
+          this->x_->visit([&](const auto& x_axis) {
+            this->y_->visit([&](const auto& y_axis) {
+              this->_evaluate_fields(x_axis, y_axis, _x, _y, arrays, grids,
+                                     _result, kernel, bounds_error, size,
+                                     num_threads, schedule, chunk_size,
+                                     indexes);
+            });
+          });
+        });
+      }
+    }
+    return result;
+  }
+
+  /// Interpolates data with the bilinear interpolation and calculates the
+  /// partial derivatives of the interpolated surface.
+  ///
+  /// The cell framing a position, and the weights of the interpolation, are
+  /// shared by the value and its derivatives, which are calculated in a
+  /// single pass.
+  ///
+  /// @return The values interpolated and their derivatives, array of shape
+  /// (size, 3): the value, the derivative with respect to x and the
+  /// derivative with respect to y.
+  pybind11::array_t<Coordinate> evaluate_gradient(
+      const pybind11::array_t<Coordinate>& x,
+      const pybind11::array_t<Coordinate>& y, const bool bounds_error,
+      const size_t num_threads, const detail::Schedule schedule,
+      const size_t chunk_size, const bool reorder) const {
+    pyinterp::detail::check_array_ndim("x", 1, x, "y", 1, y);
+    pyinterp::detail::check_ndarray_shape("x", x, "y", y);
+
+    auto size = x.size();
+    auto result = pybind11::array_t<Coordinate>(
+        pybind11::array::ShapeContainer{size, pybind11::ssize_t(3)});
+    auto _x = x.template unchecked<1>();
+    auto _y = y.template unchecked<1>();
+    auto _result = result.template mutable_unchecked<2>();
+    auto interpolator = detail::math::Bilinear<Point, Coordinate>();
+
+    {
+      pybind11::gil_scoped_release release;
+
+      auto indexes =
+          reorder ? detail::morton::order<2>(
+                        [&](const size_t ix, const size_t dim) {
+                          return dim == 0 ? _x(ix) : _y(ix);
+                        },
+                        size, num_threads)
+                  : std::vector<size_t>();
+
+      this->x_->visit([&](const auto& x_axis) {
+        this->y_->visit([&](const auto& y_axis) {
+          this->_evaluate_gradient(x_axis, y_axis, _x, _y, _result,
+                                   interpolator, bounds_error, size,
+                                   num_threads, schedule, chunk_size,
+                                   indexes);
+        });
+      });
+    }
+    return result;
+  }
+
+  /// Interpolates the grid onto the grid defined by the target axes.
+  ///
+  /// The cells of the grid framing the coordinates of the target axes are
+  /// searched once per target column and once per target row, instead of
+  /// once per target point, then the values are interpolated by blocks of
+  /// target points accessing neighbouring areas of the grid.
+  pybind11::array_t<Coordinate> regrid(
+      const Axis& x, const Axis& y,
+      const BivariateInterpolator<Point, Coordinate>* interpolator,
+      const bool bounds_error, const size_t num_threads) {
+    auto result = pybind11::array_t<Coordinate>(
+        pybind11::array::ShapeContainer{x.size(), y.size()});
+    auto _result = result.template mutable_unchecked<2>();
+
+    // Interpolators written in Python may process the values by batches.
+    auto evaluate_batch =
+        pybind11::get_overload(interpolator, "evaluate_batch");
+
+    {
+      pybind11::gil_scoped_release release;
+
+      auto columns = this->x_->visit([&](const auto& x_axis) {
+        return this->_cells(*this->x_, x_axis, x, "x", bounds_error);
+      });
+      auto rows = this->y_->visit([&](const auto& y_axis) {
+        return this->_cells(*this->y_, y_axis, y, "y", bounds_error);
+      });
+
+      if (evaluate_batch) {
+        detail::dispatch(
+            [&](size_t start, size_t end) {
+              auto batch =
+                  BatchInterpolator<Point, Coordinate>(evaluate_batch);
+              // Indexes of the values whose interpolation has been recorded
+              auto recorded = std::vector<std::tuple<size_t, size_t>>();
+
+              _traverse(start, end, rows.size(), [&](size_t ix, size_t jx) {
+                _result(ix, jx) = _blend(columns[ix], rows[jx], batch);
+                if (batch.size() != recorded.size()) {
+                  recorded.emplace_back(ix, jx);
                 }
+              });
+              auto values = batch.solve();
+              for (size_t kx = 0; kx < recorded.size(); ++kx) {
+                _result(std::get<0>(recorded[kx]),
+                        std::get<1>(recorded[kx])) = values[kx];
               }
-            } catch (...) {
-              except = std::current_exception();
-            }
-          },
-          size, num_threads);
-
-      if (except != nullptr) {
-        std::rethrow_exception(except);
+            },
+            columns.size(), num_threads);
+      } else {
+        detail::math::visit(interpolator, [&](const auto& kernel) {
+          detail::dispatch(
+              [&](size_t start, size_t end) {
+                _traverse(start, end, rows.size(), [&](size_t ix, size_t jx) {
+                  _result(ix, jx) = _blend(columns[ix], rows[jx], kernel);
+                });
+              },
+              columns.size(), num_threads);
+        });
       }
     }
     return result;
   }
 
+  /// Precomputes the interpolation of positions, in order to interpolate
+  /// many arrays defined on this grid.
+  ///
+  /// The interpolators implemented being linear with respect to the values
+  /// of the grid, the weight of a grid value is the value interpolated when
+  /// this grid value is 1 and the others 0. The grid values whose weight is
+  /// zero are not stored: unlike evaluate, an undefined value of the grid
+  /// does not propagate to a position that does not depend on it. The masked
+  /// bilinear interpolation drops the corners undefined in this grid: the
+  /// plan is then valid for the arrays sharing its mask.
+  InterpolationPlan plan(
+      const pybind11::array_t<Coordinate>& x,
+      const pybind11::array_t<Coordinate>& y,
+      const BivariateInterpolator<Point, Coordinate>* interpolator,
+      const bool bounds_error, const size_t num_threads) const {
+    pyinterp::detail::check_array_ndim("x", 1, x, "y", 1, y);
+    pyinterp::detail::check_ndarray_shape("x", x, "y", y);
+
+    auto size = static_cast<size_t>(x.size());
+    auto _x = x.template unchecked<1>();
+    auto _y = y.template unchecked<1>();
+
+    // Up to four grid values per position, compacted once computed.
+    auto counts = std::vector<int64_t>(size);
+    auto indices = std::vector<int64_t>(4 * size);
+    auto weights = std::vector<double>(4 * size);
+
+    {
+      pybind11::gil_scoped_release release;
+
+      detail::math::visit(interpolator, [&](const auto& kernel) {
+        using Interpolator = std::decay_t<decltype(kernel)>;
+        if constexpr (std::is_same_v<
+                          Interpolator,
+                          BivariateInterpolator<Point, Coordinate>>) {
+          throw std::invalid_argument(
+              "interpolation plans are only available for the built-in "
+              "interpolators");
+        } else {
+          this->x_->visit([&](const auto& x_axis) {
+            this->y_->visit([&](const auto& y_axis) {
+              detail::dispatch(
+                  [&](size_t start, size_t end) {
+                    auto x_cursor = detail::axis::Cursor();
+                    auto y_cursor = detail::axis::Cursor();
+
+                    for (auto ix = start; ix < end; ++ix) {
+                      counts[ix] = _plan(x_axis, y_axis, _x(ix), _y(ix),
+                                         kernel, bounds_error, x_cursor,
+                                         y_cursor, &indices[4 * ix],
+                                         &weights[4 * ix]);
+                    }
+                  },
+                  size, num_threads);
+            });
+          });
+        }
+      });
+
+      auto item = int64_t(0);
+      for (size_t ix = 0; ix < size; ++ix) {
+        auto count = counts[ix];
+        std::copy(&indices[4 * ix], &indices[4 * ix] + count,
+                  &indices[item]);
+        std::copy(&weights[4 * ix], &weights[4 * ix] + count,
+                  &weights[item]);
+        counts[ix] = item;
+        item += count;
+      }
+      counts.push_back(item);
+      indices.resize(item);
+      weights.resize(item);
+    }
+    // The arrays interpolated are stored like the array of the grid.
+    return InterpolationPlan(this->x_->size(), this->y_->size(),
+                             std::move(counts), std::move(indices),
+                             std::move(weights),
+                             this->axes_ && (*this->axes_)[0] == 1);
+  }
+
   /// Pickle support: set state
   static Bivariate setstate(const pybind11::tuple& tuple) {
     return Bivariate(Grid2D<Type>::setstate(tuple));
@@ -148,6 +554,740 @@ class Bivariate : public Grid2D<Type> {
  private:
   /// Construct a new instance from a serialized instance
   explicit Bivariate(Grid2D<Type>&& grid) : Grid2D<Type>(grid) {}
+
+  /// Interpolates data using the defined interpolation function.
+  ///
+  /// The values are processed in the order given by "indexes", or in their
+  /// original order if "indexes" is empty.
+  ///
+  /// @tparam X Type of the container handling the X-Axis values
+  /// @tparam Y Type of the container handling the Y-Axis values
+  /// @tparam Interpolator Type of the interpolator
+  template <typename X, typename Y, typename Interpolator>
+  void _evaluate(
+      const X& x_axis, const Y& y_axis,
+      const detail::FlatView<const Coordinate>& _x,
+      const detail::FlatView<const Coordinate>& _y,
+      const detail::FlatView<Coordinate>& _result,
+      const Interpolator& interpolator,
+      const bool bounds_error, const size_t size, const size_t num_threads,
+      const detail::Schedule schedule, const size_t chunk_size,
+      const std::vector<size_t>& indexes) const {
+    // The bilinear interpolation of grids whose axes are regular is
+    // vectorized.
+    if constexpr (std::is_same_v<Interpolator,
+                                 detail::math::Bilinear<Point, Coordinate>> &&
+                  std::is_same_v<X, detail::axis::container::Regular> &&
+                  std::is_same_v<Y, detail::axis::container::Regular>) {
+      if (x_axis.size() > 1 && y_axis.size() > 1) {
+        _evaluate_batch(x_axis, y_axis, _x, _y, _result, interpolator,
+                        bounds_error, size, num_threads, schedule, chunk_size,
+                        indexes);
+        return;
+      }
+    }
+
+    detail::dispatch(
+        [&](size_t start, size_t end) {
+          auto x_cursor = detail::axis::Cursor();
+          auto y_cursor = detail::axis::Cursor();
+
+          for (size_t jx = start; jx < end; ++jx) {
+            auto ix = indexes.empty() ? jx : indexes[jx];
+            _result(ix) = _interpolate(x_axis, y_axis, _x(ix), _y(ix),
+                                       interpolator, bounds_error, x_cursor,
+                                       y_cursor);
+          }
+        },
+        size, num_threads, schedule, chunk_size);
+  }
+
+  /// Interpolates data by batches of positions with the vectorized bilinear
+  /// kernel. The positions that this kernel does not handle (located outside
+  /// the grid, between the last and the first element of a circle, or framed
+  /// by undefined values) are then interpolated one by one.
+  ///
+  /// @see _evaluate
+  template <typename Interpolator>
+  void _evaluate_batch(
+      const detail::axis::container::Regular& x_axis,
+      const detail::axis::container::Regular& y_axis,
+      const detail::FlatView<const Coordinate>& _x,
+      const detail::FlatView<const Coordinate>& _y,
+      const detail::FlatView<Coordinate>& _result,
+      const Interpolator& interpolator,
+      const bool bounds_error, const size_t size, const size_t num_threads,
+      const detail::Schedule schedule, const size_t chunk_size,
+      const std::vector<size_t>& indexes) const {
+    namespace batch = detail::math::batch;
+
+    auto x_regular =
+        batch::Regular{x_axis.coordinate_value(0), x_axis.step(),
+                       static_cast<double>(x_axis.size() - 1)};
+    auto y_regular =
+        batch::Regular{y_axis.coordinate_value(0), y_axis.step(),
+                       static_cast<double>(y_axis.size() - 1)};
+    auto strides =
+        std::array<int64_t, 2>{static_cast<int64_t>(this->array_.strides(0)),
+                               static_cast<int64_t>(this->array_.strides(1))};
+    auto grid = this->array_.data();
+
+    detail::dispatch(
+        [&](size_t start, size_t end) {
+          auto x_cursor = detail::axis::Cursor();
+          auto y_cursor = detail::axis::Cursor();
+          auto x = std::array<Coordinate, batch::kSize>();
+          auto y = std::array<Coordinate, batch::kSize>();
+          auto values = std::array<Coordinate, batch::kSize>();
+
+          for (auto first = start; first < end; first += batch::kSize) {
+            auto count = std::min(batch::kSize, end - first);
+            for (size_t jx = 0; jx < count; ++jx) {
+              auto ix = indexes.empty() ? first + jx : indexes[first + jx];
+              x[jx] = this->x_->normalize_coordinate(_x(ix));
+              y[jx] = this->y_->normalize_coordinate(_y(ix));
+            }
+            if constexpr (std::is_integral_v<Type>) {
+              batch::bilinear(grid, strides, this->packing_, x_regular,
+                              y_regular, x.data(), y.data(), count,
+                              values.data());
+            } else {
+              batch::bilinear(grid, strides, x_regular, y_regular, x.data(),
+                              y.data(), count, values.data());
+            }
+            for (size_t jx = 0; jx < count; ++jx) {
+              auto ix = indexes.empty() ? first + jx : indexes[first + jx];
+              _result(ix) =
+                  std::isnan(values[jx])
+                      ? _interpolate(x_axis, y_axis, _x(ix), _y(ix),
+                                     interpolator, bounds_error, x_cursor,
+                                     y_cursor)
+                      : static_cast<Coordinate>(values[jx]);
+            }
+          }
+        },
+        size, num_threads, schedule, chunk_size);
+  }
+
+  /// Interpolates data with the bilinear interpolation and calculates the
+  /// partial derivatives of the interpolated surface.
+  ///
+  /// @see evaluate_gradient
+  template <typename X, typename Y>
+  void _evaluate_gradient(
+      const X& x_axis, const Y& y_axis,
+      const pybind11::detail::unchecked_reference<Coordinate, 1>& _x,
+      const pybind11::detail::unchecked_reference<Coordinate, 1>& _y,
+      pybind11::detail::unchecked_mutable_reference<Coordinate, 2>& _result,
+      const detail::math::Bilinear<Point, Coordinate>& interpolator,
+      const bool bounds_error, const size_t size, const size_t num_threads,
+      const detail::Schedule schedule, const size_t chunk_size,
+      const std::vector<size_t>& indexes) const {
+    // The calculation is vectorized on grids whose axes are regular.
+    if constexpr (std::is_same_v<X, detail::axis::container::Regular> &&
+                  std::is_same_v<Y, detail::axis::container::Regular>) {
+      if (x_axis.size() > 1 && y_axis.size() > 1) {
+        _evaluate_gradient_batch(x_axis, y_axis, _x, _y, _result,
+                                 interpolator, bounds_error, size,
+                                 num_threads, schedule, chunk_size, indexes);
+        return;
+      }
+    }
+
+    detail::dispatch(
+        [&](size_t start, size_t end) {
+          auto x_cursor = detail::axis::Cursor();
+          auto y_cursor = detail::axis::Cursor();
+
+          for (size_t jx = start; jx < end; ++jx) {
+            auto ix = indexes.empty() ? jx : indexes[jx];
+            _gradient(x_axis, y_axis, _x(ix), _y(ix), interpolator,
+                      bounds_error, x_cursor, y_cursor,
+                      _result.mutable_data(ix, 0));
+          }
+        },
+        size, num_threads, schedule, chunk_size);
+  }
+
+  /// Interpolates data, and calculates the partial derivatives, by batches
+  /// of positions with the vectorized kernel. The positions that this kernel
+  /// does not handle are then processed one by one.
+  ///
+  /// @see _evaluate_batch
+  void _evaluate_gradient_batch(
+      const detail::axis::container::Regular& x_axis,
+      const detail::axis::container::Regular& y_axis,
+      const pybind11::detail::unchecked_reference<Coordinate, 1>& _x,
+      const pybind11::detail::unchecked_reference<Coordinate, 1>& _y,
+      pybind11::detail::unchecked_mutable_reference<Coordinate, 2>& _result,
+      const detail::math::Bilinear<Point, Coordinate>& interpolator,
+      const bool bounds_error, const size_t size, const size_t num_threads,
+      const detail::Schedule schedule, const size_t chunk_size,
+      const std::vector<size_t>& indexes) const {
+    namespace batch = detail::math::batch;
+
+    auto x_regular =
+        batch::Regular{x_axis.coordinate_value(0), x_axis.step(),
+                       static_cast<double>(x_axis.size() - 1)};
+    auto y_regular =
+        batch::Regular{y_axis.coordinate_value(0), y_axis.step(),
+                       static_cast<double>(y_axis.size() - 1)};
+    auto strides =
+        std::array<int64_t, 2>{static_cast<int64_t>(this->array_.strides(0)),
+                               static_cast<int64_t>(this->array_.strides(1))};
+    auto grid = this->array_.data();
+
+    detail::dispatch(
+        [&](size_t start, size_t end) {
+          auto x_cursor = detail::axis::Cursor();
+          auto y_cursor = detail::axis::Cursor();
+          auto x = std::array<Coordinate, batch::kSize>();
+          auto y = std::array<Coordinate, batch::kSize>();
+          auto values = std::array<Coordinate, 3 * batch::kSize>();
+
+          for (auto first = start; first < end; first += batch::kSize) {
+            auto count = std::min(batch::kSize, end - first);
+            for (size_t jx = 0; jx < count; ++jx) {
+              auto ix = indexes.empty() ? first + jx : indexes[first + jx];
+              x[jx] = this->x_->normalize_coordinate(_x(ix));
+              y[jx] = this->y_->normalize_coordinate(_y(ix));
+            }
+            if constexpr (std::is_integral_v<Type>) {
+              batch::bilinear_gradient(grid, strides, this->packing_,
+                                       x_regular, y_regular, x.data(),
+                                       y.data(), count, values.data());
+            } else {
+              batch::bilinear_gradient(grid, strides, x_regular, y_regular,
+                                       x.data(), y.data(), count,
+                                       values.data());
+            }
+            for (size_t jx = 0; jx < count; ++jx) {
+              auto ix = indexes.empty() ? first + jx : indexes[first + jx];
+              if (std::isnan(values[jx])) {
+                _gradient(x_axis, y_axis, _x(ix), _y(ix), interpolator,
+                          bounds_error, x_cursor, y_cursor,
+                          _result.mutable_data(ix, 0));
+                continue;
+              }
+              for (size_t kx = 0; kx < 3; ++kx) {
+                _result(ix, kx) =
+                    static_cast<Coordinate>(values[kx * count + jx]);
+              }
+            }
+          }
+        },
+        size, num_threads, schedule, chunk_size);
+  }
+
+  /// Interpolates the values of several fields using the defined
+  /// interpolation function.
+  ///
+  /// @see _evaluate
+  template <typename X, typename Y, typename Interpolator>
+  void _evaluate_fields(
+      const X& x_axis, const Y& y_axis,
+      const pybind11::detail::unchecked_reference<Coordinate, 1>& _x,
+      const pybind11::detail::unchecked_reference<Coordinate, 1>& _y,
+      const std::vector<pybind11::array_t<Type>>& fields,
+      const std::vector<pybind11::detail::unchecked_reference<Type, 2>>& grids,
+      pybind11::detail::unchecked_mutable_reference<Coordinate, 2>& _result,
+      const Interpolator& interpolator, const bool bounds_error,
+      const size_t size, const size_t num_threads,
+      const detail::Schedule schedule, const size_t chunk_size,
+      const std::vector<size_t>& indexes) const {
+    if constexpr (std::is_same_v<Interpolator,
+                                 detail::math::Bilinear<Point, Coordinate>> &&
+                  std::is_same_v<X, detail::axis::container::Regular> &&
+                  std::is_same_v<Y, detail::axis::container::Regular>) {
+      if (x_axis.size() > 1 && y_axis.size() > 1) {
+        _evaluate_fields_batch(x_axis, y_axis, _x, _y, fields, grids, _result,
+                               interpolator, bounds_error, size, num_threads,
+                               schedule, chunk_size, indexes);
+        return;
+      }
+    }
+
+    detail::dispatch(
+        [&](size_t start, size_t end) {
+          auto x_cursor = detail::axis::Cursor();
+          auto y_cursor = detail::axis::Cursor();
+
+          for (size_t jx = start; jx < end; ++jx) {
+            auto ix = indexes.empty() ? jx : indexes[jx];
+            _interpolate_fields(x_axis, y_axis, _x(ix), _y(ix), grids,
+                                interpolator, bounds_error, x_cursor, y_cursor,
+                                _result.mutable_data(ix, 0));
+          }
+        },
+        size, num_threads, schedule, chunk_size);
+  }
+
+  /// Interpolates the values of several fields by batches of positions with
+  /// the vectorized bilinear kernel.
+  ///
+  /// @see _evaluate_batch
+  template <typename Interpolator>
+  void _evaluate_fields_batch(
+      const detail::axis::container::Regular& x_axis,
+      const detail::axis::container::Regular& y_axis,
+      const pybind11::detail::unchecked_reference<Coordinate, 1>& _x,
+      const pybind11::detail::unchecked_reference<Coordinate, 1>& _y,
+      const std::vector<pybind11::array_t<Type>>& fields,
+      const std::vector<pybind11::detail::unchecked_reference<Type, 2>>& grids,
+      pybind11::detail::unchecked_mutable_reference<Coordinate, 2>& _result,
+      const Interpolator& interpolator, const bool bounds_error,
+      const size_t size, const size_t num_threads,
+      const detail::Schedule schedule, const size_t chunk_size,
+      const std::vector<size_t>& indexes) const {
+    namespace batch = detail::math::batch;
+
+    auto x_regular =
+        batch::Regular{x_axis.coordinate_value(0), x_axis.step(),
+                       static_cast<double>(x_axis.size() - 1)};
+    auto y_regular =
+        batch::Regular{y_axis.coordinate_value(0), y_axis.step(),
+                       static_cast<double>(y_axis.size() - 1)};
+    auto pointers = std::vector<const Type*>{this->array_.data()};
+    auto strides = std::vector<std::array<int64_t, 2>>{
+        {static_cast<int64_t>(this->array_.strides(0)),
+         static_cast<int64_t>(this->array_.strides(1))}};
+    for (const auto& item : fields) {
+      pointers.push_back(item.data());
+      strides.push_back({static_cast<int64_t>(item.strides(0)),
+                         static_cast<int64_t>(item.strides(1))});
+    }
+    auto count = grids.size();
+
+    detail::dispatch(
+        [&](size_t start, size_t end) {
+          auto x_cursor = detail::axis::Cursor();
+          auto y_cursor = detail::axis::Cursor();
+          auto x = std::array<Coordinate, batch::kSize>();
+          auto y = std::array<Coordinate, batch::kSize>();
+          auto values = std::vector<Coordinate>(count * batch::kSize);
+
+          for (auto first = start; first < end; first += batch::kSize) {
+            auto n = std::min(batch::kSize, end - first);
+            for (size_t jx = 0; jx < n; ++jx) {
+              auto ix = indexes.empty() ? first + jx : indexes[first + jx];
+              x[jx] = this->x_->normalize_coordinate(_x(ix));
+              y[jx] = this->y_->normalize_coordinate(_y(ix));
+            }
+            if constexpr (std::is_integral_v<Type>) {
+              batch::bilinear(pointers.data(), strides.data(), count,
+                              this->packing_, x_regular, y_regular, x.data(),
+                              y.data(), n, values.data());
+            } else {
+              batch::bilinear(pointers.data(), strides.data(), count,
+                              x_regular, y_regular, x.data(), y.data(), n,
+                              values.data());
+            }
+            for (size_t jx = 0; jx < n; ++jx) {
+              auto ix = indexes.empty() ? first + jx : indexes[first + jx];
+              auto defined = true;
+              for (size_t kx = 0; kx < count; ++kx) {
+                defined &= !std::isnan(values[kx * n + jx]);
+              }
+              if (!defined) {
+                _interpolate_fields(x_axis, y_axis, _x(ix), _y(ix), grids,
+                                    interpolator, bounds_error, x_cursor,
+                                    y_cursor, _result.mutable_data(ix, 0));
+                continue;
+              }
+              for (size_t kx = 0; kx < count; ++kx) {
+                _result(ix, kx) = static_cast<Coordinate>(values[kx * n + jx]);
+              }
+            }
+          }
+        },
+        size, num_threads, schedule, chunk_size);
+  }
+
+  /// Cell of the grid framing a coordinate of a target axis
+  struct Cell {
+    /// Index of the first element of the cell, or -1 if the coordinate is
+    /// outside the grid.
+    int64_t i0;
+    /// Index of the second element of the cell
+    int64_t i1;
+    /// Coordinate, normalized with respect to c0 if the axis is an angle
+    Coordinate value;
+    /// Coordinate of the first element of the cell
+    Coordinate c0;
+    /// Coordinate of the second element of the cell
+    Coordinate c1;
+    /// Weight of the second element for a linear interpolation
+    Coordinate weight;
+  };
+
+  /// Searches the cells of the grid framing the coordinates of a target axis.
+  ///
+  /// @tparam Container Type of the container handling the values of the
+  /// axis of the grid.
+  template <typename Container>
+  static std::vector<Cell> _cells(const Axis& axis, const Container& container,
+                                  const Axis& target, const std::string& name,
+                                  const bool bounds_error) {
+    auto result = std::vector<Cell>(target.size());
+    auto cursor = detail::axis::Cursor();
+    for (size_t ix = 0; ix < result.size(); ++ix) {
+      auto& cell = result[ix];
+      auto value = static_cast<Coordinate>(target.coordinate_value(ix));
+      auto indexes = axis.template find_indexes<Container>(value, cursor);
+      if (!indexes.has_value()) {
+        if (bounds_error) {
+          Bivariate::index_error(axis, value, name);
+        }
+        cell.i0 = -1;
+        continue;
+      }
+      std::tie(cell.i0, cell.i1) = *indexes;
+      cell.c0 = container.coordinate_value(cell.i0);
+      cell.c1 = container.coordinate_value(cell.i1);
+      cell.value =
+          axis.is_angle() ? detail::math::normalize_angle(value, cell.c0)
+                          : value;
+      cell.weight = (cell.value - cell.c0) / (cell.c1 - cell.c0);
+    }
+    return result;
+  }
+
+  /// Calls the function for the target columns [start, end) and all the
+  /// target rows, the target points being processed by square blocks so that
+  /// the values of the grid read are reused while they are in the CPU caches,
+  /// whatever the memory layout of the grid.
+  template <typename Function>
+  static void _traverse(const size_t start, const size_t end,
+                        const size_t rows, const Function& function) {
+    constexpr size_t kBlock = 64;
+    for (auto i0 = start; i0 < end; i0 += kBlock) {
+      auto i1 = std::min(i0 + kBlock, end);
+      for (size_t j0 = 0; j0 < rows; j0 += kBlock) {
+        auto j1 = std::min(j0 + kBlock, rows);
+        for (auto ix = i0; ix < i1; ++ix) {
+          for (auto jx = j0; jx < j1; ++jx) {
+            function(ix, jx);
+          }
+        }
+      }
+    }
+  }
+
+  /// Interpolates the value of a target point from the cells framing it.
+  /// The bilinear interpolation blends the values of the grid with the
+  /// weights calculated once per target column and row.
+  template <typename Interpolator>
+  Coordinate _blend(const Cell& column, const Cell& row,
+                    const Interpolator& interpolator) const {
+    if (column.i0 == -1 || row.i0 == -1) {
+      return std::numeric_limits<Coordinate>::quiet_NaN();
+    }
+    auto q00 = this->template value<Coordinate>(column.i0, row.i0);
+    auto q01 = this->template value<Coordinate>(column.i0, row.i1);
+    auto q10 = this->template value<Coordinate>(column.i1, row.i0);
+    auto q11 = this->template value<Coordinate>(column.i1, row.i1);
+    if constexpr (std::is_same_v<Interpolator,
+                                 detail::math::Bilinear<Point, Coordinate>>) {
+      auto t = column.weight;
+      auto u = row.weight;
+      auto result = (1 - t) * (1 - u) * q00 + t * (1 - u) * q10 +
+                    (1 - t) * u * q01 + t * u * q11;
+      if (interpolator.masked() && std::isnan(result)) {
+        return detail::math::renormalize<Coordinate, 4>(
+            {(1 - t) * (1 - u), (1 - t) * u, t * (1 - u), t * u},
+            {q00, q01, q10, q11}, interpolator.min_valid());
+      }
+      return result;
+    } else {
+      return interpolator.evaluate(Point<Coordinate>(column.value, row.value),
+                                   Point<Coordinate>(column.c0, row.c0),
+                                   Point<Coordinate>(column.c1, row.c1), q00,
+                                   q01, q10, q11);
+    }
+  }
+
+  /// Interpolates data with an interpolator written in Python, whose method
+  /// "evaluate_batch" is called once for each chunk of values processed by
+  /// a thread.
+  ///
+  /// @see _evaluate
+  template <typename X, typename Y>
+  void _evaluate_python(
+      const X& x_axis, const Y& y_axis,
+      const detail::FlatView<const Coordinate>& _x,
+      const detail::FlatView<const Coordinate>& _y,
+      const detail::FlatView<Coordinate>& _result,
+      const pybind11::function& evaluate_batch, const bool bounds_error,
+      const size_t size, const size_t num_threads,
+      const detail::Schedule schedule, const size_t chunk_size,
+      const std::vector<size_t>& indexes) const {
+    detail::dispatch(
+        [&](size_t start, size_t end) {
+          auto x_cursor = detail::axis::Cursor();
+          auto y_cursor = detail::axis::Cursor();
+          auto interpolator =
+              BatchInterpolator<Point, Coordinate>(evaluate_batch);
+          // Indexes of the values whose interpolation has been recorded
+          auto recorded = std::vector<size_t>();
+
+          for (size_t jx = start; jx < end; ++jx) {
+            auto ix = indexes.empty() ? jx : indexes[jx];
+            _result(ix) = _interpolate(x_axis, y_axis, _x(ix), _y(ix),
+                                       interpolator, bounds_error, x_cursor,
+                                       y_cursor);
+            if (interpolator.size() != recorded.size()) {
+              recorded.push_back(ix);
+            }
+          }
+          auto values = interpolator.solve();
+          for (size_t jx = 0; jx < recorded.size(); ++jx) {
+            _result(recorded[jx]) = values[jx];
+          }
+        },
+        size, num_threads, schedule, chunk_size);
+  }
+
+  /// Interpolates the values of the fields at a position, the cell framing
+  /// it being searched once for all the fields.
+  ///
+  /// @param result The values interpolated, one per field
+  /// @return True if the position is inside the grid
+  /// @see evaluate_fields
+  template <typename X, typename Y, typename Interpolator>
+  bool _interpolate_fields(
+      const X& x_axis, const Y& y_axis, const Coordinate x, const Coordinate y,
+      const std::vector<pybind11::detail::unchecked_reference<Type, 2>>& grids,
+      const Interpolator& interpolator, const bool bounds_error,
+      detail::axis::Cursor& x_cursor, detail::axis::Cursor& y_cursor,
+      Coordinate* result) const {
+    auto x_indexes = this->x_->template find_indexes<X>(x, x_cursor);
+    auto y_indexes = this->y_->template find_indexes<Y>(y, y_cursor);
+
+    if (!x_indexes.has_value() || !y_indexes.has_value()) {
+      if (bounds_error) {
+        if (!x_indexes.has_value()) {
+          Bivariate::index_error(*this->x_, x, "x");
+        }
+        Bivariate::index_error(*this->y_, y, "y");
+      }
+      std::fill(result, result + grids.size(),
+                std::numeric_limits<Coordinate>::quiet_NaN());
+      return false;
+    }
+
+    int64_t ix0, ix1, iy0, iy1;
+    std::tie(ix0, ix1) = *x_indexes;
+    std::tie(iy0, iy1) = *y_indexes;
+
+    auto x0 = static_cast<Coordinate>(x_axis.coordinate_value(ix0));
+    auto p = Point<Coordinate>(
+        this->x_->is_angle() ? detail::math::normalize_angle(x, x0) : x, y);
+    auto p0 = Point<Coordinate>(x0, y_axis.coordinate_value(iy0));
+    auto p1 = Point<Coordinate>(x_axis.coordinate_value(ix1),
+                                y_axis.coordinate_value(iy1));
+
+    if constexpr (std::is_same_v<Interpolator,
+                                 detail::math::Bilinear<Point, Coordinate>>) {
+      // The weights are shared by all the fields.
+      auto t = (boost::geometry::get<0>(p) - boost::geometry::get<0>(p0)) /
+               (boost::geometry::get<0>(p1) - boost::geometry::get<0>(p0));
+      auto u = (boost::geometry::get<1>(p) - boost::geometry::get<1>(p0)) /
+               (boost::geometry::get<1>(p1) - boost::geometry::get<1>(p0));
+      auto w00 = (1 - t) * (1 - u);
+      auto w10 = t * (1 - u);
+      auto w01 = (1 - t) * u;
+      auto w11 = t * u;
+      for (size_t ix = 0; ix < grids.size(); ++ix) {
+        const auto& grid = grids[ix];
+        auto q00 = this->template unpack<Coordinate>(grid(ix0, iy0));
+        auto q01 = this->template unpack<Coordinate>(grid(ix0, iy1));
+        auto q10 = this->template unpack<Coordinate>(grid(ix1, iy0));
+        auto q11 = this->template unpack<Coordinate>(grid(ix1, iy1));
+        result[ix] = w00 * q00 + w10 * q10 + w01 * q01 + w11 * q11;
+        if (interpolator.masked() && std::isnan(result[ix])) {
+          result[ix] = detail::math::renormalize<Coordinate, 4>(
+              {w00, w01, w10, w11}, {q00, q01, q10, q11},
+              interpolator.min_valid());
+        }
+      }
+    } else {
+      for (size_t ix = 0; ix < grids.size(); ++ix) {
+        const auto& grid = grids[ix];
+        result[ix] = interpolator.evaluate(
+            p, p0, p1, this->template unpack<Coordinate>(grid(ix0, iy0)),
+            this->template unpack<Coordinate>(grid(ix0, iy1)),
+            this->template unpack<Coordinate>(grid(ix1, iy0)),
+            this->template unpack<Coordinate>(grid(ix1, iy1)));
+      }
+    }
+    return true;
+  }
+
+  /// Interpolates the value of a position and calculates its partial
+  /// derivatives.
+  ///
+  /// @param result The value interpolated, followed by its derivatives with
+  /// respect to x and y.
+  /// @see evaluate_gradient
+  template <typename X, typename Y>
+  void _gradient(const X& x_axis, const Y& y_axis, const Coordinate x,
+                 const Coordinate y,
+                 const detail::math::Bilinear<Point, Coordinate>& interpolator,
+                 const bool bounds_error, detail::axis::Cursor& x_cursor,
+                 detail::axis::Cursor& y_cursor, Coordinate* result) const {
+    auto x_indexes = this->x_->template find_indexes<X>(x, x_cursor);
+    auto y_indexes = this->y_->template find_indexes<Y>(y, y_cursor);
+
+    if (!x_indexes.has_value() || !y_indexes.has_value()) {
+      if (bounds_error) {
+        if (!x_indexes.has_value()) {
+          Bivariate::index_error(*this->x_, x, "x");
+        }
+        Bivariate::index_error(*this->y_, y, "y");
+      }
+      std::fill(result, result + 3,
+                std::numeric_limits<Coordinate>::quiet_NaN());
+      return;
+    }
+
+    int64_t ix0, ix1, iy0, iy1;
+    std::tie(ix0, ix1) = *x_indexes;
+    std::tie(iy0, iy1) = *y_indexes;
+
+    auto x0 = static_cast<Coordinate>(x_axis.coordinate_value(ix0));
+    std::tie(result[0], result[1], result[2]) = interpolator.gradient(
+        Point<Coordinate>(
+            this->x_->is_angle() ? detail::math::normalize_angle(x, x0) : x,
+            y),
+        Point<Coordinate>(x0, y_axis.coordinate_value(iy0)),
+        Point<Coordinate>(x_axis.coordinate_value(ix1),
+                          y_axis.coordinate_value(iy1)),
+        this->template value<Coordinate>(ix0, iy0),
+        this->template value<Coordinate>(ix0, iy1),
+        this->template value<Coordinate>(ix1, iy0),
+        this->template value<Coordinate>(ix1, iy1));
+  }
+
+  /// Calculates the weights of the grid values used to interpolate a
+  /// position.
+  ///
+  /// @param indices Index of the grid values, flattened in C order
+  /// @param weights Weights of the grid values
+  /// @return The number of grid values stored, zero if the position is
+  /// outside the grid.
+  /// @see plan
+  template <typename X, typename Y, typename Interpolator>
+  int64_t _plan(const X& x_axis, const Y& y_axis, const Coordinate x,
+                const Coordinate y, const Interpolator& interpolator,
+                const bool bounds_error, detail::axis::Cursor& x_cursor,
+                detail::axis::Cursor& y_cursor, int64_t* indices,
+                double* weights) const {
+    auto x_indexes = this->x_->template find_indexes<X>(x, x_cursor);
+    auto y_indexes = this->y_->template find_indexes<Y>(y, y_cursor);
+
+    if (!x_indexes.has_value() || !y_indexes.has_value()) {
+      if (bounds_error) {
+        if (!x_indexes.has_value()) {
+          Bivariate::index_error(*this->x_, x, "x");
+        }
+        Bivariate::index_error(*this->y_, y, "y");
+      }
+      return 0;
+    }
+
+    int64_t ix0, ix1, iy0, iy1;
+    std::tie(ix0, ix1) = *x_indexes;
+    std::tie(iy0, iy1) = *y_indexes;
+
+    auto x0 = static_cast<Coordinate>(x_axis.coordinate_value(ix0));
+    auto p = Point<Coordinate>(
+        this->x_->is_angle() ? detail::math::normalize_angle(x, x0) : x, y);
+    auto p0 = Point<Coordinate>(x0, y_axis.coordinate_value(iy0));
+    auto p1 = Point<Coordinate>(x_axis.coordinate_value(ix1),
+                                y_axis.coordinate_value(iy1));
+
+    constexpr auto kMasked =
+        std::is_same_v<Interpolator, detail::math::Bilinear<Point, Coordinate>>;
+    auto ny = static_cast<int64_t>(this->y_->size());
+    auto count = int64_t(0);
+    auto valid = 0;
+    auto append = [&](const int64_t ix, const int64_t iy, const Coordinate q00,
+                      const Coordinate q01, const Coordinate q10,
+                      const Coordinate q11) {
+      // The masked bilinear interpolation drops the corners undefined in
+      // this grid.
+      if constexpr (kMasked) {
+        if (interpolator.masked() &&
+            std::isnan(this->template value<Coordinate>(ix, iy))) {
+          return;
+        }
+      }
+      ++valid;
+      auto weight = interpolator.evaluate(p, p0, p1, q00, q01, q10, q11);
+      if (weight != 0) {
+        indices[count] = ix * ny + iy;
+        weights[count] = weight;
+        ++count;
+      }
+    };
+    append(ix0, iy0, 1, 0, 0, 0);
+    append(ix0, iy1, 0, 1, 0, 0);
+    append(ix1, iy0, 0, 0, 1, 0);
+    append(ix1, iy1, 0, 0, 0, 1);
+
+    // The weights of the corners kept are renormalized.
+    if constexpr (kMasked) {
+      if (interpolator.masked()) {
+        auto norm = std::accumulate(weights, weights + count, 0.0);
+        if (valid < interpolator.min_valid() || norm == 0) {
+          return 0;
+        }
+        std::transform(weights, weights + count, weights,
+                       [norm](const double item) { return item / norm; });
+      }
+    }
+    return count;
+  }
+
+  /// Interpolates the value of a position.
+  ///
+  /// @see _evaluate
+  template <typename X, typename Y, typename Interpolator>
+  Coordinate _interpolate(const X& x_axis, const Y& y_axis, const Coordinate x,
+                          const Coordinate y, const Interpolator& interpolator,
+                          const bool bounds_error,
+                          detail::axis::Cursor& x_cursor,
+                          detail::axis::Cursor& y_cursor) const {
+    auto x_indexes = this->x_->template find_indexes<X>(x, x_cursor);
+    auto y_indexes = this->y_->template find_indexes<Y>(y, y_cursor);
+
+    if (x_indexes.has_value() && y_indexes.has_value()) {
+      int64_t ix0, ix1, iy0, iy1;
+      std::tie(ix0, ix1) = *x_indexes;
+      std::tie(iy0, iy1) = *y_indexes;
+
+      auto x0 = static_cast<Coordinate>(x_axis.coordinate_value(ix0));
+
+      return interpolator.evaluate(
+          Point<Coordinate>(
+              this->x_->is_angle() ? detail::math::normalize_angle(x, x0) : x,
+              y),
+          Point<Coordinate>(x0, y_axis.coordinate_value(iy0)),
+          Point<Coordinate>(x_axis.coordinate_value(ix1),
+                            y_axis.coordinate_value(iy1)),
+          this->template value<Coordinate>(ix0, iy0),
+          this->template value<Coordinate>(ix0, iy1),
+          this->template value<Coordinate>(ix1, iy0),
+          this->template value<Coordinate>(ix1, iy1));
+    }
+    if (bounds_error) {
+      if (!x_indexes.has_value()) {
+        Bivariate::index_error(*this->x_, x, "x");
+      }
+      Bivariate::index_error(*this->y_, y, "y");
+    }
+    return std::numeric_limits<Coordinate>::quiet_NaN();
+  }
 };
 
 template <template <class> class Point, typename T>
@@ -171,12 +1311,49 @@ void implement_bivariate_interpolator(pybind11::module& m,
   /// BivariateInterpolator implemented here
   auto interpolator = pybind11::class_<CoordinateSystem, PyInterpolator>(
       m, ("BivariateInterpolator" + suffix).c_str(),
-      ("Bilinear interpolation in a " + suffix + " space").c_str());
+      ("Bivariate interpolation in a " + suffix + R"__doc__( space
+
+Interpolators written in Python derive from this class and define the method
+``evaluate_batch(p, p0, p1, q00, q01, q10, q11)``, called once for each chunk
+of values processed by a thread, in order to interpolate all the values of the
+chunk at once (e.g. with NumPy or Numba).
+
+Args:
+    p (numpy.ndarray): Query points, array of shape (n, dimensions)
+    p0 (numpy.ndarray): Points of coordinates (x0, y0), array of shape
+        (n, dimensions)
+    p1 (numpy.ndarray): Points of coordinates (x1, y1), array of shape
+        (n, dimensions)
+    q00 (numpy.ndarray): Values of the grid at (x0, y0)
+    q01 (numpy.ndarray): Values of the grid at (x0, y1)
+    q10 (numpy.ndarray): Values of the grid at (x1, y0)
+    q11 (numpy.ndarray): Values of the grid at (x1, y1)
+Return:
+    numpy.ndarray: The n interpolated values
+)__doc__")
+          .c_str());
+  interpolator.def(pybind11::init<>());
 
   pybind11::class_<Bilinear<Point, T>>(
       m, ("Bilinear" + suffix).c_str(), interpolator,
-      ("Bilinear interpolation in a " + suffix + " space").c_str())
+      ("Bilinear interpolation in a " + suffix + R"__doc__( space
+
+Args:
+    min_valid (int, optional): Minimum number of corners of the cell whose
+        value is defined. The undefined corners are dropped and the weights
+        of the others renormalized: the values close to a masked area (e.g.
+        a coastline) are interpolated from the defined values instead of
+        being undefined. If fewer corners are defined, or if the position is
+        located on an undefined corner, the value interpolated is undefined.
+        Defaults to the number of corners of the cell (4, or 8 for the
+        trivariate interpolation): all the corners must be defined.
+)__doc__")
+          .c_str())
       .def(pybind11::init<>())
+      .def(pybind11::init<int>(), pybind11::arg("min_valid"))
+      .def_property_readonly(
+          "min_valid", &Bilinear<Point, T>::min_valid,
+          "Gets the minimum number of corners whose value is defined")
       .def(pybind11::pickle(
           [](const Bilinear<Point, T>& self) { return self.getstate(); },
           [](const pybind11::tuple& state) {
@@ -209,13 +1386,15 @@ void implement_bivariate_interpolator(pybind11::module& m,
 
 template <template <class> class Point, typename Coordinate, typename Type>
 void implement_bivariate(pybind11::module& m, const char* class_name) {
-  pybind11::class_<Bivariate<Point, Coordinate, Type>>(m, class_name,
-                                                       R"__doc__(
+  auto cls = pybind11::class_<Bivariate<Point, Coordinate, Type>>(
+      m, class_name, R"__doc__(
 Interpolation of bivariate functions
 )__doc__")
       .def(pybind11::init<std::shared_ptr<Axis>, std::shared_ptr<Axis>,
-                          pybind11::array_t<Type>>(),
+                          pybind11::array_t<Type>,
+                          std::optional<std::vector<ssize_t>>>(),
            pybind11::arg("x"), pybind11::arg("y"), pybind11::arg("z"),
+           pybind11::arg("axes") = pybind11::none(),
            R"__doc__(
 Default constructor
 
@@ -223,6 +1402,9 @@ Args:
     x (pyinterp.core.Axis): X-Axis
     y (pyinterp.core.Axis): Y-Axis
     array (numpy.ndarray): Bivariate function
+    axes (tuple, optional): Dimension of the array holding each axis of the
+        grid, if the array is not stored in the order of the axes. The array
+        is then read without being copied. Defaults to ``None``.
 )__doc__")
       .def_property_readonly(
           "x",
@@ -256,17 +1438,81 @@ Gets the values handled by this instance
 
 Returns:
     numpy.ndarray: values
+)__doc__")
+      .def_property_readonly(
+          "dtype",
+          [](const Bivariate<Point, Coordinate, Type>& /*self*/) {
+            return pybind11::dtype::of<Coordinate>();
+          },
+          R"__doc__(
+Gets the type of the coordinates and of the values interpolated
+
+Returns:
+    numpy.dtype: ``float64``, or ``float32`` for the interpolators calculating
+    in single precision
 )__doc__")
       .def("evaluate", &Bivariate<Point, Coordinate, Type>::evaluate,
            pybind11::arg("x"), pybind11::arg("y"),
            pybind11::arg("interpolator"), pybind11::arg("bounds_error") = false,
            pybind11::arg("num_threads") = 0,
+           pybind11::arg("schedule") = detail::kStatic,
+           pybind11::arg("chunk_size") = 0, pybind11::arg("reorder") = false,
+           pybind11::arg("out").noconvert() = pybind11::none(),
            R"__doc__(
 Interpolate the values provided on the defined bivariate function.
 
+Args:
+    x (numpy.ndarray): X-values, array of any shape
+    y (numpy.ndarray): Y-values, array of any shape
+    interpolator (pyinterp.core.BivariateInterpolator2D): 2D interpolator
+      used to interpolate.
+    bounds_error (bool, optional): If True, when interpolated values are
+      requested outside of the domain of the input axes (x,y), a ValueError
+      is raised. If False, then value is set to Nan.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+    schedule (pyinterp.core.Schedule, optional): Distribution of the values
+        between the threads. ``Dynamic`` balances the load between threads
+        when the cost of the calculation varies from one value to another.
+        Defaults to ``Static``.
+    chunk_size (int, optional): Number of values claimed at once by a thread
+        with the ``Dynamic`` schedule. If 0, the size is chosen according to
+        the number of values and threads. Defaults to ``0``.
+    reorder (bool, optional): If True, the values are processed in the
+        order of a space-filling curve (Morton order), so that consecutive
+        calculations access neighbouring memory areas. This improves the
+        cache efficiency for large numbers of randomly scattered values, at
+        the cost of sorting them. Defaults to ``False``.
+    out (numpy.ndarray, optional): Array receiving the values interpolated.
+        It must have the shape of the coordinates broadcast together and the
+        type of the result; it can be a non-contiguous view. Defaults to
+        ``None``, a new array being allocated.
+Return:
+    numpy.ndarray: Values interpolated, array of the shape of the coordinates
+    broadcast together (``out`` if provided).
+)__doc__")
+      .def("evaluate_fields",
+           &Bivariate<Point, Coordinate, Type>::evaluate_fields,
+           pybind11::arg("x"), pybind11::arg("y"), pybind11::arg("fields"),
+           pybind11::arg("interpolator"), pybind11::arg("bounds_error") = false,
+           pybind11::arg("num_threads") = 0,
+           pybind11::arg("schedule") = detail::kStatic,
+           pybind11::arg("chunk_size") = 0, pybind11::arg("reorder") = false,
+           R"__doc__(
+Interpolate the values provided on the bivariate function and on other fields
+defined on the same axes.
+
+The cells framing the values provided are searched once for all the fields,
+so interpolating several fields together costs little more than interpolating
+one of them.
+
 Args:
     x (numpy.ndarray): X-values
     y (numpy.ndarray): Y-values
+    fields (list): Values of the other fields, arrays stored like the array
+        of the bivariate function, in the same axis order.
     interpolator (pyinterp.core.BivariateInterpolator2D): 2D interpolator
       used to interpolate.
     bounds_error (bool, optional): If True, when interpolated values are
@@ -276,8 +1522,104 @@ Args:
         computation. If 0 all CPUs are used. If 1 is given, no parallel
         computing code is used at all, which is useful for debugging.
         Defaults to ``0``.
+    schedule (pyinterp.core.Schedule, optional): Distribution of the values
+        between the threads. Defaults to ``Static``.
+    chunk_size (int, optional): Number of values claimed at once by a thread
+        with the ``Dynamic`` schedule. Defaults to ``0``.
+    reorder (bool, optional): If True, the values are processed in the
+        order of a space-filling curve (Morton order). Defaults to
+        ``False``.
+Return:
+    numpy.ndarray: Values interpolated, array of shape (x.size, 1 +
+    len(fields)). The first column contains the values of the bivariate
+    function, followed by a column for each field.
+)__doc__")
+      .def("evaluate_gradient",
+           &Bivariate<Point, Coordinate, Type>::evaluate_gradient,
+           pybind11::arg("x"), pybind11::arg("y"),
+           pybind11::arg("bounds_error") = false,
+           pybind11::arg("num_threads") = 0,
+           pybind11::arg("schedule") = detail::kStatic,
+           pybind11::arg("chunk_size") = 0, pybind11::arg("reorder") = false,
+           R"__doc__(
+Interpolate the values provided on the bivariate function with the bilinear
+interpolation, and calculate the partial derivatives of the interpolated
+surface.
+
+The value and its derivatives are calculated in a single pass, from the same
+cell and the same weights. The derivatives are expressed in units of the
+function per unit of the axes (for example per degree for a longitude axis).
+
+Args:
+    x (numpy.ndarray): X-values
+    y (numpy.ndarray): Y-values
+    bounds_error (bool, optional): If True, when interpolated values are
+      requested outside of the domain of the input axes (x,y), a ValueError
+      is raised. If False, then value is set to Nan.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+    schedule (pyinterp.core.Schedule, optional): Distribution of the values
+        between the threads. Defaults to ``Static``.
+    chunk_size (int, optional): Number of values claimed at once by a thread
+        with the ``Dynamic`` schedule. Defaults to ``0``.
+    reorder (bool, optional): If True, the values are processed in the
+        order of a space-filling curve (Morton order). Defaults to
+        ``False``.
 Return:
-    numpy.ndarray: Values interpolated
+    numpy.ndarray: Array of shape (x.size, 3) containing the values
+    interpolated, their derivatives with respect to x and their derivatives
+    with respect to y.
+)__doc__")
+      .def("plan", &Bivariate<Point, Coordinate, Type>::plan,
+           pybind11::arg("x"), pybind11::arg("y"),
+           pybind11::arg("interpolator"), pybind11::arg("bounds_error") = false,
+           pybind11::arg("num_threads") = 0,
+           R"__doc__(
+Precompute the interpolation of the values provided, in order to interpolate
+many arrays defined on the axes of this grid.
+
+Args:
+    x (numpy.ndarray): X-values
+    y (numpy.ndarray): Y-values
+    interpolator (pyinterp.core.BivariateInterpolator2D): One of the built-in
+        2D interpolators.
+    bounds_error (bool, optional): If True, when interpolated values are
+      requested outside of the domain of the input axes (x,y), a ValueError
+      is raised. If False, then value is set to Nan.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+Return:
+    pyinterp.core.InterpolationPlan: The interpolation plan
+)__doc__")
+      .def("regrid", &Bivariate<Point, Coordinate, Type>::regrid,
+           pybind11::arg("x"), pybind11::arg("y"),
+           pybind11::arg("interpolator"), pybind11::arg("bounds_error") = false,
+           pybind11::arg("num_threads") = 0,
+           R"__doc__(
+Interpolate the bivariate function onto the grid defined by the target axes.
+
+The cells framing the coordinates of the target axes are searched once per
+target column and once per target row, which is much faster than evaluating
+the function on the points of a mesh grid.
+
+Args:
+    x (pyinterp.core.Axis): X-Axis of the target grid
+    y (pyinterp.core.Axis): Y-Axis of the target grid
+    interpolator (pyinterp.core.BivariateInterpolator2D): 2D interpolator
+      used to interpolate.
+    bounds_error (bool, optional): If True, when interpolated values are
+      requested outside of the domain of the input axes (x,y), a ValueError
+      is raised. If False, then value is set to Nan.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+Return:
+    numpy.ndarray: Values interpolated, array of shape (x.size(), y.size())
 )__doc__")
       .def_static("_setstate", &Bivariate<Point, Coordinate, Type>::setstate,
                   pybind11::arg("state"), R"__doc__(
@@ -293,6 +1635,38 @@ Args:
           [](const pybind11::tuple& state) {
             return Bivariate<Point, Coordinate, Type>::setstate(state);
           }));
+
+  if constexpr (std::is_integral_v<Type>) {
+    cls.def(pybind11::init<std::shared_ptr<Axis>, std::shared_ptr<Axis>,
+                           pybind11::array_t<Type>, double, double,
+                           std::optional<Type>,
+                           std::optional<std::vector<ssize_t>>>(),
+            pybind11::arg("x"), pybind11::arg("y"), pybind11::arg("z"),
+            pybind11::arg("scale_factor") = 1.0,
+            pybind11::arg("add_offset") = 0.0,
+            pybind11::arg("fill_value") = pybind11::none(),
+            pybind11::arg("axes") = pybind11::none(),
+            R"__doc__(
+Constructor of a grid of packed integers: the integer q represents the
+value q * scale_factor + add_offset, or an undefined value if it is equal to
+the fill value. The values are decoded when they are interpolated.
+
+Args:
+    x (pyinterp.core.Axis): X-Axis
+    y (pyinterp.core.Axis): Y-Axis
+    array (numpy.ndarray): Bivariate function, packed
+    scale_factor (float, optional): Factor applied to the integers. Defaults
+        to ``1``.
+    add_offset (float, optional): Offset added to the integers multiplied by
+        the scale factor. Defaults to ``0``.
+    fill_value (int, optional): Integer representing the undefined values.
+        Defaults to ``None``, all the integers representing a value.
+    axes (tuple, optional): Dimension of the array holding each axis of the
+        grid, if the array is not stored in the order of the axes. The array
+        is then read without being copied. Defaults to ``None``.
+)__doc__");
+    implement_packing(cls);
+  }
 }
 
 }  // namespace pyinterp
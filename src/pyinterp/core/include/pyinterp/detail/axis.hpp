@@ -48,6 +48,7 @@ class Axis {
        const double epsilon = 1e-6, const bool is_circle = false,
        const bool is_radian = false)
       : circle_(Axis::set_circle(is_circle, is_radian)),
+        type_(axis::container::kRegular),
         axis_(std::make_shared<axis::container::Regular>(
             axis::container::Regular(start, stop, num))) {
     compute_properties(epsilon);
@@ -60,8 +61,14 @@ class Axis {
   /// order to consider them equal.
   /// @param is_circle True, if the axis can represent a circle.
   /// @param is_radian True, if the coordinate system is radian.
+  /// @param bucket_factor Maximum number of buckets, per axis value, of the
+  /// lookup table accelerating the searches if the values are not evenly
+  /// spaced.
+  /// @see axis::container::Irregular::Irregular
   explicit Axis(std::vector<double> values, double epsilon = 1e-6,
-                bool is_circle = false, bool is_radian = false);
+                bool is_circle = false, bool is_radian = false,
+                size_t bucket_factor =
+                    axis::container::Irregular::kDefaultBucketFactor);
 
   /// Destructor
   ~Axis() = default;
@@ -115,7 +122,12 @@ class Axis {
 
   /// Check if this axis values are spaced regularly
   inline bool is_regular() const noexcept {
-    return dynamic_cast<axis::container::Regular*>(axis_.get()) != nullptr;
+    return type_ == axis::container::kRegular;
+  }
+
+  /// Gets the type of container handling the axis values.
+  inline axis::container::Type container_type() const noexcept {
+    return type_;
   }
 
   /// Returns true if this axis represents a circle.
@@ -146,11 +158,23 @@ class Axis {
   /// @return increment value if is_regular()
   /// @throw std::logic_error if this instance does not represent a regular axis
   inline double increment() const {
-    auto ptr = dynamic_cast<axis::container::Regular*>(axis_.get());
-    if (ptr == nullptr) {
+    if (!is_regular()) {
       throw std::logic_error("this axis is not regular.");
     }
-    return ptr->step();
+    return static_cast<const axis::container::Regular&>(*axis_).step();
+  }
+
+  /// Gets the memory used by the lookup table accelerating the searches, in
+  /// bytes.
+  ///
+  /// @return the size of the lookup table if the axis is irregular, 0
+  /// otherwise
+  inline size_t lookup_table_size() const noexcept {
+    if (type_ != axis::container::kIrregular) {
+      return 0;
+    }
+    return static_cast<const axis::container::Irregular&>(*axis_)
+        .lookup_table_size();
   }
 
   /// compare two variables instances
@@ -209,6 +233,52 @@ class Axis {
   std::optional<std::tuple<int64_t, int64_t>> find_indexes(
       double coordinate) const;
 
+  /// Given a coordinate position, find grids elements around it, the type of
+  /// the container handling the axis values being known at compile time.
+  ///
+  /// @param coordinate position in this coordinate system
+  /// @return None if coordinate is outside the axis definition domain otherwise
+  /// the tuple (i0, i1)
+  /// @tparam Container Type of the container handling the axis values (see
+  /// Axis::visit). If axis::container::Abstract is given, the search goes
+  /// through the virtual interface of the container.
+  template <typename Container>
+  std::optional<std::tuple<int64_t, int64_t>> find_indexes(
+      double coordinate) const;
+
+  /// Given a coordinate position, find grids elements around it, the search
+  /// starting from the cell found by the previous search performed with the
+  /// cursor provided. This accelerates the searches of successive positions
+  /// close to each other, for example along a track.
+  ///
+  /// @param coordinate position in this coordinate system
+  /// @param cursor cursor updated with the result of the search
+  /// @return None if coordinate is outside the axis definition domain otherwise
+  /// the tuple (i0, i1)
+  /// @tparam Container Type of the container handling the axis values.
+  template <typename Container>
+  std::optional<std::tuple<int64_t, int64_t>> find_indexes(
+      double coordinate, axis::Cursor& cursor) const;
+
+  /// Given coordinate positions, find grids elements around them and the
+  /// fractional position of the coordinates between these elements. For each
+  /// position located inside the axis definition domain:
+  /// @code
+  /// coordinate = (1 - weight) * (*this)(i0) + weight * (*this)(i1)
+  /// @endcode
+  /// the coordinate being reduced modulo the circle if this axis represents
+  /// an angle.
+  ///
+  /// @param coordinates Contiguous positions in this coordinate system
+  /// @param size Number of positions to process
+  /// @param i0 Index of the first element framing each position
+  /// @param i1 Index of the second element framing each position
+  /// @param weight Fractional position between the elements i0 and i1
+  /// @param mask Set to true if the position is outside the axis definition
+  /// domain, i0 and i1 are then set to -1 and weight to NaN.
+  void find_indexes(const double* coordinates, size_t size, int64_t* i0,
+                    int64_t* i1, double* weight, bool* mask) const;
+
   /// Create a table of "size" indices located on either side of the required
   /// position.
   ///
@@ -222,6 +292,70 @@ class Axis {
   std::vector<int64_t> find_indexes(double coordinate, uint32_t size,
                                     Boundary boundary = kUndef) const;
 
+  /// Create a table of "size" indices located on either side of the required
+  /// position, the type of the container handling the axis values being known
+  /// at compile time.
+  ///
+  /// @see find_indexes(double, uint32_t, Boundary) const
+  /// @tparam Container Type of the container handling the axis values.
+  template <typename Container>
+  std::vector<int64_t> find_indexes(double coordinate, uint32_t size,
+                                    Boundary boundary = kUndef) const;
+
+  /// Create a table of "size" indices located on either side of the required
+  /// position, the search starting from the cell found by the previous search
+  /// performed with the cursor provided.
+  ///
+  /// @see find_indexes(double, uint32_t, Boundary) const
+  /// @see find_indexes(double, axis::Cursor&) const
+  /// @tparam Container Type of the container handling the axis values.
+  template <typename Container>
+  std::vector<int64_t> find_indexes(double coordinate, uint32_t size,
+                                    Boundary boundary,
+                                    axis::Cursor& cursor) const;
+
+  /// Writes the "size" indices located on either side of the required
+  /// position into the buffer provided, the search starting from the cell
+  /// found by the previous search performed with the cursor provided. Unlike
+  /// the other overloads, this method does not allocate memory, the same
+  /// buffer being reused for successive positions.
+  ///
+  /// @param coordinate Position in this coordinate system
+  /// @param size Size of the half window to be built.
+  /// @param boundary How to handle boundaries (this parameter is not used if
+  /// the manipulated axis is a circle.)
+  /// @param cursor cursor updated with the result of the search
+  /// @param indexes Buffer of at least "2*size" elements receiving the indices
+  /// of the axis framing the value provided.
+  /// @return false if the value is located outside the axis definition
+  /// domain, the content of the buffer being then undefined.
+  /// @tparam Container Type of the container handling the axis values.
+  template <typename Container>
+  bool find_indexes(double coordinate, uint32_t size, Boundary boundary,
+                    axis::Cursor& cursor, int64_t* indexes) const;
+
+  /// Calls the function provided with the container handling the axis values,
+  /// cast to its actual type. The calls made by the function on this container
+  /// are thus resolved at compile time and can be inlined.
+  ///
+  /// @param function Generic function called with a constant reference to an
+  /// axis::container::Undefined, axis::container::Irregular or
+  /// axis::container::Regular instance.
+  /// @return the value returned by the function.
+  template <typename Function>
+  inline decltype(auto) visit(Function&& function) const {
+    switch (type_) {
+      case axis::container::kRegular:
+        return function(static_cast<const axis::container::Regular&>(*axis_));
+      case axis::container::kIrregular:
+        return function(
+            static_cast<const axis::container::Irregular&>(*axis_));
+      default:
+        return function(
+            static_cast<const axis::container::Undefined&>(*axis_));
+    }
+  }
+
   /// Get a string representing this instance.
   ///
   /// @return a string holding the converted instance.
@@ -259,6 +393,7 @@ class Axis {
       : is_circle_(is_circle),
         circle_(is_circle_ ? (is_radian ? math::pi<double>() : 360)
                            : std::numeric_limits<double>::quiet_NaN()),
+        type_(Axis::get_container_type(axis.get())),
         axis_(std::move(axis)) {}
 
  private:
@@ -268,6 +403,9 @@ class Axis {
   /// The value of the circle (360, π)
   double circle_{std::numeric_limits<double>::quiet_NaN()};
 
+  /// The type of the container handling the axis values.
+  axis::container::Type type_{axis::container::kUndefined};
+
   /// The object that handles access and searches for the values defined by the
   /// axis.
   std::shared_ptr<axis::container::Abstract> axis_{
@@ -289,12 +427,139 @@ class Axis {
     return coordinate;
   }
 
+  /// Finds the grid elements around a coordinate from the index of the cell
+  /// containing it.
+  template <typename Container>
+  std::optional<std::tuple<int64_t, int64_t>> frame_index(
+      const Container& container, double coordinate, int64_t i0) const;
+
+  /// Builds the table of "2*size" indices located on either side of the grid
+  /// elements framing a position. Returns false if the table cannot be built
+  /// with the boundary handling requested.
+  bool make_window(const std::tuple<int64_t, int64_t>& indexes, int64_t len,
+                   uint32_t size, Boundary boundary, int64_t* result) const;
+
+  /// Builds the table of indices located on either side of the grid elements
+  /// framing a position in a newly allocated vector.
+  std::vector<int64_t> make_window(
+      const std::optional<std::tuple<int64_t, int64_t>>& indexes, int64_t len,
+      uint32_t size, Boundary boundary) const;
+
+  /// Determines the type of container handling the axis values.
+  static axis::container::Type get_container_type(
+      const axis::container::Abstract* axis);
+
   /// Computes axis's properties
   void compute_properties(double epsilon);
 
+  /// Batch search of the indexes framing the positions provided, specialized
+  /// for regular axes whose size fits in a 32-bit integer: the search is
+  /// carried out by math::batch::find_indexes.
+  ///
+  /// @see find_indexes(const double*, size_t, int64_t*, int64_t*, double*,
+  /// bool*) const
+  void find_regular_indexes(const double* coordinates, size_t size,
+                            int64_t* i0, int64_t* i1, double* weight,
+                            bool* mask) const;
+
   /// Put longitude into the range [0, circle_] degrees.
   void normalize_longitude(std::vector<double>& points);  // NOLINT
 };
 
+template <typename Container>
+std::optional<std::tuple<int64_t, int64_t>> Axis::find_indexes(
+    double coordinate) const {
+  const auto& container = static_cast<const Container&>(*axis_);
+  coordinate = normalize_coordinate(coordinate, container.min_value());
+  return frame_index(container, coordinate,
+                     container.find_index(coordinate, false));
+}
+
+template <typename Container>
+std::optional<std::tuple<int64_t, int64_t>> Axis::find_indexes(
+    double coordinate, axis::Cursor& cursor) const {
+  const auto& container = static_cast<const Container&>(*axis_);
+  coordinate = normalize_coordinate(coordinate, container.min_value());
+  return frame_index(container, coordinate,
+                     container.find_index(coordinate, false, cursor));
+}
+
+template <typename Container>
+std::optional<std::tuple<int64_t, int64_t>> Axis::frame_index(
+    const Container& container, const double coordinate, int64_t i0) const {
+  auto length = container.size();
+
+  /// If the value is outside the circle, then the value is between the last and
+  /// first index.
+  if (i0 == -1) {
+    return is_circle_ ? std::make_tuple(static_cast<int64_t>(length - 1),
+                                        static_cast<int64_t>(0))
+                      : std::optional<std::tuple<int64_t, int64_t>>();
+  }
+
+  // Given the delta between the found coordinate and the given coordinate,
+  // chose the other index that frames the coordinate
+  auto delta = coordinate - container.coordinate_value(i0);
+  auto i1 = i0;
+  if (delta == 0) {
+    // The requested coordinate is located on an element of the axis.
+    i1 == length - 1 ? --i0 : ++i1;
+  } else {
+    if (delta < 0) {
+      // The found point is located after the coordinate provided.
+      container.is_ascending() ? --i0 : ++i0;
+      if (is_circle_) {
+        i0 = math::remainder(i0, length);
+      }
+    } else {
+      // The found point is located before the coordinate provided.
+      container.is_ascending() ? ++i1 : --i1;
+      if (is_circle_) {
+        i1 = math::remainder(i1, length);
+      }
+    }
+  }
+
+  if (i0 >= 0 && i0 < length && i1 >= 0 && i1 < length) {
+    return std::make_tuple(i0, i1);
+  }
+  return std::optional<std::tuple<int64_t, int64_t>>{};
+}
+
+template <typename Container>
+std::vector<int64_t> Axis::find_indexes(double coordinate, uint32_t size,
+                                        Boundary boundary) const {
+  if (size == 0) {
+    throw std::invalid_argument("The size must not be zero.");
+  }
+  return make_window(find_indexes<Container>(coordinate),
+                     static_cast<const Container&>(*axis_).size(), size,
+                     boundary);
+}
+
+template <typename Container>
+std::vector<int64_t> Axis::find_indexes(double coordinate, uint32_t size,
+                                        Boundary boundary,
+                                        axis::Cursor& cursor) const {
+  if (size == 0) {
+    throw std::invalid_argument("The size must not be zero.");
+  }
+  return make_window(find_indexes<Container>(coordinate, cursor),
+                     static_cast<const Container&>(*axis_).size(), size,
+                     boundary);
+}
+
+template <typename Container>
+bool Axis::find_indexes(double coordinate, uint32_t size, Boundary boundary,
+                        axis::Cursor& cursor, int64_t* indexes) const {
+  if (size == 0) {
+    throw std::invalid_argument("The size must not be zero.");
+  }
+  auto frame = find_indexes<Container>(coordinate, cursor);
+  return frame && make_window(*frame,
+                              static_cast<const Container&>(*axis_).size(),
+                              size, boundary, indexes);
+}
+
 }  // namespace detail
 }  // namespace pyinterp
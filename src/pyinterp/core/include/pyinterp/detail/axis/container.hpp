@@ -3,10 +3,12 @@
 // All rights reserved. Use of this source code is governed by a
 // BSD-style license that can be found in the LICENSE file.
 #pragma once
+#include "pyinterp/detail/axis/cursor.hpp"
 #include <algorithm>
 #include <cmath>
 #include <limits>
 #include <stdexcept>
+#include <tuple>
 #include <vector>
 
 namespace pyinterp {
@@ -14,6 +16,13 @@ namespace detail {
 namespace axis {
 namespace container {
 
+/// Type of container handling the values of an axis.
+enum Type : uint8_t {
+  kUndefined,  //!< Undefined axis
+  kIrregular,  //!< Irregularly spaced values
+  kRegular,    //!< Regularly spaced values
+};
+
 /// Abstraction of a container of values representing a mathematical axis.
 class Abstract {
  public:
@@ -91,6 +100,21 @@ class Abstract {
   /// system area.
   virtual int64_t find_index(double coordinate, bool bounded) const = 0;
 
+  /// Search for the index corresponding to the requested value, starting from
+  /// the cell found by the previous search performed with the cursor.
+  ///
+  /// @param coordinate position in this coordinate system
+  /// @param bounded see find_index(double, bool) const
+  /// @param cursor cursor updated with the index found
+  /// @return index of the requested value it or -1 if outside this coordinate
+  /// system area.
+  virtual int64_t find_index(double coordinate, bool bounded,
+                             Cursor& cursor) const {
+    auto index = find_index(coordinate, bounded);
+    cursor.index(index);
+    return index;
+  }
+
   /// compare two variables instances
   ///
   /// @param rhs A variable to compare
@@ -108,7 +132,7 @@ class Abstract {
 };
 
 /// Represents a container for an undefined axis
-class Undefined : public Abstract {
+class Undefined final : public Abstract {
  public:
   /// Default constructor
   Undefined() = default;
@@ -161,6 +185,8 @@ class Undefined : public Abstract {
   /// @copydoc Abstract::back() const
   inline double back() const noexcept override { return coordinate_value(0); }
 
+  using Abstract::find_index;
+
   /// @copydoc Abstract::find_index(double,bool) const
   inline int64_t find_index(double coordinate, bool bounded) const  /// NOLINT
       noexcept override {
@@ -174,13 +200,23 @@ class Undefined : public Abstract {
 };
 
 /// Represents a container for an irregularly spaced axis
-class Irregular : public Abstract {
+class Irregular final : public Abstract {
  public:
+  /// Default maximum number of buckets of the lookup table per axis value.
+  static constexpr size_t kDefaultBucketFactor = 4;
+
   /// Creation of a container representing an irregularly spaced coordinate
   /// system.
   ///
   /// @param points axis values
-  explicit Irregular(std::vector<double> points);
+  /// @param bucket_factor Maximum number of buckets, per axis value, of the
+  /// lookup table used to accelerate the searches. The table divides the axis
+  /// definition domain into buckets of constant width, no wider than the
+  /// smallest step of the axis if this maximum allows it, each bucket giving
+  /// the range of edges to be searched. If zero, no table is built and the
+  /// searches are performed by a binary search over all the edges.
+  explicit Irregular(std::vector<double> points,
+                     size_t bucket_factor = kDefaultBucketFactor);
 
   /// Destructor
   ~Irregular() override = default;
@@ -238,7 +274,105 @@ class Irregular : public Abstract {
   inline double back() const override { return points_.back(); }
 
   /// @copydoc Abstract::find_index(double,bool) const
-  int64_t find_index(double coordinate, bool bounded) const override;
+  inline int64_t find_index(double coordinate, bool bounded) const override {
+    int64_t low = 0;
+    int64_t high = size();
+
+    if (is_ascending_) {
+      if (coordinate < edges_.front()) {
+        return bounded ? 0 : -1;
+      }
+
+      if (coordinate > edges_.back()) {
+        return bounded ? high - 1 : -1;
+      }
+    } else {
+      if (coordinate < edges_.back()) {
+        return bounded ? high - 1 : -1;
+      }
+
+      if (coordinate > edges_.front()) {
+        return bounded ? 0 : -1;
+      }
+    }
+
+    if (!buckets_.empty()) {
+      std::tie(low, high) = bucket_bounds(coordinate);
+    }
+    return search(coordinate, low, high);
+  }
+
+  /// @copydoc Abstract::find_index(double,bool,Cursor&) const
+  ///
+  /// If the cursor holds the result of a previous search, the cell found is
+  /// tested first, then the search gallops outwards from it: the cost of the
+  /// search only depends on the distance between the two cells found.
+  inline int64_t find_index(double coordinate, bool bounded,
+                            Cursor& cursor) const override {
+    auto n = size();
+    auto hint = cursor.index();
+
+    auto inside = is_ascending_ ? coordinate >= edges_.front() &&
+                                      coordinate <= edges_.back()
+                                : coordinate <= edges_.front() &&
+                                      coordinate >= edges_.back();
+
+    if (hint < 0 || hint >= n || !inside) {
+      hint = find_index(coordinate, bounded);
+      cursor.index(hint);
+      return hint;
+    }
+
+    // Tests if the cell "ix" is located before the coordinate, i.e. if the
+    // cell containing the coordinate is located at or after "ix".
+    auto before = [&](const int64_t ix) -> bool {
+      return is_ascending_ ? edges_[ix] <= coordinate
+                           : edges_[ix] >= coordinate;
+    };
+
+    int64_t low;
+    int64_t high;
+    int64_t step = 1;
+    if (before(hint)) {
+      if (hint + 1 == n || !before(hint + 1)) {
+        return hint;
+      }
+      low = hint + 1;
+      high = low + step;
+      while (high < n && before(high)) {
+        low = high;
+        step <<= 1U;
+        high = low + step;
+      }
+      high = std::min(high, n);
+    } else {
+      high = hint;
+      low = high - step;
+      while (low > 0 && !before(low)) {
+        high = low;
+        step <<= 1U;
+        low = high - step;
+      }
+      low = std::max(low, int64_t(0));
+    }
+    hint = search(coordinate, low, high);
+    cursor.index(hint);
+    return hint;
+  }
+
+  /// Gets the number of buckets of the lookup table used to accelerate the
+  /// searches.
+  inline size_t bucket_count() const noexcept {
+    return buckets_.empty() ? 0 : buckets_.size() - 1;
+  }
+
+  /// Gets the memory used by the lookup table, in bytes.
+  inline size_t lookup_table_size() const noexcept {
+    return buckets_.capacity() * sizeof(int64_t);
+  }
+
+  /// Gets the maximum number of buckets, per axis value, of the lookup table.
+  inline size_t bucket_factor() const noexcept { return bucket_factor_; }
 
   /// @copydoc Abstract::operator==(const Abstract&) const
   bool operator==(const Abstract& rhs) const noexcept override {
@@ -253,12 +387,88 @@ class Irregular : public Abstract {
   std::vector<double> points_{};
   std::vector<double> edges_{};
 
+  /// Lookup table: the element "i" contains the index of the cell holding the
+  /// value bucket_min_ + i / bucket_scale_.
+  std::vector<int64_t> buckets_{};
+  size_t bucket_factor_{kDefaultBucketFactor};
+  double bucket_min_{};
+  double bucket_scale_{};
+
   /// Computes the edges, if the axis data are not spaced regularly.
   void make_edges();
+
+  /// Computes the lookup table.
+  void make_buckets();
+
+  /// Binary search of the cell containing the coordinate provided between the
+  /// cells "low" (inclusive) and "high" (exclusive).
+  inline int64_t search(const double coordinate, int64_t low,
+                        int64_t high) const {
+    int64_t mid = 0;
+
+    if (is_ascending_) {
+      while (high > low + 1) {
+        mid = (low + high) >> 1;  // NOLINT (low and high are strictly positive)
+        auto value = edges_[mid];
+
+        if (value == coordinate) {
+          return mid;
+        }
+        value < coordinate ? low = mid : high = mid;
+      }
+      return low;
+    }
+
+    while (high > low + 1) {
+      mid = (low + high) >> 1;  // NOLINT (low and high are strictly positive)
+      auto value = edges_[mid];
+
+      if (value == coordinate) {
+        return mid;
+      }
+      value < coordinate ? high = mid : low = mid;
+    }
+    return low;
+  }
+
+  /// Gets the range of cells to be searched for the coordinate provided, from
+  /// the lookup table.
+  inline std::tuple<int64_t, int64_t> bucket_bounds(
+      const double coordinate) const {
+    auto last = static_cast<int64_t>(buckets_.size()) - 2;
+    auto position = (coordinate - bucket_min_) * bucket_scale_;
+    auto ix = position >= 0 ? (position < last ? static_cast<int64_t>(position)
+                                               : last)
+                            : 0;
+    auto n = size();
+
+    // The bounds read from the table are adjusted to take into account the
+    // rounding errors made on the position of the buckets.
+    if (is_ascending_) {
+      auto low = buckets_[ix];
+      auto high = buckets_[ix + 1] + 1;
+      while (low > 0 && edges_[low] > coordinate) {
+        --low;
+      }
+      while (high < n && edges_[high] <= coordinate) {
+        ++high;
+      }
+      return std::make_tuple(low, high);
+    }
+    auto low = buckets_[ix + 1];
+    auto high = buckets_[ix] + 1;
+    while (low > 0 && edges_[low] < coordinate) {
+      --low;
+    }
+    while (high < n && edges_[high] >= coordinate) {
+      ++high;
+    }
+    return std::make_tuple(low, high);
+  }
 };
 
 /// Represents a container for an regularly spaced axis
-class Regular : public Abstract {
+class Regular final : public Abstract {
  public:
   /// Create a container from evenly spaced numbers over a specified
   /// interval.
@@ -312,8 +522,11 @@ class Regular : public Abstract {
     return start_ + index * step_;
   }
 
+  using Abstract::find_index;
+
   /// @copydoc Abstract::find_index(double,bool) const
-  int64_t find_index(double coordinate, bool bounded) const noexcept override {
+  inline int64_t find_index(double coordinate, bool bounded) const
+      noexcept override {
     auto index =
         static_cast<int64_t>(std::round((coordinate - start_) / step_));
 
@@ -326,6 +539,15 @@ class Regular : public Abstract {
     return index;
   }
 
+  /// @copydoc Abstract::find_index(double,bool,Cursor&) const
+  ///
+  /// The index is calculated directly from the coordinate: the cursor is
+  /// neither read nor updated.
+  inline int64_t find_index(double coordinate, bool bounded,
+                            Cursor& /*cursor*/) const noexcept override {
+    return Regular::find_index(coordinate, bounded);
+  }
+
   /// @copydoc Abstract::min_value() const
   inline double min_value() const noexcept override {
     return coordinate_value(is_ascending_ ? 0 : size_ - 1);
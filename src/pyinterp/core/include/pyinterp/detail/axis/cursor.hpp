@@ -0,0 +1,38 @@
+// Copyright (c) 2019 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <cstdint>
+
+namespace pyinterp {
+namespace detail {
+namespace axis {
+
+/// Kind of iterator for axis lookups. It caches the index of the cell found by
+/// the previous search. When the subsequent coordinate falls in the same or in
+/// a neighboring cell, the search starts from this cell instead of scanning
+/// the whole axis. A cursor must be used with only one axis and by only one
+/// thread.
+class Cursor {
+ public:
+  /// Default constructor
+  Cursor() = default;
+
+  /// Gets the index of the cell found by the last search or -1 if there is no
+  /// such cell.
+  inline int64_t index() const noexcept { return index_; }
+
+  /// Sets the index of the cell found by the last search.
+  inline void index(const int64_t value) noexcept { index_ = value; }
+
+  /// Forgets the last search performed.
+  inline void reset() noexcept { index_ = -1; }
+
+ private:
+  int64_t index_{-1};
+};
+
+}  // namespace axis
+}  // namespace detail
+}  // namespace pyinterp
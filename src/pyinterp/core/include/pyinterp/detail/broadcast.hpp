@@ -3,9 +3,12 @@
 // All rights reserved. Use of this source code is governed by a
 // BSD-style license that can be found in the LICENSE file.
 #pragma once
+#include <cstdint>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 namespace pyinterp {
 namespace detail {
@@ -28,7 +31,7 @@ std::string ndarray_shape(const Array& array) {
   std::stringstream ss;
   ss << "(";
   for (auto ix = 0; ix < array.ndim(); ++ix) {
-    ss << array.shape(ix) << ", ";
+    ss << (ix == 0 ? "" : ", ") << array.shape(ix);
   }
   ss << ")";
   return ss.str();
@@ -183,5 +186,155 @@ void check_ndarray_shape(const std::string& name1, const Array1& a1,
   check_ndarray_shape(name1, a1, args...);
 }
 
+/// Broadcasts a shape with the shape of a tensor, according to the numpy
+/// rules.
+///
+/// @param shape shape to update
+/// @param a tensor to process
+/// @return false if the shapes cannot be broadcast together
+template <typename Array>
+bool broadcast_to(std::vector<int64_t>& shape, const Array& a) {
+  auto ndim = static_cast<size_t>(a.ndim());
+  if (ndim > shape.size()) {
+    shape.insert(shape.begin(), ndim - shape.size(), 1);
+  }
+  auto offset = shape.size() - ndim;
+  for (size_t ix = 0; ix < ndim; ++ix) {
+    auto& item = shape[offset + ix];
+    auto extent = static_cast<int64_t>(a.shape(ix));
+    if (item == 1) {
+      item = extent;
+    } else if (extent != 1 && extent != item) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// Broadcast shape calculation function pattern.
+template <typename Array>
+void broadcast_shape(std::vector<int64_t>& /*shape*/,
+                     const std::string& /*name*/, const Array& /*a*/) {}
+
+/// Broadcast shape calculation function pattern.
+///
+/// @throw std::invalid_argument if the tensors cannot be broadcast together
+template <typename Array1, typename Array2, typename... Args>
+void broadcast_shape(std::vector<int64_t>& shape, const std::string& name1,
+                     const Array1& a1, const std::string& name2,
+                     const Array2& a2, const Args&... args) {
+  static_assert(sizeof...(Args) % 2 == 0,
+                "an even number of parameters is expected");
+  if (!broadcast_to(shape, a2)) {
+    throw std::invalid_argument(name1 + ", " + name2 +
+                                " could not be broadcast together with shape " +
+                                ndarray_shape(a1) + "  " + ndarray_shape(a2));
+  }
+  broadcast_shape(shape, name1, a1, args...);
+}
+
+/// Calculates the shape of the tensors broadcast together, according to the
+/// numpy rules.
+///
+/// @param name1 name of the variable containing the first array
+/// @param a1 first array
+/// @param args names and arrays of the other tensors
+/// @return the shape of the tensors broadcast together
+/// @throw std::invalid_argument if the tensors cannot be broadcast together
+template <typename Array, typename... Args>
+std::vector<int64_t> broadcast_shape(const std::string& name1, const Array& a1,
+                                     const Args&... args) {
+  auto shape = std::vector<int64_t>();
+  broadcast_to(shape, a1);
+  broadcast_shape(shape, name1, a1, args...);
+  return shape;
+}
+
+/// Checks that a tensor has the expected shape.
+///
+/// @param name name of the variable containing the array
+/// @param a array to check
+/// @param shape expected shape
+/// @throw std::invalid_argument if the shape of the array is different
+template <typename Array>
+void check_ndarray_shape(const std::string& name, const Array& a,
+                         const std::vector<int64_t>& shape) {
+  auto match = static_cast<size_t>(a.ndim()) == shape.size();
+  for (size_t ix = 0; match && ix < shape.size(); ++ix) {
+    match = static_cast<int64_t>(a.shape(ix)) == shape[ix];
+  }
+  if (!match) {
+    std::stringstream ss;
+    ss << "(";
+    for (auto item : shape) {
+      ss << item << ", ";
+    }
+    ss << ")";
+    throw std::invalid_argument(name + " must be an array of shape " +
+                                ss.str() + ": " + ndarray_shape(a));
+  }
+}
+
+/// View of a tensor broadcast to a shape, whose elements are accessed by
+/// their index in the broadcast tensor flattened in C order. The tensor can
+/// have any memory layout: it is not copied.
+///
+/// @tparam T Type of the elements, const qualified for a read-only view.
+template <typename T>
+class FlatView {
+ public:
+  /// Default constructor
+  ///
+  /// @param data address of the first element of the tensor
+  /// @param a tensor to view, providing its shape and its strides (in bytes)
+  /// @param shape shape to which the tensor is broadcast
+  template <typename Array>
+  FlatView(T* data, const Array& a, const std::vector<int64_t>& shape)
+      : data_(reinterpret_cast<Byte*>(data)) {
+    auto offset = shape.size() - static_cast<size_t>(a.ndim());
+    for (size_t ix = 0; ix < shape.size(); ++ix) {
+      // The dimensions of size 1 do not contribute to the offsets.
+      if (shape[ix] == 1) {
+        continue;
+      }
+      auto dim = static_cast<int64_t>(ix) - static_cast<int64_t>(offset);
+      shape_.push_back(shape[ix]);
+      strides_.push_back(dim < 0 || a.shape(dim) == 1
+                             ? 0
+                             : static_cast<int64_t>(a.strides(dim)));
+    }
+    // If the elements are equally spaced, the offset of an element is
+    // proportional to its index.
+    step_ = strides_.empty() ? 0 : strides_.back();
+    for (size_t ix = 1; ix < strides_.size() && linear_; ++ix) {
+      linear_ = strides_[ix - 1] == strides_[ix] * shape_[ix];
+    }
+  }
+
+  /// Gets the element at the given index of the flattened tensor.
+  inline T& operator()(const int64_t index) const noexcept {
+    if (linear_) {
+      return *reinterpret_cast<T*>(data_ + index * step_);
+    }
+    auto offset = int64_t(0);
+    auto remainder = index;
+    for (auto ix = shape_.size() - 1; ix > 0; --ix) {
+      auto quotient = remainder / shape_[ix];
+      offset += (remainder - quotient * shape_[ix]) * strides_[ix];
+      remainder = quotient;
+    }
+    return *reinterpret_cast<T*>(data_ + offset + remainder * strides_[0]);
+  }
+
+ private:
+  using Byte = std::conditional_t<std::is_const_v<T>, const char, char>;
+
+  Byte* data_;
+  std::vector<int64_t> shape_{};
+  std::vector<int64_t> strides_{};
+  int64_t step_{0};
+  bool linear_{true};
+};
+
 }  // namespace detail
 }  // namespace pyinterp
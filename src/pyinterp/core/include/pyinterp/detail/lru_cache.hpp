@@ -0,0 +1,125 @@
+// Copyright (c) 2019 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+namespace pyinterp {
+namespace detail {
+
+/// Statistics of the accesses to a cache
+struct CacheStatistics {
+  /// Number of items found in the cache
+  size_t hits{0};
+  /// Number of items searched but not found in the cache
+  size_t misses{0};
+  /// Number of items discarded to respect the capacity of the cache
+  size_t evictions{0};
+};
+
+/// Cache of bounded capacity discarding the least recently used items.
+///
+/// The items are shared: an item discarded by the cache remains valid as long
+/// as it is used. The cache can be accessed by several threads.
+///
+/// @tparam Key Type of the keys identifying the items
+/// @tparam Value Type of the items stored
+template <typename Key, typename Value>
+class LRUCache {
+ public:
+  /// Default constructor
+  ///
+  /// @param capacity Maximum number of items stored
+  /// @throw std::invalid_argument if the capacity is zero
+  explicit LRUCache(const size_t capacity) : capacity_(capacity) {
+    if (capacity == 0) {
+      throw std::invalid_argument("the capacity of a cache must be positive");
+    }
+  }
+
+  /// Gets an item, which becomes the most recently used one.
+  ///
+  /// @return The item, or nullptr if it is not in the cache
+  std::shared_ptr<const Value> get(const Key& key) {
+    auto lock = std::unique_lock<std::mutex>(mutex_);
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+      ++statistics_.misses;
+      return nullptr;
+    }
+    ++statistics_.hits;
+    items_.splice(items_.begin(), items_, it->second);
+    return it->second->second;
+  }
+
+  /// Stores an item, which becomes the most recently used one. The least
+  /// recently used items are discarded if the capacity is exceeded.
+  void put(const Key& key, std::shared_ptr<const Value> value) {
+    auto lock = std::unique_lock<std::mutex>(mutex_);
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+      it->second->second = std::move(value);
+      items_.splice(items_.begin(), items_, it->second);
+      return;
+    }
+    items_.emplace_front(key, std::move(value));
+    index_.emplace(key, items_.begin());
+    while (items_.size() > capacity_) {
+      index_.erase(items_.back().first);
+      items_.pop_back();
+      ++statistics_.evictions;
+    }
+  }
+
+  /// Discards all the items
+  void clear() {
+    auto lock = std::unique_lock<std::mutex>(mutex_);
+    index_.clear();
+    items_.clear();
+  }
+
+  /// Gets the number of items stored
+  size_t size() const {
+    auto lock = std::unique_lock<std::mutex>(mutex_);
+    return items_.size();
+  }
+
+  /// Gets the maximum number of items stored
+  inline size_t capacity() const noexcept { return capacity_; }
+
+  /// Gets the statistics of the accesses to the cache
+  CacheStatistics statistics() const {
+    auto lock = std::unique_lock<std::mutex>(mutex_);
+    return statistics_;
+  }
+
+  /// Resets the statistics of the accesses to the cache
+  void reset_statistics() {
+    auto lock = std::unique_lock<std::mutex>(mutex_);
+    statistics_ = CacheStatistics();
+  }
+
+ private:
+  using Item = std::pair<Key, std::shared_ptr<const Value>>;
+
+  /// Maximum number of items stored
+  size_t capacity_;
+  /// Items, from the most recently used to the least recently used
+  std::list<Item> items_;
+  /// Position of the items in the list, by key
+  std::unordered_map<Key, typename std::list<Item>::iterator> index_;
+  /// Statistics of the accesses
+  CacheStatistics statistics_;
+  /// Protects the accesses to the cache
+  mutable std::mutex mutex_;
+};
+
+}  // namespace detail
+}  // namespace pyinterp
@@ -4,6 +4,7 @@
 // BSD-style license that can be found in the LICENSE file.
 #pragma once
 #include <cmath>
+#include <limits>
 #include <tuple>
 
 namespace pyinterp {
@@ -224,6 +225,28 @@ struct Fill<T, std::enable_if_t<std::is_integral<T>::value>> {
   }
 };
 
+/// Decoding of packed integers: the integer q represents the value
+/// q * scale_factor + add_offset, or an undefined value if it is equal to
+/// the fill value.
+struct Packing {
+  /// Factor applied to the integers
+  double scale_factor{1};
+  /// Offset added to the integers multiplied by the scale factor
+  double add_offset{0};
+  /// Integer representing the undefined values, NaN if all the integers
+  /// represent a value.
+  double fill_value{std::numeric_limits<double>::quiet_NaN()};
+
+  /// Decodes a packed integer, NaN being returned for the fill value.
+  template <typename T, typename U = double>
+  inline constexpr U unpack(const T& item) const noexcept {
+    auto value = static_cast<double>(item);
+    return value == fill_value
+               ? std::numeric_limits<U>::quiet_NaN()
+               : static_cast<U>(value * scale_factor + add_offset);
+  }
+};
+
 }  // namespace math
 }  // namespace detail
 }  // namespace pyinterp
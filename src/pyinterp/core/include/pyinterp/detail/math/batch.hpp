@@ -0,0 +1,429 @@
+// Copyright (c) 2019 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include "pyinterp/detail/math.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace pyinterp {
+namespace detail {
+namespace math {
+namespace batch {
+
+/// Number of positions processed at once by the batch kernels.
+constexpr size_t kSize = 256;
+
+/// Definition of a regular axis used by the batch kernels.
+struct Regular {
+  /// Value of the first element of the axis
+  double start;
+  /// Step between two successive elements
+  double step;
+  /// Index of the last element of the axis, which must be greater than 0.
+  double last;
+};
+
+/// Bilinear interpolation of a batch of positions located on a grid whose
+/// axes are regular.
+///
+/// The index of the grid elements framing the positions and the weights of
+/// the interpolation are calculated for several positions at once, the
+/// values of the grid being read with gather instructions. On x86-64 Linux,
+/// the kernels are compiled for several instruction sets (AVX-512, AVX2 and
+/// the baseline of the target), the version used being selected at load time
+/// according to the CPU.
+///
+/// The positions must be normalized with respect to the axes. The positions
+/// located outside the grid, including those located between the last and
+/// the first element of an axis representing a circle, are set to NaN: they
+/// must be processed by the scalar interpolation.
+///
+/// @param grid Address of the first value of the grid
+/// @param strides Number of bytes separating two successive values along
+/// each dimension of the grid.
+/// @param x_axis Definition of the X-Axis
+/// @param y_axis Definition of the Y-Axis
+/// @param x X-coordinates of the positions
+/// @param y Y-coordinates of the positions
+/// @param size Number of positions to process
+/// @param result Interpolated values
+void bilinear(const double* grid, const std::array<int64_t, 2>& strides,
+              const Regular& x_axis, const Regular& y_axis, const double* x,
+              const double* y, size_t size, double* result);
+
+/// @copydoc bilinear(const double*, const std::array<int64_t, 2>&,
+/// const Regular&, const Regular&, const double*, const double*, size_t,
+/// double*)
+void bilinear(const float* grid, const std::array<int64_t, 2>& strides,
+              const Regular& x_axis, const Regular& y_axis, const double* x,
+              const double* y, size_t size, double* result);
+
+/// Bilinear interpolation of a batch of positions located on a grid whose
+/// axes are regular, and partial derivatives of the interpolated surface
+/// with respect to the coordinates.
+///
+/// @param result Interpolated values, followed by the derivatives with
+/// respect to x and by the derivatives with respect to y: the value, dx and
+/// dy of the position i are result[i], result[size + i] and
+/// result[2 * size + i]. The derivatives of the positions whose value is
+/// NaN are undefined.
+/// @see bilinear(const double*, const std::array<int64_t, 2>&,
+/// const Regular&, const Regular&, const double*, const double*, size_t,
+/// double*)
+void bilinear_gradient(const double* grid,
+                       const std::array<int64_t, 2>& strides,
+                       const Regular& x_axis, const Regular& y_axis,
+                       const double* x, const double* y, size_t size,
+                       double* result);
+
+/// @copydoc bilinear_gradient(const double*, const std::array<int64_t, 2>&,
+/// const Regular&, const Regular&, const double*, const double*, size_t,
+/// double*)
+void bilinear_gradient(const float* grid,
+                       const std::array<int64_t, 2>& strides,
+                       const Regular& x_axis, const Regular& y_axis,
+                       const double* x, const double* y, size_t size,
+                       double* result);
+
+/// Trilinear interpolation of a batch of positions located on a grid whose
+/// axes are regular: bilinear interpolation on the planes z0 and z1, then
+/// linear interpolation along the Z-Axis.
+///
+/// @see bilinear(const double*, const std::array<int64_t, 2>&,
+/// const Regular&, const Regular&, const double*, const double*, size_t,
+/// double*)
+void trilinear(const double* grid, const std::array<int64_t, 3>& strides,
+               const Regular& x_axis, const Regular& y_axis,
+               const Regular& z_axis, const double* x, const double* y,
+               const double* z, size_t size, double* result);
+
+/// @copydoc trilinear(const double*, const std::array<int64_t, 3>&,
+/// const Regular&, const Regular&, const Regular&, const double*,
+/// const double*, const double*, size_t, double*)
+void trilinear(const float* grid, const std::array<int64_t, 3>& strides,
+               const Regular& x_axis, const Regular& y_axis,
+               const Regular& z_axis, const double* x, const double* y,
+               const double* z, size_t size, double* result);
+
+/// Bilinear interpolation of a batch of positions on several fields defined
+/// on the same grid. The grid elements framing the positions and the weights
+/// of the interpolation are calculated once for all the fields.
+///
+/// @param grids Address of the first value of each field
+/// @param strides Strides of each field, in bytes
+/// @param fields Number of fields
+/// @param size Number of positions to process, at most kSize
+/// @param result Interpolated values, stored field after field: the value of
+/// the field f at the position i is result[f * size + i].
+/// @see bilinear(const double*, const std::array<int64_t, 2>&,
+/// const Regular&, const Regular&, const double*, const double*, size_t,
+/// double*)
+void bilinear(const double* const* grids,
+              const std::array<int64_t, 2>* strides, size_t fields,
+              const Regular& x_axis, const Regular& y_axis, const double* x,
+              const double* y, size_t size, double* result);
+
+/// @copydoc bilinear(const double* const*, const std::array<int64_t, 2>*,
+/// size_t, const Regular&, const Regular&, const double*, const double*,
+/// size_t, double*)
+void bilinear(const float* const* grids, const std::array<int64_t, 2>* strides,
+              size_t fields, const Regular& x_axis, const Regular& y_axis,
+              const double* x, const double* y, size_t size, double* result);
+
+/// Trilinear interpolation of a batch of positions on several fields defined
+/// on the same grid.
+///
+/// @see bilinear(const double* const*, const std::array<int64_t, 2>*,
+/// size_t, const Regular&, const Regular&, const double*, const double*,
+/// size_t, double*)
+void trilinear(const double* const* grids,
+               const std::array<int64_t, 3>* strides, size_t fields,
+               const Regular& x_axis, const Regular& y_axis,
+               const Regular& z_axis, const double* x, const double* y,
+               const double* z, size_t size, double* result);
+
+/// @copydoc trilinear(const double* const*, const std::array<int64_t, 3>*,
+/// size_t, const Regular&, const Regular&, const Regular&, const double*,
+/// const double*, const double*, size_t, double*)
+void trilinear(const float* const* grids,
+               const std::array<int64_t, 3>* strides, size_t fields,
+               const Regular& x_axis, const Regular& y_axis,
+               const Regular& z_axis, const double* x, const double* y,
+               const double* z, size_t size, double* result);
+
+/// Bilinear interpolation, in single precision, of a batch of positions
+/// located on a grid whose axes are regular: the coordinates, the weights
+/// and the interpolated values are of type float.
+///
+/// @see bilinear(const double*, const std::array<int64_t, 2>&,
+/// const Regular&, const Regular&, const double*, const double*, size_t,
+/// double*)
+void bilinear(const float* grid, const std::array<int64_t, 2>& strides,
+              const Regular& x_axis, const Regular& y_axis, const float* x,
+              const float* y, size_t size, float* result);
+
+/// Bilinear interpolation, in single precision, of a batch of positions and
+/// partial derivatives of the interpolated surface.
+///
+/// @see bilinear_gradient(const double*, const std::array<int64_t, 2>&,
+/// const Regular&, const Regular&, const double*, const double*, size_t,
+/// double*)
+void bilinear_gradient(const float* grid,
+                       const std::array<int64_t, 2>& strides,
+                       const Regular& x_axis, const Regular& y_axis,
+                       const float* x, const float* y, size_t size,
+                       float* result);
+
+/// Trilinear interpolation, in single precision, of a batch of positions.
+///
+/// @see trilinear(const double*, const std::array<int64_t, 3>&,
+/// const Regular&, const Regular&, const Regular&, const double*,
+/// const double*, const double*, size_t, double*)
+void trilinear(const float* grid, const std::array<int64_t, 3>& strides,
+               const Regular& x_axis, const Regular& y_axis,
+               const Regular& z_axis, const float* x, const float* y,
+               const float* z, size_t size, float* result);
+
+/// Bilinear interpolation, in single precision, of a batch of positions on
+/// several fields defined on the same grid.
+///
+/// @see bilinear(const double* const*, const std::array<int64_t, 2>*,
+/// size_t, const Regular&, const Regular&, const double*, const double*,
+/// size_t, double*)
+void bilinear(const float* const* grids, const std::array<int64_t, 2>* strides,
+              size_t fields, const Regular& x_axis, const Regular& y_axis,
+              const float* x, const float* y, size_t size, float* result);
+
+/// Trilinear interpolation, in single precision, of a batch of positions on
+/// several fields defined on the same grid.
+///
+/// @see trilinear(const double* const*, const std::array<int64_t, 3>*,
+/// size_t, const Regular&, const Regular&, const Regular&, const double*,
+/// const double*, const double*, size_t, double*)
+void trilinear(const float* const* grids,
+               const std::array<int64_t, 3>* strides, size_t fields,
+               const Regular& x_axis, const Regular& y_axis,
+               const Regular& z_axis, const float* x, const float* y,
+               const float* z, size_t size, float* result);
+
+/// Bilinear interpolation of a batch of positions located on a grid of packed
+/// integers whose axes are regular. The values of the grid are decoded when
+/// they are read, the fill value being decoded as NaN.
+///
+/// @param packing Decoding of the values of the grid
+/// @see bilinear(const double*, const std::array<int64_t, 2>&,
+/// const Regular&, const Regular&, const double*, const double*, size_t,
+/// double*)
+void bilinear(const int8_t* grid, const std::array<int64_t, 2>& strides,
+              const Packing& packing, const Regular& x_axis,
+              const Regular& y_axis, const double* x, const double* y,
+              size_t size, double* result);
+
+/// Bilinear interpolation of a batch of positions located on a grid of packed
+/// integers, and partial derivatives of the interpolated surface.
+///
+/// @see bilinear_gradient(const double*, const std::array<int64_t, 2>&,
+/// const Regular&, const Regular&, const double*, const double*, size_t,
+/// double*)
+void bilinear_gradient(const int8_t* grid,
+                       const std::array<int64_t, 2>& strides,
+                       const Packing& packing, const Regular& x_axis,
+                       const Regular& y_axis, const double* x,
+                       const double* y, size_t size, double* result);
+
+/// Trilinear interpolation of a batch of positions located on a grid of
+/// packed integers.
+///
+/// @see trilinear(const double*, const std::array<int64_t, 3>&,
+/// const Regular&, const Regular&, const Regular&, const double*,
+/// const double*, const double*, size_t, double*)
+void trilinear(const int8_t* grid, const std::array<int64_t, 3>& strides,
+               const Packing& packing, const Regular& x_axis,
+               const Regular& y_axis, const Regular& z_axis, const double* x,
+               const double* y, const double* z, size_t size, double* result);
+
+/// Bilinear interpolation of a batch of positions on several fields of
+/// packed integers defined on the same grid. The fields share the decoding
+/// of their values.
+///
+/// @see bilinear(const double* const*, const std::array<int64_t, 2>*,
+/// size_t, const Regular&, const Regular&, const double*, const double*,
+/// size_t, double*)
+void bilinear(const int8_t* const* grids,
+              const std::array<int64_t, 2>* strides, size_t fields,
+              const Packing& packing, const Regular& x_axis,
+              const Regular& y_axis, const double* x, const double* y,
+              size_t size, double* result);
+
+/// Trilinear interpolation of a batch of positions on several fields of
+/// packed integers defined on the same grid.
+///
+/// @see trilinear(const double* const*, const std::array<int64_t, 3>*,
+/// size_t, const Regular&, const Regular&, const Regular&, const double*,
+/// const double*, const double*, size_t, double*)
+void trilinear(const int8_t* const* grids,
+               const std::array<int64_t, 3>* strides, size_t fields,
+               const Packing& packing, const Regular& x_axis,
+               const Regular& y_axis, const Regular& z_axis, const double* x,
+               const double* y, const double* z, size_t size, double* result);
+
+/// @copydoc bilinear(const int8_t*, const std::array<int64_t, 2>&,
+/// const Packing&, const Regular&, const Regular&, const double*,
+/// const double*, size_t, double*)
+void bilinear(const uint8_t* grid, const std::array<int64_t, 2>& strides,
+              const Packing& packing, const Regular& x_axis,
+              const Regular& y_axis, const double* x, const double* y,
+              size_t size, double* result);
+
+/// @copydoc bilinear_gradient(const int8_t*, const std::array<int64_t, 2>&,
+/// const Packing&, const Regular&, const Regular&, const double*,
+/// const double*, size_t, double*)
+void bilinear_gradient(const uint8_t* grid,
+                       const std::array<int64_t, 2>& strides,
+                       const Packing& packing, const Regular& x_axis,
+                       const Regular& y_axis, const double* x,
+                       const double* y, size_t size, double* result);
+
+/// @copydoc trilinear(const int8_t*, const std::array<int64_t, 3>&,
+/// const Packing&, const Regular&, const Regular&, const Regular&,
+/// const double*, const double*, const double*, size_t, double*)
+void trilinear(const uint8_t* grid, const std::array<int64_t, 3>& strides,
+               const Packing& packing, const Regular& x_axis,
+               const Regular& y_axis, const Regular& z_axis, const double* x,
+               const double* y, const double* z, size_t size, double* result);
+
+/// @copydoc bilinear(const int8_t* const*, const std::array<int64_t, 2>*,
+/// size_t, const Packing&, const Regular&, const Regular&, const double*,
+/// const double*, size_t, double*)
+void bilinear(const uint8_t* const* grids,
+              const std::array<int64_t, 2>* strides, size_t fields,
+              const Packing& packing, const Regular& x_axis,
+              const Regular& y_axis, const double* x, const double* y,
+              size_t size, double* result);
+
+/// @copydoc trilinear(const int8_t* const*, const std::array<int64_t, 3>*,
+/// size_t, const Packing&, const Regular&, const Regular&, const Regular&,
+/// const double*, const double*, const double*, size_t, double*)
+void trilinear(const uint8_t* const* grids,
+               const std::array<int64_t, 3>* strides, size_t fields,
+               const Packing& packing, const Regular& x_axis,
+               const Regular& y_axis, const Regular& z_axis, const double* x,
+               const double* y, const double* z, size_t size, double* result);
+
+/// @copydoc bilinear(const int8_t*, const std::array<int64_t, 2>&,
+/// const Packing&, const Regular&, const Regular&, const double*,
+/// const double*, size_t, double*)
+void bilinear(const int16_t* grid, const std::array<int64_t, 2>& strides,
+              const Packing& packing, const Regular& x_axis,
+              const Regular& y_axis, const double* x, const double* y,
+              size_t size, double* result);
+
+/// @copydoc bilinear_gradient(const int8_t*, const std::array<int64_t, 2>&,
+/// const Packing&, const Regular&, const Regular&, const double*,
+/// const double*, size_t, double*)
+void bilinear_gradient(const int16_t* grid,
+                       const std::array<int64_t, 2>& strides,
+                       const Packing& packing, const Regular& x_axis,
+                       const Regular& y_axis, const double* x,
+                       const double* y, size_t size, double* result);
+
+/// @copydoc trilinear(const int8_t*, const std::array<int64_t, 3>&,
+/// const Packing&, const Regular&, const Regular&, const Regular&,
+/// const double*, const double*, const double*, size_t, double*)
+void trilinear(const int16_t* grid, const std::array<int64_t, 3>& strides,
+               const Packing& packing, const Regular& x_axis,
+               const Regular& y_axis, const Regular& z_axis, const double* x,
+               const double* y, const double* z, size_t size, double* result);
+
+/// @copydoc bilinear(const int8_t* const*, const std::array<int64_t, 2>*,
+/// size_t, const Packing&, const Regular&, const Regular&, const double*,
+/// const double*, size_t, double*)
+void bilinear(const int16_t* const* grids,
+              const std::array<int64_t, 2>* strides, size_t fields,
+              const Packing& packing, const Regular& x_axis,
+              const Regular& y_axis, const double* x, const double* y,
+              size_t size, double* result);
+
+/// @copydoc trilinear(const int8_t* const*, const std::array<int64_t, 3>*,
+/// size_t, const Packing&, const Regular&, const Regular&, const Regular&,
+/// const double*, const double*, const double*, size_t, double*)
+void trilinear(const int16_t* const* grids,
+               const std::array<int64_t, 3>* strides, size_t fields,
+               const Packing& packing, const Regular& x_axis,
+               const Regular& y_axis, const Regular& z_axis, const double* x,
+               const double* y, const double* z, size_t size, double* result);
+
+/// @copydoc bilinear(const int8_t*, const std::array<int64_t, 2>&,
+/// const Packing&, const Regular&, const Regular&, const double*,
+/// const double*, size_t, double*)
+void bilinear(const uint16_t* grid, const std::array<int64_t, 2>& strides,
+              const Packing& packing, const Regular& x_axis,
+              const Regular& y_axis, const double* x, const double* y,
+              size_t size, double* result);
+
+/// @copydoc bilinear_gradient(const int8_t*, const std::array<int64_t, 2>&,
+/// const Packing&, const Regular&, const Regular&, const double*,
+/// const double*, size_t, double*)
+void bilinear_gradient(const uint16_t* grid,
+                       const std::array<int64_t, 2>& strides,
+                       const Packing& packing, const Regular& x_axis,
+                       const Regular& y_axis, const double* x,
+                       const double* y, size_t size, double* result);
+
+/// @copydoc trilinear(const int8_t*, const std::array<int64_t, 3>&,
+/// const Packing&, const Regular&, const Regular&, const Regular&,
+/// const double*, const double*, const double*, size_t, double*)
+void trilinear(const uint16_t* grid, const std::array<int64_t, 3>& strides,
+               const Packing& packing, const Regular& x_axis,
+               const Regular& y_axis, const Regular& z_axis, const double* x,
+               const double* y, const double* z, size_t size, double* result);
+
+/// @copydoc bilinear(const int8_t* const*, const std::array<int64_t, 2>*,
+/// size_t, const Packing&, const Regular&, const Regular&, const double*,
+/// const double*, size_t, double*)
+void bilinear(const uint16_t* const* grids,
+              const std::array<int64_t, 2>* strides, size_t fields,
+              const Packing& packing, const Regular& x_axis,
+              const Regular& y_axis, const double* x, const double* y,
+              size_t size, double* result);
+
+/// @copydoc trilinear(const int8_t* const*, const std::array<int64_t, 3>*,
+/// size_t, const Packing&, const Regular&, const Regular&, const Regular&,
+/// const double*, const double*, const double*, size_t, double*)
+void trilinear(const uint16_t* const* grids,
+               const std::array<int64_t, 3>* strides, size_t fields,
+               const Packing& packing, const Regular& x_axis,
+               const Regular& y_axis, const Regular& z_axis, const double* x,
+               const double* y, const double* z, size_t size, double* result);
+
+/// Search of the indexes of the elements of a regular axis framing a batch
+/// of positions, and of the weights of the interpolation between them.
+///
+/// The search carried out is the one of Axis::find_indexes(double): the
+/// positions must be normalized with respect to the axis if it represents an
+/// angle. The positions that cannot be framed get the indexes -1, a NaN
+/// weight and a true mask.
+///
+/// @param start Value of the first element of the axis
+/// @param step Step between two successive elements
+/// @param length Number of elements of the axis
+/// @param is_circle True if the axis represents a circle
+/// @param circle Value of a circle if the axis represents an angle, 0
+/// otherwise
+/// @param coordinates Positions to search
+/// @param size Number of positions
+/// @param i0 Indexes of the first element framing the positions
+/// @param i1 Indexes of the second element framing the positions
+/// @param weight Weights of the interpolation between the two elements
+/// @param mask True for the positions that cannot be framed
+void find_indexes(double start, double step, int32_t length, bool is_circle,
+                  double circle, const double* coordinates, size_t size,
+                  int64_t* i0, int64_t* i1, double* weight, bool* mask);
+
+}  // namespace batch
+}  // namespace math
+}  // namespace detail
+}  // namespace pyinterp
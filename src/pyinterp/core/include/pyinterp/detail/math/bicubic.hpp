@@ -6,6 +6,7 @@
 #include "pyinterp/detail/gsl/interpolate1d.hpp"
 #include "pyinterp/detail/math.hpp"
 #include <Eigen/Core>
+#include <tuple>
 
 namespace pyinterp {
 namespace detail {
@@ -157,6 +158,30 @@ class Bicubic {
                     std::move(acc));
   }
 
+  /// Return the interpolated value for a given point (x, y) and the partial
+  /// derivatives of the interpolated surface with respect to x and y.
+  ///
+  /// The splines fitted along the Y-Axis on the rows of the frame provide
+  /// both the values and the derivatives along Y used by the splines fitted
+  /// along the X-Axis: the frame is processed once.
+  std::tuple<double, double, double> gradient(
+      const double x, const double y, const XArray &xr,
+      gsl::Accelerator acc = gsl::Accelerator()) const {
+    Eigen::VectorXd fy(xr.x().size());
+    Eigen::VectorXd dfy(xr.x().size());
+
+    for (auto ix = 0; ix < xr.x().size(); ++ix) {
+      Eigen::VectorXd row = xr.q().row(ix);
+      auto interpolator = gsl::Interpolate1D(type_, xr.y(), row, acc);
+      fy(ix) = interpolator.interpolate(y);
+      dfy(ix) = interpolator.derivative(y);
+    }
+    auto fx = gsl::Interpolate1D(type_, xr.x(), fy, acc);
+    return std::make_tuple(fx.interpolate(x), fx.derivative(x),
+                           gsl::Interpolate1D(type_, xr.x(), dfy, acc)
+                               .interpolate(x));
+  }
+
  private:
   using InterpolateFunction =
       double (gsl::Interpolate1D::*)(const double) const;
@@ -4,7 +4,11 @@
 // BSD-style license that can be found in the LICENSE file.
 #pragma once
 #include <boost/geometry.hpp>
+#include <array>
 #include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
 #include <tuple>
 
 namespace pyinterp {
@@ -55,12 +59,69 @@ struct Bivariate {
                      const T& q11) const = 0;
 };
 
+/// Weighted average of the values of the corners of a cell, the undefined
+/// values being dropped and the weights of the others renormalized so that
+/// their sum is 1.
+///
+/// @param weights Weights of the corners
+/// @param values Values of the corners
+/// @param min_valid Minimum number of defined values
+/// @return The average, or NaN if less than min_valid values are defined or
+/// if the weights of the defined values are all zero.
+template <typename T, size_t N>
+inline T renormalize(const std::array<T, N>& weights,
+                     const std::array<T, N>& values, const int min_valid) {
+  auto sum = T(0);
+  auto norm = T(0);
+  auto valid = 0;
+  for (size_t ix = 0; ix < N; ++ix) {
+    if (!std::isnan(values[ix])) {
+      sum += weights[ix] * values[ix];
+      norm += weights[ix];
+      ++valid;
+    }
+  }
+  return valid < min_valid || norm == 0
+             ? std::numeric_limits<T>::quiet_NaN()
+             : sum / norm;
+}
+
 /// Bilinear interpolation
+///
+/// By default, the interpolated value is undefined if one of the corners of
+/// the cell is undefined. If a minimum number of valid corners is given, the
+/// undefined corners are dropped and the weights of the others renormalized,
+/// which extends the interpolation up to the edge of a masked area (e.g. a
+/// coastline) instead of interpolating again the undefined values with
+/// another method. The cell has 4 corners, or 8 with the Z-Axis when this
+/// interpolator is used by the trivariate interpolation.
 template <template <class> class Point, typename T>
 struct Bilinear : public Bivariate<Point, T> {
-  /// Default constructor
+  /// Number of corners of a cell
+  static constexpr int kCorners =
+      1 << boost::geometry::dimension<Point<T>>::value;
+
+  /// Default constructor (all corners must be defined)
   Bilinear() = default;
 
+  /// Explicit definition of the minimum number of valid corners
+  ///
+  /// @param min_valid Minimum number of corners whose value is defined, in
+  /// [1, kCorners].
+  explicit Bilinear(const int min_valid) : min_valid_(min_valid) {
+    if (min_valid < 1 || min_valid > kCorners) {
+      throw std::invalid_argument("min_valid must be in [1, " +
+                                  std::to_string(kCorners) +
+                                  "]: " + std::to_string(min_valid));
+    }
+  }
+
+  /// Returns the minimum number of valid corners
+  inline int min_valid() const noexcept { return min_valid_; }
+
+  /// Returns true if the undefined corners are dropped
+  inline bool masked() const noexcept { return min_valid_ != kCorners; }
+
   /// Default destructor
   virtual ~Bilinear() = default;
 
@@ -92,9 +153,38 @@ struct Bilinear : public Bivariate<Point, T> {
     auto dy = boost::geometry::get<1>(p1) - boost::geometry::get<1>(p0);
     auto t = (boost::geometry::get<0>(p) - boost::geometry::get<0>(p0)) / dx;
     auto u = (boost::geometry::get<1>(p) - boost::geometry::get<1>(p0)) / dy;
-    return (T(1) - t) * (T(1) - u) * q00 + t * (T(1) - u) * q10 +
-           (T(1) - t) * u * q01 + t * u * q11;
+    auto result = (T(1) - t) * (T(1) - u) * q00 + t * (T(1) - u) * q10 +
+                  (T(1) - t) * u * q01 + t * u * q11;
+    if (masked() && std::isnan(result)) {
+      return renormalize<T, 4>(
+          {(T(1) - t) * (T(1) - u), (T(1) - t) * u, t * (T(1) - u), t * u},
+          {q00, q01, q10, q11}, min_valid_);
+    }
+    return result;
+  }
+
+  /// Performs the bilinear interpolation and calculates the partial
+  /// derivatives of the interpolated surface, from the same weights.
+  ///
+  /// @return the interpolated value and its derivatives with respect to x
+  /// and y.
+  inline std::tuple<T, T, T> gradient(const Point<T>& p, const Point<T>& p0,
+                                      const Point<T>& p1, const T& q00,
+                                      const T& q01, const T& q10,
+                                      const T& q11) const {
+    auto dx = boost::geometry::get<0>(p1) - boost::geometry::get<0>(p0);
+    auto dy = boost::geometry::get<1>(p1) - boost::geometry::get<1>(p0);
+    auto t = (boost::geometry::get<0>(p) - boost::geometry::get<0>(p0)) / dx;
+    auto u = (boost::geometry::get<1>(p) - boost::geometry::get<1>(p0)) / dy;
+    return std::make_tuple(
+        (T(1) - t) * (T(1) - u) * q00 + t * (T(1) - u) * q10 +
+            (T(1) - t) * u * q01 + t * u * q11,
+        ((T(1) - u) * (q10 - q00) + u * (q11 - q01)) / dx,
+        ((T(1) - t) * (q01 - q00) + t * (q11 - q10)) / dy);
   }
+
+ private:
+  int min_valid_{kCorners};
 };
 
 /// Inverse distance weighting interpolation
@@ -248,6 +338,30 @@ struct Nearest : public Bivariate<Point, T> {
   }
 };
 
+/// Calls the function with the interpolator converted to its actual type if
+/// it's one of the interpolators implemented above: the calls to "evaluate"
+/// made by the function are then resolved at compile time and inlined, instead
+/// of going through the virtual table for each point. Other interpolators
+/// (e.g. defined in Python) are passed through their abstract interface.
+///
+/// @param interpolator Interpolator to convert
+/// @param function Function called with the converted interpolator
+template <template <class> class Point, typename T, typename Function>
+inline decltype(auto) visit(const Bivariate<Point, T>* interpolator,
+                            Function&& function) {
+  if (auto bilinear = dynamic_cast<const Bilinear<Point, T>*>(interpolator)) {
+    return function(*bilinear);
+  }
+  if (auto nearest = dynamic_cast<const Nearest<Point, T>*>(interpolator)) {
+    return function(*nearest);
+  }
+  if (auto idw = dynamic_cast<const InverseDistanceWeighting<Point, T>*>(
+          interpolator)) {
+    return function(*idw);
+  }
+  return function(*interpolator);
+}
+
 }  // namespace math
 }  // namespace detail
 }  // namespace pyinterp
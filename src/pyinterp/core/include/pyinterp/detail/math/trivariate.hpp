@@ -5,11 +5,42 @@
 #pragma once
 #include "pyinterp/detail/math/bivariate.hpp"
 #include "pyinterp/detail/math/linear.hpp"
+#include <array>
+#include <type_traits>
 
 namespace pyinterp {
 namespace detail {
 namespace math {
 
+/// Trilinear interpolation dropping the undefined corners of the cell, the
+/// weights of the defined corners being renormalized.
+///
+/// @param p Query point
+/// @param p0 Point of coordinate (x0, y0, z0)
+/// @param p1 Point of coordinate (x1, y1, z1)
+/// @param q Values of the corners, in the order (x0, y0), (x0, y1), (x1, y0),
+/// (x1, y1) on the plane z0, then on the plane z1.
+/// @param min_valid Minimum number of defined values
+/// @see renormalize
+template <template <class> class Point, typename T>
+inline T trilinear(const Point<T>& p, const Point<T>& p0, const Point<T>& p1,
+                   const std::array<T, 8>& q, const int min_valid) {
+  auto t = (boost::geometry::get<0>(p) - boost::geometry::get<0>(p0)) /
+           (boost::geometry::get<0>(p1) - boost::geometry::get<0>(p0));
+  auto u = (boost::geometry::get<1>(p) - boost::geometry::get<1>(p0)) /
+           (boost::geometry::get<1>(p1) - boost::geometry::get<1>(p0));
+  auto v = (boost::geometry::get<2>(p) - boost::geometry::get<2>(p0)) /
+           (boost::geometry::get<2>(p1) - boost::geometry::get<2>(p0));
+  auto w00 = (T(1) - t) * (T(1) - u);
+  auto w01 = (T(1) - t) * u;
+  auto w10 = t * (T(1) - u);
+  auto w11 = t * u;
+  return renormalize<T, 8>({w00 * (T(1) - v), w01 * (T(1) - v),
+                            w10 * (T(1) - v), w11 * (T(1) - v), w00 * v,
+                            w01 * v, w10 * v, w11 * v},
+                           q, min_valid);
+}
+
 /// Performs the interpolation
 ///
 /// @param p Query point
@@ -23,12 +54,26 @@ namespace math {
 /// @param q011 Point value for the coordinate (x0, y1, z1)
 /// @param q101 Point value for the coordinate (x1, y0, z1)
 /// @param q111 Point value for the coordinate (x1, y1, z1)
+/// @param bivariate Interpolator used on the planes z0 and z1
 /// @return interpolated value at coordinate (x, y, z)
-template <template <class> class Point, typename T>
+/// @tparam Interpolator Type of the bivariate interpolator: the abstract
+/// interface, or an actual type to resolve the calls at compile time (see
+/// visit).
+template <template <class> class Point, typename T,
+          typename Interpolator = Bivariate<Point, T>>
 inline T trivariate(const Point<T>& p, const Point<T>& p0, const Point<T>& p1,
                     const T& q000, const T& q010, const T& q100, const T& q110,
                     const T& q001, const T& q011, const T& q101, const T& q111,
-                    const Bivariate<Point, T>* bivariate) {
+                    const Interpolator* bivariate) {
+  // The undefined corners are dropped among the eight corners of the cell,
+  // not among the four corners of each plane.
+  if constexpr (std::is_same_v<Interpolator, Bilinear<Point, T>>) {
+    if (bivariate->masked()) {
+      return trilinear<Point, T>(
+          p, p0, p1, {q000, q010, q100, q110, q001, q011, q101, q111},
+          bivariate->min_valid());
+    }
+  }
   auto z0 = bivariate->evaluate(p, p0, p1, q000, q010, q100, q110);
   auto z1 = bivariate->evaluate(p, p0, p1, q001, q011, q101, q111);
   return linear(boost::geometry::get<2>(p), boost::geometry::get<2>(p0),
@@ -0,0 +1,193 @@
+// Copyright (c) 2019 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include "pyinterp/detail/thread.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace pyinterp {
+namespace detail {
+namespace morton {
+
+/// Number of bits used to quantize a coordinate in a space of the given
+/// dimension: the interleaved bits of all coordinates fit in 63 bits, so that
+/// the greatest 64-bit key can designate the points having a non finite
+/// coordinate.
+template <size_t Dimensions>
+constexpr uint32_t bits() noexcept {
+  return 63 / Dimensions;
+}
+
+/// Inserts Dimensions - 1 zero bits between the bits of the value.
+template <size_t Dimensions>
+inline uint64_t spread(uint32_t value) noexcept;
+
+/// Inserts a zero bit between the 32 bits of the value.
+template <>
+inline uint64_t spread<2>(const uint32_t value) noexcept {
+  auto x = static_cast<uint64_t>(value);
+  x = (x | (x << 16U)) & 0x0000FFFF0000FFFFULL;
+  x = (x | (x << 8U)) & 0x00FF00FF00FF00FFULL;
+  x = (x | (x << 4U)) & 0x0F0F0F0F0F0F0F0FULL;
+  x = (x | (x << 2U)) & 0x3333333333333333ULL;
+  x = (x | (x << 1U)) & 0x5555555555555555ULL;
+  return x;
+}
+
+/// Inserts two zero bits between the 21 least significant bits of the value.
+template <>
+inline uint64_t spread<3>(const uint32_t value) noexcept {
+  auto x = static_cast<uint64_t>(value) & 0x1FFFFFULL;
+  x = (x | (x << 32U)) & 0x001F00000000FFFFULL;
+  x = (x | (x << 16U)) & 0x001F0000FF0000FFULL;
+  x = (x | (x << 8U)) & 0x100F00F00F00F00FULL;
+  x = (x | (x << 4U)) & 0x10C30C30C30C30C3ULL;
+  x = (x | (x << 2U)) & 0x1249249249249249ULL;
+  return x;
+}
+
+/// Calculates the Morton code (Z-order curve) of a point whose coordinates
+/// have been quantized on bits<Dimensions>() bits.
+template <size_t Dimensions>
+inline uint64_t encode(const std::array<uint32_t, Dimensions>& cell) noexcept {
+  auto result = uint64_t(0);
+  for (size_t dim = 0; dim < Dimensions; ++dim) {
+    result |= spread<Dimensions>(cell[dim]) << dim;
+  }
+  return result;
+}
+
+/// Calculates the order in which to process points so that consecutive
+/// points are close in space: the points are sorted along the Morton curve
+/// (Z-order) traversing the bounding box of the points. Processing the
+/// points in this order keeps in the CPU caches the grid cells, or the tree
+/// nodes, accessed by neighbouring points.
+///
+/// The keys are sorted in parallel: the points are first distributed in
+/// buckets according to the most significant bits of their key, then the
+/// buckets are sorted independently by the threads. Points having a non
+/// finite coordinate are placed at the end.
+///
+/// @param coordinate Function returning the coordinate "dim" of the point
+/// "ix": coordinate(ix, dim).
+/// @param size Number of points
+/// @param num_threads The number of threads to use for the computation.
+/// @return The indexes of the points in the order in which to process them.
+/// @tparam Dimensions Number of coordinates of a point
+/// @tparam Coordinate Function returning the coordinates of the points
+template <size_t Dimensions, typename Coordinate>
+std::vector<size_t> order(const Coordinate& coordinate, const size_t size,
+                          const size_t num_threads) {
+  // Bounding box of the points, computed in parallel.
+  auto min = std::array<double, Dimensions>();
+  auto max = std::array<double, Dimensions>();
+  min.fill(std::numeric_limits<double>::max());
+  max.fill(std::numeric_limits<double>::lowest());
+  auto mutex = std::mutex();
+
+  dispatch(
+      [&](const size_t start, const size_t end) {
+        auto block_min = std::array<double, Dimensions>();
+        auto block_max = std::array<double, Dimensions>();
+        block_min.fill(std::numeric_limits<double>::max());
+        block_max.fill(std::numeric_limits<double>::lowest());
+        for (size_t ix = start; ix < end; ++ix) {
+          for (size_t dim = 0; dim < Dimensions; ++dim) {
+            auto value = static_cast<double>(coordinate(ix, dim));
+            if (std::isfinite(value)) {
+              block_min[dim] = std::min(block_min[dim], value);
+              block_max[dim] = std::max(block_max[dim], value);
+            }
+          }
+        }
+        auto lock = std::unique_lock<std::mutex>(mutex);
+        for (size_t dim = 0; dim < Dimensions; ++dim) {
+          min[dim] = std::min(min[dim], block_min[dim]);
+          max[dim] = std::max(max[dim], block_max[dim]);
+        }
+      },
+      size, num_threads);
+
+  // Scale factors quantizing the coordinates on the bits available.
+  constexpr auto cells = static_cast<double>((1ULL << bits<Dimensions>()) - 1);
+  auto scale = std::array<double, Dimensions>();
+  for (size_t dim = 0; dim < Dimensions; ++dim) {
+    scale[dim] = max[dim] > min[dim] ? cells / (max[dim] - min[dim]) : 0;
+  }
+
+  // Morton code of each point.
+  auto keys = std::vector<uint64_t>(size);
+  dispatch(
+      [&](const size_t start, const size_t end) {
+        auto cell = std::array<uint32_t, Dimensions>();
+        for (size_t ix = start; ix < end; ++ix) {
+          auto key = std::numeric_limits<uint64_t>::max();
+          auto dim = size_t(0);
+          for (; dim < Dimensions; ++dim) {
+            auto value = static_cast<double>(coordinate(ix, dim));
+            if (!std::isfinite(value)) {
+              break;
+            }
+            cell[dim] = static_cast<uint32_t>(
+                std::min((value - min[dim]) * scale[dim], cells));
+          }
+          if (dim == Dimensions) {
+            key = encode<Dimensions>(cell);
+          }
+          keys[ix] = key;
+        }
+      },
+      size, num_threads);
+
+  // Distribution of the points in buckets according to the most significant
+  // bits of their key. The keys are copied with the indexes of the points so
+  // that the buckets can be sorted without indirect memory accesses.
+  constexpr auto kBucketBits = 16U;
+  constexpr auto kShift = Dimensions * bits<Dimensions>() - kBucketBits;
+  // The last bucket contains the points having a non finite coordinate.
+  auto buckets = std::vector<size_t>((1U << kBucketBits) + 2, 0);
+  auto bucket = [](const uint64_t key) -> size_t {
+    return key == std::numeric_limits<uint64_t>::max()
+               ? (1U << kBucketBits)
+               : static_cast<size_t>(key >> kShift);
+  };
+  for (size_t ix = 0; ix < size; ++ix) {
+    ++buckets[bucket(keys[ix]) + 2];
+  }
+  for (size_t ix = 2; ix < buckets.size(); ++ix) {
+    buckets[ix] += buckets[ix - 1];
+  }
+  auto items = std::vector<std::pair<uint64_t, size_t>>(size);
+  for (size_t ix = 0; ix < size; ++ix) {
+    items[buckets[bucket(keys[ix]) + 1]++] = {keys[ix], ix};
+  }
+  keys = std::vector<uint64_t>();
+
+  // Each bucket is then sorted by the threads. The sizes of the buckets
+  // depend on the distribution of the points: they are claimed dynamically.
+  auto result = std::vector<size_t>(size);
+  dispatch(
+      [&](const size_t start, const size_t end) {
+        for (auto ix = start; ix < end; ++ix) {
+          std::sort(items.begin() + buckets[ix],
+                    items.begin() + buckets[ix + 1]);
+        }
+        for (auto ix = buckets[start]; ix < buckets[end]; ++ix) {
+          result[ix] = items[ix].second;
+        }
+      },
+      buckets.size() - 1, num_threads, kDynamic);
+  return result;
+}
+
+}  // namespace morton
+}  // namespace detail
+}  // namespace pyinterp
@@ -3,47 +3,353 @@
 // All rights reserved. Use of this source code is governed by a
 // BSD-style license that can be found in the LICENSE file.
 #pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <queue>
 #include <thread>
+#include <utility>
 #include <vector>
 
 namespace pyinterp {
 namespace detail {
 
+/// Pool of threads executing the tasks submitted. The threads are created on
+/// demand and then wait for new tasks until the destruction of the pool, so
+/// that the cost of their creation is paid only once.
+class ThreadPool {
+ public:
+  /// Default constructor
+  ThreadPool() = default;
+
+  /// Destructor: waits for the completion of the submitted tasks and stops
+  /// the threads.
+  ~ThreadPool();
+
+  /// Copy constructor
+  ThreadPool(const ThreadPool&) = delete;
+
+  /// Move constructor
+  ThreadPool(ThreadPool&&) = delete;
+
+  /// Copy assignment operator
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /// Move assignment operator
+  ThreadPool& operator=(ThreadPool&&) = delete;
+
+  /// Gets the pool shared by the whole process.
+  static ThreadPool& instance();
+
+  /// Returns true if the calling thread belongs to a pool.
+  static bool is_worker() noexcept;
+
+  /// Gets the number of threads of the pool.
+  size_t size() const;
+
+  /// Creates, if necessary, new threads so that the pool contains at least
+  /// the number of threads requested.
+  void reserve(size_t num_threads);
+
+  /// Submits a task to be executed by one of the threads of the pool.
+  void submit(std::function<void()> task);
+
+ private:
+  std::vector<std::thread> threads_{};
+  std::queue<std::function<void()>> tasks_{};
+  mutable std::mutex mutex_{};
+  std::condition_variable condition_{};
+  bool stop_{false};
+
+  /// Function executed by the threads of the pool.
+  void run();
+};
+
+/// Group of tasks executed by a thread pool, whose completion can be awaited.
+/// The first exception thrown by a task cancels the group: the tasks can then
+/// stop their calculation, and this exception is rethrown by wait().
+class TaskGroup {
+ public:
+  /// Default constructor
+  ///
+  /// @param pool Thread pool executing the tasks
+  explicit TaskGroup(ThreadPool& pool) : pool_(pool) {}
+
+  /// Destructor: waits for the completion of the tasks.
+  ~TaskGroup() { join(); }
+
+  /// Copy constructor
+  TaskGroup(const TaskGroup&) = delete;
+
+  /// Move constructor
+  TaskGroup(TaskGroup&&) = delete;
+
+  /// Copy assignment operator
+  TaskGroup& operator=(const TaskGroup&) = delete;
+
+  /// Move assignment operator
+  TaskGroup& operator=(TaskGroup&&) = delete;
+
+  /// Submits a task to the pool.
+  void run(std::function<void()> task) {
+    {
+      auto lock = std::unique_lock<std::mutex>(mutex_);
+      ++pending_;
+    }
+    try {
+      pool_.submit([this, task = std::move(task)] {
+        call(task);
+        done();
+      });
+    } catch (...) {
+      // The task will never run: it must not be waited for.
+      done();
+      throw;
+    }
+  }
+
+  /// Executes a task in the calling thread, the exception it throws being
+  /// handled like those of the tasks submitted to the pool.
+  void call(const std::function<void()>& task) {
+    try {
+      task();
+    } catch (...) {
+      cancel(std::current_exception());
+    }
+  }
+
+  /// Returns true if one of the tasks has failed.
+  inline bool cancelled() const noexcept {
+    return cancelled_.load(std::memory_order_relaxed);
+  }
+
+  /// Waits for the completion of the tasks submitted and rethrows the first
+  /// exception thrown by one of them.
+  void wait() {
+    join();
+    if (except_ != nullptr) {
+      std::rethrow_exception(std::exchange(except_, nullptr));
+    }
+  }
+
+ private:
+  ThreadPool& pool_;
+  std::mutex mutex_{};
+  std::condition_variable condition_{};
+  size_t pending_{0};
+  std::exception_ptr except_{nullptr};
+  std::atomic<bool> cancelled_{false};
+
+  /// Marks a task as completed, waking up the threads waiting for the group
+  /// if it was the last one.
+  void done() {
+    auto lock = std::unique_lock<std::mutex>(mutex_);
+    if (--pending_ == 0) {
+      condition_.notify_all();
+    }
+  }
+
+  /// Cancels the group, keeping only the first exception thrown.
+  void cancel(std::exception_ptr except) {
+    auto lock = std::unique_lock<std::mutex>(mutex_);
+    if (except_ == nullptr) {
+      except_ = std::move(except);
+      cancelled_.store(true, std::memory_order_relaxed);
+    }
+  }
+
+  /// Waits for the completion of the tasks submitted.
+  void join() {
+    auto lock = std::unique_lock<std::mutex>(mutex_);
+    condition_.wait(lock, [this] { return pending_ == 0; });
+  }
+};
+
+/// Distribution of the items to be processed between the threads.
+enum Schedule : uint8_t {
+  kStatic,   //!< Each thread processes a slice of the same size.
+  kDynamic,  //!< Each thread claims chunks of items until exhaustion.
+};
+
+/// Default number of chunks claimed by each thread with the dynamic schedule.
+constexpr size_t kChunksPerThread = 16;
+
+/// Gets the number of CPUs usable by the process: the CPUs of its affinity
+/// mask, limited by the CPU quota of its control group (cgroup v1 or v2) when
+/// it runs in a container.
+size_t cpu_count() noexcept;
+
+/// Gets the maximum number of threads used simultaneously, by all the calls
+/// to the "dispatch" function, to perform parallel calculations.
+size_t max_threads() noexcept;
+
+/// Sets the maximum number of threads used simultaneously, by all the calls
+/// to the "dispatch" function, to perform parallel calculations.
+///
+/// @param value Number of threads. Zero restores the default value:
+/// cpu_count().
+void set_max_threads(size_t value) noexcept;
+
+/// Reservation of threads within the budget defined by max_threads(). The
+/// threads are given back to the budget when the reservation is destroyed.
+class ThreadReservation {
+ public:
+  /// Reserves up to the number of threads requested. The calling thread is
+  /// always granted, even if the budget is exhausted, so that the calculation
+  /// can progress without parallelism.
+  ///
+  /// @param num_threads Number of threads requested, calling thread included
+  explicit ThreadReservation(size_t num_threads) noexcept
+      : size_(acquire(num_threads)) {}
+
+  /// Destructor: gives back the threads to the budget.
+  ~ThreadReservation() { release(size_); }
+
+  /// Copy constructor
+  ThreadReservation(const ThreadReservation&) = delete;
+
+  /// Move constructor
+  ThreadReservation(ThreadReservation&&) = delete;
+
+  /// Copy assignment operator
+  ThreadReservation& operator=(const ThreadReservation&) = delete;
+
+  /// Move assignment operator
+  ThreadReservation& operator=(ThreadReservation&&) = delete;
+
+  /// Gets the number of threads granted, calling thread included.
+  inline size_t size() const noexcept { return size_; }
+
+ private:
+  size_t size_;
+
+  /// Takes from the budget up to the number of threads requested.
+  static size_t acquire(size_t num_threads) noexcept;
+
+  /// Gives back threads to the budget.
+  static void release(size_t num_threads) noexcept;
+};
+
+/// Gets the minimum number of items processed by a thread launched by the
+/// "dispatch" function.
+size_t grain_size() noexcept;
+
+/// Sets the minimum number of items processed by a thread launched by the
+/// "dispatch" function. Vectors smaller than twice this value are processed
+/// without parallelism.
+///
+/// @param value Number of items. Zero restores the default value.
+void set_grain_size(size_t value) noexcept;
+
 /// Automates the cutting of vectors to be processed in thread.
 ///
+/// The calculation is distributed between the calling thread and the threads
+/// of the pool shared by the whole process, each thread processing at least
+/// grain_size() items. Calls made from a thread of the pool are processed
+/// without parallelism. The threads are reserved within the budget shared by
+/// all the calls in progress (see max_threads()): concurrent calls, made for
+/// example by Dask tasks, do not oversubscribe the CPUs.
+///
+/// With the static schedule, the vectors are cut into equal slices, one per
+/// thread. With the dynamic schedule, the threads claim successive chunks of
+/// items until the vectors are exhausted, which balances the load when the
+/// cost of the items varies (e.g. items located outside the domain, returning
+/// immediately, mixed with items requiring a costly calculation).
+///
+/// In both cases, the threads call the lambda function on successive blocks
+/// of their items, and stop as soon as one of them has thrown an exception.
+/// The lambda function must therefore not catch the exceptions itself.
+///
 /// @param worker Lambda function called in each thread launched
 /// @param size Size of all vectors to be processed
 /// @param num_threads The number of threads to use for the computation. If 0
-/// all CPUs are used. If 1 is given, no parallel computing code is used at all,
-/// which is useful for debugging.
+/// all CPUs usable by the process are used (see cpu_count()). If 1 is given,
+/// no parallel computing code is used at all, which is useful for debugging.
+/// @param schedule Distribution of the items between the threads.
+/// @param chunk_size Number of items claimed at once by a thread with the
+/// dynamic schedule. If 0, the vectors are cut into chunks so that each
+/// thread claims about kChunksPerThread chunks.
+/// @throw The first exception thrown by the lambda function.
 /// @tparam Lambda Lambda function
 template <typename Lambda>
-void dispatch(Lambda worker, size_t size, size_t num_threads = 0) {
-  if (num_threads == 1) {
+void dispatch(Lambda worker, size_t size, size_t num_threads = 0,
+              const Schedule schedule = kStatic, size_t chunk_size = 0) {
+  if (num_threads == 0) {
+    num_threads = cpu_count();
+  }
+  num_threads =
+      std::min(num_threads, std::max(size / grain_size(), size_t(1)));
+
+  if (num_threads <= 1 || ThreadPool::is_worker()) {
     worker(0, size);
     return;
   }
 
-  if (num_threads == 0) {
-    num_threads = std::thread::hardware_concurrency();
+  // The reservation is released once the tasks of the group are completed.
+  auto reservation = ThreadReservation(num_threads);
+  num_threads = reservation.size();
+  if (num_threads <= 1) {
+    worker(0, size);
+    return;
   }
 
-  // List of threads responsible for parallelizing the calculation
-  std::vector<std::thread> threads(num_threads);
+  auto& pool = ThreadPool::instance();
+  pool.reserve(num_threads - 1);
+
+  // Index of the next chunk to claim, with the dynamic schedule.
+  auto next = std::atomic<size_t>(0);
+
+  // The tasks submitted to the pool process the first slices, the calling
+  // thread processing the last one.
+  auto group = TaskGroup(pool);
+
+  if (schedule == kDynamic) {
+    if (chunk_size == 0) {
+      chunk_size =
+          std::max(size / (num_threads * kChunksPerThread), size_t(1));
+    }
+    auto task = [worker, &next, &group, size, chunk_size]() mutable {
+      for (auto start = next.fetch_add(chunk_size);
+           start < size && !group.cancelled();
+           start = next.fetch_add(chunk_size)) {
+        worker(start, std::min(start + chunk_size, size));
+      }
+    };
+    for (size_t ix = 1; ix < num_threads; ++ix) {
+      group.run(task);
+    }
+    group.call(task);
+    group.wait();
+    return;
+  }
 
   // Access index to the vectors required for calculation
   size_t start = 0, shift = size / num_threads;
 
-  // Launch and join threads
-  for (auto it = std::begin(threads); it != std::end(threads) - 1; ++it) {
-    *it = std::thread(worker, start, start + shift);
-    start += shift;
-  }
-  threads.back() = std::thread(worker, start, size);
+  // The slices are processed by blocks, in order to check between two blocks
+  // whether the calculation has been cancelled.
+  auto block = std::max(shift / kChunksPerThread, grain_size());
 
-  for (auto&& item : threads) {
-    item.join();
+  for (size_t ix = 0; ix < num_threads; ++ix) {
+    auto end = ix == num_threads - 1 ? size : start + shift;
+    auto task = [worker, &group, start, end, block]() mutable {
+      for (auto first = start; first < end && !group.cancelled();
+           first += block) {
+        worker(first, std::min(first + block, end));
+      }
+    };
+    if (ix == num_threads - 1) {
+      group.call(task);
+    } else {
+      group.run(task);
+    }
+    start = end;
   }
+  group.wait();
 }
 
 }  // namespace detail
@@ -62,26 +62,14 @@ class Box2D : public boost::geometry::model::box<Point2D<T>> {
     {
       pybind11::gil_scoped_release release;
 
-      // Captures the detected exceptions in the calculation function
-      // (only the last exception captured is kept)
-      auto except = std::exception_ptr(nullptr);
-
       detail::dispatch(
           [&](size_t start, size_t end) {
-            try {
-              for (size_t ix = start; ix < end; ++ix) {
-                _result(ix) = static_cast<int8_t>(
-                    covered_by(Point2D<T>(lon(ix), lat(ix))));
-              }
-            } catch (...) {
-              except = std::current_exception();
+            for (size_t ix = start; ix < end; ++ix) {
+              _result(ix) = static_cast<int8_t>(
+                  covered_by(Point2D<T>(lon(ix), lat(ix))));
             }
           },
           size, num_threads);
-
-      if (except != nullptr) {
-        std::rethrow_exception(except);
-      }
     }
     return result;
   }
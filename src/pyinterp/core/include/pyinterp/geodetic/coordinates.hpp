@@ -47,29 +47,17 @@ class Coordinates : public detail::geodetic::Coordinates {
     {
       pybind11::gil_scoped_release release;
 
-      // Captures the detected exceptions in the calculation function
-      // (only the last exception captured is kept)
-      auto except = std::exception_ptr(nullptr);
-
       detail::dispatch(
           [&](size_t start, size_t end) {
-            try {
-              for (size_t ix = start; ix < end; ++ix) {
-                auto lla = detail::geodetic::Coordinates::ecef_to_lla(
-                    detail::geometry::Point3D<T>{x(ix), y(ix), z(ix)});
-                _lon(ix) = boost::geometry::get<0>(lla);
-                _lat(ix) = boost::geometry::get<1>(lla);
-                _alt(ix) = boost::geometry::get<2>(lla);
-              }
-            } catch (...) {
-              except = std::current_exception();
+            for (size_t ix = start; ix < end; ++ix) {
+              auto lla = detail::geodetic::Coordinates::ecef_to_lla(
+                  detail::geometry::Point3D<T>{x(ix), y(ix), z(ix)});
+              _lon(ix) = boost::geometry::get<0>(lla);
+              _lat(ix) = boost::geometry::get<1>(lla);
+              _alt(ix) = boost::geometry::get<2>(lla);
             }
           },
           size, num_threads);
-
-      if (except != nullptr) {
-        std::rethrow_exception(except);
-      }
     }
     return pybind11::make_tuple(lon, lat, alt);
   }
@@ -95,30 +83,18 @@ class Coordinates : public detail::geodetic::Coordinates {
     {
       pybind11::gil_scoped_release release;
 
-      // Captures the detected exceptions in the calculation function
-      // (only the last exception captured is kept)
-      auto except = std::exception_ptr(nullptr);
-
       detail::dispatch(
           [&](size_t start, size_t end) {
-            try {
-              for (size_t ix = start; ix < end; ++ix) {
-                auto ecef = detail::geodetic::Coordinates::lla_to_ecef(
-                    detail::geometry::EquatorialPoint3D<T>{lon(ix), lat(ix),
-                                                           alt(ix)});
-                x_(ix) = boost::geometry::get<0>(ecef);
-                y_(ix) = boost::geometry::get<1>(ecef);
-                z_(ix) = boost::geometry::get<2>(ecef);
-              }
-            } catch (...) {
-              except = std::current_exception();
+            for (size_t ix = start; ix < end; ++ix) {
+              auto ecef = detail::geodetic::Coordinates::lla_to_ecef(
+                  detail::geometry::EquatorialPoint3D<T>{lon(ix), lat(ix),
+                                                         alt(ix)});
+              x_(ix) = boost::geometry::get<0>(ecef);
+              y_(ix) = boost::geometry::get<1>(ecef);
+              z_(ix) = boost::geometry::get<2>(ecef);
             }
           },
           size, num_threads);
-
-      if (except != nullptr) {
-        std::rethrow_exception(except);
-      }
     }
     return pybind11::make_tuple(x, y, z);
   }
@@ -144,30 +120,18 @@ class Coordinates : public detail::geodetic::Coordinates {
     {
       pybind11::gil_scoped_release release;
 
-      // Captures the detected exceptions in the calculation function
-      // (only the last exception captured is kept)
-      auto except = std::exception_ptr(nullptr);
-
       detail::dispatch(
           [&](size_t start, size_t end) {
-            try {
-              for (size_t ix = start; ix < end; ++ix) {
-                auto lla = detail::geodetic::Coordinates::transform(
-                    target, detail::geometry::EquatorialPoint3D<T>{
-                                lon1(ix), lat1(ix), alt1(ix)});
-                _lon2(ix) = boost::geometry::get<0>(lla);
-                _lat2(ix) = boost::geometry::get<1>(lla);
-                _alt2(ix) = boost::geometry::get<2>(lla);
-              }
-            } catch (...) {
-              except = std::current_exception();
+            for (size_t ix = start; ix < end; ++ix) {
+              auto lla = detail::geodetic::Coordinates::transform(
+                  target, detail::geometry::EquatorialPoint3D<T>{
+                              lon1(ix), lat1(ix), alt1(ix)});
+              _lon2(ix) = boost::geometry::get<0>(lla);
+              _lat2(ix) = boost::geometry::get<1>(lla);
+              _alt2(ix) = boost::geometry::get<2>(lla);
             }
           },
           size, num_threads);
-
-      if (except != nullptr) {
-        std::rethrow_exception(except);
-      }
     }
     return pybind11::make_tuple(lon2, lat2, alt2);
   }
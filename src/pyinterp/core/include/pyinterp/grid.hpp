@@ -5,24 +5,68 @@
 #pragma once
 #include "pyinterp/axis.hpp"
 #include "pyinterp/detail/broadcast.hpp"
+#include "pyinterp/detail/math.hpp"
+#include <pybind11/pybind11.h>
 #include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+#include <cmath>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
 
 namespace pyinterp {
 
 /// Cartesian Grid 2D
+///
+/// The values of a grid of integers can be packed: they are decoded on the
+/// fly, when read, according to a scale factor, an offset and a fill value
+/// (see detail::math::Packing).
 template <typename T, ssize_t Dimension = 2>
 class Grid2D {
  public:
   /// Default constructor
+  ///
+  /// @param axes Dimension of the array holding each axis (x, y[, z]) of
+  /// the grid, if the array is not stored in this order. The array is then
+  /// read through its own strides, without being copied.
   Grid2D(std::shared_ptr<Axis> x, std::shared_ptr<Axis> y,
-         pybind11::array_t<T> z)
+         pybind11::array_t<T> z,
+         const std::optional<std::vector<ssize_t>>& axes = {})
       : x_(std::move(x)),
         y_(std::move(y)),
-        array_(std::move(z)),
-        ptr_(array_.template unchecked<Dimension>()) {
+        array_(transpose(std::move(z), axes)),
+        ptr_(array_.template unchecked<Dimension>()),
+        axes_(axes) {
     check_shape(0, x_.get(), "x", "z", y_.get(), "y", "z");
   }
 
+  /// Constructor of a grid of packed integers
+  ///
+  /// @param scale_factor Factor applied to the integers
+  /// @param add_offset Offset added to the integers multiplied by the scale
+  /// factor
+  /// @param fill_value Integer representing the undefined values, if any
+  /// @param axes Dimension of the array holding each axis of the grid
+  Grid2D(std::shared_ptr<Axis> x, std::shared_ptr<Axis> y,
+         pybind11::array_t<T> z, const double scale_factor,
+         const double add_offset, const std::optional<T>& fill_value,
+         const std::optional<std::vector<ssize_t>>& axes = {})
+      : Grid2D(std::move(x), std::move(y), std::move(z), axes) {
+    static_assert(std::is_integral_v<T>,
+                  "only the grids of integers can be packed");
+    if (!std::isfinite(scale_factor) || !std::isfinite(add_offset)) {
+      throw std::invalid_argument(
+          "scale_factor and add_offset must be finite numbers");
+    }
+    packing_.scale_factor = scale_factor;
+    packing_.add_offset = add_offset;
+    if (fill_value) {
+      packing_.fill_value = static_cast<double>(*fill_value);
+    }
+  }
+
   /// Default constructor
   Grid2D() = default;
 
@@ -58,21 +102,56 @@ class Grid2D {
   /// Gets values of the array to interpolate
   inline const pybind11::array_t<T>& array() const noexcept { return array_; }
 
-  /// Pickle support: get state of this instance
+  /// Gets the decoding of the values of the grid
+  inline const detail::math::Packing& packing() const noexcept {
+    return packing_;
+  }
+
+  /// Gets the dimension of the array holding each axis of the grid, if the
+  /// array is not stored in the order of the axes
+  inline const std::optional<std::vector<ssize_t>>& axes() const noexcept {
+    return axes_;
+  }
+
+  /// Gets the integer representing the undefined values, if any
+  inline std::optional<T> fill_value() const noexcept {
+    if (std::isnan(packing_.fill_value)) {
+      return {};
+    }
+    return static_cast<T>(packing_.fill_value);
+  }
+
+  /// Pickle support: get state of this instance. The array is stored in
+  /// its native order, followed by the axes mapping it to the grid.
   virtual pybind11::tuple getstate() const {
-    return pybind11::make_tuple(x_->getstate(), y_->getstate(), array_);
+    if constexpr (std::is_integral_v<T>) {
+      return pybind11::make_tuple(x_->getstate(), y_->getstate(),
+                                  native_array(), packing_.scale_factor,
+                                  packing_.add_offset, fill_value(), axes_);
+    } else {
+      return pybind11::make_tuple(x_->getstate(), y_->getstate(),
+                                  native_array(), axes_);
+    }
   }
 
   /// Pickle support: set state of this instance
   static Grid2D setstate(const pybind11::tuple& tuple) {
-    if (tuple.size() != 3) {
+    auto size = size_t(std::is_integral_v<T> ? 6 : 3);
+    if (tuple.size() != size && tuple.size() != size + 1) {
       throw std::runtime_error("invalid state");
     }
-    return Grid2D(std::make_shared<Axis>(
-                      Axis(Axis::setstate(tuple[0].cast<pybind11::tuple>()))),
-                  std::make_shared<Axis>(
-                      Axis(Axis::setstate(tuple[1].cast<pybind11::tuple>()))),
-                  tuple[2].cast<pybind11::array_t<T>>());
+    auto x = std::make_shared<Axis>(
+        Axis(Axis::setstate(tuple[0].cast<pybind11::tuple>())));
+    auto y = std::make_shared<Axis>(
+        Axis(Axis::setstate(tuple[1].cast<pybind11::tuple>())));
+    auto axes = state_axes(tuple, size);
+    if constexpr (std::is_integral_v<T>) {
+      return Grid2D(x, y, tuple[2].cast<pybind11::array_t<T>>(),
+                    tuple[3].cast<double>(), tuple[4].cast<double>(),
+                    tuple[5].cast<std::optional<T>>(), axes);
+    } else {
+      return Grid2D(x, y, tuple[2].cast<pybind11::array_t<T>>(), axes);
+    }
   }
 
  protected:
@@ -80,6 +159,110 @@ class Grid2D {
   std::shared_ptr<Axis> y_;
   pybind11::array_t<T> array_;
   pybind11::detail::unchecked_reference<T, Dimension> ptr_;
+  std::optional<std::vector<ssize_t>> axes_;
+  detail::math::Packing packing_{};
+
+  /// Gets a value of the grid, or of a field sharing its axes, converted to
+  /// the type U. The packed integers are decoded; the values of the other
+  /// grids are only converted.
+  template <typename U>
+  inline U unpack(const T& item) const noexcept {
+    if constexpr (std::is_integral_v<T>) {
+      return packing_.template unpack<T, U>(item);
+    } else {
+      return static_cast<U>(item);
+    }
+  }
+
+  /// Gets the value of the grid located at the given index, converted to
+  /// the type U.
+  ///
+  /// @see unpack
+  template <typename U, typename... Index>
+  inline U value(const Index... index) const noexcept {
+    return unpack<U>(ptr_(index...));
+  }
+
+  /// Gets a view of the array whose dimensions are ordered as the axes of
+  /// the grid. The view shares the buffer of the array.
+  ///
+  /// @param array Array to interpolate
+  /// @param axes Dimension of the array holding each axis of the grid, or
+  /// nothing if the array is already ordered as the grid.
+  /// @throw std::invalid_argument if the axes are not a permutation of the
+  /// dimensions of the array.
+  static pybind11::array_t<T> transpose(
+      pybind11::array_t<T> array,
+      const std::optional<std::vector<ssize_t>>& axes) {
+    if (!axes) {
+      return array;
+    }
+    if (array.ndim() != Dimension ||
+        axes->size() != static_cast<size_t>(Dimension)) {
+      throw std::invalid_argument(
+          "axes must give the dimension holding each of the " +
+          std::to_string(Dimension) + " axes of the array of shape " +
+          detail::ndarray_shape(array));
+    }
+    auto shape = std::vector<ssize_t>(Dimension);
+    auto strides = std::vector<ssize_t>(Dimension);
+    auto used = std::vector<bool>(Dimension, false);
+    for (ssize_t ix = 0; ix < Dimension; ++ix) {
+      auto axis = (*axes)[ix];
+      if (axis < 0 || axis >= Dimension || used[axis]) {
+        throw std::invalid_argument(
+            "axes must be a permutation of the dimensions of the array");
+      }
+      used[axis] = true;
+      shape[ix] = array.shape(axis);
+      strides[ix] = array.strides(axis);
+    }
+    return pybind11::array_t<T>(std::move(shape), std::move(strides),
+                                array.data(), array);
+  }
+
+  /// Gets views of the fields sharing the axes of the grid, whose dimensions
+  /// are ordered as the axes of the grid: the fields are stored in the same
+  /// order as the array of the grid.
+  ///
+  /// @see transpose
+  std::vector<pybind11::array_t<T>> transpose(
+      const std::vector<pybind11::array_t<T>>& fields) const {
+    auto result = std::vector<pybind11::array_t<T>>();
+    result.reserve(fields.size());
+    for (const auto& item : fields) {
+      result.emplace_back(transpose(item, axes_));
+    }
+    return result;
+  }
+
+  /// Gets a view of the array of the grid in the order in which it is
+  /// stored, the inverse of transpose.
+  pybind11::array_t<T> native_array() const {
+    if (!axes_) {
+      return array_;
+    }
+    auto shape = std::vector<ssize_t>(Dimension);
+    auto strides = std::vector<ssize_t>(Dimension);
+    for (ssize_t ix = 0; ix < Dimension; ++ix) {
+      shape[(*axes_)[ix]] = array_.shape(ix);
+      strides[(*axes_)[ix]] = array_.strides(ix);
+    }
+    return pybind11::array_t<T>(std::move(shape), std::move(strides),
+                                array_.data(), array_);
+  }
+
+  /// Gets the axes stored at the end of a state, if any.
+  ///
+  /// @param tuple State of the instance
+  /// @param size Number of items of the state without the axes
+  static std::optional<std::vector<ssize_t>> state_axes(
+      const pybind11::tuple& tuple, const size_t size) {
+    if (tuple.size() == size) {
+      return {};
+    }
+    return tuple[size].cast<std::optional<std::vector<ssize_t>>>();
+  }
 
   /// Throws an exception indicating that the value searched on the axis is
   /// outside the domain axis.
@@ -87,13 +270,35 @@ class Grid2D {
   /// @param axis Axis involved.
   /// @param value The value outside the axis domain.
   /// @param axis_label The name of the axis
-  static void index_error(const Axis& axis, const T& value,
+  static void index_error(const Axis& axis, const double value,
                           const std::string& axis_label) {
     throw std::invalid_argument(std::to_string(value) +
                                 " is out ouf bounds for axis " + axis_label +
                                 " (" + static_cast<std::string>(axis) + ")");
   }
 
+  /// Gets the values of the grid, followed by those of the fields sharing
+  /// its axes, in order to interpolate them together. The fields of a grid
+  /// of packed integers are decoded like the grid.
+  ///
+  /// @param fields Values of the other variables defined on the grid
+  /// @throw std::invalid_argument if the shape of a field differs from the
+  /// shape of the grid.
+  std::vector<pybind11::detail::unchecked_reference<T, Dimension>> fields(
+      const std::vector<pybind11::array_t<T>>& fields) const {
+    auto result =
+        std::vector<pybind11::detail::unchecked_reference<T, Dimension>>{
+            ptr_};
+    result.reserve(fields.size() + 1);
+    for (size_t ix = 0; ix < fields.size(); ++ix) {
+      detail::check_ndarray_shape("array", array_,
+                                  "fields[" + std::to_string(ix) + "]",
+                                  fields[ix]);
+      result.emplace_back(fields[ix].template unchecked<Dimension>());
+    }
+    return result;
+  }
+
   /// End of the recursive call of the function "check_shape"
   void check_shape(const size_t idx) {}
 
@@ -116,9 +321,26 @@ template <typename T>
 class Grid3D : public Grid2D<T, 3> {
  public:
   /// Default constructor
+  ///
+  /// @see Grid2D::Grid2D
+  Grid3D(std::shared_ptr<Axis> x, std::shared_ptr<Axis> y,
+         std::shared_ptr<Axis> z, pybind11::array_t<T> u,
+         const std::optional<std::vector<ssize_t>>& axes = {})
+      : Grid2D<T, 3>(x, y, std::move(u), axes), z_(std::move(z)) {
+    this->check_shape(2, z_.get(), "z", "u");
+  }
+
+  /// Constructor of a grid of packed integers
+  ///
+  /// @see Grid2D::Grid2D
   Grid3D(std::shared_ptr<Axis> x, std::shared_ptr<Axis> y,
-         std::shared_ptr<Axis> z, pybind11::array_t<T> u)
-      : Grid2D<T, 3>(x, y, std::move(u)), z_(std::move(z)) {
+         std::shared_ptr<Axis> z, pybind11::array_t<T> u,
+         const double scale_factor, const double add_offset,
+         const std::optional<T>& fill_value,
+         const std::optional<std::vector<ssize_t>>& axes = {})
+      : Grid2D<T, 3>(x, y, std::move(u), scale_factor, add_offset,
+                     fill_value, axes),
+        z_(std::move(z)) {
     this->check_shape(2, z_.get(), "z", "u");
   }
 
@@ -126,27 +348,77 @@ class Grid3D : public Grid2D<T, 3> {
   inline const std::shared_ptr<Axis> z() const noexcept { return z_; }
 
   /// Pickle support: get state of this instance
+  ///
+  /// @see Grid2D::getstate
   pybind11::tuple getstate() const final {
-    return pybind11::make_tuple(this->x_->getstate(), this->y_->getstate(),
-                                z_->getstate(), this->array_);
+    if constexpr (std::is_integral_v<T>) {
+      return pybind11::make_tuple(
+          this->x_->getstate(), this->y_->getstate(), z_->getstate(),
+          this->native_array(), this->packing_.scale_factor,
+          this->packing_.add_offset, this->fill_value(), this->axes_);
+    } else {
+      return pybind11::make_tuple(this->x_->getstate(), this->y_->getstate(),
+                                  z_->getstate(), this->native_array(),
+                                  this->axes_);
+    }
   }
 
   /// Pickle support: set state of this instance
   static Grid3D setstate(const pybind11::tuple& tuple) {
-    if (tuple.size() != 4) {
+    auto size = size_t(std::is_integral_v<T> ? 7 : 4);
+    if (tuple.size() != size && tuple.size() != size + 1) {
       throw std::runtime_error("invalid state");
     }
-    return Grid3D(std::make_shared<Axis>(
-                      Axis::setstate(tuple[0].cast<pybind11::tuple>())),
-                  std::make_shared<Axis>(
-                      Axis::setstate(tuple[1].cast<pybind11::tuple>())),
-                  std::make_shared<Axis>(
-                      Axis::setstate(tuple[2].cast<pybind11::tuple>())),
-                  tuple[3].cast<pybind11::array_t<T>>());
+    auto axes = Grid3D::state_axes(tuple, size);
+    auto x = std::make_shared<Axis>(
+        Axis::setstate(tuple[0].cast<pybind11::tuple>()));
+    auto y = std::make_shared<Axis>(
+        Axis::setstate(tuple[1].cast<pybind11::tuple>()));
+    auto z = std::make_shared<Axis>(
+        Axis::setstate(tuple[2].cast<pybind11::tuple>()));
+    if constexpr (std::is_integral_v<T>) {
+      return Grid3D(x, y, z, tuple[3].cast<pybind11::array_t<T>>(),
+                    tuple[4].cast<double>(), tuple[5].cast<double>(),
+                    tuple[6].cast<std::optional<T>>(), axes);
+    } else {
+      return Grid3D(x, y, z, tuple[3].cast<pybind11::array_t<T>>(), axes);
+    }
   }
 
  protected:
   std::shared_ptr<Axis> z_;
 };
 
+/// Registers the properties describing the decoding of the values of a grid
+/// of packed integers.
+template <typename Grid>
+void implement_packing(pybind11::class_<Grid>& cls) {
+  cls.def_property_readonly(
+         "scale_factor",
+         [](const Grid& self) { return self.packing().scale_factor; },
+         R"__doc__(
+Gets the factor applied to the packed integers
+
+Returns:
+    float: scale factor
+)__doc__")
+      .def_property_readonly(
+          "add_offset",
+          [](const Grid& self) { return self.packing().add_offset; },
+          R"__doc__(
+Gets the offset added to the packed integers multiplied by the scale factor
+
+Returns:
+    float: offset
+)__doc__")
+      .def_property_readonly(
+          "fill_value", [](const Grid& self) { return self.fill_value(); },
+          R"__doc__(
+Gets the integer representing the undefined values
+
+Returns:
+    int, optional: fill value, or None if all the integers represent a value
+)__doc__");
+}
+
 }  // namespace pyinterp
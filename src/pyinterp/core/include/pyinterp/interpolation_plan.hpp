@@ -0,0 +1,173 @@
+// Copyright (c) 2019 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include "pyinterp/detail/broadcast.hpp"
+#include "pyinterp/detail/thread.hpp"
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace pyinterp {
+
+/// Interpolation of a fixed set of positions on a grid, precomputed once in
+/// order to interpolate many arrays defined on this grid.
+///
+/// The plan is a sparse matrix, stored in the CSR (compressed sparse row)
+/// format, of shape (number of positions, nx * ny): the row i holds the
+/// weights of the grid values used to interpolate the position i, the
+/// columns being the indexes of these values in the grid flattened in C
+/// order. Interpolating an array only gathers and blends its values. The
+/// positions located outside the grid have an empty row and are interpolated
+/// to NaN. The arrays interpolated are stored like the array of the grid:
+/// (nx, ny), or (ny, nx) if the grid reads its array transposed.
+class InterpolationPlan {
+ public:
+  /// Default constructor
+  ///
+  /// @param nx Number of elements of the X-Axis of the grid
+  /// @param ny Number of elements of the Y-Axis of the grid
+  /// @param indptr Index, in indices and weights, of the first item of each
+  /// row, followed by the number of items.
+  /// @param indices Index of the grid values used by each row
+  /// @param weights Weight of the grid values used by each row
+  /// @param transposed True if the arrays interpolated are stored (ny, nx)
+  InterpolationPlan(size_t nx, size_t ny, std::vector<int64_t> indptr,
+                    std::vector<int64_t> indices, std::vector<double> weights,
+                    bool transposed = false);
+
+  /// Gets the number of positions interpolated
+  inline size_t size() const noexcept { return indptr_.size() - 1; }
+
+  /// Gets the shape of the grid
+  inline pybind11::tuple grid_shape() const {
+    return pybind11::make_tuple(nx_, ny_);
+  }
+
+  /// True if the arrays interpolated are stored (ny, nx)
+  inline bool transposed() const noexcept { return transposed_; }
+
+  /// Gets the index of the first item of each row
+  pybind11::array_t<int64_t> indptr() const;
+
+  /// Gets the index of the grid values used by each row
+  pybind11::array_t<int64_t> indices() const;
+
+  /// Gets the weight of the grid values used by each row
+  pybind11::array_t<double> weights() const;
+
+  /// Interpolates an array, or a stack of arrays, defined on the grid.
+  ///
+  /// @param array Array of shape (nx, ny), or of shape (nx, ny, k) for a
+  /// stack of k arrays; (ny, nx) or (ny, nx, k) if the plan is transposed.
+  /// @param num_threads Number of threads to use
+  /// @return The values interpolated, of shape (size) or (size, k).
+  template <typename Type>
+  pybind11::array_t<double> apply(const pybind11::array_t<Type>& array,
+                                  const size_t num_threads) const {
+    // Dimensions of the array holding the X and Y axes
+    auto x_dim = transposed_ ? 1 : 0;
+    auto y_dim = 1 - x_dim;
+    if ((array.ndim() != 2 && array.ndim() != 3) ||
+        static_cast<size_t>(array.shape(x_dim)) != nx_ ||
+        static_cast<size_t>(array.shape(y_dim)) != ny_) {
+      auto shape = transposed_
+                       ? std::to_string(ny_) + ", " + std::to_string(nx_)
+                       : std::to_string(nx_) + ", " + std::to_string(ny_);
+      throw std::invalid_argument("array must be an array of shape (" +
+                                  shape + ") or (" + shape +
+                                  ", k): " + detail::ndarray_shape(array));
+    }
+    auto size = static_cast<pybind11::ssize_t>(this->size());
+    auto stack = array.ndim() == 3 ? array.shape(2) : 1;
+    auto result = array.ndim() == 3
+                      ? pybind11::array_t<double>(
+                            pybind11::array::ShapeContainer{size, stack})
+                      : pybind11::array_t<double>(
+                            pybind11::array::ShapeContainer{size});
+    const auto* base = reinterpret_cast<const char*>(array.data());
+    auto x_stride = array.strides(x_dim);
+    auto y_stride = array.strides(y_dim);
+    auto k_stride = array.ndim() == 3 ? array.strides(2) : 0;
+    auto ny = static_cast<int64_t>(ny_);
+    // If the rows of the grid are stored one after the other, the offset of
+    // a value is proportional to its index: the division is avoided.
+    auto c_order = x_stride == ny * y_stride;
+    auto* values = result.mutable_data();
+    {
+      pybind11::gil_scoped_release release;
+
+      detail::dispatch(
+          [&](size_t start, size_t end) {
+            // Offsets, in bytes, of the grid values used by a row
+            auto offsets = std::vector<pybind11::ssize_t>();
+
+            for (size_t ix = start; ix < end; ++ix) {
+              auto* row = values + ix * stack;
+              auto first = indptr_[ix];
+              auto last = indptr_[ix + 1];
+              if (first == last) {
+                std::fill(row, row + stack,
+                          std::numeric_limits<double>::quiet_NaN());
+                continue;
+              }
+              auto offset = [&](const int64_t jx) -> pybind11::ssize_t {
+                auto index = indices_[jx];
+                return c_order ? index * y_stride
+                               : (index / ny) * x_stride +
+                                     (index % ny) * y_stride;
+              };
+              auto value = [&](const pybind11::ssize_t offset) {
+                return static_cast<double>(
+                    *reinterpret_cast<const Type*>(base + offset));
+              };
+              if (stack == 1) {
+                auto sum = 0.0;
+                for (auto jx = first; jx < last; ++jx) {
+                  sum += weights_[jx] * value(offset(jx));
+                }
+                *row = sum;
+                continue;
+              }
+              // The offsets are calculated once for all the arrays stacked.
+              offsets.resize(last - first);
+              for (auto jx = first; jx < last; ++jx) {
+                offsets[jx - first] = offset(jx);
+              }
+              for (pybind11::ssize_t kx = 0; kx < stack; ++kx) {
+                auto sum = 0.0;
+                for (auto jx = first; jx < last; ++jx) {
+                  sum += weights_[jx] *
+                         value(offsets[jx - first] + kx * k_stride);
+                }
+                row[kx] = sum;
+              }
+            }
+          },
+          this->size(), num_threads);
+    }
+    return result;
+  }
+
+  /// Pickle support: get state of this instance
+  pybind11::tuple getstate() const;
+
+  /// Pickle support: set state of this instance
+  static InterpolationPlan setstate(const pybind11::tuple& state);
+
+ private:
+  size_t nx_;
+  size_t ny_;
+  std::vector<int64_t> indptr_;
+  std::vector<int64_t> indices_;
+  std::vector<double> weights_;
+  bool transposed_;
+};
+
+}  // namespace pyinterp
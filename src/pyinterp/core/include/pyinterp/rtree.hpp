@@ -6,6 +6,7 @@
 #include "pyinterp/detail/broadcast.hpp"
 #include "pyinterp/detail/geodetic/rtree.hpp"
 #include "pyinterp/detail/geodetic/system.hpp"
+#include "pyinterp/detail/morton.hpp"
 #include "pyinterp/detail/thread.hpp"
 #include "pyinterp/geodetic/system.hpp"
 #include <pybind11/pybind11.h>
@@ -82,14 +83,19 @@ class RTree : public detail::geodetic::RTree<Coordinate, Type> {
   /// Search for the nearest K nearest neighbors of a given coordinates.
   pybind11::tuple query(const pybind11::array_t<Type> &coordinates,
                         const uint32_t k, const bool within,
-                        const size_t num_threads) const {
+                        const size_t num_threads,
+                        const detail::Schedule schedule = detail::kStatic,
+                        const size_t chunk_size = 0,
+                        const bool reorder = false) const {
     detail::check_array_ndim("coordinates", 2, coordinates);
     switch (coordinates.shape(1)) {
       case 2:
-        return _query<2>(coordinates, k, within, num_threads);
+        return _query<2>(coordinates, k, within, num_threads, schedule,
+                         chunk_size, reorder);
         break;
       case 3:
-        return _query<3>(coordinates, k, within, num_threads);
+        return _query<3>(coordinates, k, within, num_threads, schedule,
+                         chunk_size, reorder);
         break;
       default:
         throw std::invalid_argument(
@@ -104,16 +110,19 @@ class RTree : public detail::geodetic::RTree<Coordinate, Type> {
       const pybind11::array_t<Type> &coordinates,
       distance_t radius = std::numeric_limits<distance_t>::max(),
       uint32_t k = 4, uint32_t p = 2, bool within = true,
-      size_t num_threads = 0) const {
+      size_t num_threads = 0, detail::Schedule schedule = detail::kStatic,
+      size_t chunk_size = 0) const {
     detail::check_array_ndim("coordinates", 2, coordinates);
     switch (coordinates.shape(1)) {
       case 2:
         return _inverse_distance_weighting<2>(coordinates, radius, k, p, within,
-                                              num_threads);
+                                              num_threads, schedule,
+                                              chunk_size);
         break;
       case 3:
         return _inverse_distance_weighting<3>(coordinates, radius, k, p, within,
-                                              num_threads);
+                                              num_threads, schedule,
+                                              chunk_size);
         break;
       default:
         throw std::invalid_argument(
@@ -166,15 +175,16 @@ class RTree : public detail::geodetic::RTree<Coordinate, Type> {
       throw std::runtime_error("invalid state");
     }
 
-    auto _x = x.template mutable_unchecked<1>();
-    auto _y = y.template mutable_unchecked<1>();
-    auto _z = z.template mutable_unchecked<1>();
-    auto _u = u.template mutable_unchecked<1>();
+    // The arrays can be read-only buffers transmitted out of band by pickle.
+    auto _x = x.template unchecked<1>();
+    auto _y = y.template unchecked<1>();
+    auto _z = z.template unchecked<1>();
+    auto _u = u.template unchecked<1>();
 
     auto vector = std::vector<typename RTree<Coordinate, Type>::value_t>();
     vector.reserve(x.size());
 
-    for (auto ix = 0; ix < x.size(); ++ix) {
+    for (ssize_t ix = 0; ix < x.size(); ++ix) {
       vector.emplace_back(std::make_pair(
           detail::geometry::Point3D<Coordinate>{_x(ix), _y(ix), _z(ix)},
           _u(ix)));
@@ -242,7 +252,9 @@ class RTree : public detail::geodetic::RTree<Coordinate, Type> {
   template <size_t Dimensions>
   pybind11::tuple _query(const pybind11::array_t<Coordinate> &coordinates,
                          const uint32_t k, const bool within,
-                         const size_t num_threads) const {
+                         const size_t num_threads,
+                         const detail::Schedule schedule,
+                         const size_t chunk_size, const bool reorder) const {
     // Signature of the function of the class to be called.
     using query_t = std::vector<
         typename detail::geodetic::RTree<Coordinate, Type>::result_t> (
@@ -277,49 +289,45 @@ class RTree : public detail::geodetic::RTree<Coordinate, Type> {
     {
       pybind11::gil_scoped_release release;
 
-      // Captures the detected exceptions in the calculation function
-      // (only the last exception captured is kept)
-      auto except = std::exception_ptr(nullptr);
+      // Order in which the positions are processed, if they are reordered.
+      auto indexes = reorder ? detail::morton::order<Dimensions>(
+                                   [&](const size_t ix, const size_t dim) {
+                                     return _coordinates(ix, dim);
+                                   },
+                                   size, num_threads)
+                             : std::vector<size_t>();
 
       detail::dispatch(
           [&](size_t start, size_t end) {
-            try {
-              auto point = detail::geometry::EquatorialPoint3D<Coordinate>();
-              for (size_t ix = start; ix < end; ++ix) {
-                auto dim = 0ULL;
-
-                for (; dim < Dimensions; ++dim) {
-                  detail::geometry::point::set(point, _coordinates(ix, dim),
-                                               dim);
-                }
-                for (; dim < 3; ++dim) {
-                  detail::geometry::point::set(point, Coordinate(0), dim);
-                }
-
-                auto nearest = method(*this, point, k);
-                auto jx = 0ULL;
-
-                // Fill in the calculation result for all neighbors found
-                for (; jx < nearest.size(); ++jx) {
-                  _distance(ix, jx) = nearest[jx].first;
-                  _value(ix, jx) = nearest[jx].second;
-                }
-
-                // The rest of the result is filled with invalid values.
-                for (; jx < k; ++jx) {
-                  _distance(ix, jx) = -1;
-                  _value(ix, jx) = Type(-1);
-                }
+            auto point = detail::geometry::EquatorialPoint3D<Coordinate>();
+            for (size_t item = start; item < end; ++item) {
+              auto ix = indexes.empty() ? item : indexes[item];
+              auto dim = 0ULL;
+
+              for (; dim < Dimensions; ++dim) {
+                detail::geometry::point::set(point, _coordinates(ix, dim), dim);
+              }
+              for (; dim < 3; ++dim) {
+                detail::geometry::point::set(point, Coordinate(0), dim);
+              }
+
+              auto nearest = method(*this, point, k);
+              auto jx = 0ULL;
+
+              // Fill in the calculation result for all neighbors found
+              for (; jx < nearest.size(); ++jx) {
+                _distance(ix, jx) = nearest[jx].first;
+                _value(ix, jx) = nearest[jx].second;
+              }
+
+              // The rest of the result is filled with invalid values.
+              for (; jx < k; ++jx) {
+                _distance(ix, jx) = -1;
+                _value(ix, jx) = Type(-1);
               }
-            } catch (...) {
-              except = std::current_exception();
             }
           },
-          size, num_threads);
-
-      if (except != nullptr) {
-        std::rethrow_exception(except);
-      }
+          size, num_threads, schedule, chunk_size);
     }
     return pybind11::make_tuple(distance, value);
   }
@@ -328,7 +336,8 @@ class RTree : public detail::geodetic::RTree<Coordinate, Type> {
   template <size_t Dimensions>
   pybind11::tuple _inverse_distance_weighting(
       const pybind11::array_t<Type> &coordinates, distance_t radius, uint32_t k,
-      uint32_t p, bool within, size_t num_threads) const {
+      uint32_t p, bool within, size_t num_threads, detail::Schedule schedule,
+      size_t chunk_size) const {
     auto _coordinates = coordinates.template unchecked<2>();
     auto size = coordinates.shape(0);
 
@@ -344,40 +353,27 @@ class RTree : public detail::geodetic::RTree<Coordinate, Type> {
     {
       pybind11::gil_scoped_release release;
 
-      // Captures the detected exceptions in the calculation function
-      // (only the last exception captured is kept)
-      auto except = std::exception_ptr(nullptr);
-
       detail::dispatch(
           [&](size_t start, size_t end) {
-            try {
-              auto point = detail::geometry::EquatorialPoint3D<Coordinate>();
-              for (size_t ix = start; ix < end; ++ix) {
-                auto dim = 0ULL;
-
-                for (; dim < Dimensions; ++dim) {
-                  detail::geometry::point::set(point, _coordinates(ix, dim),
-                                               dim);
-                }
-                for (; dim < 3; ++dim) {
-                  detail::geometry::point::set(point, Coordinate(0), dim);
-                }
-
-                auto result = detail::geodetic::RTree<
-                    Coordinate, Type>::inverse_distance_weighting(point, radius,
-                                                                  k, p, within);
-                _data(ix) = result.first;
-                _neighbors(ix) = result.second;
+            auto point = detail::geometry::EquatorialPoint3D<Coordinate>();
+            for (size_t ix = start; ix < end; ++ix) {
+              auto dim = 0ULL;
+
+              for (; dim < Dimensions; ++dim) {
+                detail::geometry::point::set(point, _coordinates(ix, dim), dim);
               }
-            } catch (...) {
-              except = std::current_exception();
+              for (; dim < 3; ++dim) {
+                detail::geometry::point::set(point, Coordinate(0), dim);
+              }
+
+              auto result = detail::geodetic::RTree<
+                  Coordinate, Type>::inverse_distance_weighting(point, radius,
+                                                                k, p, within);
+              _data(ix) = result.first;
+              _neighbors(ix) = result.second;
             }
           },
-          size, num_threads);
-
-      if (except != nullptr) {
-        std::rethrow_exception(except);
-      }
+          size, num_threads, schedule, chunk_size);
     }
     return pybind11::make_tuple(data, neighbors);
   }
@@ -0,0 +1,269 @@
+// Copyright (c) 2019 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include "pyinterp/bivariate.hpp"
+#include "pyinterp/detail/broadcast.hpp"
+#include "pyinterp/detail/morton.hpp"
+#include "pyinterp/detail/thread.hpp"
+#include "pyinterp/tiled_grid.hpp"
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+#include <array>
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+namespace pyinterp {
+
+/// Interpolation of a bivariate function whose values are loaded on demand,
+/// by tiles.
+///
+/// @tparam Coordinate The type of data used by the interpolators.
+/// @tparam Type The type of data used by the numerical grid.
+template <template <class> class Point, typename Coordinate, typename Type>
+class TiledBivariate : public TiledGrid<Type, 2> {
+ public:
+  /// Default constructor
+  ///
+  /// @see TiledGrid::TiledGrid
+  TiledBivariate(std::shared_ptr<Axis> x, std::shared_ptr<Axis> y,
+                 std::shared_ptr<TileProvider<Type, 2>> provider,
+                 const std::array<int64_t, 2>& tile_shape,
+                 const size_t cache_size)
+      : TiledGrid<Type, 2>({std::move(x), std::move(y)}, std::move(provider),
+                           tile_shape, cache_size) {}
+
+  /// Gets the X-Axis
+  inline const std::shared_ptr<Axis>& x() const noexcept {
+    return this->axes_[0];
+  }
+
+  /// Gets the Y-Axis
+  inline const std::shared_ptr<Axis>& y() const noexcept {
+    return this->axes_[1];
+  }
+
+  /// Interpolates data using the defined interpolation function. Only the
+  /// tiles framing the positions are loaded.
+  pybind11::array_t<Coordinate> evaluate(
+      const pybind11::array_t<Coordinate>& x,
+      const pybind11::array_t<Coordinate>& y,
+      const BivariateInterpolator<Point, Coordinate>* interpolator,
+      const bool bounds_error, const size_t num_threads,
+      const detail::Schedule schedule, const size_t chunk_size,
+      const bool reorder) const {
+    auto shape = detail::broadcast_shape("x", x, "y", y);
+    auto result = pybind11::array_t<Coordinate>(shape);
+    auto size = static_cast<size_t>(result.size());
+    auto _x = detail::FlatView<const Coordinate>(x.data(), x, shape);
+    auto _y = detail::FlatView<const Coordinate>(y.data(), y, shape);
+    auto _result =
+        detail::FlatView<Coordinate>(result.mutable_data(), result, shape);
+
+    {
+      pybind11::gil_scoped_release release;
+
+      // Order in which the values are processed, if they are reordered: the
+      // positions of a block then use fewer tiles.
+      auto indexes =
+          reorder ? detail::morton::order<2>(
+                        [&](const size_t ix, const size_t dim) {
+                          return dim == 0 ? _x(ix) : _y(ix);
+                        },
+                        size, num_threads)
+                  : std::vector<size_t>();
+
+      detail::math::visit(interpolator, [&](const auto& kernel) {
+        this->x()->visit([&](const auto& x_axis) {
+          this->y()->visit([&](const auto& y_axis) {
+            this->_evaluate(x_axis, y_axis, _x, _y, _result, kernel,
+                            bounds_error, size, num_threads, schedule,
+                            chunk_size, indexes);
+          });
+        });
+      });
+    }
+    return result;
+  }
+
+ private:
+  using TileKeys = typename TiledGrid<Type, 2>::TileKeys;
+  using TileSet = typename TiledGrid<Type, 2>::TileSet;
+
+  /// Interpolates data using the defined interpolation function.
+  ///
+  /// @see Bivariate::_evaluate
+  template <typename X, typename Y, typename Interpolator>
+  void _evaluate(const X& x_axis, const Y& y_axis,
+                 const detail::FlatView<const Coordinate>& _x,
+                 const detail::FlatView<const Coordinate>& _y,
+                 const detail::FlatView<Coordinate>& _result,
+                 const Interpolator& interpolator, const bool bounds_error,
+                 const size_t size, const size_t num_threads,
+                 const detail::Schedule schedule, const size_t chunk_size,
+                 const std::vector<size_t>& indexes) const {
+    detail::dispatch(
+        [&](size_t start, size_t end) {
+          auto x_cursor = detail::axis::Cursor();
+          auto y_cursor = detail::axis::Cursor();
+
+          this->for_each_block(
+              start, end,
+              [&](const size_t jx, TileKeys& keys) {
+                auto ix = indexes.empty() ? jx : indexes[jx];
+                auto x_indexes =
+                    this->x()->template find_indexes<X>(_x(ix), x_cursor);
+                auto y_indexes =
+                    this->y()->template find_indexes<Y>(_y(ix), y_cursor);
+                if (x_indexes.has_value() && y_indexes.has_value()) {
+                  int64_t i[2], j[2];
+                  std::tie(i[0], i[1]) = *x_indexes;
+                  std::tie(j[0], j[1]) = *y_indexes;
+                  keys.add({{{i, 2}, {j, 2}}});
+                }
+              },
+              [&](const size_t jx, const TileSet& tiles) {
+                auto ix = indexes.empty() ? jx : indexes[jx];
+                _result(ix) =
+                    _interpolate(x_axis, y_axis, _x(ix), _y(ix), interpolator,
+                                 bounds_error, x_cursor, y_cursor, tiles);
+              });
+        },
+        size, num_threads, schedule, chunk_size);
+  }
+
+  /// Interpolates the value of a position.
+  ///
+  /// @see Bivariate::_interpolate
+  template <typename X, typename Y, typename Interpolator>
+  Coordinate _interpolate(const X& x_axis, const Y& y_axis, const Coordinate x,
+                          const Coordinate y, const Interpolator& interpolator,
+                          const bool bounds_error,
+                          detail::axis::Cursor& x_cursor,
+                          detail::axis::Cursor& y_cursor,
+                          const TileSet& tiles) const {
+    auto x_indexes = this->x()->template find_indexes<X>(x, x_cursor);
+    auto y_indexes = this->y()->template find_indexes<Y>(y, y_cursor);
+
+    if (x_indexes.has_value() && y_indexes.has_value()) {
+      int64_t ix0, ix1, iy0, iy1;
+      std::tie(ix0, ix1) = *x_indexes;
+      std::tie(iy0, iy1) = *y_indexes;
+
+      auto x0 = static_cast<Coordinate>(x_axis.coordinate_value(ix0));
+
+      return interpolator.evaluate(
+          Point<Coordinate>(
+              this->x()->is_angle() ? detail::math::normalize_angle(x, x0)
+                                    : x,
+              y),
+          Point<Coordinate>(x0, y_axis.coordinate_value(iy0)),
+          Point<Coordinate>(x_axis.coordinate_value(ix1),
+                            y_axis.coordinate_value(iy1)),
+          static_cast<Coordinate>(tiles(ix0, iy0)),
+          static_cast<Coordinate>(tiles(ix0, iy1)),
+          static_cast<Coordinate>(tiles(ix1, iy0)),
+          static_cast<Coordinate>(tiles(ix1, iy1)));
+    }
+    if (bounds_error) {
+      if (!x_indexes.has_value()) {
+        TiledBivariate::index_error(*this->x(), x, "x");
+      }
+      TiledBivariate::index_error(*this->y(), y, "y");
+    }
+    return std::numeric_limits<Coordinate>::quiet_NaN();
+  }
+};
+
+template <template <class> class Point, typename Coordinate, typename Type>
+void implement_tiled_bivariate(pybind11::module& m,
+                               const char* const class_name) {
+  using TiledBivariate = pyinterp::TiledBivariate<Point, Coordinate, Type>;
+
+  auto cls = pybind11::class_<TiledBivariate>(m, class_name, R"__doc__(
+Interpolation of bivariate functions whose values are loaded on demand, by
+tiles. The tiles loaded are kept in a cache of bounded capacity.
+)__doc__");
+  cls.def(pybind11::init([](std::shared_ptr<Axis> x, std::shared_ptr<Axis> y,
+                            pybind11::function provider,
+                            const std::array<int64_t, 2>& tile_shape,
+                            const size_t cache_size) {
+            return new TiledBivariate(
+                std::move(x), std::move(y),
+                std::make_shared<PythonTileProvider<Type, 2>>(
+                    std::move(provider)),
+                tile_shape, cache_size);
+          }),
+          pybind11::arg("x"), pybind11::arg("y"), pybind11::arg("provider"),
+          pybind11::arg("tile_shape"), pybind11::arg("cache_size") = 256,
+          R"__doc__(
+Default constructor
+
+Args:
+    x (pyinterp.core.Axis): X-Axis
+    y (pyinterp.core.Axis): Y-Axis
+    provider (callable): Function returning the values of a tile. It
+        receives a tuple of two slices, selecting the tile along the X and Y
+        axes, and returns the array of the values selected.
+    tile_shape (tuple): Number of values of a tile along the X and Y axes.
+    cache_size (int, optional): Maximum number of tiles kept in memory.
+        Defaults to ``256``.
+)__doc__")
+      .def_property_readonly(
+          "x", [](const TiledBivariate& self) { return self.x(); },
+          R"__doc__(
+Gets the X-Axis handled by this instance
+
+Returns:
+    pyinterp.core.Axis: X-Axis
+)__doc__")
+      .def_property_readonly(
+          "y", [](const TiledBivariate& self) { return self.y(); },
+          R"__doc__(
+Gets the Y-Axis handled by this instance
+
+Returns:
+    pyinterp.core.Axis: Y-Axis
+)__doc__")
+      .def("evaluate", &TiledBivariate::evaluate, pybind11::arg("x"),
+           pybind11::arg("y"), pybind11::arg("interpolator"),
+           pybind11::arg("bounds_error") = false,
+           pybind11::arg("num_threads") = 0,
+           pybind11::arg("schedule") = detail::kStatic,
+           pybind11::arg("chunk_size") = 0, pybind11::arg("reorder") = false,
+           R"__doc__(
+Interpolate the values provided on the defined bivariate function. The tiles
+used by the positions are loaded, if they are not cached, by blocks of
+positions: the positions processed consecutively should be close to each
+other, which ``reorder`` ensures.
+
+Args:
+    x (numpy.ndarray): X-values, array of any shape
+    y (numpy.ndarray): Y-values, array of any shape
+    interpolator (pyinterp.core.BivariateInterpolator2D): 2D interpolator
+      used to interpolate.
+    bounds_error (bool, optional): If True, when interpolated values are
+      requested outside of the domain of the input axes (x,y), a ValueError
+      is raised. If False, then value is set to Nan.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+    schedule (pyinterp.core.Schedule, optional): Distribution of the values
+        between the threads. Defaults to ``Static``.
+    chunk_size (int, optional): Number of values claimed at once by a thread
+        with the ``Dynamic`` schedule. Defaults to ``0``.
+    reorder (bool, optional): If True, the values are processed in the
+        order of a space-filling curve (Morton order). Defaults to
+        ``False``.
+Return:
+    numpy.ndarray: Values interpolated, of the shape of the coordinates
+)__doc__");
+  implement_tiled_grid(cls);
+}
+
+}  // namespace pyinterp
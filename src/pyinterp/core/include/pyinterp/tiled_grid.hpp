@@ -0,0 +1,401 @@
+// Copyright (c) 2019 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include "pyinterp/axis.hpp"
+#include "pyinterp/detail/broadcast.hpp"
+#include "pyinterp/detail/lru_cache.hpp"
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace pyinterp {
+
+/// Block of values of a tiled grid
+template <typename T, size_t Dimension>
+struct Tile {
+  /// Index of the first value of the tile along each axis
+  std::array<int64_t, Dimension> start;
+  /// Number of values of the tile along each axis
+  std::array<int64_t, Dimension> count;
+  /// Values of the tile, stored in C order
+  std::vector<T> values;
+};
+
+/// Source of the values of a tiled grid
+template <typename T, size_t Dimension>
+class TileProvider {
+ public:
+  /// Default destructor
+  virtual ~TileProvider() = default;
+
+  /// Loads the values of several tiles. This method is called by several
+  /// threads simultaneously.
+  ///
+  /// @param tiles Tiles to load: their start and count are set, their
+  /// values, sized accordingly, are to be filled in.
+  virtual void load(const std::vector<Tile<T, Dimension>*>& tiles) const = 0;
+};
+
+/// Tile provider calling a Python function. The function receives a tuple of
+/// slices, one per axis of the grid, and returns the array of the values
+/// selected.
+template <typename T, size_t Dimension>
+class PythonTileProvider : public TileProvider<T, Dimension> {
+ public:
+  /// Default constructor
+  explicit PythonTileProvider(pybind11::function function)
+      : function_(std::move(function)) {}
+
+  /// Loads the tiles with one acquisition of the GIL.
+  void load(const std::vector<Tile<T, Dimension>*>& tiles) const override {
+    pybind11::gil_scoped_acquire acquire;
+
+    for (auto* tile : tiles) {
+      auto index = pybind11::tuple(Dimension);
+      for (size_t ix = 0; ix < Dimension; ++ix) {
+        index[ix] = pybind11::slice(tile->start[ix],
+                                    tile->start[ix] + tile->count[ix], 1);
+      }
+      auto array = function_(index)
+                       .template cast<pybind11::array_t<
+                           T, pybind11::array::c_style |
+                                  pybind11::array::forcecast>>();
+      auto valid = array.ndim() == static_cast<pybind11::ssize_t>(Dimension);
+      for (size_t ix = 0; valid && ix < Dimension; ++ix) {
+        valid = array.shape(ix) == tile->count[ix];
+      }
+      if (!valid) {
+        throw std::invalid_argument(
+            "the tile provider returned an array of shape " +
+            detail::ndarray_shape(array) + " instead of " + shape(*tile));
+      }
+      std::copy(array.data(), array.data() + array.size(),
+                tile->values.data());
+    }
+  }
+
+ private:
+  pybind11::function function_;
+
+  /// Gets a string representing the shape of a tile
+  static std::string shape(const Tile<T, Dimension>& tile) {
+    auto result = std::string("(");
+    for (size_t ix = 0; ix < Dimension; ++ix) {
+      result += (ix == 0 ? "" : ", ") + std::to_string(tile.count[ix]);
+    }
+    return result + ")";
+  }
+};
+
+/// Cartesian grid whose values are loaded on demand, by tiles, from a tile
+/// provider. The tiles loaded are kept in a cache of bounded capacity,
+/// shared by the threads.
+template <typename T, size_t Dimension>
+class TiledGrid {
+ public:
+  /// Tiles loaded for a block of positions. The tiles stay in memory while
+  /// this object exists, even if the cache discards them.
+  class TileSet {
+   public:
+    /// Gets the value of the grid located at the given index
+    template <typename... Index>
+    inline T operator()(const Index... index) const {
+      auto item = std::array<int64_t, Dimension>{index...};
+      const auto& tile = find(grid_->key(item));
+      auto offset = int64_t(0);
+      for (size_t ix = 0; ix < Dimension; ++ix) {
+        offset = offset * tile.count[ix] + (item[ix] - tile.start[ix]);
+      }
+      return tile.values[offset];
+    }
+
+   private:
+    friend class TiledGrid;
+
+    using Item = std::pair<int64_t, std::shared_ptr<const Tile<T, Dimension>>>;
+
+    const TiledGrid* grid_;
+    /// Tiles, sorted by key
+    std::vector<Item> tiles_;
+    /// Position of the last tile read
+    mutable size_t last_{0};
+
+    TileSet(const TiledGrid* grid, std::vector<Item>&& tiles)
+        : grid_(grid), tiles_(std::move(tiles)) {}
+
+    /// Gets the tile identified by the key, which must have been loaded.
+    inline const Tile<T, Dimension>& find(const int64_t key) const {
+      if (tiles_[last_].first != key) {
+        last_ = std::lower_bound(tiles_.begin(), tiles_.end(), key,
+                                 [](const Item& item, const int64_t value) {
+                                   return item.first < value;
+                                 }) -
+                tiles_.begin();
+      }
+      return *tiles_[last_].second;
+    }
+  };
+
+  /// Keys of the tiles holding the values used by a block of positions
+  class TileKeys {
+   public:
+    /// Default constructor
+    explicit TileKeys(const TiledGrid& grid) : grid_(&grid) {}
+
+    /// Records the tiles holding the values located at the intersection of
+    /// the indexes given for each axis.
+    ///
+    /// @param indexes Pointer to the indexes, and number of indexes, of each
+    /// axis
+    void add(const std::array<std::pair<const int64_t*, size_t>, Dimension>&
+                 indexes) {
+      // Coordinates of the tiles along each axis, without duplicates
+      for (size_t ix = 0; ix < Dimension; ++ix) {
+        auto& item = coordinates_[ix];
+        item.clear();
+        for (size_t jx = 0; jx < indexes[ix].second; ++jx) {
+          auto value = indexes[ix].first[jx] / grid_->tile_shape_[ix];
+          if (std::find(item.begin(), item.end(), value) == item.end()) {
+            item.push_back(value);
+          }
+        }
+      }
+      // Keys of the tiles located at the intersection of these coordinates
+      auto position = std::array<size_t, Dimension>{};
+      while (true) {
+        auto key = int64_t(0);
+        for (size_t ix = 0; ix < Dimension; ++ix) {
+          key = key * grid_->tiles_[ix] + coordinates_[ix][position[ix]];
+        }
+        if (keys_.empty() || keys_.back() != key) {
+          keys_.push_back(key);
+        }
+        auto ix = Dimension;
+        while (ix-- > 0) {
+          if (++position[ix] < coordinates_[ix].size()) {
+            break;
+          }
+          position[ix] = 0;
+        }
+        if (ix == static_cast<size_t>(-1)) {
+          break;
+        }
+      }
+    }
+
+    /// Gets the keys recorded, sorted and without duplicates
+    const std::vector<int64_t>& keys() {
+      std::sort(keys_.begin(), keys_.end());
+      keys_.erase(std::unique(keys_.begin(), keys_.end()), keys_.end());
+      return keys_;
+    }
+
+    /// Forgets the keys recorded
+    inline void clear() noexcept { keys_.clear(); }
+
+   private:
+    const TiledGrid* grid_;
+    std::vector<int64_t> keys_;
+    std::array<std::vector<int64_t>, Dimension> coordinates_;
+  };
+
+  /// Default constructor
+  ///
+  /// @param axes Axes of the grid
+  /// @param provider Source of the values of the grid
+  /// @param tile_shape Number of values of a tile along each axis
+  /// @param cache_size Maximum number of tiles kept in memory
+  TiledGrid(std::array<std::shared_ptr<Axis>, Dimension> axes,
+            std::shared_ptr<TileProvider<T, Dimension>> provider,
+            const std::array<int64_t, Dimension>& tile_shape,
+            const size_t cache_size)
+      : axes_(std::move(axes)),
+        provider_(std::move(provider)),
+        tile_shape_(tile_shape),
+        cache_(cache_size) {
+    for (size_t ix = 0; ix < Dimension; ++ix) {
+      if (tile_shape_[ix] < 1) {
+        throw std::invalid_argument(
+            "the shape of the tiles must contain positive values");
+      }
+      auto size = axes_[ix]->size();
+      tiles_[ix] = (size + tile_shape_[ix] - 1) / tile_shape_[ix];
+    }
+  }
+
+  /// Default destructor
+  virtual ~TiledGrid() = default;
+
+  /// Gets the number of values of a tile along each axis
+  inline const std::array<int64_t, Dimension>& tile_shape() const noexcept {
+    return tile_shape_;
+  }
+
+  /// Gets the maximum number of tiles kept in memory
+  inline size_t cache_size() const noexcept { return cache_.capacity(); }
+
+  /// Gets the statistics of the accesses to the tiles cached
+  inline detail::CacheStatistics cache_statistics() const {
+    return cache_.statistics();
+  }
+
+  /// Discards the tiles cached and resets the statistics
+  void clear_cache() {
+    cache_.clear();
+    cache_.reset_statistics();
+  }
+
+ protected:
+  /// Number of positions whose tiles are loaded at once
+  static constexpr size_t kBlockSize = 4096;
+
+  /// Axes of the grid
+  std::array<std::shared_ptr<Axis>, Dimension> axes_;
+
+  /// Throws an exception indicating that the value searched on the axis is
+  /// outside the domain axis.
+  ///
+  /// @param axis Axis involved.
+  /// @param value The value outside the axis domain.
+  /// @param axis_label The name of the axis
+  static void index_error(const Axis& axis, const double value,
+                          const std::string& axis_label) {
+    throw std::invalid_argument(std::to_string(value) +
+                                " is out ouf bounds for axis " + axis_label +
+                                " (" + static_cast<std::string>(axis) + ")");
+  }
+
+  /// Processes the positions [start, end) by blocks. The tiles used by the
+  /// positions of a block are searched, the tiles missing from the cache are
+  /// loaded all at once, then the positions of the block are processed.
+  ///
+  /// @param collect Function recording, in the TileKeys object, the tiles
+  /// used by the position at the given index.
+  /// @param process Function processing the position at the given index with
+  /// the values of the TileSet object.
+  template <typename Collect, typename Process>
+  void for_each_block(const size_t start, const size_t end, Collect&& collect,
+                      Process&& process) const {
+    auto keys = TileKeys(*this);
+    for (auto first = start; first < end; first += kBlockSize) {
+      auto last = std::min(first + kBlockSize, end);
+      keys.clear();
+      for (auto ix = first; ix < last; ++ix) {
+        collect(ix, keys);
+      }
+      auto tiles = fetch(keys.keys());
+      for (auto ix = first; ix < last; ++ix) {
+        process(ix, tiles);
+      }
+    }
+  }
+
+ private:
+  /// Source of the values of the grid
+  std::shared_ptr<TileProvider<T, Dimension>> provider_;
+  /// Number of values of a tile along each axis
+  std::array<int64_t, Dimension> tile_shape_;
+  /// Number of tiles along each axis
+  std::array<int64_t, Dimension> tiles_{};
+  /// Tiles loaded
+  mutable detail::LRUCache<int64_t, Tile<T, Dimension>> cache_;
+
+  /// Gets the key of the tile holding the value at the given index
+  inline int64_t key(const std::array<int64_t, Dimension>& index) const {
+    auto result = int64_t(0);
+    for (size_t ix = 0; ix < Dimension; ++ix) {
+      result = result * tiles_[ix] + index[ix] / tile_shape_[ix];
+    }
+    return result;
+  }
+
+  /// Gets the tiles identified by the keys, sorted, loading those missing
+  /// from the cache with a single call to the tile provider.
+  TileSet fetch(const std::vector<int64_t>& keys) const {
+    auto tiles = std::vector<typename TileSet::Item>();
+    auto missing = std::vector<std::shared_ptr<Tile<T, Dimension>>>();
+    tiles.reserve(keys.size());
+    for (auto key : keys) {
+      auto tile = cache_.get(key);
+      if (!tile) {
+        missing.emplace_back(allocate(key));
+        tile = missing.back();
+      }
+      tiles.emplace_back(key, std::move(tile));
+    }
+    if (!missing.empty()) {
+      auto items = std::vector<Tile<T, Dimension>*>();
+      items.reserve(missing.size());
+      for (auto& item : missing) {
+        items.push_back(item.get());
+      }
+      provider_->load(items);
+      for (size_t ix = 0, jx = 0; ix < tiles.size(); ++ix) {
+        if (jx < missing.size() && tiles[ix].second == missing[jx]) {
+          cache_.put(tiles[ix].first, missing[jx++]);
+        }
+      }
+    }
+    return TileSet(this, std::move(tiles));
+  }
+
+  /// Allocates the tile identified by the key
+  std::shared_ptr<Tile<T, Dimension>> allocate(int64_t key) const {
+    auto result = std::make_shared<Tile<T, Dimension>>();
+    auto size = int64_t(1);
+    for (auto ix = static_cast<int64_t>(Dimension) - 1; ix >= 0; --ix) {
+      auto coordinate = key % tiles_[ix];
+      key /= tiles_[ix];
+      result->start[ix] = coordinate * tile_shape_[ix];
+      result->count[ix] = std::min(tile_shape_[ix],
+                                   axes_[ix]->size() - result->start[ix]);
+      size *= result->count[ix];
+    }
+    result->values.resize(size);
+    return result;
+  }
+};
+
+/// Registers the properties and methods describing the tiles of a tiled
+/// grid.
+template <typename Grid>
+void implement_tiled_grid(pybind11::class_<Grid>& cls) {
+  cls.def_property_readonly(
+         "tile_shape", [](const Grid& self) { return self.tile_shape(); },
+         R"__doc__(
+Gets the number of values of a tile along each axis
+
+Returns:
+    tuple: shape of the tiles
+)__doc__")
+      .def_property_readonly(
+          "cache_size", [](const Grid& self) { return self.cache_size(); },
+          R"__doc__(
+Gets the maximum number of tiles kept in memory
+
+Returns:
+    int: capacity of the cache
+)__doc__")
+      .def("cache_statistics", &Grid::cache_statistics, R"__doc__(
+Gets the statistics of the accesses to the tiles cached
+
+Returns:
+    pyinterp.core.CacheStatistics: number of tiles found in the cache (hits),
+    loaded from the tile provider (misses) and discarded (evictions)
+)__doc__")
+      .def("clear_cache", &Grid::clear_cache, R"__doc__(
+Discards the tiles cached and resets the statistics of the cache
+)__doc__");
+}
+
+}  // namespace pyinterp
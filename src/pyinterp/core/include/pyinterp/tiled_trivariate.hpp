@@ -0,0 +1,310 @@
+// Copyright (c) 2019 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include "pyinterp/detail/broadcast.hpp"
+#include "pyinterp/detail/math/trivariate.hpp"
+#include "pyinterp/detail/morton.hpp"
+#include "pyinterp/detail/thread.hpp"
+#include "pyinterp/tiled_grid.hpp"
+#include "pyinterp/trivariate.hpp"
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+#include <array>
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+namespace pyinterp {
+
+/// Interpolation of a trivariate function whose values are loaded on demand,
+/// by tiles.
+///
+/// @tparam Coordinate The type of data used by the interpolators.
+/// @tparam Type The type of data used by the numerical grid.
+template <template <class> class Point, typename Coordinate, typename Type>
+class TiledTrivariate : public TiledGrid<Type, 3> {
+ public:
+  /// Default constructor
+  ///
+  /// @see TiledGrid::TiledGrid
+  TiledTrivariate(std::shared_ptr<Axis> x, std::shared_ptr<Axis> y,
+                  std::shared_ptr<Axis> z,
+                  std::shared_ptr<TileProvider<Type, 3>> provider,
+                  const std::array<int64_t, 3>& tile_shape,
+                  const size_t cache_size)
+      : TiledGrid<Type, 3>({std::move(x), std::move(y), std::move(z)},
+                           std::move(provider), tile_shape, cache_size) {}
+
+  /// Gets the X-Axis
+  inline const std::shared_ptr<Axis>& x() const noexcept {
+    return this->axes_[0];
+  }
+
+  /// Gets the Y-Axis
+  inline const std::shared_ptr<Axis>& y() const noexcept {
+    return this->axes_[1];
+  }
+
+  /// Gets the Z-Axis
+  inline const std::shared_ptr<Axis>& z() const noexcept {
+    return this->axes_[2];
+  }
+
+  /// Interpolates data using the defined interpolation function. Only the
+  /// tiles framing the positions are loaded.
+  pybind11::array_t<Coordinate> evaluate(
+      const pybind11::array_t<Coordinate>& x,
+      const pybind11::array_t<Coordinate>& y,
+      const pybind11::array_t<Coordinate>& z,
+      const Bivariate3D<Point, Coordinate>* interpolator,
+      const bool bounds_error, const size_t num_threads,
+      const detail::Schedule schedule, const size_t chunk_size,
+      const bool reorder) const {
+    auto shape = detail::broadcast_shape("x", x, "y", y, "z", z);
+    auto result = pybind11::array_t<Coordinate>(shape);
+    auto size = static_cast<size_t>(result.size());
+    auto _x = detail::FlatView<const Coordinate>(x.data(), x, shape);
+    auto _y = detail::FlatView<const Coordinate>(y.data(), y, shape);
+    auto _z = detail::FlatView<const Coordinate>(z.data(), z, shape);
+    auto _result =
+        detail::FlatView<Coordinate>(result.mutable_data(), result, shape);
+
+    {
+      pybind11::gil_scoped_release release;
+
+      // Order in which the values are processed, if they are reordered.
+      auto indexes =
+          reorder ? detail::morton::order<3>(
+                        [&](const size_t ix, const size_t dim) {
+                          return dim == 0 ? _x(ix) : dim == 1 ? _y(ix) : _z(ix);
+                        },
+                        size, num_threads)
+                  : std::vector<size_t>();
+
+      detail::math::visit(interpolator, [&](const auto& kernel) {
+        this->x()->visit([&](const auto& x_axis) {
+          this->y()->visit([&](const auto& y_axis) {
+            this->z()->visit([&](const auto& z_axis) {
+              this->_evaluate(x_axis, y_axis, z_axis, _x, _y, _z, _result,
+                              kernel, bounds_error, size, num_threads,
+                              schedule, chunk_size, indexes);
+            });
+          });
+        });
+      });
+    }
+    return result;
+  }
+
+ private:
+  using TileKeys = typename TiledGrid<Type, 3>::TileKeys;
+  using TileSet = typename TiledGrid<Type, 3>::TileSet;
+
+  /// Interpolates data using the defined interpolation function.
+  ///
+  /// @see Trivariate::_evaluate
+  template <typename X, typename Y, typename Z, typename Interpolator>
+  void _evaluate(const X& x_axis, const Y& y_axis, const Z& z_axis,
+                 const detail::FlatView<const Coordinate>& _x,
+                 const detail::FlatView<const Coordinate>& _y,
+                 const detail::FlatView<const Coordinate>& _z,
+                 const detail::FlatView<Coordinate>& _result,
+                 const Interpolator& interpolator, const bool bounds_error,
+                 const size_t size, const size_t num_threads,
+                 const detail::Schedule schedule, const size_t chunk_size,
+                 const std::vector<size_t>& indexes) const {
+    detail::dispatch(
+        [&](size_t start, size_t end) {
+          auto x_cursor = detail::axis::Cursor();
+          auto y_cursor = detail::axis::Cursor();
+          auto z_cursor = detail::axis::Cursor();
+
+          this->for_each_block(
+              start, end,
+              [&](const size_t jx, TileKeys& keys) {
+                auto ix = indexes.empty() ? jx : indexes[jx];
+                auto x_indexes =
+                    this->x()->template find_indexes<X>(_x(ix), x_cursor);
+                auto y_indexes =
+                    this->y()->template find_indexes<Y>(_y(ix), y_cursor);
+                auto z_indexes =
+                    this->z()->template find_indexes<Z>(_z(ix), z_cursor);
+                if (x_indexes.has_value() && y_indexes.has_value() &&
+                    z_indexes.has_value()) {
+                  int64_t i[2], j[2], k[2];
+                  std::tie(i[0], i[1]) = *x_indexes;
+                  std::tie(j[0], j[1]) = *y_indexes;
+                  std::tie(k[0], k[1]) = *z_indexes;
+                  keys.add({{{i, 2}, {j, 2}, {k, 2}}});
+                }
+              },
+              [&](const size_t jx, const TileSet& tiles) {
+                auto ix = indexes.empty() ? jx : indexes[jx];
+                _result(ix) = _interpolate(x_axis, y_axis, z_axis, _x(ix),
+                                           _y(ix), _z(ix), interpolator,
+                                           bounds_error, x_cursor, y_cursor,
+                                           z_cursor, tiles);
+              });
+        },
+        size, num_threads, schedule, chunk_size);
+  }
+
+  /// Interpolates the value of a position.
+  ///
+  /// @see Trivariate::_interpolate
+  template <typename X, typename Y, typename Z, typename Interpolator>
+  Coordinate _interpolate(const X& x_axis, const Y& y_axis, const Z& z_axis,
+                          const Coordinate x, const Coordinate y,
+                          const Coordinate z, const Interpolator& interpolator,
+                          const bool bounds_error,
+                          detail::axis::Cursor& x_cursor,
+                          detail::axis::Cursor& y_cursor,
+                          detail::axis::Cursor& z_cursor,
+                          const TileSet& tiles) const {
+    auto x_indexes = this->x()->template find_indexes<X>(x, x_cursor);
+    auto y_indexes = this->y()->template find_indexes<Y>(y, y_cursor);
+    auto z_indexes = this->z()->template find_indexes<Z>(z, z_cursor);
+
+    if (x_indexes.has_value() && y_indexes.has_value() &&
+        z_indexes.has_value()) {
+      int64_t ix0, ix1, iy0, iy1, iz0, iz1;
+      std::tie(ix0, ix1) = *x_indexes;
+      std::tie(iy0, iy1) = *y_indexes;
+      std::tie(iz0, iz1) = *z_indexes;
+
+      auto x0 = static_cast<Coordinate>(x_axis.coordinate_value(ix0));
+
+      return pyinterp::detail::math::trivariate<Point, Coordinate>(
+          Point<Coordinate>(
+              this->x()->is_angle() ? detail::math::normalize_angle(x, x0)
+                                    : x,
+              y, z),
+          Point<Coordinate>(x0, y_axis.coordinate_value(iy0),
+                            z_axis.coordinate_value(iz0)),
+          Point<Coordinate>(x_axis.coordinate_value(ix1),
+                            y_axis.coordinate_value(iy1),
+                            z_axis.coordinate_value(iz1)),
+          static_cast<Coordinate>(tiles(ix0, iy0, iz0)),
+          static_cast<Coordinate>(tiles(ix0, iy1, iz0)),
+          static_cast<Coordinate>(tiles(ix1, iy0, iz0)),
+          static_cast<Coordinate>(tiles(ix1, iy1, iz0)),
+          static_cast<Coordinate>(tiles(ix0, iy0, iz1)),
+          static_cast<Coordinate>(tiles(ix0, iy1, iz1)),
+          static_cast<Coordinate>(tiles(ix1, iy0, iz1)),
+          static_cast<Coordinate>(tiles(ix1, iy1, iz1)), &interpolator);
+    }
+    if (bounds_error) {
+      if (!x_indexes.has_value()) {
+        TiledTrivariate::index_error(*this->x(), x, "x");
+      }
+      if (!y_indexes.has_value()) {
+        TiledTrivariate::index_error(*this->y(), y, "y");
+      }
+      TiledTrivariate::index_error(*this->z(), z, "z");
+    }
+    return std::numeric_limits<Coordinate>::quiet_NaN();
+  }
+};
+
+template <template <class> class Point, typename Coordinate, typename Type>
+void implement_tiled_trivariate(pybind11::module& m,
+                                const char* const class_name) {
+  using TiledTrivariate = pyinterp::TiledTrivariate<Point, Coordinate, Type>;
+
+  auto cls = pybind11::class_<TiledTrivariate>(m, class_name, R"__doc__(
+Interpolation of trivariate functions whose values are loaded on demand, by
+tiles. The tiles loaded are kept in a cache of bounded capacity.
+)__doc__");
+  cls.def(pybind11::init([](std::shared_ptr<Axis> x, std::shared_ptr<Axis> y,
+                            std::shared_ptr<Axis> z,
+                            pybind11::function provider,
+                            const std::array<int64_t, 3>& tile_shape,
+                            const size_t cache_size) {
+            return new TiledTrivariate(
+                std::move(x), std::move(y), std::move(z),
+                std::make_shared<PythonTileProvider<Type, 3>>(
+                    std::move(provider)),
+                tile_shape, cache_size);
+          }),
+          pybind11::arg("x"), pybind11::arg("y"), pybind11::arg("z"),
+          pybind11::arg("provider"), pybind11::arg("tile_shape"),
+          pybind11::arg("cache_size") = 256,
+          R"__doc__(
+Default constructor
+
+Args:
+    x (pyinterp.core.Axis): X-Axis
+    y (pyinterp.core.Axis): Y-Axis
+    z (pyinterp.core.Axis): Z-Axis
+    provider (callable): Function returning the values of a tile. It
+        receives a tuple of three slices, selecting the tile along the X, Y
+        and Z axes, and returns the array of the values selected.
+    tile_shape (tuple): Number of values of a tile along the X, Y and Z
+        axes.
+    cache_size (int, optional): Maximum number of tiles kept in memory.
+        Defaults to ``256``.
+)__doc__")
+      .def_property_readonly(
+          "x", [](const TiledTrivariate& self) { return self.x(); },
+          R"__doc__(
+Gets the X-Axis handled by this instance
+
+Returns:
+    pyinterp.core.Axis: X-Axis
+)__doc__")
+      .def_property_readonly(
+          "y", [](const TiledTrivariate& self) { return self.y(); },
+          R"__doc__(
+Gets the Y-Axis handled by this instance
+
+Returns:
+    pyinterp.core.Axis: Y-Axis
+)__doc__")
+      .def_property_readonly(
+          "z", [](const TiledTrivariate& self) { return self.z(); },
+          R"__doc__(
+Gets the Z-Axis handled by this instance
+
+Returns:
+    pyinterp.core.Axis: Z-Axis
+)__doc__")
+      .def("evaluate", &TiledTrivariate::evaluate, pybind11::arg("x"),
+           pybind11::arg("y"), pybind11::arg("z"),
+           pybind11::arg("interpolator"), pybind11::arg("bounds_error") = false,
+           pybind11::arg("num_threads") = 0,
+           pybind11::arg("schedule") = detail::kStatic,
+           pybind11::arg("chunk_size") = 0, pybind11::arg("reorder") = false,
+           R"__doc__(
+Interpolate the values provided on the defined trivariate function. The
+tiles used by the positions are loaded, if they are not cached, by blocks of
+positions.
+
+Args:
+    x (numpy.ndarray): X-values, array of any shape
+    y (numpy.ndarray): Y-values, array of any shape
+    z (numpy.ndarray): Z-values, array of any shape
+    interpolator (pyinterp.core.BivariateInterpolator3D): 3D interpolator
+        used to interpolate values on the surface (x, y).
+    bounds_error (bool, optional): If True, when interpolated values are
+      requested outside of the domain of the input axes (x,y,z), a ValueError
+      is raised. If False, then value is set to Nan.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. Defaults to ``0``.
+    schedule (pyinterp.core.Schedule, optional): Distribution of the values
+        between the threads. Defaults to ``Static``.
+    chunk_size (int, optional): Number of values claimed at once by a thread
+        with the ``Dynamic`` schedule. Defaults to ``0``.
+    reorder (bool, optional): If True, the values are processed in the
+        order of a space-filling curve (Morton order), which reduces the
+        number of tiles used by a block of positions. Defaults to ``False``.
+Return:
+    numpy.ndarray: Values interpolated, of the shape of the coordinates
+)__doc__");
+  implement_tiled_grid(cls);
+}
+
+}  // namespace pyinterp
@@ -5,12 +5,15 @@
 #pragma once
 #include "pyinterp/bivariate.hpp"
 #include "pyinterp/detail/geometry/point.hpp"
+#include "pyinterp/detail/math/batch.hpp"
 #include "pyinterp/detail/math/trivariate.hpp"
+#include "pyinterp/detail/morton.hpp"
 #include "pyinterp/detail/thread.hpp"
 #include "pyinterp/grid.hpp"
 #include <pybind11/pybind11.h>
 #include <pybind11/numpy.h>
 #include <pybind11/stl.h>
+#include <optional>
 
 namespace pyinterp {
 
@@ -33,84 +36,170 @@ class Trivariate : public Grid3D<Type> {
       const pybind11::array_t<Coordinate>& y,
       const pybind11::array_t<Coordinate>& z,
       const Bivariate3D<Point, Coordinate>* interpolator,
-      const bool bounds_error, const size_t num_threads) {
-    pyinterp::detail::check_array_ndim("x", 1, x, "y", 1, y);
-    pyinterp::detail::check_ndarray_shape("x", x, "y", y);
+      const bool bounds_error, const size_t num_threads,
+      const detail::Schedule schedule, const size_t chunk_size,
+      const bool reorder,
+      const std::optional<pybind11::array_t<Coordinate>>& out) {
+    auto shape = pyinterp::detail::broadcast_shape("x", x, "y", y, "z", z);
+    if (out) {
+      pyinterp::detail::check_ndarray_shape("out", *out, shape);
+    }
+
+    auto result = out ? *out : pybind11::array_t<Coordinate>(shape);
+    auto size = static_cast<size_t>(result.size());
+    auto _x = detail::FlatView<const Coordinate>(x.data(), x, shape);
+    auto _y = detail::FlatView<const Coordinate>(y.data(), y, shape);
+    auto _z = detail::FlatView<const Coordinate>(z.data(), z, shape);
+    auto _result =
+        detail::FlatView<Coordinate>(result.mutable_data(), result, shape);
+
+    // Interpolators written in Python may process the values by batches.
+    auto evaluate_batch =
+        pybind11::get_overload(interpolator, "evaluate_batch");
+
+    {
+      pybind11::gil_scoped_release release;
+
+      // Order in which the values are processed, if they are reordered.
+      auto indexes =
+          reorder ? detail::morton::order<3>(
+                        [&](const size_t ix, const size_t dim) {
+                          return dim == 0 ? _x(ix) : dim == 1 ? _y(ix) : _z(ix);
+                        },
+                        size, num_threads)
+                  : std::vector<size_t>();
+
+      if (evaluate_batch) {
+        this->x_->visit([&](const auto& x_axis) {
+          this->y_->visit([&](const auto& y_axis) {
+            this->z_->visit([&](const auto& z_axis) {
+              this->_evaluate_python(x_axis, y_axis, z_axis, _x, _y, _z,
+                                     _result, evaluate_batch, bounds_error,
+                                     size, num_threads, schedule, chunk_size,
+                                     indexes);
+            });
+          });
+        });
+      } else {
+        // The evaluation loop is instantiated for the actual types of the
+        // interpolator and of the axes containers in order to resolve the
+        // interpolation and the index searches at compile time.
+        detail::math::visit(interpolator, [&](const auto& kernel) {
+          this->x_->visit([&](const auto& x_axis) {
+            this->y_->visit([&](const auto& y_axis) {
+              this->z_->visit([&](const auto& z_axis) {
+                this->_evaluate(x_axis, y_axis, z_axis, _x, _y, _z, _result,
+                                kernel, bounds_error, size, num_threads,
+                                schedule, chunk_size, indexes);
+              });
+            });
+          });
+        });
+      }
+    }
+    return result;
+  }
+
+  /// Interpolates the values of the grid and of the fields sharing its axes.
+  ///
+  /// The cells framing the positions, and the weights of the trilinear
+  /// interpolation, are calculated once per position for all the fields.
+  ///
+  /// @return The values interpolated, array of shape (size, 1 + number of
+  /// fields): the first column contains the values of this grid.
+  pybind11::array_t<Coordinate> evaluate_fields(
+      const pybind11::array_t<Coordinate>& x,
+      const pybind11::array_t<Coordinate>& y,
+      const pybind11::array_t<Coordinate>& z,
+      const std::vector<pybind11::array_t<Type>>& fields,
+      const Bivariate3D<Point, Coordinate>* interpolator,
+      const bool bounds_error, const size_t num_threads,
+      const detail::Schedule schedule, const size_t chunk_size,
+      const bool reorder) {
+    pyinterp::detail::check_array_ndim("x", 1, x, "y", 1, y, "z", 1, z);
+    pyinterp::detail::check_ndarray_shape("x", x, "y", y, "z", z);
+    // The fields are stored in the same order as the array of the grid.
+    auto arrays = this->transpose(fields);
+    auto grids = this->fields(arrays);
 
     auto size = x.size();
-    auto result =
-        pybind11::array_t<Coordinate>(pybind11::array::ShapeContainer{size});
+    auto result = pybind11::array_t<Coordinate>(
+        pybind11::array::ShapeContainer{
+            size, static_cast<pybind11::ssize_t>(grids.size())});
     auto _x = x.template unchecked<1>();
     auto _y = y.template unchecked<1>();
     auto _z = z.template unchecked<1>();
-    auto _result = result.template mutable_unchecked<1>();
+    auto _result = result.template mutable_unchecked<2>();
+
+    // Interpolators written in Python may process the values by batches.
+    auto evaluate_batch =
+        pybind11::get_overload(interpolator, "evaluate_batch");
 
     {
       pybind11::gil_scoped_release release;
 
-      // Captures the detected exceptions in the calculation function
-      // (only the last exception captured is kept)
-      auto except = std::exception_ptr(nullptr);
-
-      detail::dispatch(
-          [&](size_t start, size_t end) {
-            try {
-              for (size_t ix = start; ix < end; ++ix) {
-                auto x_indexes = this->x_->find_indexes(_x(ix));
-                auto y_indexes = this->y_->find_indexes(_y(ix));
-                auto z_indexes = this->z_->find_indexes(_z(ix));
-
-                if (x_indexes.has_value() && y_indexes.has_value() &&
-                    z_indexes.has_value()) {
-                  int64_t ix0, ix1, iy0, iy1, iz0, iz1;
-                  std::tie(ix0, ix1) = *x_indexes;
-                  std::tie(iy0, iy1) = *y_indexes;
-                  std::tie(iz0, iz1) = *z_indexes;
-
-                  auto x0 = (*this->x_)(ix0);
-
-                  _result(ix) =
-                      pyinterp::detail::math::trivariate<Point, Coordinate>(
-                          Point<Coordinate>(
-                              this->x_->is_angle()
-                                  ? detail::math::normalize_angle(_x(ix), x0)
-                                  : _x(ix),
-                              _y(ix), _z(ix)),
-                          Point<Coordinate>((*this->x_)(ix0), (*this->y_)(iy0),
-                                            (*this->z_)(iz0)),
-                          Point<Coordinate>((*this->x_)(ix1), (*this->y_)(iy1),
-                                            (*this->z_)(iz1)),
-                          static_cast<Coordinate>(this->ptr_(ix0, iy0, iz0)),
-                          static_cast<Coordinate>(this->ptr_(ix0, iy1, iz0)),
-                          static_cast<Coordinate>(this->ptr_(ix1, iy0, iz0)),
-                          static_cast<Coordinate>(this->ptr_(ix1, iy1, iz0)),
-                          static_cast<Coordinate>(this->ptr_(ix0, iy0, iz1)),
-                          static_cast<Coordinate>(this->ptr_(ix0, iy1, iz1)),
-                          static_cast<Coordinate>(this->ptr_(ix1, iy0, iz1)),
-                          static_cast<Coordinate>(this->ptr_(ix1, iy1, iz1)),
-                          interpolator);
-
-                } else {
-                  if (bounds_error) {
-                    if (!x_indexes.has_value()) {
-                      Trivariate::index_error(*this->x_, _x(ix), "x");
+      auto indexes =
+          reorder ? detail::morton::order<3>(
+                        [&](const size_t ix, const size_t dim) {
+                          return dim == 0 ? _x(ix) : dim == 1 ? _y(ix) : _z(ix);
+                        },
+                        size, num_threads)
+                  : std::vector<size_t>();
+
+      if (evaluate_batch) {
+        this->x_->visit([&](const auto& x_axis) {
+          this->y_->visit([&](const auto& y_axis) {
+            this->z_->visit([&](const auto& z_axis) {
+              detail::dispatch(
+                  [&](size_t start, size_t end) {
+                    auto x_cursor = detail::axis::Cursor();
+                    auto y_cursor = detail::axis::Cursor();
+                    auto z_cursor = detail::axis::Cursor();
+                    auto batch =
+                        BatchInterpolator<Point, Coordinate>(evaluate_batch);
+                    // Indexes of the values whose interpolation has been
+                    // recorded: two problems, on the planes z0 and z1, are
+                    // recorded per field for each of them.
+                    auto recorded = std::vector<size_t>();
+
+                    for (size_t jx = start; jx < end; ++jx) {
+                      auto ix = indexes.empty() ? jx : indexes[jx];
+                      if (_interpolate_fields(x_axis, y_axis, z_axis, _x(ix),
+                                              _y(ix), _z(ix), grids, batch,
+                                              bounds_error, x_cursor, y_cursor,
+                                              z_cursor,
+                                              _result.mutable_data(ix, 0))) {
+                        recorded.push_back(ix);
+                      }
                     }
-                    if (!y_indexes.has_value()) {
-                      Trivariate::index_error(*this->y_, _y(ix), "y");
+                    auto values = batch.solve();
+                    auto kx = size_t(0);
+                    for (auto ix : recorded) {
+                      Coordinate z, z0, z1;
+                      std::tie(z, z0, z1) = batch.coordinates(kx, 2);
+                      for (size_t jx = 0; jx < grids.size(); ++jx, kx += 2) {
+                        _result(ix, jx) = detail::math::linear(
+                            z, z0, z1, values[kx], values[kx + 1]);
+                      }
                     }
-                    Trivariate::index_error(*this->z_, _z(ix), "z");
-                  }
-                  _result(ix) = std::numeric_limits<Coordinate>::quiet_NaN();
-                }
-              }
-            } catch (...) {
-              except = std::current_exception();
-            }
-          },
-          size, num_threads);
-
-      if (except != nullptr) {
-        std::rethrow_exception(except);
+                  },
+                  size, num_threads, schedule, chunk_size);
+            });
+          });
+        });
+      } else {
+        detail::math::visit(interpolator, [&](const auto& kernel) {
+          this->x_->visit([&](const auto& x_axis) {
+            this->y_->visit([&](const auto& y_axis) {
+              this->z_->visit([&](const auto& z_axis) {
+                this->_evaluate_fields(x_axis, y_axis, z_axis, _x, _y, _z,
+                                       arrays, grids, _result, kernel,
+                                       bounds_error, size, num_threads,
+                                       schedule, chunk_size, indexes);
+              });
+            });
+          });
+        });
       }
     }
     return result;
@@ -124,18 +213,493 @@ class Trivariate : public Grid3D<Type> {
  private:
   /// Construct a new instance from a serialized instance
   explicit Trivariate(Grid3D<Type>&& grid) : Grid3D<Type>(grid) {}
+
+  /// Interpolates data using the defined interpolation function.
+  ///
+  /// The values are processed in the order given by "indexes", or in their
+  /// original order if "indexes" is empty.
+  ///
+  /// @tparam X Type of the container handling the X-Axis values
+  /// @tparam Y Type of the container handling the Y-Axis values
+  /// @tparam Z Type of the container handling the Z-Axis values
+  /// @tparam Interpolator Type of the interpolator
+  template <typename X, typename Y, typename Z, typename Interpolator>
+  void _evaluate(
+      const X& x_axis, const Y& y_axis, const Z& z_axis,
+      const detail::FlatView<const Coordinate>& _x,
+      const detail::FlatView<const Coordinate>& _y,
+      const detail::FlatView<const Coordinate>& _z,
+      const detail::FlatView<Coordinate>& _result,
+      const Interpolator& interpolator,
+      const bool bounds_error, const size_t size, const size_t num_threads,
+      const detail::Schedule schedule, const size_t chunk_size,
+      const std::vector<size_t>& indexes) const {
+    // The trilinear interpolation of grids whose axes are regular is
+    // vectorized.
+    if constexpr (std::is_same_v<Interpolator,
+                                 detail::math::Bilinear<Point, Coordinate>> &&
+                  std::is_same_v<X, detail::axis::container::Regular> &&
+                  std::is_same_v<Y, detail::axis::container::Regular> &&
+                  std::is_same_v<Z, detail::axis::container::Regular>) {
+      if (x_axis.size() > 1 && y_axis.size() > 1 && z_axis.size() > 1) {
+        _evaluate_batch(x_axis, y_axis, z_axis, _x, _y, _z, _result,
+                        interpolator, bounds_error, size, num_threads,
+                        schedule, chunk_size, indexes);
+        return;
+      }
+    }
+
+    detail::dispatch(
+        [&](size_t start, size_t end) {
+          auto x_cursor = detail::axis::Cursor();
+          auto y_cursor = detail::axis::Cursor();
+          auto z_cursor = detail::axis::Cursor();
+
+          for (size_t jx = start; jx < end; ++jx) {
+            auto ix = indexes.empty() ? jx : indexes[jx];
+            _result(ix) = _interpolate(x_axis, y_axis, z_axis, _x(ix), _y(ix),
+                                       _z(ix), interpolator, bounds_error,
+                                       x_cursor, y_cursor, z_cursor);
+          }
+        },
+        size, num_threads, schedule, chunk_size);
+  }
+
+  /// Interpolates data by batches of positions with the vectorized trilinear
+  /// kernel. The positions that this kernel does not handle (located outside
+  /// the grid, between the last and the first element of a circle, or framed
+  /// by undefined values) are then interpolated one by one.
+  ///
+  /// @see _evaluate
+  template <typename Interpolator>
+  void _evaluate_batch(
+      const detail::axis::container::Regular& x_axis,
+      const detail::axis::container::Regular& y_axis,
+      const detail::axis::container::Regular& z_axis,
+      const detail::FlatView<const Coordinate>& _x,
+      const detail::FlatView<const Coordinate>& _y,
+      const detail::FlatView<const Coordinate>& _z,
+      const detail::FlatView<Coordinate>& _result,
+      const Interpolator& interpolator,
+      const bool bounds_error, const size_t size, const size_t num_threads,
+      const detail::Schedule schedule, const size_t chunk_size,
+      const std::vector<size_t>& indexes) const {
+    namespace batch = detail::math::batch;
+
+    auto x_regular =
+        batch::Regular{x_axis.coordinate_value(0), x_axis.step(),
+                       static_cast<double>(x_axis.size() - 1)};
+    auto y_regular =
+        batch::Regular{y_axis.coordinate_value(0), y_axis.step(),
+                       static_cast<double>(y_axis.size() - 1)};
+    auto z_regular =
+        batch::Regular{z_axis.coordinate_value(0), z_axis.step(),
+                       static_cast<double>(z_axis.size() - 1)};
+    auto strides =
+        std::array<int64_t, 3>{static_cast<int64_t>(this->array_.strides(0)),
+                               static_cast<int64_t>(this->array_.strides(1)),
+                               static_cast<int64_t>(this->array_.strides(2))};
+    auto grid = this->array_.data();
+
+    detail::dispatch(
+        [&](size_t start, size_t end) {
+          auto x_cursor = detail::axis::Cursor();
+          auto y_cursor = detail::axis::Cursor();
+          auto z_cursor = detail::axis::Cursor();
+          auto x = std::array<Coordinate, batch::kSize>();
+          auto y = std::array<Coordinate, batch::kSize>();
+          auto z = std::array<Coordinate, batch::kSize>();
+          auto values = std::array<Coordinate, batch::kSize>();
+
+          for (auto first = start; first < end; first += batch::kSize) {
+            auto count = std::min(batch::kSize, end - first);
+            for (size_t jx = 0; jx < count; ++jx) {
+              auto ix = indexes.empty() ? first + jx : indexes[first + jx];
+              x[jx] = this->x_->normalize_coordinate(_x(ix));
+              y[jx] = this->y_->normalize_coordinate(_y(ix));
+              z[jx] = this->z_->normalize_coordinate(_z(ix));
+            }
+            if constexpr (std::is_integral_v<Type>) {
+              batch::trilinear(grid, strides, this->packing_, x_regular,
+                               y_regular, z_regular, x.data(), y.data(),
+                               z.data(), count, values.data());
+            } else {
+              batch::trilinear(grid, strides, x_regular, y_regular, z_regular,
+                               x.data(), y.data(), z.data(), count,
+                               values.data());
+            }
+            for (size_t jx = 0; jx < count; ++jx) {
+              auto ix = indexes.empty() ? first + jx : indexes[first + jx];
+              _result(ix) =
+                  std::isnan(values[jx])
+                      ? _interpolate(x_axis, y_axis, z_axis, _x(ix), _y(ix),
+                                     _z(ix), interpolator, bounds_error,
+                                     x_cursor, y_cursor, z_cursor)
+                      : static_cast<Coordinate>(values[jx]);
+            }
+          }
+        },
+        size, num_threads, schedule, chunk_size);
+  }
+
+  /// Interpolates the values of several fields using the defined
+  /// interpolation function.
+  ///
+  /// @see _evaluate
+  template <typename X, typename Y, typename Z, typename Interpolator>
+  void _evaluate_fields(
+      const X& x_axis, const Y& y_axis, const Z& z_axis,
+      const pybind11::detail::unchecked_reference<Coordinate, 1>& _x,
+      const pybind11::detail::unchecked_reference<Coordinate, 1>& _y,
+      const pybind11::detail::unchecked_reference<Coordinate, 1>& _z,
+      const std::vector<pybind11::array_t<Type>>& fields,
+      const std::vector<pybind11::detail::unchecked_reference<Type, 3>>& grids,
+      pybind11::detail::unchecked_mutable_reference<Coordinate, 2>& _result,
+      const Interpolator& interpolator, const bool bounds_error,
+      const size_t size, const size_t num_threads,
+      const detail::Schedule schedule, const size_t chunk_size,
+      const std::vector<size_t>& indexes) const {
+    if constexpr (std::is_same_v<Interpolator,
+                                 detail::math::Bilinear<Point, Coordinate>> &&
+                  std::is_same_v<X, detail::axis::container::Regular> &&
+                  std::is_same_v<Y, detail::axis::container::Regular> &&
+                  std::is_same_v<Z, detail::axis::container::Regular>) {
+      if (x_axis.size() > 1 && y_axis.size() > 1 && z_axis.size() > 1) {
+        _evaluate_fields_batch(x_axis, y_axis, z_axis, _x, _y, _z, fields,
+                               grids, _result, interpolator, bounds_error,
+                               size, num_threads, schedule, chunk_size,
+                               indexes);
+        return;
+      }
+    }
+
+    detail::dispatch(
+        [&](size_t start, size_t end) {
+          auto x_cursor = detail::axis::Cursor();
+          auto y_cursor = detail::axis::Cursor();
+          auto z_cursor = detail::axis::Cursor();
+
+          for (size_t jx = start; jx < end; ++jx) {
+            auto ix = indexes.empty() ? jx : indexes[jx];
+            _interpolate_fields(x_axis, y_axis, z_axis, _x(ix), _y(ix), _z(ix),
+                                grids, interpolator, bounds_error, x_cursor,
+                                y_cursor, z_cursor,
+                                _result.mutable_data(ix, 0));
+          }
+        },
+        size, num_threads, schedule, chunk_size);
+  }
+
+  /// Interpolates the values of several fields by batches of positions with
+  /// the vectorized trilinear kernel.
+  ///
+  /// @see _evaluate_batch
+  template <typename Interpolator>
+  void _evaluate_fields_batch(
+      const detail::axis::container::Regular& x_axis,
+      const detail::axis::container::Regular& y_axis,
+      const detail::axis::container::Regular& z_axis,
+      const pybind11::detail::unchecked_reference<Coordinate, 1>& _x,
+      const pybind11::detail::unchecked_reference<Coordinate, 1>& _y,
+      const pybind11::detail::unchecked_reference<Coordinate, 1>& _z,
+      const std::vector<pybind11::array_t<Type>>& fields,
+      const std::vector<pybind11::detail::unchecked_reference<Type, 3>>& grids,
+      pybind11::detail::unchecked_mutable_reference<Coordinate, 2>& _result,
+      const Interpolator& interpolator, const bool bounds_error,
+      const size_t size, const size_t num_threads,
+      const detail::Schedule schedule, const size_t chunk_size,
+      const std::vector<size_t>& indexes) const {
+    namespace batch = detail::math::batch;
+
+    auto x_regular =
+        batch::Regular{x_axis.coordinate_value(0), x_axis.step(),
+                       static_cast<double>(x_axis.size() - 1)};
+    auto y_regular =
+        batch::Regular{y_axis.coordinate_value(0), y_axis.step(),
+                       static_cast<double>(y_axis.size() - 1)};
+    auto z_regular =
+        batch::Regular{z_axis.coordinate_value(0), z_axis.step(),
+                       static_cast<double>(z_axis.size() - 1)};
+    auto pointers = std::vector<const Type*>{this->array_.data()};
+    auto strides = std::vector<std::array<int64_t, 3>>{
+        {static_cast<int64_t>(this->array_.strides(0)),
+         static_cast<int64_t>(this->array_.strides(1)),
+         static_cast<int64_t>(this->array_.strides(2))}};
+    for (const auto& item : fields) {
+      pointers.push_back(item.data());
+      strides.push_back({static_cast<int64_t>(item.strides(0)),
+                         static_cast<int64_t>(item.strides(1)),
+                         static_cast<int64_t>(item.strides(2))});
+    }
+    auto count = grids.size();
+
+    detail::dispatch(
+        [&](size_t start, size_t end) {
+          auto x_cursor = detail::axis::Cursor();
+          auto y_cursor = detail::axis::Cursor();
+          auto z_cursor = detail::axis::Cursor();
+          auto x = std::array<Coordinate, batch::kSize>();
+          auto y = std::array<Coordinate, batch::kSize>();
+          auto z = std::array<Coordinate, batch::kSize>();
+          auto values = std::vector<Coordinate>(count * batch::kSize);
+
+          for (auto first = start; first < end; first += batch::kSize) {
+            auto n = std::min(batch::kSize, end - first);
+            for (size_t jx = 0; jx < n; ++jx) {
+              auto ix = indexes.empty() ? first + jx : indexes[first + jx];
+              x[jx] = this->x_->normalize_coordinate(_x(ix));
+              y[jx] = this->y_->normalize_coordinate(_y(ix));
+              z[jx] = this->z_->normalize_coordinate(_z(ix));
+            }
+            if constexpr (std::is_integral_v<Type>) {
+              batch::trilinear(pointers.data(), strides.data(), count,
+                               this->packing_, x_regular, y_regular,
+                               z_regular, x.data(), y.data(), z.data(), n,
+                               values.data());
+            } else {
+              batch::trilinear(pointers.data(), strides.data(), count,
+                               x_regular, y_regular, z_regular, x.data(),
+                               y.data(), z.data(), n, values.data());
+            }
+            for (size_t jx = 0; jx < n; ++jx) {
+              auto ix = indexes.empty() ? first + jx : indexes[first + jx];
+              auto defined = true;
+              for (size_t kx = 0; kx < count; ++kx) {
+                defined &= !std::isnan(values[kx * n + jx]);
+              }
+              if (!defined) {
+                _interpolate_fields(x_axis, y_axis, z_axis, _x(ix), _y(ix),
+                                    _z(ix), grids, interpolator, bounds_error,
+                                    x_cursor, y_cursor, z_cursor,
+                                    _result.mutable_data(ix, 0));
+                continue;
+              }
+              for (size_t kx = 0; kx < count; ++kx) {
+                _result(ix, kx) = static_cast<Coordinate>(values[kx * n + jx]);
+              }
+            }
+          }
+        },
+        size, num_threads, schedule, chunk_size);
+  }
+
+  /// Interpolates data with an interpolator written in Python, whose method
+  /// "evaluate_batch" is called once for each chunk of values processed by
+  /// a thread. The bivariate interpolations on the planes z0 and z1 of all
+  /// the values are solved by this call, then the values are interpolated
+  /// linearly along the Z-Axis.
+  ///
+  /// @see _evaluate
+  template <typename X, typename Y, typename Z>
+  void _evaluate_python(
+      const X& x_axis, const Y& y_axis, const Z& z_axis,
+      const detail::FlatView<const Coordinate>& _x,
+      const detail::FlatView<const Coordinate>& _y,
+      const detail::FlatView<const Coordinate>& _z,
+      const detail::FlatView<Coordinate>& _result,
+      const pybind11::function& evaluate_batch, const bool bounds_error,
+      const size_t size, const size_t num_threads,
+      const detail::Schedule schedule, const size_t chunk_size,
+      const std::vector<size_t>& indexes) const {
+    detail::dispatch(
+        [&](size_t start, size_t end) {
+          auto x_cursor = detail::axis::Cursor();
+          auto y_cursor = detail::axis::Cursor();
+          auto z_cursor = detail::axis::Cursor();
+          auto interpolator =
+              BatchInterpolator<Point, Coordinate>(evaluate_batch);
+          // Indexes of the values whose interpolation has been recorded: two
+          // problems, on the planes z0 and z1, are recorded for each of them.
+          auto recorded = std::vector<size_t>();
+
+          for (size_t jx = start; jx < end; ++jx) {
+            auto ix = indexes.empty() ? jx : indexes[jx];
+            _result(ix) = _interpolate(x_axis, y_axis, z_axis, _x(ix), _y(ix),
+                                       _z(ix), interpolator, bounds_error,
+                                       x_cursor, y_cursor, z_cursor);
+            if (interpolator.size() != 2 * recorded.size()) {
+              recorded.push_back(ix);
+            }
+          }
+          auto values = interpolator.solve();
+          for (size_t jx = 0; jx < recorded.size(); ++jx) {
+            Coordinate z, z0, z1;
+            std::tie(z, z0, z1) = interpolator.coordinates(2 * jx, 2);
+            _result(recorded[jx]) = detail::math::linear(
+                z, z0, z1, values[2 * jx], values[2 * jx + 1]);
+          }
+        },
+        size, num_threads, schedule, chunk_size);
+  }
+
+  /// Interpolates the values of the fields at a position, the cell framing
+  /// it being searched once for all the fields.
+  ///
+  /// @param result The values interpolated, one per field
+  /// @return True if the position is inside the grid
+  /// @see evaluate_fields
+  template <typename X, typename Y, typename Z, typename Interpolator>
+  bool _interpolate_fields(
+      const X& x_axis, const Y& y_axis, const Z& z_axis, const Coordinate x,
+      const Coordinate y, const Coordinate z,
+      const std::vector<pybind11::detail::unchecked_reference<Type, 3>>& grids,
+      const Interpolator& interpolator, const bool bounds_error,
+      detail::axis::Cursor& x_cursor, detail::axis::Cursor& y_cursor,
+      detail::axis::Cursor& z_cursor, Coordinate* result) const {
+    auto x_indexes = this->x_->template find_indexes<X>(x, x_cursor);
+    auto y_indexes = this->y_->template find_indexes<Y>(y, y_cursor);
+    auto z_indexes = this->z_->template find_indexes<Z>(z, z_cursor);
+
+    if (!x_indexes.has_value() || !y_indexes.has_value() ||
+        !z_indexes.has_value()) {
+      if (bounds_error) {
+        if (!x_indexes.has_value()) {
+          Trivariate::index_error(*this->x_, x, "x");
+        }
+        if (!y_indexes.has_value()) {
+          Trivariate::index_error(*this->y_, y, "y");
+        }
+        Trivariate::index_error(*this->z_, z, "z");
+      }
+      std::fill(result, result + grids.size(),
+                std::numeric_limits<Coordinate>::quiet_NaN());
+      return false;
+    }
+
+    int64_t ix0, ix1, iy0, iy1, iz0, iz1;
+    std::tie(ix0, ix1) = *x_indexes;
+    std::tie(iy0, iy1) = *y_indexes;
+    std::tie(iz0, iz1) = *z_indexes;
+
+    auto x0 = static_cast<Coordinate>(x_axis.coordinate_value(ix0));
+    auto p = Point<Coordinate>(
+        this->x_->is_angle() ? detail::math::normalize_angle(x, x0) : x, y, z);
+    auto p0 = Point<Coordinate>(x0, y_axis.coordinate_value(iy0),
+                                z_axis.coordinate_value(iz0));
+    auto p1 = Point<Coordinate>(x_axis.coordinate_value(ix1),
+                                y_axis.coordinate_value(iy1),
+                                z_axis.coordinate_value(iz1));
+
+    if constexpr (std::is_same_v<Interpolator,
+                                 detail::math::Bilinear<Point, Coordinate>>) {
+      // The weights are shared by all the fields.
+      auto t = (boost::geometry::get<0>(p) - boost::geometry::get<0>(p0)) /
+               (boost::geometry::get<0>(p1) - boost::geometry::get<0>(p0));
+      auto u = (boost::geometry::get<1>(p) - boost::geometry::get<1>(p0)) /
+               (boost::geometry::get<1>(p1) - boost::geometry::get<1>(p0));
+      auto w00 = (1 - t) * (1 - u);
+      auto w10 = t * (1 - u);
+      auto w01 = (1 - t) * u;
+      auto w11 = t * u;
+      auto plane = [&](const auto& grid, const int64_t iz) {
+        return w00 * this->template unpack<Coordinate>(grid(ix0, iy0, iz)) +
+               w10 * this->template unpack<Coordinate>(grid(ix1, iy0, iz)) +
+               w01 * this->template unpack<Coordinate>(grid(ix0, iy1, iz)) +
+               w11 * this->template unpack<Coordinate>(grid(ix1, iy1, iz));
+      };
+      for (size_t ix = 0; ix < grids.size(); ++ix) {
+        const auto& grid = grids[ix];
+        result[ix] = detail::math::linear(
+            z, boost::geometry::get<2>(p0), boost::geometry::get<2>(p1),
+            plane(grid, iz0), plane(grid, iz1));
+        if (interpolator.masked() && std::isnan(result[ix])) {
+          result[ix] = detail::math::trilinear<Point, Coordinate>(
+              p, p0, p1,
+              {this->template unpack<Coordinate>(grid(ix0, iy0, iz0)),
+               this->template unpack<Coordinate>(grid(ix0, iy1, iz0)),
+               this->template unpack<Coordinate>(grid(ix1, iy0, iz0)),
+               this->template unpack<Coordinate>(grid(ix1, iy1, iz0)),
+               this->template unpack<Coordinate>(grid(ix0, iy0, iz1)),
+               this->template unpack<Coordinate>(grid(ix0, iy1, iz1)),
+               this->template unpack<Coordinate>(grid(ix1, iy0, iz1)),
+               this->template unpack<Coordinate>(grid(ix1, iy1, iz1))},
+              interpolator.min_valid());
+        }
+      }
+    } else {
+      for (size_t ix = 0; ix < grids.size(); ++ix) {
+        const auto& grid = grids[ix];
+        result[ix] = pyinterp::detail::math::trivariate<Point, Coordinate>(
+            p, p0, p1, this->template unpack<Coordinate>(grid(ix0, iy0, iz0)),
+            this->template unpack<Coordinate>(grid(ix0, iy1, iz0)),
+            this->template unpack<Coordinate>(grid(ix1, iy0, iz0)),
+            this->template unpack<Coordinate>(grid(ix1, iy1, iz0)),
+            this->template unpack<Coordinate>(grid(ix0, iy0, iz1)),
+            this->template unpack<Coordinate>(grid(ix0, iy1, iz1)),
+            this->template unpack<Coordinate>(grid(ix1, iy0, iz1)),
+            this->template unpack<Coordinate>(grid(ix1, iy1, iz1)),
+            &interpolator);
+      }
+    }
+    return true;
+  }
+
+  /// Interpolates the value of a position.
+  ///
+  /// @see _evaluate
+  template <typename X, typename Y, typename Z, typename Interpolator>
+  Coordinate _interpolate(const X& x_axis, const Y& y_axis, const Z& z_axis,
+                          const Coordinate x, const Coordinate y,
+                          const Coordinate z, const Interpolator& interpolator,
+                          const bool bounds_error,
+                          detail::axis::Cursor& x_cursor,
+                          detail::axis::Cursor& y_cursor,
+                          detail::axis::Cursor& z_cursor) const {
+    auto x_indexes = this->x_->template find_indexes<X>(x, x_cursor);
+    auto y_indexes = this->y_->template find_indexes<Y>(y, y_cursor);
+    auto z_indexes = this->z_->template find_indexes<Z>(z, z_cursor);
+
+    if (x_indexes.has_value() && y_indexes.has_value() &&
+        z_indexes.has_value()) {
+      int64_t ix0, ix1, iy0, iy1, iz0, iz1;
+      std::tie(ix0, ix1) = *x_indexes;
+      std::tie(iy0, iy1) = *y_indexes;
+      std::tie(iz0, iz1) = *z_indexes;
+
+      auto x0 = static_cast<Coordinate>(x_axis.coordinate_value(ix0));
+
+      return pyinterp::detail::math::trivariate<Point, Coordinate>(
+          Point<Coordinate>(
+              this->x_->is_angle() ? detail::math::normalize_angle(x, x0) : x,
+              y, z),
+          Point<Coordinate>(x0, y_axis.coordinate_value(iy0),
+                            z_axis.coordinate_value(iz0)),
+          Point<Coordinate>(x_axis.coordinate_value(ix1),
+                            y_axis.coordinate_value(iy1),
+                            z_axis.coordinate_value(iz1)),
+          this->template value<Coordinate>(ix0, iy0, iz0),
+          this->template value<Coordinate>(ix0, iy1, iz0),
+          this->template value<Coordinate>(ix1, iy0, iz0),
+          this->template value<Coordinate>(ix1, iy1, iz0),
+          this->template value<Coordinate>(ix0, iy0, iz1),
+          this->template value<Coordinate>(ix0, iy1, iz1),
+          this->template value<Coordinate>(ix1, iy0, iz1),
+          this->template value<Coordinate>(ix1, iy1, iz1), &interpolator);
+    }
+    if (bounds_error) {
+      if (!x_indexes.has_value()) {
+        Trivariate::index_error(*this->x_, x, "x");
+      }
+      if (!y_indexes.has_value()) {
+        Trivariate::index_error(*this->y_, y, "y");
+      }
+      Trivariate::index_error(*this->z_, z, "z");
+    }
+    return std::numeric_limits<Coordinate>::quiet_NaN();
+  }
 };
 
 template <template <class> class Point, typename Coordinate, typename Type>
 void implement_trivariate(pybind11::module& m, const char* const class_name) {
-  pybind11::class_<Trivariate<Point, Coordinate, Type>>(m, class_name,
-                                                        R"__doc__(
+  auto cls = pybind11::class_<Trivariate<Point, Coordinate, Type>>(
+      m, class_name, R"__doc__(
 Interpolation of trivariate functions
 )__doc__")
       .def(pybind11::init<std::shared_ptr<Axis>, std::shared_ptr<Axis>,
-                          std::shared_ptr<Axis>, pybind11::array_t<Type>>(),
+                          std::shared_ptr<Axis>, pybind11::array_t<Type>,
+                          std::optional<std::vector<ssize_t>>>(),
            pybind11::arg("x"), pybind11::arg("y"), pybind11::arg("z"),
-           pybind11::arg("array"),
+           pybind11::arg("array"), pybind11::arg("axes") = pybind11::none(),
            R"__doc__(
 Default constructor
 
@@ -144,6 +708,9 @@ Args:
     y (pyinterp.core.Axis): Y-Axis
     z (pyinterp.core.Axis): Z-Axis
     array (numpy.ndarray): Trivariate function
+    axes (tuple, optional): Dimension of the array holding each axis of the
+        grid, if the array is not stored in the order of the axes. The array
+        is then read without being copied. Defaults to ``None``.
 )__doc__")
       .def_property_readonly(
           "x",
@@ -188,18 +755,84 @@ Gets the values handled by this instance
 
 Returns:
     numpy.ndarray: values to interpolate
+)__doc__")
+      .def_property_readonly(
+          "dtype",
+          [](const Trivariate<Point, Coordinate, Type>& /*self*/) {
+            return pybind11::dtype::of<Coordinate>();
+          },
+          R"__doc__(
+Gets the type of the coordinates and of the values interpolated
+
+Returns:
+    numpy.dtype: ``float64``, or ``float32`` for the interpolators calculating
+    in single precision
 )__doc__")
       .def("evaluate", &Trivariate<Point, Coordinate, Type>::evaluate,
            pybind11::arg("x"), pybind11::arg("y"), pybind11::arg("z"),
            pybind11::arg("interpolator"), pybind11::arg("bounds_error") = false,
            pybind11::arg("num_threads") = 0,
+           pybind11::arg("schedule") = detail::kStatic,
+           pybind11::arg("chunk_size") = 0, pybind11::arg("reorder") = false,
+           pybind11::arg("out").noconvert() = pybind11::none(),
            R"__doc__(
 Interpolate the values provided on the defined trivariate function.
 
+Args:
+    x (numpy.ndarray): X-values, array of any shape
+    y (numpy.ndarray): Y-values, array of any shape
+    z (numpy.ndarray): Z-values, array of any shape
+    interpolator (pyinterp.core.BivariateInterpolator3D): 3D interpolator
+        used to interpolate values on the surface (x, y).
+    bounds_error (bool, optional): If True, when interpolated values are
+      requested outside of the domain of the input axes (x,y,z), a ValueError
+      is raised. If False, then value is set to Nan.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+    schedule (pyinterp.core.Schedule, optional): Distribution of the values
+        between the threads. ``Dynamic`` balances the load between threads
+        when the cost of the calculation varies from one value to another.
+        Defaults to ``Static``.
+    chunk_size (int, optional): Number of values claimed at once by a thread
+        with the ``Dynamic`` schedule. If 0, the size is chosen according to
+        the number of values and threads. Defaults to ``0``.
+    reorder (bool, optional): If True, the values are processed in the
+        order of a space-filling curve (Morton order), so that consecutive
+        calculations access neighbouring memory areas. This improves the
+        cache efficiency for large numbers of randomly scattered values, at
+        the cost of sorting them. Defaults to ``False``.
+    out (numpy.ndarray, optional): Array receiving the values interpolated.
+        It must have the shape of the coordinates broadcast together and the
+        type of the result; it can be a non-contiguous view. Defaults to
+        ``None``, a new array being allocated.
+Return:
+    numpy.ndarray: Values interpolated, array of the shape of the coordinates
+    broadcast together (``out`` if provided).
+)__doc__")
+      .def("evaluate_fields",
+           &Trivariate<Point, Coordinate, Type>::evaluate_fields,
+           pybind11::arg("x"), pybind11::arg("y"), pybind11::arg("z"),
+           pybind11::arg("fields"), pybind11::arg("interpolator"),
+           pybind11::arg("bounds_error") = false,
+           pybind11::arg("num_threads") = 0,
+           pybind11::arg("schedule") = detail::kStatic,
+           pybind11::arg("chunk_size") = 0, pybind11::arg("reorder") = false,
+           R"__doc__(
+Interpolate the values provided on the trivariate function and on other fields
+defined on the same axes.
+
+The cells framing the values provided are searched once for all the fields,
+so interpolating several fields together costs little more than interpolating
+one of them.
+
 Args:
     x (numpy.ndarray): X-values
     y (numpy.ndarray): Y-values
     z (numpy.ndarray): Z-values
+    fields (list): Values of the other fields, arrays stored like the array
+        of the trivariate function, in the same axis order.
     interpolator (pyinterp.core.BivariateInterpolator3D): 3D interpolator
         used to interpolate values on the surface (x, y).
     bounds_error (bool, optional): If True, when interpolated values are
@@ -209,8 +842,17 @@ Args:
         computation. If 0 all CPUs are used. If 1 is given, no parallel
         computing code is used at all, which is useful for debugging.
         Defaults to ``0``.
+    schedule (pyinterp.core.Schedule, optional): Distribution of the values
+        between the threads. Defaults to ``Static``.
+    chunk_size (int, optional): Number of values claimed at once by a thread
+        with the ``Dynamic`` schedule. Defaults to ``0``.
+    reorder (bool, optional): If True, the values are processed in the
+        order of a space-filling curve (Morton order). Defaults to
+        ``False``.
 Return:
-    numpy.ndarray: Values interpolated
+    numpy.ndarray: Values interpolated, array of shape (x.size, 1 +
+    len(fields)). The first column contains the values of the trivariate
+    function, followed by a column for each field.
 )__doc__")
       .def_static("_setstate", &Trivariate<Point, Coordinate, Type>::setstate,
                   pybind11::arg("state"), R"__doc__(
@@ -226,6 +868,39 @@ Args:
           [](const pybind11::tuple& state) {
             return Trivariate<Point, Coordinate, Type>::setstate(state);
           }));
+
+  if constexpr (std::is_integral_v<Type>) {
+    cls.def(pybind11::init<std::shared_ptr<Axis>, std::shared_ptr<Axis>,
+                           std::shared_ptr<Axis>, pybind11::array_t<Type>,
+                           double, double, std::optional<Type>,
+                           std::optional<std::vector<ssize_t>>>(),
+            pybind11::arg("x"), pybind11::arg("y"), pybind11::arg("z"),
+            pybind11::arg("array"), pybind11::arg("scale_factor") = 1.0,
+            pybind11::arg("add_offset") = 0.0,
+            pybind11::arg("fill_value") = pybind11::none(),
+            pybind11::arg("axes") = pybind11::none(),
+            R"__doc__(
+Constructor of a grid of packed integers: the integer q represents the
+value q * scale_factor + add_offset, or an undefined value if it is equal to
+the fill value. The values are decoded when they are interpolated.
+
+Args:
+    x (pyinterp.core.Axis): X-Axis
+    y (pyinterp.core.Axis): Y-Axis
+    z (pyinterp.core.Axis): Z-Axis
+    array (numpy.ndarray): Trivariate function, packed
+    scale_factor (float, optional): Factor applied to the integers. Defaults
+        to ``1``.
+    add_offset (float, optional): Offset added to the integers multiplied by
+        the scale factor. Defaults to ``0``.
+    fill_value (int, optional): Integer representing the undefined values.
+        Defaults to ``None``, all the integers representing a value.
+    axes (tuple, optional): Dimension of the array holding each axis of the
+        grid, if the array is not stored in the order of the axes. The array
+        is then read without being copied. Defaults to ``None``.
+)__doc__");
+    implement_packing(cls);
+  }
 }
 
 }  // namespace pyinterp
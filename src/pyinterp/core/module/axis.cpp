@@ -24,9 +24,10 @@ inline std::vector<T> vector_from_numpy(
 }
 
 Axis::Axis(const py::array_t<double, py::array::c_style>& points,
-           const double epsilon, const bool is_circle, const bool is_radian)
+           const double epsilon, const bool is_circle, const bool is_radian,
+           const size_t bucket_factor)
     : Axis(vector_from_numpy<double>("points", points), epsilon, is_circle,
-           is_radian) {}
+           is_radian, bucket_factor) {}
 
 py::array_t<double> Axis::coordinate_values(const py::slice& slice) const {
   size_t start, stop, step, slicelength;
@@ -57,13 +58,39 @@ pybind11::array_t<int64_t> Axis::find_index(
 
   {
     pybind11::gil_scoped_release release;
-    for (auto ix = 0; ix < size; ++ix) {
-      _result(ix) = detail::Axis::find_index(_coordinates(ix), bounded);
-    }
+    visit([&](const auto& container) {
+      for (auto ix = 0; ix < size; ++ix) {
+        _result(ix) = container.find_index(
+            normalize_coordinate(_coordinates(ix)), bounded);
+      }
+    });
   }
   return result;
 }
 
+pybind11::tuple Axis::find_indexes(
+    const py::array_t<double, py::array::c_style | py::array::forcecast>&
+        coordinates) const {
+  detail::check_array_ndim("coordinates", 1, coordinates);
+
+  auto size = coordinates.size();
+  auto i0 = py::array_t<int64_t>(size);
+  auto i1 = py::array_t<int64_t>(size);
+  auto weight = py::array_t<double>(size);
+  auto mask = py::array_t<bool>(size);
+  auto _i0 = i0.mutable_data();
+  auto _i1 = i1.mutable_data();
+  auto _weight = weight.mutable_data();
+  auto _mask = mask.mutable_data();
+
+  {
+    pybind11::gil_scoped_release release;
+    detail::Axis::find_indexes(coordinates.data(), size, _i0, _i1, _weight,
+                               _mask);
+  }
+  return py::make_tuple(i0, i1, weight, mask);
+}
+
 pybind11::tuple Axis::getstate() const {
   // Regular
   {
@@ -83,7 +110,8 @@ pybind11::tuple Axis::getstate() const {
       for (auto ix = 0LL; ix < ptr->size(); ++ix) {
         _values[ix] = ptr->coordinate_value(ix);
       }
-      return pybind11::make_tuple(IRREGULAR, values, is_circle(), is_radian());
+      return pybind11::make_tuple(IRREGULAR, values, is_circle(), is_radian(),
+                                  ptr->bucket_factor());
     }
   }
   // Undefined
@@ -103,12 +131,21 @@ Axis Axis::setstate(const pybind11::tuple& state) {
     case UNDEFINED:
       return Axis();
       break;
-    case IRREGULAR:
+    case IRREGULAR: {
+      // The states created before the lookup table was configurable do not
+      // store its bucket factor.
+      auto bucket_factor =
+          state.size() > 4
+              ? state[4].cast<size_t>()
+              : detail::axis::container::Irregular::kDefaultBucketFactor;
       return Axis(
           std::shared_ptr<detail::axis::container::Abstract>(
-              new detail::axis::container::Irregular(vector_from_numpy<double>(
-                  "state[1]", state[1].cast<py::array_t<double>>()))),
+              new detail::axis::container::Irregular(
+                  vector_from_numpy<double>(
+                      "state[1]", state[1].cast<py::array_t<double>>()),
+                  bucket_factor)),
           state[2].cast<bool>(), state[3].cast<bool>());
+    }
     case REGULAR:
       return Axis(std::shared_ptr<detail::axis::container::Abstract>(
                       new detail::axis::container::Regular(
@@ -139,9 +176,11 @@ Type of boundary handling.
       .value("Undef", pyinterp::Axis::kUndef,
              "*Boundary violation is not defined*.");
 
-  axis.def(py::init<const py::array_t<double>&, double, bool, bool>(),
+  axis.def(py::init<const py::array_t<double>&, double, bool, bool, size_t>(),
            py::arg("values"), py::arg("epsilon") = 1e-6,
            py::arg("is_circle") = false, py::arg("is_radian") = false,
+           py::arg("bucket_factor") = pyinterp::detail::axis::container::
+               Irregular::kDefaultBucketFactor,
            R"__doc__(
 Create a coordinate axis from values.
 
@@ -153,6 +192,10 @@ Args:
         circle. Defaults to ``false``.
     is_radian (bool, optional): True, if the coordinate system is radian.
         Defaults to ``false``.
+    bucket_factor (int, optional): Maximum number of buckets, per axis
+        value, of the lookup table accelerating the searches if the values
+        are not evenly spaced. Zero disables the table, the searches being
+        then performed by a binary search. Defaults to ``4``.
 )__doc__")
       .def(py::init<double, double, double, double, bool, bool>(),
            py::arg("start"), py::arg("stop"), py::arg("step"),
@@ -219,6 +262,29 @@ Return:
     ``bounded`` parameter is set to false and if one of the searched indexes
     is out of the definition range of the axis, otherwise the index of the
     closest value of the coordinate is returned.
+)__doc__")
+      .def(
+          "find_indexes",
+          [](const pyinterp::Axis& self,
+             const py::array_t<double, py::array::c_style |
+                                           py::array::forcecast>& coordinates)
+              -> py::tuple { return self.find_indexes(coordinates); },
+          py::arg("coordinates"), R"__doc__(
+Given coordinate positions, find the grid elements around them and the
+fractional position of the coordinates between these elements.
+
+For each position located inside the axis definition domain
+``coordinate = (1 - weight) * axis[i0] + weight * axis[i1]``, the coordinate
+being reduced modulo the circle if the axis represents an angle.
+
+Args:
+    coordinates (numpy.ndarray): Positions in this coordinate system
+Return:
+    tuple: A tuple of four arrays ``(i0, i1, weight, mask)`` containing, for
+    each position, the indexes of the two elements framing it, its fractional
+    position between these elements and a mask set to true if the position is
+    outside the axis definition domain (``i0`` and ``i1`` are then set to -1 and
+    ``weight`` to NaN).
 )__doc__")
       .def("front", &pyinterp::Axis::front, R"__doc__(
 Get the first value of this axis
@@ -251,6 +317,14 @@ Test if this axis represents a circle.
 
 Return:
     bool: True if this axis represents a circle
+)__doc__")
+      .def_property_readonly("lookup_table_size",
+                             &pyinterp::Axis::lookup_table_size, R"__doc__(
+Get the memory used by the lookup table accelerating the searches on an
+irregular axis.
+
+Return:
+    int: The size of the lookup table in bytes, 0 if the axis is regular.
 )__doc__")
       .def("__eq__",
            [](const pyinterp::Axis& self, const pyinterp::Axis& rhs) -> bool {
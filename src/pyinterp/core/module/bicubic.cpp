@@ -3,6 +3,7 @@
 // All rights reserved. Use of this source code is governed by a
 // BSD-style license that can be found in the LICENSE file.
 #include "pyinterp/bicubic.hpp"
+#include "pyinterp/detail/morton.hpp"
 #include <pybind11/pybind11.h>
 #include <pybind11/numpy.h>
 #include <pybind11/stl.h>
@@ -12,35 +13,40 @@ namespace py = pybind11;
 namespace pyinterp {
 
 /// Loads the interpolation frame into memory
-template <typename Type>
-bool Bicubic<Type>::load_frame(const double x, const double y,
-                               const Axis::Boundary boundary,
-                               const bool bounds_error,
-                               detail::math::XArray& frame) const {
-  auto y_indexes =
-      this->y_->find_indexes(y, static_cast<uint32_t>(frame.ny()), boundary);
-  auto x_indexes =
-      this->x_->find_indexes(x, static_cast<uint32_t>(frame.nx()), boundary);
-
-  if (x_indexes.empty() || y_indexes.empty()) {
+template <typename Coordinate, typename Type>
+template <typename X, typename Y>
+bool Bicubic<Coordinate, Type>::load_frame(
+    const X& x_axis, const Y& y_axis, const double x, const double y,
+    const Axis::Boundary boundary, const bool bounds_error,
+    detail::math::XArray& frame, detail::axis::Cursor& x_cursor,
+    detail::axis::Cursor& y_cursor, std::vector<int64_t>& x_indexes,
+    std::vector<int64_t>& y_indexes) const {
+  auto y_found = this->y_->template find_indexes<Y>(
+      y, static_cast<uint32_t>(frame.ny()), boundary, y_cursor,
+      y_indexes.data());
+  auto x_found = this->x_->template find_indexes<X>(
+      x, static_cast<uint32_t>(frame.nx()), boundary, x_cursor,
+      x_indexes.data());
+
+  if (!x_found || !y_found) {
     if (bounds_error) {
-      if (x_indexes.empty()) {
-        Bicubic::index_error(*this->x_, static_cast<Type>(x), "x");
+      if (!x_found) {
+        Bicubic::index_error(*this->x_, x, "x");
       }
-      Bicubic::index_error(*this->y_, static_cast<Type>(y), "y");
+      Bicubic::index_error(*this->y_, y, "y");
     }
     return false;
   }
 
-  auto x0 = (*this->x_)(x_indexes[0]);
+  auto x0 = x_axis.coordinate_value(x_indexes[0]);
 
   for (auto jx = 0; jx < frame.y().size(); ++jx) {
-    frame.y(jx) = (*this->y_)(y_indexes[jx]);
+    frame.y(jx) = y_axis.coordinate_value(y_indexes[jx]);
   }
 
   for (auto ix = 0; ix < frame.x().size(); ++ix) {
     auto index = x_indexes[ix];
-    auto value = (*this->x_)(index);
+    auto value = x_axis.coordinate_value(index);
 
     if (this->x_->is_angle()) {
       value = detail::math::normalize_angle(value, x0);
@@ -48,72 +54,322 @@ bool Bicubic<Type>::load_frame(const double x, const double y,
     frame.x(ix) = value;
 
     for (auto jx = 0; jx < frame.y().size(); ++jx) {
-      frame.z(ix, jx) = static_cast<double>(this->ptr_(index, y_indexes[jx]));
+      frame.z(ix, jx) = this->template value<double>(index, y_indexes[jx]);
     }
   }
   return frame.is_valid();
 }
 
+/// Evaluate the interpolation for the actual types of the axes containers.
+template <typename Coordinate, typename Type>
+template <typename X, typename Y>
+void Bicubic<Coordinate, Type>::_evaluate(
+    const X& x_axis, const Y& y_axis,
+    const detail::FlatView<const Coordinate>& _x,
+    const detail::FlatView<const Coordinate>& _y,
+    const detail::FlatView<Coordinate>& _result,
+    const size_t nx, const size_t ny,
+    const detail::math::Bicubic& interpolator, const Axis::Boundary boundary,
+    const bool bounds_error, const size_t size, const size_t num_threads,
+    const detail::Schedule schedule, const size_t chunk_size,
+    const std::vector<size_t>& indexes) const {
+  detail::dispatch(
+      [&](const size_t start, const size_t end) {
+        auto frame = detail::math::XArray(nx, ny);
+        auto acc = detail::gsl::Accelerator();
+        auto x_cursor = detail::axis::Cursor();
+        auto y_cursor = detail::axis::Cursor();
+        auto x_indexes = std::vector<int64_t>(frame.x().size());
+        auto y_indexes = std::vector<int64_t>(frame.y().size());
+
+        for (size_t jx = start; jx < end; ++jx) {
+          auto ix = indexes.empty() ? jx : indexes[jx];
+          auto xi = _x(ix);
+          auto yi = _y(ix);
+          _result(ix) =
+              load_frame(x_axis, y_axis, xi, yi, boundary, bounds_error,
+                         frame, x_cursor, y_cursor, x_indexes, y_indexes)
+                  ? interpolator.interpolate(this->x_->is_angle()
+                                                 ? frame.normalize_angle(xi)
+                                                 : xi,
+                                             yi, frame, acc)
+                  : std::numeric_limits<double>::quiet_NaN();
+        }
+      },
+      size, num_threads, schedule, chunk_size);
+}
+
 /// Evaluate the interpolation.
-template <typename Type>
-py::array_t<double> Bicubic<Type>::evaluate(
-    const py::array_t<double>& x, const py::array_t<double>& y, size_t nx,
-    size_t ny, FittingModel fitting_model, const Axis::Boundary boundary,
-    const bool bounds_error, size_t num_threads) const {
+template <typename Coordinate, typename Type>
+py::array_t<Coordinate> Bicubic<Coordinate, Type>::evaluate(
+    const py::array_t<Coordinate>& x, const py::array_t<Coordinate>& y,
+    size_t nx, size_t ny, FittingModel fitting_model,
+    const Axis::Boundary boundary, const bool bounds_error,
+    size_t num_threads, const detail::Schedule schedule,
+    const size_t chunk_size, const bool reorder,
+    const std::optional<py::array_t<Coordinate>>& out) const {
+  auto shape = detail::broadcast_shape("x", x, "y", y);
+  if (out) {
+    detail::check_ndarray_shape("out", *out, shape);
+  }
+
+  auto result = out ? *out : py::array_t<Coordinate>(shape);
+  auto size = static_cast<size_t>(result.size());
+
+  auto _x = detail::FlatView<const Coordinate>(x.data(), x, shape);
+  auto _y = detail::FlatView<const Coordinate>(y.data(), y, shape);
+  auto _result =
+      detail::FlatView<Coordinate>(result.mutable_data(), result, shape);
+  auto interpolator =
+      detail::math::Bicubic(Bicubic::interp_type(fitting_model));
+  {
+    py::gil_scoped_release release;
+
+    // Order in which the values are processed, if they are reordered.
+    auto indexes = reorder ? detail::morton::order<2>(
+                                 [&](const size_t ix, const size_t dim) {
+                                   return dim == 0 ? _x(ix) : _y(ix);
+                                 },
+                                 size, num_threads)
+                           : std::vector<size_t>();
+
+    // The evaluation loop is instantiated for the actual types of the axes
+    // containers in order to resolve the index searches at compile time.
+    this->x_->visit([&](const auto& x_axis) {
+      this->y_->visit([&](const auto& y_axis) {
+        this->_evaluate(x_axis, y_axis, _x, _y, _result, nx, ny, interpolator,
+                        boundary, bounds_error, size, num_threads, schedule,
+                        chunk_size, indexes);
+      });
+    });
+  }
+  return result;
+}
+
+/// Evaluate the interpolation and its derivatives for the actual types of the
+/// axes containers.
+template <typename Coordinate, typename Type>
+template <typename X, typename Y>
+void Bicubic<Coordinate, Type>::_evaluate_gradient(
+    const X& x_axis, const Y& y_axis,
+    const py::detail::unchecked_reference<Coordinate, 1>& _x,
+    const py::detail::unchecked_reference<Coordinate, 1>& _y,
+    py::detail::unchecked_mutable_reference<Coordinate, 2>& _result,
+    const size_t nx, const size_t ny,
+    const detail::math::Bicubic& interpolator, const Axis::Boundary boundary,
+    const bool bounds_error, const size_t size, const size_t num_threads,
+    const detail::Schedule schedule, const size_t chunk_size,
+    const std::vector<size_t>& indexes) const {
+  detail::dispatch(
+      [&](const size_t start, const size_t end) {
+        auto frame = detail::math::XArray(nx, ny);
+        auto acc = detail::gsl::Accelerator();
+        auto x_cursor = detail::axis::Cursor();
+        auto y_cursor = detail::axis::Cursor();
+        auto x_indexes = std::vector<int64_t>(frame.x().size());
+        auto y_indexes = std::vector<int64_t>(frame.y().size());
+
+        for (size_t jx = start; jx < end; ++jx) {
+          auto ix = indexes.empty() ? jx : indexes[jx];
+          auto xi = _x(ix);
+          auto yi = _y(ix);
+          if (load_frame(x_axis, y_axis, xi, yi, boundary, bounds_error,
+                         frame, x_cursor, y_cursor, x_indexes, y_indexes)) {
+            std::tie(_result(ix, 0), _result(ix, 1), _result(ix, 2)) =
+                interpolator.gradient(this->x_->is_angle()
+                                          ? frame.normalize_angle(xi)
+                                          : xi,
+                                      yi, frame, acc);
+          } else {
+            _result(ix, 0) = _result(ix, 1) = _result(ix, 2) =
+                std::numeric_limits<double>::quiet_NaN();
+          }
+        }
+      },
+      size, num_threads, schedule, chunk_size);
+}
+
+/// Evaluate the interpolation and its derivatives.
+template <typename Coordinate, typename Type>
+py::array_t<Coordinate> Bicubic<Coordinate, Type>::evaluate_gradient(
+    const py::array_t<Coordinate>& x, const py::array_t<Coordinate>& y,
+    size_t nx, size_t ny, FittingModel fitting_model,
+    const Axis::Boundary boundary, const bool bounds_error,
+    size_t num_threads, const detail::Schedule schedule,
+    const size_t chunk_size, const bool reorder) const {
   detail::check_array_ndim("x", 1, x, "y", 1, y);
   detail::check_ndarray_shape("x", x, "y", y);
 
   auto size = x.size();
-  auto result = py::array_t<double>(py::array::ShapeContainer{size});
+  auto result = py::array_t<Coordinate>(
+      py::array::ShapeContainer{size, py::ssize_t(3)});
 
   auto _x = x.template unchecked<1>();
   auto _y = y.template unchecked<1>();
-  auto _result = result.template mutable_unchecked<1>();
+  auto _result = result.template mutable_unchecked<2>();
   auto interpolator =
       detail::math::Bicubic(Bicubic::interp_type(fitting_model));
   {
     py::gil_scoped_release release;
 
-    // Captures the detected exceptions in the calculation function
-    // (only the last exception captured is kept)
-    auto except = std::exception_ptr(nullptr);
-
-    detail::dispatch(
-        [&](const size_t start, const size_t end) {
-          auto frame = detail::math::XArray(nx, ny);
-          auto acc = detail::gsl::Accelerator();
-
-          try {
-            for (size_t ix = start; ix < end; ++ix) {
-              auto xi = _x(ix);
-              auto yi = _y(ix);
-              _result(ix) =
-                  load_frame(xi, yi, boundary, bounds_error, frame)
-                      ? interpolator.interpolate(this->x_->is_angle()
-                                                     ? frame.normalize_angle(xi)
-                                                     : xi,
-                                                 yi, frame, acc)
-                      : std::numeric_limits<double>::quiet_NaN();
+    auto indexes = reorder ? detail::morton::order<2>(
+                                 [&](const size_t ix, const size_t dim) {
+                                   return dim == 0 ? _x(ix) : _y(ix);
+                                 },
+                                 size, num_threads)
+                           : std::vector<size_t>();
+
+    this->x_->visit([&](const auto& x_axis) {
+      this->y_->visit([&](const auto& y_axis) {
+        this->_evaluate_gradient(x_axis, y_axis, _x, _y, _result, nx, ny,
+                                 interpolator, boundary, bounds_error, size,
+                                 num_threads, schedule, chunk_size, indexes);
+      });
+    });
+  }
+  return result;
+}
+
+/// Searches the windows of the grid framing the coordinates of a target axis.
+template <typename Coordinate, typename Type>
+template <typename Container>
+std::vector<typename Bicubic<Coordinate, Type>::Window>
+Bicubic<Coordinate, Type>::windows(
+    const Axis& axis, const Container& container, const Axis& target,
+    const size_t size, const Axis::Boundary boundary, const bool bounds_error,
+    const std::string& name) {
+  auto result = std::vector<Window>(target.size());
+  auto cursor = detail::axis::Cursor();
+  auto indexes = std::vector<int64_t>(size << 1U);
+
+  for (size_t ix = 0; ix < result.size(); ++ix) {
+    auto& window = result[ix];
+    window.value = target.coordinate_value(ix);
+    if (!axis.template find_indexes<Container>(
+            window.value, static_cast<uint32_t>(size), boundary, cursor,
+            indexes.data())) {
+      if (bounds_error) {
+        Bicubic::index_error(axis, window.value, name);
+      }
+      continue;
+    }
+    window.indexes = indexes;
+    window.coordinates.resize(indexes.size());
+    for (size_t jx = 0; jx < indexes.size(); ++jx) {
+      window.coordinates(jx) = container.coordinate_value(indexes[jx]);
+    }
+  }
+  return result;
+}
+
+/// Interpolates the grid onto the target grid for the actual types of the
+/// axes containers.
+template <typename Coordinate, typename Type>
+template <typename X, typename Y>
+void Bicubic<Coordinate, Type>::_regrid(
+    const X& x_axis, const Y& y_axis, const Axis& x, const Axis& y,
+    py::detail::unchecked_mutable_reference<Coordinate, 2>& _result,
+    const size_t nx, const size_t ny, const gsl_interp_type* type,
+    const Axis::Boundary boundary, const bool bounds_error,
+    const size_t num_threads) const {
+  auto columns =
+      windows(*this->x_, x_axis, x, nx, boundary, bounds_error, "x");
+  auto rows = windows(*this->y_, y_axis, y, ny, boundary, bounds_error, "y");
+
+  // The longitudes are normalized with respect to the first element of their
+  // window, as done by load_frame.
+  if (this->x_->is_angle()) {
+    for (auto& window : columns) {
+      if (!window.indexes.empty()) {
+        auto x0 = window.coordinates(0);
+        for (auto ix = 0; ix < window.coordinates.size(); ++ix) {
+          window.coordinates(ix) =
+              detail::math::normalize_angle(window.coordinates(ix), x0);
+        }
+        window.value = detail::math::normalize_angle(window.value, x0);
+      }
+    }
+  }
+
+  // The threads process target rows: the splines along the Y-Axis calculated
+  // for a row are shared by all its points.
+  detail::dispatch(
+      [&](const size_t start, const size_t end) {
+        auto acc = detail::gsl::Accelerator();
+        // Value of the splines along the Y-Axis, at the current target row,
+        // for each column of the grid. "row_of" stores the target row for
+        // which the value of a column has been calculated.
+        auto fy = std::vector<double>(this->x_->size());
+        auto row_of = std::vector<size_t>(this->x_->size(), end);
+        auto column = Eigen::VectorXd(ny << 1U);
+        auto fx = Eigen::VectorXd(nx << 1U);
+
+        for (auto jx = start; jx < end; ++jx) {
+          const auto& row = rows[jx];
+          for (size_t ix = 0; ix < columns.size(); ++ix) {
+            const auto& window = columns[ix];
+            if (row.indexes.empty() || window.indexes.empty()) {
+              _result(ix, jx) = std::numeric_limits<double>::quiet_NaN();
+              continue;
+            }
+            for (size_t kx = 0; kx < window.indexes.size(); ++kx) {
+              auto index = window.indexes[kx];
+              if (row_of[index] != jx) {
+                for (size_t lx = 0; lx < row.indexes.size(); ++lx) {
+                  column(lx) =
+                      this->template value<double>(index, row.indexes[lx]);
+                }
+                fy[index] = column.hasNaN()
+                                ? std::numeric_limits<double>::quiet_NaN()
+                                : detail::gsl::Interpolate1D(
+                                      type, row.coordinates, column, acc)
+                                      .interpolate(row.value);
+                row_of[index] = jx;
+              }
+              fx(kx) = fy[index];
             }
-          } catch (...) {
-            except = std::current_exception();
+            _result(ix, jx) =
+                fx.hasNaN() ? std::numeric_limits<double>::quiet_NaN()
+                            : detail::gsl::Interpolate1D(
+                                  type, window.coordinates, fx, acc)
+                                  .interpolate(window.value);
           }
-        },
-        size, num_threads);
+        }
+      },
+      rows.size(), num_threads);
+}
 
-    if (except != nullptr) {
-      std::rethrow_exception(except);
-    }
+/// Interpolates the grid onto the grid defined by the target axes.
+template <typename Coordinate, typename Type>
+py::array_t<Coordinate> Bicubic<Coordinate, Type>::regrid(
+    const Axis& x, const Axis& y, const size_t nx, const size_t ny,
+    const FittingModel fitting_model, const Axis::Boundary boundary,
+    const bool bounds_error, const size_t num_threads) const {
+  auto result =
+      py::array_t<Coordinate>(py::array::ShapeContainer{x.size(), y.size()});
+  auto _result = result.template mutable_unchecked<2>();
+  auto type = Bicubic::interp_type(fitting_model);
+  {
+    py::gil_scoped_release release;
+
+    this->x_->visit([&](const auto& x_axis) {
+      this->y_->visit([&](const auto& y_axis) {
+        this->_regrid(x_axis, y_axis, x, y, _result, nx, ny, type, boundary,
+                      bounds_error, num_threads);
+      });
+    });
   }
   return result;
 }
 
 }  // namespace pyinterp
 
-template <typename Type>
+template <typename Coordinate, typename Type>
 void implement_bicubic(py::module& m, const char* const class_name) {
-  py::class_<pyinterp::Bicubic<Type>>(m, class_name,
-                                      R"__doc__(
+  using Bicubic = pyinterp::Bicubic<Coordinate, Type>;
+
+  auto cls = py::class_<Bicubic>(m, class_name,
+                                 R"__doc__(
 Extension of cubic interpolation for interpolating data points on a
 two-dimensional regular grid. The interpolated surface is smoother than
 corresponding surfaces obtained by bilinear interpolation or
@@ -121,8 +377,10 @@ nearest-neighbor interpolation.
 )__doc__")
       .def(
           py::init<std::shared_ptr<pyinterp::Axis>,
-                   std::shared_ptr<pyinterp::Axis>, const py::array_t<Type>&>(),
+                   std::shared_ptr<pyinterp::Axis>, const py::array_t<Type>&,
+                   std::optional<std::vector<ssize_t>>>(),
           py::arg("x"), py::arg("y"), py::arg("array"),
+          py::arg("axes") = py::none(),
           R"__doc__(
 Default constructor
 
@@ -130,9 +388,12 @@ Args:
     x (pyinterp.core.Axis): X-Axis
     y (pyinterp.core.Axis): Y-Axis
     array (numpy.ndarray): Bivariate function
+    axes (tuple, optional): Dimension of the array holding each axis of the
+        grid, if the array is not stored in the order of the axes. The array
+        is then read without being copied. Defaults to ``None``.
   )__doc__")
       .def_property_readonly(
-          "x", [](const pyinterp::Bicubic<Type>& self) { return self.x(); },
+          "x", [](const Bicubic& self) { return self.x(); },
           R"__doc__(
 Gets the X-Axis handled by this instance
 
@@ -140,7 +401,7 @@ Returns:
     pyinterp.core.Axis: X-Axis
 )__doc__")
       .def_property_readonly(
-          "y", [](const pyinterp::Bicubic<Type>& self) { return self.y(); },
+          "y", [](const Bicubic& self) { return self.y(); },
           R"__doc__(
 Gets the Y-Axis handled by this instance
 
@@ -149,21 +410,92 @@ Returns:
 )__doc__")
       .def_property_readonly(
           "array",
-          [](const pyinterp::Bicubic<Type>& self) { return self.array(); },
+          [](const Bicubic& self) { return self.array(); },
           R"__doc__(
 Gets the values handled by this instance
 
 Returns:
     numpy.ndarray: values to interpolate
 )__doc__")
-      .def("evaluate", &pyinterp::Bicubic<Type>::evaluate, py::arg("x"),
-           py::arg("y"), py::arg("nx") = 3, py::arg("ny") = 3,
+      .def_property_readonly(
+          "dtype",
+          [](const Bicubic& /*self*/) { return py::dtype::of<Coordinate>(); },
+          R"__doc__(
+Gets the type of the coordinates and of the values interpolated
+
+Returns:
+    numpy.dtype: ``float64``, or ``float32`` for the interpolators calculating
+    in single precision. The splines are fitted in double precision in both
+    cases.
+)__doc__")
+      .def("evaluate", &Bicubic::evaluate, py::arg("x"), py::arg("y"),
+           py::arg("nx") = 3, py::arg("ny") = 3,
            py::arg("fitting_model") = pyinterp::FittingModel::kCSpline,
            py::arg("boundary") = pyinterp::Axis::kUndef,
            py::arg("bounds_error") = false, py::arg("num_threads") = 0,
+           py::arg("schedule") = pyinterp::detail::kStatic,
+           py::arg("chunk_size") = 0, py::arg("reorder") = false,
+           py::arg("out").noconvert() = py::none(),
            R"__doc__(
 Evaluate the interpolation.
 
+Args:
+    x (numpy.ndarray): X-values, array of any shape
+    y (numpy.ndarray): Y-values, array of any shape
+    nx (int, optional): The number of X coordinate values required to perform
+        the interpolation. Defaults to ``3``.
+    ny (int, optional): The number of Y coordinate values required to perform
+        the interpolation. Defaults to ``3``.
+    fitting_model (pyinterp.core.FittingModel, optional): Type of interpolation
+        to be performed. Defaults to
+        :py:data:`pyinterp.core.FittingModel.CSpline`
+    boundary (pyinterp.core.Axis.Boundary, optional): Type of axis boundary
+        management. Defaults to
+        :py:data:`pyinterp.core.Axis.Boundary.kUndef`
+    bounds_error (bool, optional): If True, when interpolated values are
+        requested outside of the domain of the input axes (x,y), a ValueError
+        is raised. If False, then value is set to Nan.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+    schedule (pyinterp.core.Schedule, optional): Distribution of the values
+        between the threads. ``Dynamic`` balances the load between threads
+        when the cost of the calculation varies from one value to another.
+        Defaults to ``Static``.
+    chunk_size (int, optional): Number of values claimed at once by a thread
+        with the ``Dynamic`` schedule. If 0, the size is chosen according to
+        the number of values and threads. Defaults to ``0``.
+    reorder (bool, optional): If True, the values are processed in the
+        order of a space-filling curve (Morton order), so that consecutive
+        calculations access neighbouring memory areas. This improves the
+        cache efficiency for large numbers of randomly scattered values, at
+        the cost of sorting them. Defaults to ``False``.
+    out (numpy.ndarray, optional): Array receiving the values interpolated.
+        It must have the shape of the coordinates broadcast together and the
+        type of the result; it can be a non-contiguous view. Defaults to
+        ``None``, a new array being allocated.
+Return:
+    numpy.ndarray: Values interpolated, array of the shape of the coordinates
+    broadcast together (``out`` if provided).
+  )__doc__")
+      .def("evaluate_gradient", &Bicubic::evaluate_gradient,
+           py::arg("x"), py::arg("y"), py::arg("nx") = 3, py::arg("ny") = 3,
+           py::arg("fitting_model") = pyinterp::FittingModel::kCSpline,
+           py::arg("boundary") = pyinterp::Axis::kUndef,
+           py::arg("bounds_error") = false, py::arg("num_threads") = 0,
+           py::arg("schedule") = pyinterp::detail::kStatic,
+           py::arg("chunk_size") = 0, py::arg("reorder") = false,
+           R"__doc__(
+Evaluate the interpolation and the partial derivatives of the interpolated
+surface.
+
+The value and its derivatives are calculated in a single pass: the frame
+framing a value is loaded once, and the splines fitted along the Y-Axis
+provide both the values and the derivatives along Y. The derivatives are
+expressed in units of the function per unit of the axes (for example per
+degree for a longitude axis).
+
 Args:
     x (numpy.ndarray): X-values
     y (numpy.ndarray): Y-values
@@ -184,22 +516,96 @@ Args:
         computation. If 0 all CPUs are used. If 1 is given, no parallel
         computing code is used at all, which is useful for debugging.
         Defaults to ``0``.
+    schedule (pyinterp.core.Schedule, optional): Distribution of the values
+        between the threads. Defaults to ``Static``.
+    chunk_size (int, optional): Number of values claimed at once by a thread
+        with the ``Dynamic`` schedule. Defaults to ``0``.
+    reorder (bool, optional): If True, the values are processed in the
+        order of a space-filling curve (Morton order). Defaults to
+        ``False``.
 Return:
-    numpy.ndarray: Values interpolated
+    numpy.ndarray: Array of shape (x.size, 3) containing the values
+    interpolated, their derivatives with respect to x and their derivatives
+    with respect to y.
   )__doc__")
-      .def_static("_setstate", &pyinterp::Bicubic<Type>::setstate,
-                  py::arg("state"), R"__doc__(
+      .def("regrid", &Bicubic::regrid, py::arg("x"), py::arg("y"),
+           py::arg("nx") = 3, py::arg("ny") = 3,
+           py::arg("fitting_model") = pyinterp::FittingModel::kCSpline,
+           py::arg("boundary") = pyinterp::Axis::kUndef,
+           py::arg("bounds_error") = false, py::arg("num_threads") = 0,
+           R"__doc__(
+Interpolate the function onto the grid defined by the target axes.
+
+The windows framing the coordinates of the target axes are searched once per
+target column and once per target row, and the splines fitted along the Y-Axis
+are shared by all the points of a target row, which is much faster than
+evaluating the function on the points of a mesh grid.
+
+Args:
+    x (pyinterp.core.Axis): X-Axis of the target grid
+    y (pyinterp.core.Axis): Y-Axis of the target grid
+    nx (int, optional): The number of X coordinate values required to perform
+        the interpolation. Defaults to ``3``.
+    ny (int, optional): The number of Y coordinate values required to perform
+        the interpolation. Defaults to ``3``.
+    fitting_model (pyinterp.core.FittingModel, optional): Type of interpolation
+        to be performed. Defaults to
+        :py:data:`pyinterp.core.FittingModel.CSpline`
+    boundary (pyinterp.core.Axis.Boundary, optional): Type of axis boundary
+        management. Defaults to
+        :py:data:`pyinterp.core.Axis.Boundary.kUndef`
+    bounds_error (bool, optional): If True, when interpolated values are
+        requested outside of the domain of the input axes (x,y), a ValueError
+        is raised. If False, then value is set to Nan.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+Return:
+    numpy.ndarray: Values interpolated, array of shape (x.size(), y.size())
+  )__doc__")
+      .def_static("_setstate", &Bicubic::setstate, py::arg("state"),
+                  R"__doc__(
 Rebuild an instance from a registered state of this object.
 
 Args:
   state: Registred state of this object
 )__doc__")
       .def(py::pickle(
-          [](const pyinterp::Bicubic<Type>& self) { return self.getstate(); },
+          [](const Bicubic& self) { return self.getstate(); },
           [](const py::tuple& tuple) {
-            return new pyinterp::Bicubic(
-                pyinterp::Bicubic<Type>::setstate(tuple));
+            return new Bicubic(Bicubic::setstate(tuple));
           }));
+
+  if constexpr (std::is_integral_v<Type>) {
+    cls.def(py::init<std::shared_ptr<pyinterp::Axis>,
+                     std::shared_ptr<pyinterp::Axis>, const py::array_t<Type>&,
+                     double, double, std::optional<Type>,
+                     std::optional<std::vector<ssize_t>>>(),
+            py::arg("x"), py::arg("y"), py::arg("array"),
+            py::arg("scale_factor") = 1.0, py::arg("add_offset") = 0.0,
+            py::arg("fill_value") = py::none(), py::arg("axes") = py::none(),
+            R"__doc__(
+Constructor of a grid of packed integers: the integer q represents the
+value q * scale_factor + add_offset, or an undefined value if it is equal to
+the fill value. The values are decoded when they are interpolated.
+
+Args:
+    x (pyinterp.core.Axis): X-Axis
+    y (pyinterp.core.Axis): Y-Axis
+    array (numpy.ndarray): Bivariate function, packed
+    scale_factor (float, optional): Factor applied to the integers. Defaults
+        to ``1``.
+    add_offset (float, optional): Offset added to the integers multiplied by
+        the scale factor. Defaults to ``0``.
+    fill_value (int, optional): Integer representing the undefined values.
+        Defaults to ``None``, all the integers representing a value.
+    axes (tuple, optional): Dimension of the array holding each axis of the
+        grid, if the array is not stored in the order of the axes. The array
+        is then read without being copied. Defaults to ``None``.
+)__doc__");
+    pyinterp::implement_packing(cls);
+  }
 }
 
 void init_bicubic(py::module& m) {
@@ -223,6 +629,11 @@ Bicubic fitting model
           "*Steffen’s method guarantees the monotonicity of data points. the "
           "interpolating function between the given*.");
 
-  implement_bicubic<double>(m, "BicubicFloat64");
-  implement_bicubic<float>(m, "BicubicFloat32");
+  implement_bicubic<double, double>(m, "BicubicFloat64");
+  implement_bicubic<double, float>(m, "BicubicFloat32");
+  implement_bicubic<float, float>(m, "BicubicFloat32Float32");
+  implement_bicubic<double, int8_t>(m, "BicubicInt8");
+  implement_bicubic<double, uint8_t>(m, "BicubicUInt8");
+  implement_bicubic<double, int16_t>(m, "BicubicInt16");
+  implement_bicubic<double, uint16_t>(m, "BicubicUInt16");
 }
@@ -14,14 +14,38 @@ void init_grid(py::module& m) {
                                              double>(m, "2D");
   pyinterp::implement_bivariate_interpolator<geometry::EquatorialPoint3D,
                                              double>(m, "3D");
+  pyinterp::implement_bivariate_interpolator<geometry::EquatorialPoint2D,
+                                             float>(m, "2DFloat32");
+  pyinterp::implement_bivariate_interpolator<geometry::EquatorialPoint3D,
+                                             float>(m, "3DFloat32");
 
   pyinterp::implement_bivariate<geometry::EquatorialPoint2D, double, double>(
       m, "BivariateFloat64");
   pyinterp::implement_bivariate<geometry::EquatorialPoint2D, double, float>(
       m, "BivariateFloat32");
+  pyinterp::implement_bivariate<geometry::EquatorialPoint2D, float, float>(
+      m, "BivariateFloat32Float32");
+  pyinterp::implement_bivariate<geometry::EquatorialPoint2D, double, int8_t>(
+      m, "BivariateInt8");
+  pyinterp::implement_bivariate<geometry::EquatorialPoint2D, double, uint8_t>(
+      m, "BivariateUInt8");
+  pyinterp::implement_bivariate<geometry::EquatorialPoint2D, double, int16_t>(
+      m, "BivariateInt16");
+  pyinterp::implement_bivariate<geometry::EquatorialPoint2D, double,
+                                uint16_t>(m, "BivariateUInt16");
 
   pyinterp::implement_trivariate<geometry::EquatorialPoint3D, double, double>(
       m, "TrivariateFloat64");
   pyinterp::implement_trivariate<geometry::EquatorialPoint3D, double, float>(
       m, "TrivariateFloat32");
+  pyinterp::implement_trivariate<geometry::EquatorialPoint3D, float, float>(
+      m, "TrivariateFloat32Float32");
+  pyinterp::implement_trivariate<geometry::EquatorialPoint3D, double, int8_t>(
+      m, "TrivariateInt8");
+  pyinterp::implement_trivariate<geometry::EquatorialPoint3D, double,
+                                 uint8_t>(m, "TrivariateUInt8");
+  pyinterp::implement_trivariate<geometry::EquatorialPoint3D, double,
+                                 int16_t>(m, "TrivariateInt16");
+  pyinterp::implement_trivariate<geometry::EquatorialPoint3D, double,
+                                 uint16_t>(m, "TrivariateUInt16");
 }
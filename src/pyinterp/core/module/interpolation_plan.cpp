@@ -0,0 +1,164 @@
+// Copyright (c) 2019 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "pyinterp/interpolation_plan.hpp"
+#include <pybind11/pybind11.h>
+
+namespace py = pybind11;
+
+namespace pyinterp {
+
+/// Copies a vector into a new NumPy array
+template <typename T>
+inline py::array_t<T> to_numpy(const std::vector<T>& vector) {
+  return py::array_t<T>(
+      py::array::ShapeContainer{static_cast<py::ssize_t>(vector.size())},
+      vector.data());
+}
+
+/// Copies a NumPy array into a new vector
+template <typename T>
+inline std::vector<T> from_numpy(
+    const std::string& name,
+    const py::array_t<T, py::array::c_style | py::array::forcecast>&
+        ndarray) {
+  detail::check_array_ndim(name, 1, ndarray);
+  return std::vector<T>(ndarray.data(), ndarray.data() + ndarray.size());
+}
+
+InterpolationPlan::InterpolationPlan(const size_t nx, const size_t ny,
+                                     std::vector<int64_t> indptr,
+                                     std::vector<int64_t> indices,
+                                     std::vector<double> weights,
+                                     const bool transposed)
+    : nx_(nx),
+      ny_(ny),
+      indptr_(std::move(indptr)),
+      indices_(std::move(indices)),
+      weights_(std::move(weights)),
+      transposed_(transposed) {
+  if (indptr_.empty() || indptr_.front() != 0 ||
+      indptr_.back() != static_cast<int64_t>(indices_.size()) ||
+      indices_.size() != weights_.size() ||
+      !std::is_sorted(indptr_.begin(), indptr_.end())) {
+    throw std::invalid_argument("invalid interpolation plan");
+  }
+  auto cells = static_cast<int64_t>(nx_ * ny_);
+  for (auto item : indices_) {
+    if (item < 0 || item >= cells) {
+      throw std::invalid_argument("invalid interpolation plan");
+    }
+  }
+}
+
+py::array_t<int64_t> InterpolationPlan::indptr() const {
+  return to_numpy(indptr_);
+}
+
+py::array_t<int64_t> InterpolationPlan::indices() const {
+  return to_numpy(indices_);
+}
+
+py::array_t<double> InterpolationPlan::weights() const {
+  return to_numpy(weights_);
+}
+
+py::tuple InterpolationPlan::getstate() const {
+  return py::make_tuple(nx_, ny_, indptr(), indices(), weights(),
+                        transposed_);
+}
+
+InterpolationPlan InterpolationPlan::setstate(const py::tuple& state) {
+  if (state.size() != 5 && state.size() != 6) {
+    throw std::runtime_error("invalid state");
+  }
+  return InterpolationPlan(
+      state[0].cast<size_t>(), state[1].cast<size_t>(),
+      from_numpy<int64_t>("indptr", state[2].cast<py::array_t<int64_t>>()),
+      from_numpy<int64_t>("indices", state[3].cast<py::array_t<int64_t>>()),
+      from_numpy<double>("weights", state[4].cast<py::array_t<double>>()),
+      state.size() == 6 && state[5].cast<bool>());
+}
+
+}  // namespace pyinterp
+
+void init_interpolation_plan(py::module& m) {
+  py::class_<pyinterp::InterpolationPlan>(m, "InterpolationPlan", R"__doc__(
+Interpolation of a fixed set of positions on a grid, precomputed once in order
+to interpolate many arrays defined on this grid.
+
+A plan is built by the method ``plan`` of the bivariate interpolators. It
+holds, in the CSR (compressed sparse row) format, the sparse matrix of shape
+(number of positions, nx * ny) whose row i contains the weights of the grid
+values used to interpolate the position i, the columns being the indexes of
+these values in the grid flattened in C order. The positions located outside
+the grid have an empty row and are interpolated to NaN.
+)__doc__")
+      .def("__len__", &pyinterp::InterpolationPlan::size,
+           "Gets the number of positions interpolated")
+      .def_property_readonly("grid_shape",
+                             &pyinterp::InterpolationPlan::grid_shape,
+                             R"__doc__(
+Gets the shape of the grid handled by this plan
+
+Returns:
+    tuple: (nx, ny)
+)__doc__")
+      .def_property_readonly("transposed",
+                             &pyinterp::InterpolationPlan::transposed,
+                             R"__doc__(
+Gets whether the arrays interpolated are stored (ny, nx), like the array of a
+grid read in its native axis order.
+
+Returns:
+    bool: True if the arrays are transposed
+)__doc__")
+      .def_property_readonly("indptr", &pyinterp::InterpolationPlan::indptr,
+                             R"__doc__(
+Gets the index of the first item of each row, followed by the number of items
+
+Returns:
+    numpy.ndarray: vector of size ``len(plan) + 1``
+)__doc__")
+      .def_property_readonly("indices", &pyinterp::InterpolationPlan::indices,
+                             R"__doc__(
+Gets the index of the grid values used by each row
+
+Returns:
+    numpy.ndarray: indices
+)__doc__")
+      .def_property_readonly("weights", &pyinterp::InterpolationPlan::weights,
+                             R"__doc__(
+Gets the weight of the grid values used by each row
+
+Returns:
+    numpy.ndarray: weights
+)__doc__")
+      .def("apply", &pyinterp::InterpolationPlan::apply<double>,
+           py::arg("array"), py::arg("num_threads") = 0, R"__doc__(
+Interpolate an array, or a stack of arrays, defined on the grid.
+
+Args:
+    array (numpy.ndarray): Values of the grid, array of shape (nx, ny), or of
+        shape (nx, ny, k) to interpolate a stack of k arrays at once; (ny,
+        nx) or (ny, nx, k) if the plan is transposed. The array may have any
+        memory layout.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+Return:
+    numpy.ndarray: Values interpolated, of shape (len(plan), ) or
+    (len(plan), k)
+)__doc__")
+      .def("apply", &pyinterp::InterpolationPlan::apply<float>,
+           py::arg("array"), py::arg("num_threads") = 0)
+      .def(py::pickle(
+          [](const pyinterp::InterpolationPlan& self) {
+            return self.getstate();
+          },
+          [](const py::tuple& state) {
+            return pyinterp::InterpolationPlan::setstate(state);
+          }));
+}
@@ -11,7 +11,10 @@ extern void init_axis(py::module&);
 extern void init_bicubic(py::module&);
 extern void init_geodetic(py::module&);
 extern void init_grid(py::module&);
+extern void init_interpolation_plan(py::module&);
 extern void init_rtree(py::module&);
+extern void init_thread(py::module&);
+extern void init_tiled_grid(py::module&);
 
 PYBIND11_MODULE(core, m) {
   m.doc() = R"__doc__(
@@ -26,9 +29,14 @@ Geographic coordinate system
 
   pyinterp::detail::gsl::set_error_handler();
 
+  // Must be called first: the other modules use the types defined here as
+  // default values of their arguments.
+  init_thread(m);
   init_axis(m);
+  init_interpolation_plan(m);
   init_grid(m);
   init_bicubic(m);
+  init_tiled_grid(m);
   init_geodetic(geodetic);
   init_rtree(m);
 }
@@ -84,11 +84,16 @@ Args:
       .def("query",
            [](const pyinterp::RTree<Coordinate, Type>& self,
               const py::array_t<double>& coordinates, const uint32_t k,
-              const bool within, const size_t num_threads) -> py::tuple {
-             return self.query(coordinates, k, within, num_threads);
+              const bool within, const size_t num_threads,
+              const pyinterp::detail::Schedule schedule,
+              const size_t chunk_size, const bool reorder) -> py::tuple {
+             return self.query(coordinates, k, within, num_threads, schedule,
+                               chunk_size, reorder);
            },
            py::arg("coordinates"), py::arg("k") = 4, py::arg("within") = false,
            py::arg("num_threads") = 0,
+           py::arg("schedule") = pyinterp::detail::kStatic,
+           py::arg("chunk_size") = 0, py::arg("reorder") = false,
            R"__doc__(
 Search for the nearest K nearest neighbors of a given point.
 
@@ -105,6 +110,18 @@ Args:
         computation. If 0 all CPUs are used. If 1 is given, no parallel
         computing code is used at all, which is useful for debugging.
         Defaults to ``0``.
+    schedule (pyinterp.core.Schedule, optional): Distribution of the values
+        between the threads. ``Dynamic`` balances the load between threads
+        when the cost of the calculation varies from one value to another.
+        Defaults to ``Static``.
+    chunk_size (int, optional): Number of values claimed at once by a thread
+        with the ``Dynamic`` schedule. If 0, the size is chosen according to
+        the number of values and threads. Defaults to ``0``.
+    reorder (bool, optional): If True, the positions are processed in the
+        order of a space-filling curve (Morton order), so that consecutive
+        searches walk through neighbouring nodes of the tree. This improves
+        the cache efficiency for large numbers of randomly scattered
+        positions, at the cost of sorting them. Defaults to ``False``.
 Return:
     tuple: A tuple containing a matrix describing for each provided position,
     the distance, in meters, between the provided position and the found
@@ -117,6 +134,8 @@ Return:
            py::arg("radius") = std::numeric_limits<Coordinate>::max(),
            py::arg("k") = 4, py::arg("p") = 2, py::arg("within") = true,
            py::arg("num_threads") = 0,
+           py::arg("schedule") = pyinterp::detail::kStatic,
+           py::arg("chunk_size") = 0,
            R"__doc__(
 Interpolation of the value at the requested position by inverse distance
 weighting method.
@@ -139,6 +158,13 @@ Args:
         computation. If 0 all CPUs are used. If 1 is given, no parallel
         computing code is used at all, which is useful for debugging.
         Defaults to ``0``.
+    schedule (pyinterp.core.Schedule, optional): Distribution of the values
+        between the threads. ``Dynamic`` balances the load between threads
+        when the cost of the calculation varies from one value to another.
+        Defaults to ``Static``.
+    chunk_size (int, optional): Number of values claimed at once by a thread
+        with the ``Dynamic`` schedule. If 0, the size is chosen according to
+        the number of values and threads. Defaults to ``0``.
 Return:
     tuple: The interpolated value and the number of neighbors used in the
     calculation.
@@ -0,0 +1,63 @@
+// Copyright (c) 2019 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "pyinterp/detail/thread.hpp"
+#include <pybind11/pybind11.h>
+
+namespace py = pybind11;
+
+void init_thread(py::module& m) {
+  py::enum_<pyinterp::detail::Schedule>(m, "Schedule", R"__doc__(
+Distribution of the values to be processed between the threads.
+)__doc__")
+      .value("Static", pyinterp::detail::kStatic,
+             "*Each thread processes a slice of the same size*.")
+      .value("Dynamic", pyinterp::detail::kDynamic,
+             "*Each thread claims chunks of values until exhaustion*.");
+
+  m.def("cpu_count", &pyinterp::detail::cpu_count, R"__doc__(
+Gets the number of CPUs usable by the process: the CPUs of its affinity mask,
+limited by the CPU quota of its control group when it runs in a container.
+This is the number of threads used by the parallel calculations when
+``num_threads`` is ``0``.
+
+Returns:
+    int: number of CPUs
+)__doc__")
+      .def("get_max_threads", &pyinterp::detail::max_threads, R"__doc__(
+Gets the maximum number of threads used simultaneously by all the parallel
+calculations in progress in the process.
+
+Returns:
+    int: number of threads
+)__doc__")
+      .def("set_max_threads", &pyinterp::detail::set_max_threads,
+           py::arg("num_threads"), R"__doc__(
+Sets the maximum number of threads used simultaneously by all the parallel
+calculations in progress in the process. Calculations started concurrently,
+for example by several Dask tasks, share this budget: once it is exhausted,
+new calculations are carried out by their calling thread only.
+
+Args:
+    num_threads (int): number of threads. Zero restores the default value:
+        :py:func:`cpu_count`.
+)__doc__")
+      .def("get_grain_size", &pyinterp::detail::grain_size, R"__doc__(
+Gets the minimum number of items processed by each thread during parallel
+calculations.
+
+Returns:
+    int: number of items
+)__doc__")
+      .def("set_grain_size", &pyinterp::detail::set_grain_size,
+           py::arg("size"), R"__doc__(
+Sets the minimum number of items processed by each thread during parallel
+calculations. Calculations on fewer than twice this number of items are
+carried out by the calling thread, which avoids the cost of synchronizing
+threads for small batches.
+
+Args:
+    size (int): number of items. Zero restores the default value.
+)__doc__");
+}
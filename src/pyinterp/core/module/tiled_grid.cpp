@@ -0,0 +1,35 @@
+// Copyright (c) 2019 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "pyinterp/detail/lru_cache.hpp"
+#include "pyinterp/tiled_bivariate.hpp"
+#include "pyinterp/tiled_trivariate.hpp"
+#include <pybind11/pybind11.h>
+
+namespace py = pybind11;
+namespace geometry = pyinterp::detail::geometry;
+
+void init_tiled_grid(py::module& m) {
+  py::class_<pyinterp::detail::CacheStatistics>(m, "CacheStatistics",
+                                                R"__doc__(
+Statistics of the accesses to the cache of the tiles loaded
+)__doc__")
+      .def_readonly("hits", &pyinterp::detail::CacheStatistics::hits,
+                    "Number of tiles found in the cache")
+      .def_readonly("misses", &pyinterp::detail::CacheStatistics::misses,
+                    "Number of tiles loaded because not found in the cache")
+      .def_readonly("evictions",
+                    &pyinterp::detail::CacheStatistics::evictions,
+                    "Number of tiles discarded to respect the cache size");
+
+  pyinterp::implement_tiled_bivariate<geometry::EquatorialPoint2D, double,
+                                      double>(m, "TiledBivariateFloat64");
+  pyinterp::implement_tiled_bivariate<geometry::EquatorialPoint2D, double,
+                                      float>(m, "TiledBivariateFloat32");
+
+  pyinterp::implement_tiled_trivariate<geometry::EquatorialPoint3D, double,
+                                       double>(m, "TiledTrivariateFloat64");
+  pyinterp::implement_tiled_trivariate<geometry::EquatorialPoint3D, double,
+                                       float>(m, "TiledTrivariateFloat32");
+}
@@ -596,3 +596,163 @@ TEST(axis, search_window) {
   indexes = axis.find_indexes(9, 4, detail::Axis::kUndef);
   ASSERT_TRUE(indexes.empty());
 }
+
+TEST(axis, visit) {
+  namespace container = detail::axis::container;
+
+  detail::Axis undefined;
+  EXPECT_EQ(undefined.container_type(), container::kUndefined);
+  EXPECT_TRUE(undefined.visit([](const auto& item) {
+    return std::is_same<std::decay_t<decltype(item)>,
+                        container::Undefined>::value;
+  }));
+
+  detail::Axis regular(-180, 179, 360, 1e-6, true);
+  EXPECT_EQ(regular.container_type(), container::kRegular);
+  EXPECT_TRUE(regular.visit([](const auto& item) {
+    return std::is_same<std::decay_t<decltype(item)>,
+                        container::Regular>::value;
+  }));
+
+  detail::Axis irregular(std::vector<double>{0, 1, 4, 8, 20});
+  EXPECT_EQ(irregular.container_type(), container::kIrregular);
+  EXPECT_TRUE(irregular.visit([](const auto& item) {
+    return std::is_same<std::decay_t<decltype(item)>,
+                        container::Irregular>::value;
+  }));
+
+  // The search specialized for the actual container must give the same
+  // results as the search through the virtual interface.
+  for (auto value : {-180.0, -179.5, 0.0, 0.4, 179.0, 179.6, 200.0, 540.0}) {
+    EXPECT_EQ(regular.find_indexes<container::Regular>(value),
+              regular.find_indexes<container::Abstract>(value));
+    EXPECT_EQ(regular.find_indexes<container::Regular>(value, 3,
+                                                       detail::Axis::kWrap),
+              regular.find_indexes<container::Abstract>(value, 3,
+                                                        detail::Axis::kWrap));
+  }
+  for (auto value : {-1.0, 0.0, 0.5, 3.0, 8.0, 19.0, 20.0, 21.0}) {
+    EXPECT_EQ(irregular.find_indexes<container::Irregular>(value),
+              irregular.find_indexes<container::Abstract>(value));
+    EXPECT_EQ(irregular.find_indexes<container::Irregular>(
+                  value, 2, detail::Axis::kSym),
+              irregular.find_indexes<container::Abstract>(value, 2,
+                                                          detail::Axis::kSym));
+  }
+}
+
+TEST(axis, find_indexes_batch) {
+  auto axes = std::vector<detail::Axis>{
+      detail::Axis(-180, 179, 360, 1e-6, true),
+      detail::Axis(0, 359, 360, 1e-6, true),
+      detail::Axis(359, 0, 360, 1e-6, true),
+      detail::Axis(0, 180, 181, 1e-6, true),
+      detail::Axis(-90, 90, 181),
+      detail::Axis(90, -90, 181),
+      detail::Axis(0, 1, 1),
+      detail::Axis(std::vector<double>{0, 1, 4, 8, 20}),
+      detail::Axis(std::vector<double>{20, 8, 4, 1, 0}),
+      detail::Axis(std::vector<double>{0, 10, 90, 180, 270, 300, 350}, 1e-6,
+                   true)};
+
+  auto coordinates = std::vector<double>();
+  for (auto ix = -400.0; ix <= 400.0; ix += 0.25) {
+    coordinates.push_back(ix);
+  }
+  auto size = coordinates.size();
+  auto i0 = std::vector<int64_t>(size);
+  auto i1 = std::vector<int64_t>(size);
+  auto weight = std::vector<double>(size);
+  auto mask = std::unique_ptr<bool[]>(new bool[size]);
+
+  for (auto&& axis : axes) {
+    axis.find_indexes(coordinates.data(), size, i0.data(), i1.data(),
+                      weight.data(), mask.get());
+    for (size_t ix = 0; ix < size; ++ix) {
+      auto indexes = axis.find_indexes(coordinates[ix]);
+      ASSERT_EQ(indexes.has_value(), !mask[ix]);
+      if (!indexes) {
+        EXPECT_EQ(i0[ix], -1);
+        EXPECT_EQ(i1[ix], -1);
+        EXPECT_TRUE(std::isnan(weight[ix]));
+        continue;
+      }
+      EXPECT_EQ(std::get<0>(*indexes), i0[ix]);
+      EXPECT_EQ(std::get<1>(*indexes), i1[ix]);
+      EXPECT_GE(weight[ix], 0);
+      EXPECT_LE(weight[ix], 1);
+
+      // The weight must locate the coordinate between the two elements.
+      auto x0 = axis(i0[ix]);
+      auto dx = axis(i1[ix]) - x0;
+      auto error = x0 - coordinates[ix];
+      if (axis.is_angle()) {
+        dx = detail::math::normalize_angle(dx, -180.0);
+        error = detail::math::normalize_angle(error + weight[ix] * dx, -180.0);
+      } else {
+        error += weight[ix] * dx;
+      }
+      EXPECT_NEAR(error, 0, 1e-9);
+    }
+  }
+}
+
+TEST(axis, lookup_table) {
+  auto values = std::vector<double>{0, 1, 4, 8, 20};
+  auto a1 = detail::Axis(values);
+  auto a2 = detail::Axis(values, 1e-6, false, false, 0);
+  auto a3 = detail::Axis(-90, 90, 181);
+
+  EXPECT_GT(a1.lookup_table_size(), 0);
+  EXPECT_EQ(a2.lookup_table_size(), 0);
+  EXPECT_EQ(a3.lookup_table_size(), 0);
+  EXPECT_EQ(a1, a2);
+  for (auto ix = -1.0; ix <= 21.0; ix += 0.25) {
+    EXPECT_EQ(a1.find_indexes(ix), a2.find_indexes(ix));
+  }
+}
+
+TEST(axis, cursor) {
+  auto axes = std::vector<detail::Axis>{
+      detail::Axis(-180, 179, 360, 1e-6, true),
+      detail::Axis(90, -90, 181),
+      detail::Axis(std::vector<double>{0, 1, 4, 8, 20}),
+      detail::Axis(std::vector<double>{20, 8, 4, 1, 0}),
+      detail::Axis(std::vector<double>{0, 10, 90, 180, 270, 300, 350}, 1e-6,
+                   true)};
+
+  for (auto& axis : axes) {
+    axis.visit([&](const auto& container) {
+      using Container = std::decay_t<decltype(container)>;
+      auto cursor = detail::axis::Cursor();
+      auto window_cursor = detail::axis::Cursor();
+      auto buffer_cursor = detail::axis::Cursor();
+      auto buffer = std::vector<int64_t>(6);
+
+      // Increasing, then decreasing positions
+      for (auto ix = -400.0; ix <= 400.0; ix += 0.25) {
+        EXPECT_EQ(axis.find_indexes<Container>(ix, cursor),
+                  axis.find_indexes<Container>(ix));
+        EXPECT_EQ(axis.find_indexes<Container>(ix, 2, detail::Axis::kWrap,
+                                               window_cursor),
+                  axis.find_indexes<Container>(ix, 2, detail::Axis::kWrap));
+
+        // Window written into a buffer provided by the caller
+        for (auto boundary : {detail::Axis::kUndef, detail::Axis::kSym}) {
+          auto expected = axis.find_indexes<Container>(ix, 3, boundary);
+          auto found = axis.find_indexes<Container>(ix, 3, boundary,
+                                                    buffer_cursor,
+                                                    buffer.data());
+          EXPECT_EQ(found, !expected.empty());
+          if (found) {
+            EXPECT_EQ(buffer, expected);
+          }
+        }
+      }
+      for (auto ix = 400.0; ix >= -400.0; ix -= 0.25) {
+        EXPECT_EQ(axis.find_indexes<Container>(ix, cursor),
+                  axis.find_indexes<Container>(ix));
+      }
+    });
+  }
+}
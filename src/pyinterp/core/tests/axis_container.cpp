@@ -40,6 +40,86 @@ TEST(axis_container, irregular) {
   EXPECT_FALSE(a1 == container::Undefined());
 }
 
+TEST(axis_container, irregular_lookup_table) {
+  // stretched axis, in ascending and descending order
+  auto values = std::vector<double>();
+  for (auto ix = 0; ix < 100; ++ix) {
+    values.push_back(std::sinh(ix * 0.05) * 10);
+  }
+  auto reversed = std::vector<double>(values.rbegin(), values.rend());
+
+  for (auto& points : {values, reversed}) {
+    auto a1 = container::Irregular(points);
+    auto a2 = container::Irregular(points, 0);
+    auto a3 = container::Irregular(points, 1);
+    EXPECT_GT(a1.bucket_count(), 0);
+    EXPECT_LE(a1.bucket_count(),
+              100 * container::Irregular::kDefaultBucketFactor);
+    EXPECT_GE(a1.lookup_table_size(),
+              (a1.bucket_count() + 1) * sizeof(int64_t));
+    EXPECT_EQ(a2.bucket_count(), 0);
+    EXPECT_EQ(a2.lookup_table_size(), 0);
+    EXPECT_EQ(a3.bucket_count(), 100);
+    EXPECT_EQ(a1, a2);
+
+    auto min = a1.min_value() - 1;
+    auto max = a1.max_value() + 1;
+    for (auto ix = 0; ix <= 10000; ++ix) {
+      auto value = min + (max - min) * ix / 10000.0;
+      EXPECT_EQ(a1.find_index(value, false), a2.find_index(value, false));
+      EXPECT_EQ(a1.find_index(value, true), a2.find_index(value, true));
+      EXPECT_EQ(a3.find_index(value, true), a2.find_index(value, true));
+    }
+    // Values located exactly on the edges or on the points
+    for (auto ix = 0; ix < 100; ++ix) {
+      auto value = points[ix];
+      EXPECT_EQ(a1.find_index(value, false), ix);
+      EXPECT_EQ(a3.find_index(value, false), ix);
+      if (ix != 0) {
+        value = (points[ix - 1] + points[ix]) * 0.5;
+        EXPECT_EQ(a1.find_index(value, false), a2.find_index(value, false));
+      }
+    }
+  }
+}
+
+TEST(axis_container, irregular_cursor) {
+  auto values = std::vector<double>();
+  for (auto ix = 0; ix < 100; ++ix) {
+    values.push_back(std::sinh(ix * 0.05) * 10);
+  }
+  auto reversed = std::vector<double>(values.rbegin(), values.rend());
+
+  for (auto& points : {values, reversed}) {
+    auto a1 = container::Irregular(points);
+    auto cursor = pyinterp::detail::axis::Cursor();
+    EXPECT_EQ(cursor.index(), -1);
+
+    auto min = a1.min_value() - 1;
+    auto max = a1.max_value() + 1;
+    // Sorted track, then random jumps, to test the galloping in both
+    // directions.
+    for (auto ix = 0; ix <= 10000; ++ix) {
+      auto value = min + (max - min) * ix / 10000.0;
+      EXPECT_EQ(a1.find_index(value, false, cursor),
+                a1.find_index(value, false));
+      EXPECT_EQ(a1.find_index(value, true, cursor),
+                a1.find_index(value, true));
+    }
+    for (auto ix = 0; ix <= 10000; ++ix) {
+      auto value = min + (max - min) * ((ix * 7919) % 10001) / 10000.0;
+      EXPECT_EQ(a1.find_index(value, false, cursor),
+                a1.find_index(value, false));
+    }
+    for (auto ix = 0; ix < 100; ++ix) {
+      EXPECT_EQ(a1.find_index(points[99 - ix], false, cursor), 99 - ix);
+      EXPECT_EQ(cursor.index(), 99 - ix);
+    }
+    cursor.reset();
+    EXPECT_EQ(cursor.index(), -1);
+  }
+}
+
 TEST(axis_container, regular) {
   // regular axis
   EXPECT_THROW(container::Regular(0, 359, 0), std::invalid_argument);
@@ -53,6 +133,11 @@ TEST(axis_container, regular) {
   EXPECT_EQ(a1.find_index(360, false), -1);
   EXPECT_EQ(a1.find_index(360, true), 359);
   EXPECT_EQ(a1.size(), 360);
+  auto cursor = pyinterp::detail::axis::Cursor();
+  for (auto ix = -10.0; ix <= 370.0; ix += 0.5) {
+    EXPECT_EQ(a1.find_index(ix, false, cursor), a1.find_index(ix, false));
+    EXPECT_EQ(a1.find_index(ix, true, cursor), a1.find_index(ix, true));
+  }
   EXPECT_EQ(a1, a1);
   auto a2 = container::Regular(-180, 179, 360);
   EXPECT_FALSE(a1 == a2);
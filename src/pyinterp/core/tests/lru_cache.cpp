@@ -0,0 +1,75 @@
+// Copyright (c) 2019 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "pyinterp/detail/lru_cache.hpp"
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace detail = pyinterp::detail;
+
+TEST(lru_cache, get_put) {
+  auto cache = detail::LRUCache<int64_t, double>(2);
+  EXPECT_EQ(cache.capacity(), 2);
+  EXPECT_EQ(cache.get(1), nullptr);
+
+  cache.put(1, std::make_shared<double>(1));
+  cache.put(2, std::make_shared<double>(2));
+  ASSERT_NE(cache.get(1), nullptr);
+  EXPECT_EQ(*cache.get(1), 1);
+
+  // The item 2 is the least recently used one: it is discarded.
+  auto item = cache.get(2);
+  cache.get(1);
+  cache.put(3, std::make_shared<double>(3));
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_EQ(cache.get(2), nullptr);
+  EXPECT_EQ(*cache.get(3), 3);
+  // The items discarded remain valid while they are used.
+  EXPECT_EQ(*item, 2);
+
+  // Replacing an item does not discard the others.
+  cache.put(3, std::make_shared<double>(4));
+  EXPECT_EQ(*cache.get(3), 4);
+  EXPECT_EQ(*cache.get(1), 1);
+
+  auto statistics = cache.statistics();
+  EXPECT_EQ(statistics.hits, 7);
+  EXPECT_EQ(statistics.misses, 2);
+  EXPECT_EQ(statistics.evictions, 1);
+
+  cache.reset_statistics();
+  cache.clear();
+  EXPECT_EQ(cache.size(), 0);
+  EXPECT_EQ(cache.get(1), nullptr);
+  EXPECT_EQ(cache.statistics().misses, 1);
+  EXPECT_EQ(cache.statistics().hits, 0);
+
+  EXPECT_THROW((detail::LRUCache<int64_t, double>(0)), std::invalid_argument);
+}
+
+TEST(lru_cache, threads) {
+  auto cache = detail::LRUCache<int64_t, int64_t>(16);
+  auto threads = std::vector<std::thread>();
+  for (auto ix = 0; ix < 4; ++ix) {
+    threads.emplace_back([&cache]() {
+      for (int64_t jx = 0; jx < 1000; ++jx) {
+        auto key = jx % 32;
+        auto item = cache.get(key);
+        if (item == nullptr) {
+          cache.put(key, std::make_shared<int64_t>(key));
+        } else {
+          EXPECT_EQ(*item, key);
+        }
+      }
+    });
+  }
+  for (auto& item : threads) {
+    item.join();
+  }
+  auto statistics = cache.statistics();
+  EXPECT_EQ(statistics.hits + statistics.misses, 4000);
+  EXPECT_LE(cache.size(), 16);
+}
@@ -0,0 +1,214 @@
+// Copyright (c) 2019 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "pyinterp/detail/math/batch.hpp"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+namespace batch = pyinterp::detail::math::batch;
+
+/// Multilinear function, reproduced exactly by the interpolation.
+static double function(const double x, const double y, const double z = 1) {
+  return (1 + 2 * x) * (3 - y) * (2 + z);
+}
+
+TEST(math_batch, bilinear) {
+  // Grid of 5 x 4 values, X-Axis from -1 to 1, Y-Axis from 4 to -2.
+  auto x_axis = batch::Regular{-1, 0.5, 4};
+  auto y_axis = batch::Regular{4, -2, 3};
+  auto grid = std::vector<double>(20);
+  auto grid32 = std::vector<float>(20);
+  for (auto ix = 0; ix < 5; ++ix) {
+    for (auto jx = 0; jx < 4; ++jx) {
+      grid[ix * 4 + jx] = function(-1 + ix * 0.5, 4 - jx * 2);
+      grid32[ix * 4 + jx] = static_cast<float>(grid[ix * 4 + jx]);
+    }
+  }
+  auto strides = std::array<int64_t, 2>{4 * sizeof(double), sizeof(double)};
+  auto strides32 = std::array<int64_t, 2>{4 * sizeof(float), sizeof(float)};
+
+  auto x = std::vector<double>{-1, -0.3, 0.25, 1, 1, -1.01, 0, 0, NAN};
+  auto y = std::vector<double>{4, 1.5, -2, -2, 0.7, 0, 4.2, -2.5, 0};
+  auto result = std::vector<double>(x.size());
+  batch::bilinear(grid.data(), strides, x_axis, y_axis, x.data(), y.data(),
+                  x.size(), result.data());
+  for (size_t ix = 0; ix < 5; ++ix) {
+    EXPECT_NEAR(result[ix], function(x[ix], y[ix]), 1e-12);
+  }
+  // Positions located outside the grid
+  for (size_t ix = 5; ix < x.size(); ++ix) {
+    EXPECT_TRUE(std::isnan(result[ix]));
+  }
+
+  batch::bilinear(grid32.data(), strides32, x_axis, y_axis, x.data(),
+                  y.data(), x.size(), result.data());
+  for (size_t ix = 0; ix < 5; ++ix) {
+    EXPECT_NEAR(result[ix], function(x[ix], y[ix]), 1e-5);
+  }
+  for (size_t ix = 5; ix < x.size(); ++ix) {
+    EXPECT_TRUE(std::isnan(result[ix]));
+  }
+}
+
+TEST(math_batch, bilinear_gradient) {
+  auto x_axis = batch::Regular{-1, 0.5, 4};
+  auto y_axis = batch::Regular{4, -2, 3};
+  auto grid = std::vector<float>(20);
+  for (auto ix = 0; ix < 5; ++ix) {
+    for (auto jx = 0; jx < 4; ++jx) {
+      grid[ix * 4 + jx] =
+          static_cast<float>(function(-1 + ix * 0.5, 4 - jx * 2));
+    }
+  }
+  auto strides = std::array<int64_t, 2>{4 * sizeof(float), sizeof(float)};
+
+  auto x = std::vector<double>{-1, -0.3, 0.25, 1, 0.6, -1.01, NAN};
+  auto y = std::vector<double>{4, 1.5, -2, -2, 0.7, 0, 0};
+  auto size = x.size();
+  auto result = std::vector<double>(3 * size);
+  batch::bilinear_gradient(grid.data(), strides, x_axis, y_axis, x.data(),
+                           y.data(), size, result.data());
+  for (size_t ix = 0; ix < 5; ++ix) {
+    // The function is bilinear: its derivatives are reproduced exactly.
+    EXPECT_NEAR(result[ix], function(x[ix], y[ix]), 1e-5);
+    EXPECT_NEAR(result[size + ix], 2 * (3 - y[ix]) * 3, 1e-5);
+    EXPECT_NEAR(result[2 * size + ix], -(1 + 2 * x[ix]) * 3, 1e-5);
+  }
+  for (size_t ix = 5; ix < size; ++ix) {
+    EXPECT_TRUE(std::isnan(result[ix]));
+  }
+}
+
+TEST(math_batch, trilinear) {
+  // Grid of 3 x 4 x 2 values stored in Fortran order.
+  auto x_axis = batch::Regular{0, 1, 2};
+  auto y_axis = batch::Regular{-3, 2, 3};
+  auto z_axis = batch::Regular{10, 5, 1};
+  auto grid = std::vector<double>(24);
+  for (auto ix = 0; ix < 3; ++ix) {
+    for (auto jx = 0; jx < 4; ++jx) {
+      for (auto kx = 0; kx < 2; ++kx) {
+        grid[kx * 12 + jx * 3 + ix] = function(ix, -3 + jx * 2, 10 + kx * 5);
+      }
+    }
+  }
+  auto strides = std::array<int64_t, 3>{sizeof(double), 3 * sizeof(double),
+                                        12 * sizeof(double)};
+
+  auto x = std::vector<double>{0, 1.5, 2, 0.2, 2.5, 1, 1};
+  auto y = std::vector<double>{-3, 0.1, 3, -1, 0, -3.1, 0};
+  auto z = std::vector<double>{10, 12.5, 15, 11, 10, 10, 15.5};
+  auto result = std::vector<double>(x.size());
+  batch::trilinear(grid.data(), strides, x_axis, y_axis, z_axis, x.data(),
+                   y.data(), z.data(), x.size(), result.data());
+  for (size_t ix = 0; ix < 4; ++ix) {
+    EXPECT_NEAR(result[ix], function(x[ix], y[ix], z[ix]), 1e-12);
+  }
+  for (size_t ix = 4; ix < x.size(); ++ix) {
+    EXPECT_TRUE(std::isnan(result[ix]));
+  }
+}
+
+TEST(math_batch, fields) {
+  // Two fields of 5 x 4 values, the second one stored in Fortran order.
+  auto x_axis = batch::Regular{-1, 0.5, 4};
+  auto y_axis = batch::Regular{4, -2, 3};
+  auto field0 = std::vector<double>(20);
+  auto field1 = std::vector<double>(20);
+  for (auto ix = 0; ix < 5; ++ix) {
+    for (auto jx = 0; jx < 4; ++jx) {
+      field0[ix * 4 + jx] = function(-1 + ix * 0.5, 4 - jx * 2);
+      field1[jx * 5 + ix] = -field0[ix * 4 + jx];
+    }
+  }
+  const double* grids[] = {field0.data(), field1.data()};
+  std::array<int64_t, 2> strides[] = {{4 * sizeof(double), sizeof(double)},
+                                      {sizeof(double), 5 * sizeof(double)}};
+
+  auto x = std::vector<double>{-1, -0.3, 0.25, 1, 1, -1.01, 0, 0, NAN};
+  auto y = std::vector<double>{4, 1.5, -2, -2, 0.7, 0, 4.2, -2.5, 0};
+  auto size = x.size();
+  auto result = std::vector<double>(2 * size);
+  batch::bilinear(grids, strides, 2, x_axis, y_axis, x.data(), y.data(), size,
+                  result.data());
+  for (size_t ix = 0; ix < 5; ++ix) {
+    EXPECT_NEAR(result[ix], function(x[ix], y[ix]), 1e-12);
+    EXPECT_NEAR(result[size + ix], -function(x[ix], y[ix]), 1e-12);
+  }
+  for (size_t ix = 5; ix < size; ++ix) {
+    EXPECT_TRUE(std::isnan(result[ix]));
+    EXPECT_TRUE(std::isnan(result[size + ix]));
+  }
+
+  // The same fields, constant along a Z-Axis of 2 values.
+  auto z_axis = batch::Regular{0, 1, 1};
+  std::array<int64_t, 3> strides3[] = {
+      {4 * sizeof(double), sizeof(double), 0},
+      {sizeof(double), 5 * sizeof(double), 0}};
+  auto z = std::vector<double>(size, 0.5);
+  batch::trilinear(grids, strides3, 2, x_axis, y_axis, z_axis, x.data(),
+                   y.data(), z.data(), size, result.data());
+  for (size_t ix = 0; ix < 5; ++ix) {
+    EXPECT_NEAR(result[ix], function(x[ix], y[ix]), 1e-12);
+    EXPECT_NEAR(result[size + ix], -function(x[ix], y[ix]), 1e-12);
+  }
+  for (size_t ix = 5; ix < size; ++ix) {
+    EXPECT_TRUE(std::isnan(result[ix]));
+    EXPECT_TRUE(std::isnan(result[size + ix]));
+  }
+}
+
+TEST(math_batch, packed) {
+  // Grid of 5 x 4 packed integers: the value is q * 0.5 + 5.
+  auto x_axis = batch::Regular{-1, 0.5, 4};
+  auto y_axis = batch::Regular{4, -2, 3};
+  auto packing = pyinterp::detail::math::Packing{0.5, 5, -32768};
+  auto grid = std::vector<int16_t>(20);
+  for (auto ix = 0; ix < 5; ++ix) {
+    for (auto jx = 0; jx < 4; ++jx) {
+      grid[ix * 4 + jx] =
+          static_cast<int16_t>(2 * function(-1 + ix * 0.5, 4 - jx * 2) - 10);
+    }
+  }
+  EXPECT_EQ(packing.unpack(grid[7]), function(-0.5, -2));
+  EXPECT_TRUE(std::isnan(packing.unpack(int16_t(-32768))));
+  auto strides = std::array<int64_t, 2>{4 * sizeof(int16_t), sizeof(int16_t)};
+
+  auto x = std::vector<double>{-1, -0.3, 0.25, 1, 1, -1.01, 0, 0, NAN};
+  auto y = std::vector<double>{4, 1.5, -2, -2, 0.7, 0, 4.2, -2.5, 0};
+  auto size = x.size();
+  auto result = std::vector<double>(3 * size);
+  batch::bilinear(grid.data(), strides, packing, x_axis, y_axis, x.data(),
+                  y.data(), size, result.data());
+  for (size_t ix = 0; ix < 5; ++ix) {
+    EXPECT_NEAR(result[ix], function(x[ix], y[ix]), 1e-12);
+  }
+  for (size_t ix = 5; ix < size; ++ix) {
+    EXPECT_TRUE(std::isnan(result[ix]));
+  }
+
+  batch::bilinear_gradient(grid.data(), strides, packing, x_axis, y_axis,
+                           x.data(), y.data(), size, result.data());
+  for (size_t ix = 0; ix < 5; ++ix) {
+    EXPECT_NEAR(result[ix], function(x[ix], y[ix]), 1e-12);
+  }
+
+  // The positions framed by the fill value are undefined.
+  grid[0] = -32768;
+  batch::bilinear(grid.data(), strides, packing, x_axis, y_axis, x.data(),
+                  y.data(), size, result.data());
+  EXPECT_TRUE(std::isnan(result[0]));
+  for (size_t ix = 1; ix < 5; ++ix) {
+    EXPECT_NEAR(result[ix], function(x[ix], y[ix]), 1e-12);
+  }
+
+  const int16_t* grids[] = {grid.data()};
+  batch::bilinear(grids, &strides, 1, packing, x_axis, y_axis, x.data(),
+                  y.data(), size, result.data());
+  EXPECT_TRUE(std::isnan(result[0]));
+  for (size_t ix = 1; ix < 5; ++ix) {
+    EXPECT_NEAR(result[ix], function(x[ix], y[ix]), 1e-12);
+  }
+}
@@ -65,3 +65,27 @@ TEST(math_bicubic, bicubic) {
     }
   }
 }
+
+TEST(math_bicubic, gradient) {
+  auto xr = math::XArray(3, 3);
+
+  // The splines reproduce exactly a linear function.
+  for (auto ix = 0; ix < 6; ++ix) {
+    xr.x(ix) = xr.y(ix) = ix * 0.1;
+    for (auto iy = 0; iy < 6; ++iy) {
+      xr.z(ix, iy) = ix * 0.1 - 2 * iy * 0.1;
+    }
+  }
+
+  auto interpolator = math::Bicubic();
+  auto acc = gsl::Accelerator();
+  double value, dx, dy;
+  for (auto x : {0.05, 0.22, 0.31}) {
+    for (auto y : {0.0, 0.17, 0.43}) {
+      std::tie(value, dx, dy) = interpolator.gradient(x, y, xr, acc);
+      EXPECT_NEAR(value, interpolator.interpolate(x, y, xr, acc), 1e-12);
+      EXPECT_NEAR(dx, 1, 1e-12);
+      EXPECT_NEAR(dy, -2, 1e-12);
+    }
+  }
+}
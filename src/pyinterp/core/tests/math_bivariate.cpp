@@ -92,3 +92,52 @@ TEST(math_bivariate, idw) {
                             geometry::Point2D<double>{1, 1}, 0, 1, 2, 3),
       1.5);
 }
+
+TEST(math_bivariate, bilinear_gradient) {
+  auto interpolator = math::Bilinear<geometry::Point2D, double>();
+  auto p = geometry::Point2D<double>{14.5, 20.2};
+  auto p0 = geometry::Point2D<double>{14.0, 21.0};
+  auto p1 = geometry::Point2D<double>{15.0, 20.0};
+
+  double value, dx, dy;
+  std::tie(value, dx, dy) =
+      interpolator.gradient(p, p0, p1, 162.0, 91.0, 95.0, 210.0);
+  EXPECT_DOUBLE_EQ(value,
+                   interpolator.evaluate(p, p0, p1, 162.0, 91.0, 95.0, 210.0));
+  EXPECT_NEAR(dx, 81.8, 1e-12);
+  EXPECT_NEAR(dy, -22.0, 1e-12);
+}
+
+TEST(math_bivariate, bilinear_masked) {
+  auto p = geometry::Point2D<double>{0.25, 0.5};
+  auto p0 = geometry::Point2D<double>{0, 0};
+  auto p1 = geometry::Point2D<double>{1, 1};
+  auto nan = std::numeric_limits<double>::quiet_NaN();
+
+  // By default, an undefined corner makes the value undefined.
+  auto bilinear = math::Bilinear<geometry::Point2D, double>();
+  EXPECT_FALSE(bilinear.masked());
+  EXPECT_TRUE(std::isnan(bilinear.evaluate(p, p0, p1, 1, 2, 3, nan)));
+
+  // The weights of the corners (x0, y0), (x0, y1) and (x1, y0) are 0.375,
+  // 0.375 and 0.125, renormalized over their sum.
+  bilinear = math::Bilinear<geometry::Point2D, double>(3);
+  EXPECT_TRUE(bilinear.masked());
+  EXPECT_DOUBLE_EQ(bilinear.evaluate(p, p0, p1, 1, 2, 3, nan),
+                   (0.375 * 1 + 0.375 * 2 + 0.125 * 3) / 0.875);
+  auto all = math::Bilinear<geometry::Point2D, double>();
+  EXPECT_DOUBLE_EQ(bilinear.evaluate(p, p0, p1, 1, 2, 3, 4),
+                   all.evaluate(p, p0, p1, 1, 2, 3, 4));
+  EXPECT_TRUE(std::isnan(bilinear.evaluate(p, p0, p1, 1, nan, 3, nan)));
+
+  bilinear = math::Bilinear<geometry::Point2D, double>(1);
+  EXPECT_DOUBLE_EQ(bilinear.evaluate(p, p0, p1, nan, nan, 3, nan), 3);
+  EXPECT_TRUE(std::isnan(bilinear.evaluate(p, p0, p1, nan, nan, nan, nan)));
+  // The position is located on an undefined corner.
+  EXPECT_TRUE(std::isnan(bilinear.evaluate(p0, p0, p1, nan, 2, 3, 4)));
+
+  EXPECT_THROW((math::Bilinear<geometry::Point2D, double>(0)),
+               std::invalid_argument);
+  EXPECT_THROW((math::Bilinear<geometry::Point2D, double>(5)),
+               std::invalid_argument);
+}
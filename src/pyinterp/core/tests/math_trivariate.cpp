@@ -30,3 +30,30 @@ TEST(math_trivariate, trivariate) {
       191.0, 195.0, 310.0, &bilinear);
   EXPECT_DOUBLE_EQ(interpolated, (146.1 + 246.1) * 0.5);
 }
+
+TEST(math_trivariate, trilinear_masked) {
+  auto p = geometry::Point3D<double>{0.5, 0.5, 0.25};
+  auto p0 = geometry::Point3D<double>{0, 0, 0};
+  auto p1 = geometry::Point3D<double>{1, 1, 1};
+  auto nan = std::numeric_limits<double>::quiet_NaN();
+  auto trilinear = [&](const math::Bilinear<geometry::Point3D, double>& self,
+                       const std::array<double, 8>& q) {
+    return math::trivariate<geometry::Point3D, double>(
+        p, p0, p1, q[0], q[1], q[2], q[3], q[4], q[5], q[6], q[7], &self);
+  };
+
+  // The corners undefined are dropped among the 8 corners of the cell: the
+  // weight of a corner of the plane z0 is 0.1875, of the plane z1 0.0625.
+  auto bilinear = math::Bilinear<geometry::Point3D, double>(6);
+  EXPECT_DOUBLE_EQ(trilinear(bilinear, {nan, 1, 1, 1, nan, 2, 2, 2}),
+                   (3 * 0.1875 * 1 + 3 * 0.0625 * 2) / 0.75);
+  EXPECT_TRUE(
+      std::isnan(trilinear(bilinear, {nan, 1, 1, 1, nan, nan, 2, 2})));
+
+  // All the corners defined: the trilinear interpolation
+  auto all = math::Bilinear<geometry::Point3D, double>();
+  EXPECT_DOUBLE_EQ(trilinear(bilinear, {1, 2, 3, 4, 5, 6, 7, 8}),
+                   trilinear(all, {1, 2, 3, 4, 5, 6, 7, 8}));
+  EXPECT_THROW((math::Bilinear<geometry::Point3D, double>(9)),
+               std::invalid_argument);
+}
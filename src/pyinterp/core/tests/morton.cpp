@@ -0,0 +1,113 @@
+// Copyright (c) 2019 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "pyinterp/detail/morton.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <random>
+
+namespace morton = pyinterp::detail::morton;
+
+TEST(morton, encode) {
+  // Bits of x at the even positions, bits of y at the odd positions.
+  EXPECT_EQ(morton::encode<2>({0, 0}), 0);
+  EXPECT_EQ(morton::encode<2>({1, 0}), 1);
+  EXPECT_EQ(morton::encode<2>({0, 1}), 2);
+  EXPECT_EQ(morton::encode<2>({3, 3}), 15);
+  EXPECT_EQ(morton::encode<2>({0xFFFFFFFF, 0}), 0x5555555555555555ULL);
+  EXPECT_EQ(morton::encode<2>({0, 0xFFFFFFFF}), 0xAAAAAAAAAAAAAAAAULL);
+
+  EXPECT_EQ(morton::encode<3>({1, 0, 0}), 1);
+  EXPECT_EQ(morton::encode<3>({0, 1, 0}), 2);
+  EXPECT_EQ(morton::encode<3>({0, 0, 1}), 4);
+  EXPECT_EQ(morton::encode<3>({2, 0, 0}), 8);
+  EXPECT_EQ(morton::encode<3>({0x1FFFFF, 0, 0}), 0x1249249249249249ULL);
+  EXPECT_EQ(morton::encode<3>({0x1FFFFF, 0x1FFFFF, 0x1FFFFF}),
+            0x7FFFFFFFFFFFFFFFULL);
+}
+
+TEST(morton, order) {
+  // Points of a 4x4 grid, in random order
+  auto x = std::vector<double>();
+  auto y = std::vector<double>();
+  for (auto ix = 0; ix < 4; ++ix) {
+    for (auto jx = 0; jx < 4; ++jx) {
+      x.push_back(ix);
+      y.push_back(jx);
+    }
+  }
+  // A point with an undefined coordinate
+  x.push_back(std::numeric_limits<double>::quiet_NaN());
+  y.push_back(0);
+
+  auto permutation = std::vector<size_t>(x.size());
+  std::iota(permutation.begin(), permutation.end(), 0);
+  std::shuffle(permutation.begin(), permutation.end(), std::mt19937(0));
+
+  auto coordinate = [&](size_t ix, size_t dim) {
+    return dim == 0 ? x[permutation[ix]] : y[permutation[ix]];
+  };
+  auto indexes = morton::order<2>(coordinate, x.size(), 1);
+
+  // Each point is processed once
+  auto sorted = indexes;
+  std::sort(sorted.begin(), sorted.end());
+  for (size_t ix = 0; ix < sorted.size(); ++ix) {
+    EXPECT_EQ(sorted[ix], ix);
+  }
+
+  // The points follow the Z-order curve
+  auto expected = std::vector<std::pair<double, double>>{
+      {0, 0}, {1, 0}, {0, 1}, {1, 1}, {2, 0}, {3, 0}, {2, 1}, {3, 1},
+      {0, 2}, {1, 2}, {0, 3}, {1, 3}, {2, 2}, {3, 2}, {2, 3}, {3, 3}};
+  for (size_t ix = 0; ix < expected.size(); ++ix) {
+    EXPECT_EQ(coordinate(indexes[ix], 0), expected[ix].first);
+    EXPECT_EQ(coordinate(indexes[ix], 1), expected[ix].second);
+  }
+  EXPECT_TRUE(std::isnan(coordinate(indexes.back(), 0)));
+
+  // The parallel sort gives the same result
+  pyinterp::detail::set_max_threads(4);
+  pyinterp::detail::set_grain_size(1);
+  EXPECT_EQ(morton::order<2>(coordinate, x.size(), 4), indexes);
+  pyinterp::detail::set_grain_size(0);
+  pyinterp::detail::set_max_threads(0);
+}
+
+TEST(morton, order_3d) {
+  auto generator = std::mt19937(0);
+  auto distribution = std::uniform_real_distribution<double>(-1, 1);
+  auto points = std::vector<std::array<double, 3>>(10000);
+  for (auto&& item : points) {
+    item = {distribution(generator), distribution(generator),
+            distribution(generator)};
+  }
+  auto indexes = morton::order<3>(
+      [&](size_t ix, size_t dim) { return points[ix][dim]; }, points.size(),
+      0);
+
+  auto sorted = indexes;
+  std::sort(sorted.begin(), sorted.end());
+  for (size_t ix = 0; ix < sorted.size(); ++ix) {
+    ASSERT_EQ(sorted[ix], ix);
+  }
+
+  // Consecutive points are much closer than in the original order
+  auto length = [&](const std::vector<size_t>& order) {
+    auto result = 0.0;
+    for (size_t ix = 1; ix < order.size(); ++ix) {
+      auto& p = points[order[ix - 1]];
+      auto& q = points[order[ix]];
+      result += std::sqrt((p[0] - q[0]) * (p[0] - q[0]) +
+                          (p[1] - q[1]) * (p[1] - q[1]) +
+                          (p[2] - q[2]) * (p[2] - q[2]));
+    }
+    return result;
+  };
+  auto identity = std::vector<size_t>(points.size());
+  std::iota(identity.begin(), identity.end(), 0);
+  EXPECT_LT(length(indexes) * 10, length(identity));
+}
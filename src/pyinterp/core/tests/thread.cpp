@@ -4,6 +4,10 @@
 // BSD-style license that can be found in the LICENSE file.
 #include "pyinterp/detail/thread.hpp"
 #include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <set>
+#include <stdexcept>
 
 TEST(thread, dispatch) {
   std::vector<double> src(4096);
@@ -24,3 +28,202 @@ TEST(thread, dispatch) {
     EXPECT_EQ(src[ix], dst[ix]);
   }
 }
+
+TEST(thread, grain_size) {
+  pyinterp::detail::set_max_threads(16);
+  auto default_value = pyinterp::detail::grain_size();
+  EXPECT_GT(default_value, 0);
+
+  // Small vectors are processed by the calling thread
+  auto caller = std::this_thread::get_id();
+  auto threads = std::vector<std::thread::id>();
+  auto mutex = std::mutex();
+  auto foo = [&](size_t /*start*/, size_t /*stop*/) {
+    auto lock = std::unique_lock<std::mutex>(mutex);
+    threads.push_back(std::this_thread::get_id());
+  };
+  pyinterp::detail::set_grain_size(1000);
+  EXPECT_EQ(pyinterp::detail::grain_size(), 1000);
+  pyinterp::detail::dispatch(foo, 1999, 4);
+  ASSERT_EQ(threads.size(), 1);
+  EXPECT_EQ(threads[0], caller);
+
+  // Each thread processes at least "grain_size" items
+  threads.clear();
+  pyinterp::detail::dispatch(foo, 3000, 4);
+  EXPECT_EQ(threads.size(), 3);
+
+  pyinterp::detail::set_grain_size(0);
+  EXPECT_EQ(pyinterp::detail::grain_size(), default_value);
+  pyinterp::detail::set_max_threads(0);
+}
+
+TEST(thread, pool) {
+  pyinterp::detail::set_max_threads(16);
+  auto& pool = pyinterp::detail::ThreadPool::instance();
+  EXPECT_EQ(&pool, &pyinterp::detail::ThreadPool::instance());
+  EXPECT_FALSE(pyinterp::detail::ThreadPool::is_worker());
+
+  // The threads of the pool are reused from one call to the next
+  pyinterp::detail::set_grain_size(1);
+  auto values = std::vector<int>(4, 0);
+  for (auto ix = 0; ix < 3; ++ix) {
+    pyinterp::detail::dispatch(
+        [&](size_t start, size_t stop) {
+          for (auto jx = start; jx < stop; ++jx) {
+            ++values[jx];
+          }
+        },
+        4, 4);
+    EXPECT_EQ(pool.size(), 3);
+  }
+  EXPECT_EQ(values, std::vector<int>(4, 3));
+
+  // Nested calls made by a thread of the pool are processed by this thread
+  auto nested = std::vector<int>(4, 0);
+  pyinterp::detail::dispatch(
+      [&](size_t start, size_t stop) {
+        auto id = std::this_thread::get_id();
+        auto is_worker = pyinterp::detail::ThreadPool::is_worker();
+        for (auto ix = start; ix < stop; ++ix) {
+          pyinterp::detail::dispatch(
+              [&](size_t first, size_t last) {
+                if (is_worker) {
+                  nested[ix] = std::this_thread::get_id() == id &&
+                               first == 0 && last == 16;
+                }
+              },
+              16, 4);
+        }
+      },
+      4, 4);
+  EXPECT_EQ(nested, std::vector<int>({1, 1, 1, 0}));
+
+  // Exceptions are propagated to the calling thread
+  EXPECT_THROW(pyinterp::detail::dispatch(
+                   [](size_t start, size_t /*stop*/) {
+                     if (start == 0) {
+                       throw std::runtime_error("error");
+                     }
+                   },
+                   4, 4),
+               std::runtime_error);
+  pyinterp::detail::set_grain_size(0);
+  pyinterp::detail::set_max_threads(0);
+}
+
+TEST(thread, dynamic) {
+  pyinterp::detail::set_max_threads(16);
+  pyinterp::detail::set_grain_size(1);
+  for (auto chunk_size : {0, 1, 7, 100, 5000}) {
+    auto values = std::vector<int>(4099, 0);
+    auto mutex = std::mutex();
+    auto calls = 0;
+    pyinterp::detail::dispatch(
+        [&](size_t start, size_t stop) {
+          {
+            auto lock = std::unique_lock<std::mutex>(mutex);
+            ++calls;
+          }
+          if (chunk_size != 0) {
+            EXPECT_LE(stop - start, static_cast<size_t>(chunk_size));
+          }
+          for (auto ix = start; ix < stop; ++ix) {
+            ++values[ix];
+          }
+        },
+        values.size(), 4, pyinterp::detail::kDynamic, chunk_size);
+    // Each item is processed exactly once
+    EXPECT_EQ(values, std::vector<int>(4099, 1));
+    if (chunk_size != 0) {
+      EXPECT_EQ(calls, (4099 + chunk_size - 1) / chunk_size);
+    }
+  }
+  pyinterp::detail::set_grain_size(0);
+  pyinterp::detail::set_max_threads(0);
+}
+
+TEST(thread, cancellation) {
+  pyinterp::detail::set_max_threads(16);
+  pyinterp::detail::set_grain_size(1);
+  for (auto schedule :
+       {pyinterp::detail::kStatic, pyinterp::detail::kDynamic}) {
+    auto blocks = std::atomic<size_t>(0);
+    auto failed = std::atomic<bool>(false);
+    try {
+      pyinterp::detail::dispatch(
+          [&](size_t start, size_t /*stop*/) {
+            ++blocks;
+            if (start == 0) {
+              failed = true;
+              throw std::runtime_error("first");
+            }
+            // The other blocks fail after the first one.
+            while (!failed) {
+              std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+            throw std::runtime_error("second");
+          },
+          4096, 4, schedule, 64);
+      FAIL() << "an exception should have been thrown";
+    } catch (std::runtime_error& ex) {
+      EXPECT_STREQ(ex.what(), "first");
+    }
+    // The threads stop processing their blocks after the first failure.
+    EXPECT_LE(blocks.load(), 8);
+  }
+  pyinterp::detail::set_grain_size(0);
+  pyinterp::detail::set_max_threads(0);
+}
+
+TEST(thread, cpu_count) {
+  auto cpus = pyinterp::detail::cpu_count();
+  EXPECT_GE(cpus, 1);
+  auto hardware = std::thread::hardware_concurrency();
+  if (hardware != 0) {
+    EXPECT_LE(cpus, hardware);
+  }
+  EXPECT_EQ(pyinterp::detail::max_threads(), cpus);
+  pyinterp::detail::set_max_threads(3);
+  EXPECT_EQ(pyinterp::detail::max_threads(), 3);
+  pyinterp::detail::set_max_threads(0);
+  EXPECT_EQ(pyinterp::detail::max_threads(), cpus);
+}
+
+TEST(thread, budget) {
+  pyinterp::detail::set_max_threads(6);
+  {
+    auto first = pyinterp::detail::ThreadReservation(4);
+    EXPECT_EQ(first.size(), 4);
+    {
+      // Only the remaining threads are granted
+      auto second = pyinterp::detail::ThreadReservation(4);
+      EXPECT_EQ(second.size(), 2);
+      // The calling thread is granted even if the budget is exhausted
+      auto third = pyinterp::detail::ThreadReservation(4);
+      EXPECT_EQ(third.size(), 1);
+    }
+    auto fourth = pyinterp::detail::ThreadReservation(4);
+    EXPECT_EQ(fourth.size(), 2);
+  }
+
+  // Concurrent calls share the budget
+  pyinterp::detail::set_grain_size(1);
+  auto threads = std::set<std::thread::id>();
+  auto mutex = std::mutex();
+  {
+    auto reservation = pyinterp::detail::ThreadReservation(5);
+    pyinterp::detail::dispatch(
+        [&](size_t start, size_t stop) {
+          auto lock = std::unique_lock<std::mutex>(mutex);
+          for (auto ix = start; ix < stop; ++ix) {
+            threads.insert(std::this_thread::get_id());
+          }
+        },
+        64, 4);
+  }
+  EXPECT_EQ(threads.size(), 1);
+  EXPECT_TRUE(threads.count(std::this_thread::get_id()));
+  pyinterp::detail::set_grain_size(0);
+  pyinterp::detail::set_max_threads(0);
+}
@@ -6,9 +6,11 @@
 Interface with the library core
 ===============================
 """
-from typing import List, Tuple, Optional
+from typing import Any, List, Tuple, Optional
+import pickle
 import numpy as np
 import xarray as xr
+from . import core
 
 
 def _core_suffix(x: np.ndarray):
@@ -32,12 +34,165 @@ def _core_suffix(x: np.ndarray):
         return 'Float32'
     if dtype == np.uint32:
         return 'Float32'
+    # The small integers are interpolated without conversion: they can be
+    # packed values, decoded on the fly.
     if dtype == np.int16:
-        return 'Float32'
+        return 'Int16'
     if dtype == np.uint16:
-        return 'Float32'
+        return 'UInt16'
     if dtype == np.int8:
-        return 'Float32'
+        return 'Int8'
     if dtype == np.uint8:
+        return 'UInt8'
+    raise ValueError("Unhandled dtype: " + str(dtype))
+
+
+def _core_compute_suffix(suffix: str, dtype: Optional[np.dtype]) -> str:
+    """Get the suffix of the class calculating in the requested precision.
+
+    Args:
+        suffix (str): suffix of the class handling the grid values
+        dtype (numpy.dtype, optional): type of the coordinates and of the
+            values interpolated. ``None`` selects ``float64``.
+    Returns:
+        str: the class suffix
+    """
+    if dtype is None or np.dtype(dtype) == np.float64:
+        return ''
+    if np.dtype(dtype) == np.float32:
+        # The values of the grid are read without conversion to a wider type.
+        if suffix != 'Float32':
+            raise ValueError("single precision interpolation requires a "
+                             "grid of type float32")
         return 'Float32'
     raise ValueError("Unhandled dtype: " + str(dtype))
+
+
+def _core_packing(suffix: str, scale_factor: Optional[float],
+                  add_offset: Optional[float],
+                  fill_value: Optional[int]) -> dict:
+    """Get the arguments describing the decoding of packed values.
+
+    Args:
+        suffix (str): suffix of the class handling the grid values
+        scale_factor (float, optional): factor applied to the integers
+        add_offset (float, optional): offset added to the integers
+            multiplied by the scale factor
+        fill_value (int, optional): integer representing the undefined
+            values
+    Returns:
+        dict: the keyword arguments of the constructor of the class
+    """
+    packing = dict((key, value) for key, value in (
+        ("scale_factor", scale_factor), ("add_offset", add_offset),
+        ("fill_value", fill_value)) if value is not None)
+    if packing and suffix not in ['Int8', 'UInt8', 'Int16', 'UInt16']:
+        raise ValueError("packed values require a grid of type int8, uint8, "
+                         "int16 or uint16")
+    return packing
+
+
+def _core_schedule(schedule: str) -> core.Schedule:
+    """Get the policy distributing the values between the threads.
+
+    Args:
+        schedule (str): name of the policy: ``static`` or ``dynamic``
+    Returns:
+        pyinterp.core.Schedule: the policy
+    """
+    if schedule not in ['static', 'dynamic']:
+        raise ValueError(f"schedule {schedule!r} is not defined")
+    return getattr(core.Schedule, schedule.capitalize())
+
+
+#: Buffer transmitted out of band by the pickle protocol 5, or None if the
+#: version of Python does not provide this protocol.
+PickleBuffer = getattr(pickle, "PickleBuffer", None)
+
+
+def _array_from_buffer(buffer: Any, dtype: str, shape: Tuple[int, ...],
+                       axes: Tuple[int, ...]) -> np.ndarray:
+    """Get the array viewing a buffer transmitted by pickle.
+
+    Args:
+        buffer (object): buffer holding the values in C order
+        dtype (str): type of the values
+        shape (tuple): shape of the array stored in the buffer
+        axes (tuple): permutation of the dimensions of the array stored
+            restoring the array transmitted
+    Returns:
+        numpy.ndarray: the array, sharing the memory of the buffer
+    """
+    return np.frombuffer(buffer, dtype=dtype).reshape(shape).transpose(axes)
+
+
+class _OutOfBand:
+    """Array pickled as a buffer transmitted out of band.
+
+    A view whose dimensions are permuted, such as the arrays of the grids
+    read in their native axis order, is transmitted as the contiguous array
+    that it views, then permuted again when unpickled.
+    """
+    __slots__ = ("array", )
+
+    def __init__(self, array: np.ndarray):
+        self.array = array
+
+    def __reduce_ex__(self, protocol: int) -> Tuple:
+        array = self.array
+        order = sorted(range(array.ndim),
+                       key=lambda ix: array.strides[ix],
+                       reverse=True)
+        contiguous = array.transpose(order)
+        if not contiguous.flags.c_contiguous:
+            order = list(range(array.ndim))
+            contiguous = np.ascontiguousarray(array)
+        return (_array_from_buffer,
+                (PickleBuffer(contiguous), contiguous.dtype.str,
+                 contiguous.shape, tuple(np.argsort(order).tolist())))
+
+
+def _out_of_band(state: Any) -> Any:
+    """Mark the arrays of a state to transmit them out of band.
+
+    Args:
+        state (object): state of an instance, as returned by ``__getstate__``
+    Returns:
+        object: the state whose arrays are pickled as out-of-band buffers
+    """
+    if isinstance(state, np.ndarray) and not state.dtype.hasobject:
+        return _OutOfBand(state)
+    if isinstance(state, tuple):
+        return tuple(_out_of_band(item) for item in state)
+    return state
+
+
+def _rebuild(cls: type, state: Any) -> Any:
+    """Create an instance from a state whose arrays were transmitted out of
+    band.
+
+    Args:
+        cls (type): class of the instance
+        state (object): state of the instance
+    Returns:
+        object: the instance
+    """
+    result = cls.__new__(cls)
+    result.__setstate__(state)
+    return result
+
+
+def _reduce_ex(instance: Any, protocol: int) -> Optional[Tuple]:
+    """Reduce an instance for the pickle protocol 5, which transmits the
+    arrays of its state out of band, without copying them.
+
+    Args:
+        instance (object): instance to pickle
+        protocol (int): pickle protocol used
+    Returns:
+        tuple, optional: the reduction of the instance, or None if the
+        protocol does not support out-of-band buffers
+    """
+    if protocol < 5 or PickleBuffer is None:
+        return None
+    return (_rebuild, (type(instance), _out_of_band(instance.__getstate__())))
@@ -10,6 +10,7 @@ from typing import Optional, Tuple
 import sys
 import numpy as np
 from . import core
+from . import interface
 from . import geodetic
 
 
@@ -90,7 +91,11 @@ class RTree:
               coordinates: np.ndarray,
               k: Optional[int] = 4,
               within: Optional[bool] = True,
-              num_threads: Optional[int] = 0) -> Tuple[np.ndarray, np.ndarray]:
+              num_threads: Optional[int] = 0,
+              schedule: Optional[str] = "static",
+              chunk_size: Optional[int] = 0,
+              reorder: Optional[bool] = False
+              ) -> Tuple[np.ndarray, np.ndarray]:
         """Insert new data into the search tree.
 
         Search for the nearest K nearest neighbors of a given point.
@@ -109,13 +114,25 @@ class RTree:
                 computation. If 0 all CPUs are used. If 1 is given, no parallel
                 computing code is used at all, which is useful for debugging.
                 Defaults to ``0``.
+            schedule (str, optional): ``static`` or ``dynamic`` distribution
+                of the values between the threads. Defaults to ``static``.
+            chunk_size (int, optional): Number of values claimed at once by a
+                thread with the ``dynamic`` schedule, 0 for an automatic size.
+                Defaults to ``0``.
+            reorder (bool, optional): If True, the positions are processed in
+                the order of a space-filling curve (Morton order), which
+                improves the cache efficiency for large numbers of randomly
+                scattered positions, at the cost of sorting them. Defaults to
+                ``False``.
         Return:
             tuple: A tuple containing a matrix describing for each provided
             position, the distance, in meters, between the provided position
             and the found neighbors and a matrix containing the value of the
             different neighbors found for all provided positions.
         """
-        return self._instance.query(coordinates, k, within, num_threads)
+        return self._instance.query(coordinates, k, within, num_threads,
+                                    interface._core_schedule(schedule),
+                                    chunk_size, reorder)
 
     def inverse_distance_weighting(
             self,
@@ -124,7 +141,9 @@ class RTree:
             k: Optional[int] = 4,
             p: Optional[int] = 2,
             within: Optional[bool] = True,
-            num_threads: Optional[int] = 0) -> Tuple[np.ndarray, np.ndarray]:
+            num_threads: Optional[int] = 0,
+            schedule: Optional[str] = "static",
+            chunk_size: Optional[int] = 0) -> Tuple[np.ndarray, np.ndarray]:
         """Interpolation of the value at the requested position by inverse
         distance weighting method.
 
@@ -146,12 +165,18 @@ class RTree:
                 computation. If 0 all CPUs are used. If 1 is given, no parallel
                 computing code is used at all, which is useful for debugging.
                 Defaults to ``0``.
+            schedule (str, optional): ``static`` or ``dynamic`` distribution
+                of the values between the threads. Defaults to ``static``.
+            chunk_size (int, optional): Number of values claimed at once by a
+                thread with the ``dynamic`` schedule, 0 for an automatic size.
+                Defaults to ``0``.
         Return:
             tuple: The interpolated value and the number of neighbors used in
             the calculation.
         """
         return self._instance.inverse_distance_weighting(
-            coordinates, radius, k, p, within, num_threads)
+            coordinates, radius, k, p, within, num_threads,
+            interface._core_schedule(schedule), chunk_size)
 
     def __getstate__(self) -> Tuple:
         return (self.dtype, self._instance.__getstate__())
@@ -163,3 +188,9 @@ class RTree:
         self.dtype = _class.dtype
         _class._instance.__setstate__(state[1])
         self._instance = _class._instance
+
+    def __reduce_ex__(self, protocol: int) -> Tuple:
+        # With the protocol 5, the coordinates and the values are transmitted
+        # out of band.
+        return interface._reduce_ex(self, protocol) or super(
+            RTree, self).__reduce_ex__(protocol)
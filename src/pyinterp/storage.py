@@ -0,0 +1,176 @@
+# Copyright (c) 2019 CNES
+#
+# All rights reserved. Use of this source code is governed by a
+# BSD-style license that can be found in the LICENSE file.
+"""
+Memory-mapped grids
+===================
+
+Grid interpolators stored in a binary file that is mapped in memory when
+opened. The grid values are neither read nor copied when the file is opened:
+the pages of the file are loaded on demand and shared by all the processes
+opening the same file.
+
+The file starts with a fixed header:
+
+* the magic string ``PYINTERP`` (8 bytes),
+* the version of the format (unsigned 32-bit integer, little endian),
+* the length of the description (unsigned 32-bit integer, little endian),
+
+followed by the description, a JSON document describing the interpolator
+class, its axes (a regular axis by its bounds and size, an irregular axis by
+the buffer holding its values) and the buffers of the file. The buffers
+follow the description, each starting on a page boundary.
+"""
+from typing import Any, List
+import builtins
+import importlib
+import json
+import mmap
+import struct
+import numpy as np
+from . import GridInterpolator
+
+#: Magic string identifying the files
+MAGIC = b"PYINTERP"
+
+#: Version of the file format
+VERSION = 1
+
+#: Alignment of the buffers stored, in bytes
+ALIGNMENT = 4096
+
+_HEADER = struct.Struct("<8sII")
+
+
+def _encode(item: Any, buffers: List[np.ndarray]) -> Any:
+    """Encode a state of an interpolator, storing aside its arrays"""
+    if isinstance(item, np.ndarray):
+        buffers.append(item)
+        return dict(buffer=len(buffers) - 1)
+    if isinstance(item, (tuple, list)):
+        return [_encode(value, buffers) for value in item]
+    if isinstance(item, (np.integer, np.floating, np.bool_)):
+        return item.item()
+    if item is None or isinstance(item, (bool, int, float, str)):
+        return item
+    raise TypeError(f"cannot store an object of type {type(item).__name__}")
+
+
+def _decode(item: Any, buffers: List[np.ndarray]) -> Any:
+    """Decode a state of an interpolator, restoring its arrays"""
+    if isinstance(item, dict):
+        return buffers[item["buffer"]]
+    if isinstance(item, list):
+        return tuple(_decode(value, buffers) for value in item)
+    return item
+
+
+def _align(offset: int) -> int:
+    """Get the first aligned offset following the given one"""
+    return (offset + ALIGNMENT - 1) // ALIGNMENT * ALIGNMENT
+
+
+def save(interpolator: GridInterpolator, path: str) -> None:
+    """Store an interpolator in a file that can be mapped in memory.
+
+    Args:
+        interpolator (pyinterp.GridInterpolator): Interpolator to store
+        path (str): Path to the file to create
+    """
+    if not isinstance(interpolator, GridInterpolator):
+        raise TypeError("interpolator must be an instance of "
+                        "pyinterp.GridInterpolator")
+    # The state is the one used by pickle, which the subclasses of the
+    # interpolators complete with their own attributes.
+    buffers = []
+    state = _encode(interpolator.__getstate__(), buffers)
+
+    descriptions = []
+    cls = type(interpolator)
+    description = dict(module=cls.__module__,
+                       cls=cls.__qualname__,
+                       state=state,
+                       buffers=descriptions)
+    for item in buffers:
+        descriptions.append(
+            dict(dtype=item.dtype.newbyteorder("<").str,
+                 shape=item.shape,
+                 offset=0))
+
+    # The offsets of the buffers depend on the length of the description
+    # that contains them: they are computed until they no longer change.
+    while True:
+        header = json.dumps(description).encode("utf-8")
+        offset = _align(_HEADER.size + len(header))
+        changed = False
+        for item, array in zip(descriptions, buffers):
+            if item["offset"] != offset:
+                item["offset"] = offset
+                changed = True
+            offset = _align(offset + array.size * array.itemsize)
+        if not changed:
+            break
+
+    with builtins.open(path, "wb") as stream:
+        stream.write(_HEADER.pack(MAGIC, VERSION, len(header)))
+        stream.write(header)
+        for item, array in zip(descriptions, buffers):
+            stream.write(b"\0" * (item["offset"] - stream.tell()))
+            # The arrays are written in C order: an array viewed through its
+            # strides is stored as the interpolator reads it.
+            array.astype(item["dtype"], copy=False).tofile(stream)
+
+
+def open(path: str) -> GridInterpolator:
+    """Open an interpolator stored by :py:func:`save`.
+
+    The file is mapped in memory, read-only: the grid values are loaded on
+    demand, when interpolated, and are shared by the processes opening the
+    same file.
+
+    Args:
+        path (str): Path to the file to open
+    Returns:
+        pyinterp.GridInterpolator: the interpolator stored
+    """
+    with builtins.open(path, "rb") as stream:
+        buffer = mmap.mmap(stream.fileno(), 0, access=mmap.ACCESS_READ)
+    if len(buffer) < _HEADER.size:
+        raise ValueError(f"{path!r} is not an interpolator file")
+    magic, version, size = _HEADER.unpack_from(buffer)
+    if magic != MAGIC:
+        raise ValueError(f"{path!r} is not an interpolator file")
+    if version != VERSION:
+        raise ValueError(f"{path!r}: unhandled version {version}")
+    description = json.loads(
+        bytes(buffer[_HEADER.size:_HEADER.size + size]).decode("utf-8"))
+
+    # The arrays share the memory of the file, which stays mapped as long as
+    # they are used.
+    buffers = []
+    for item in description["buffers"]:
+        dtype = np.dtype(item["dtype"])
+        shape = tuple(item["shape"])
+        count = int(np.prod(shape, dtype=np.int64))
+        if item["offset"] + count * dtype.itemsize > len(buffer):
+            raise ValueError(f"{path!r} is truncated")
+        buffers.append(
+            np.frombuffer(buffer,
+                          dtype=dtype,
+                          count=count,
+                          offset=item["offset"]).reshape(shape))
+
+    # Only the modules of this package are imported: opening a file must not
+    # run the code of an arbitrary module.
+    module = description["module"]
+    if not (module == "pyinterp" or module.startswith("pyinterp.")):
+        raise ValueError(f"{path!r}: module {module!r} is not a module of "
+                         "pyinterp")
+    cls = getattr(importlib.import_module(module), description["cls"], None)
+    if not (isinstance(cls, type) and issubclass(cls, GridInterpolator)):
+        raise ValueError(f"{path!r}: {description['cls']} is not an "
+                         "interpolator")
+    result = cls.__new__(cls)
+    result.__setstate__(_decode(description["state"], buffers))
+    return result
@@ -6,9 +6,10 @@
 Trivariate interpolation
 ========================
 """
-from typing import Optional
+from typing import List, Optional, Tuple, Union
 import numpy as np
 from . import core
+from . import interface
 from . import bivariate
 
 
@@ -20,13 +21,47 @@ class Trivariate(bivariate.Bivariate):
         y (pyinterp.core.Axis): Y-Axis
         z (pyinterp.core.Axis): Z-Axis
         array (numpy.ndarray): Trivariate function
+        dtype (numpy.dtype, optional): Type of the coordinates and of the
+            values interpolated. ``float32`` calculates the interpolation in
+            single precision, which halves the memory used by the results,
+            and requires a grid of type ``float32``. Defaults to
+            ``float64``.
+        scale_factor (float, optional): Factor applied to the values of a
+            grid of packed integers (``int8``, ``uint8``, ``int16`` or
+            ``uint16``), which are decoded on the fly instead of being
+            converted. Defaults to ``1``.
+        add_offset (float, optional): Offset added to the packed integers
+            multiplied by the scale factor. Defaults to ``0``.
+        fill_value (int, optional): Packed integer representing the
+            undefined values. Defaults to ``None``.
+        axes (tuple, optional): Dimension of the array holding each axis of
+            the grid, if the array is not stored in the order of the axes.
+            The array is then interpolated without being copied. Defaults to
+            ``None``.
     """
     _CLASS = "Trivariate"
     _INTEROLATOR = "3D"
 
-    def __init__(self, x: core.Axis, y: core.Axis, z: core.Axis,
-                 values: np.ndarray):
-        bivariate.GridInterpolator.__init__(self, x, y, z, values)
+    def __init__(self,
+                 x: core.Axis,
+                 y: core.Axis,
+                 z: core.Axis,
+                 values: np.ndarray,
+                 dtype: Optional[np.dtype] = None,
+                 scale_factor: Optional[float] = None,
+                 add_offset: Optional[float] = None,
+                 fill_value: Optional[int] = None,
+                 axes: Optional[Tuple[int, ...]] = None):
+        bivariate.GridInterpolator.__init__(self,
+                                            x,
+                                            y,
+                                            z,
+                                            values,
+                                            dtype=dtype,
+                                            scale_factor=scale_factor,
+                                            add_offset=add_offset,
+                                            fill_value=fill_value,
+                                            axes=axes)
 
     @property
     def z(self) -> core.Axis:
@@ -42,12 +77,21 @@ class Trivariate(bivariate.Bivariate):
                  x: np.ndarray,
                  y: np.ndarray,
                  z: np.ndarray,
-                 interpolator: Optional[str] = "bilinear",
+                 interpolator: Optional[Union[
+                     str, core.BivariateInterpolator3D]] = "bilinear",
                  bounds_error: Optional[bool] = False,
                  num_threads: Optional[int] = 0,
+                 schedule: Optional[str] = "static",
+                 chunk_size: Optional[int] = 0,
+                 reorder: Optional[bool] = False,
+                 out: Optional[np.ndarray] = None,
                  **kwargs) -> np.ndarray:
         """Interpolate the values provided on the defined trivariate function.
 
+        The coordinates can be arrays of any shape, broadcast together
+        following the NumPy rules, and are read in place whatever their memory
+        layout.
+
         Args:
             x (numpy.ndarray): X-values
             y (numpy.ndarray): Y-values
@@ -55,6 +99,9 @@ class Trivariate(bivariate.Bivariate):
             interpolator (str, optional): The method of interpolation to
                 perform. Supported are ``bilinear`` and ``nearest``, and
                 ``inverse_distance_weighting``. Default to ``bilinear``.
+                An interpolator written in Python, deriving from
+                :py:class:`pyinterp.core.BivariateInterpolator3D` and
+                defining the method ``evaluate_batch``, can also be given.
             bounds_error (bool, optional): If True, when interpolated values
                 are requested outside of the domain of the input axes (x,y), a
                 :py:class:`ValueError` is raised. If False, then value is set
@@ -63,12 +110,97 @@ class Trivariate(bivariate.Bivariate):
                 computation. If 0 all CPUs are used. If 1 is given, no parallel
                 computing code is used at all, which is useful for debugging.
                 Defaults to ``0``.
+            schedule (str, optional): ``static`` or ``dynamic`` distribution
+                of the values between the threads. Defaults to ``static``.
+            chunk_size (int, optional): Number of values claimed at once by a
+                thread with the ``dynamic`` schedule, 0 for an automatic size.
+                Defaults to ``0``.
+            reorder (bool, optional): If True, the values are processed in
+                the order of a space-filling curve (Morton order), which
+                improves the cache efficiency for large numbers of randomly
+                scattered values, at the cost of sorting them. Defaults to
+                ``False``.
+            out (numpy.ndarray, optional): Array, of the shape of the
+                coordinates broadcast together and of type :py:attr:`dtype`, in
+                which the values interpolated are written. The array may be
+                a non-contiguous view. Defaults to ``None``: a new array is
+                allocated.
             p (int, optional): The power to be used by the interpolator
                 inverse_distance_weighting. Default to ``2``.
+            min_valid (int, optional): The minimum number of defined corners
+                of the cell used by the interpolator bilinear, the undefined
+                corners being dropped and the weights of the others
+                renormalized. Default to ``8``: all the corners must be
+                defined.
         Return:
-            numpy.ndarray: Values interpolated
+            numpy.ndarray: Values interpolated, of the shape of the
+            coordinates broadcast together (``out`` if provided).
         """
         return self._instance.evaluate(
             np.asarray(x), np.asarray(y), np.asarray(z),
             self._n_variate_interpolator(interpolator, **kwargs), bounds_error,
-            num_threads)
+            num_threads, interface._core_schedule(schedule), chunk_size,
+            reorder, out)
+
+    def evaluate_fields(self,
+                        x: np.ndarray,
+                        y: np.ndarray,
+                        z: np.ndarray,
+                        fields: List[np.ndarray],
+                        interpolator: Optional[Union[
+                            str, core.BivariateInterpolator3D]] = "bilinear",
+                        bounds_error: Optional[bool] = False,
+                        num_threads: Optional[int] = 0,
+                        schedule: Optional[str] = "static",
+                        chunk_size: Optional[int] = 0,
+                        reorder: Optional[bool] = False,
+                        **kwargs) -> np.ndarray:
+        """Interpolate the values provided on the defined trivariate function
+        and on other fields defined on the same axes.
+
+        The cells framing the values provided are searched once for all the
+        fields, so interpolating several fields together costs little more
+        than interpolating one of them.
+
+        Args:
+            x (numpy.ndarray): X-values
+            y (numpy.ndarray): Y-values
+            z (numpy.ndarray): Z-values
+            fields (list): Values of the other fields, arrays of the same
+                shape as the trivariate function.
+            interpolator (str, optional): The method of interpolation to
+                perform. See :py:meth:`evaluate`. Default to ``bilinear``.
+            bounds_error (bool, optional): If True, when interpolated values
+                are requested outside of the domain of the input axes (x,y,z),
+                a :py:class:`ValueError` is raised. If False, then value is set
+                to Nan. Default to ``False``
+            num_threads (int, optional): The number of threads to use for the
+                computation. If 0 all CPUs are used. If 1 is given, no parallel
+                computing code is used at all, which is useful for debugging.
+                Defaults to ``0``.
+            schedule (str, optional): ``static`` or ``dynamic`` distribution
+                of the values between the threads. Defaults to ``static``.
+            chunk_size (int, optional): Number of values claimed at once by a
+                thread with the ``dynamic`` schedule, 0 for an automatic size.
+                Defaults to ``0``.
+            reorder (bool, optional): If True, the values are processed in
+                the order of a space-filling curve (Morton order). Defaults to
+                ``False``.
+            p (int, optional): The power to be used by the interpolator
+                inverse_distance_weighting. Default to ``2``.
+            min_valid (int, optional): The minimum number of defined corners
+                of the cell used by the interpolator bilinear, the undefined
+                corners being dropped and the weights of the others
+                renormalized. Default to ``8``: all the corners must be
+                defined.
+        Return:
+            numpy.ndarray: Values interpolated, of shape ``(x.size, 1 +
+            len(fields))``. The first column contains the values of the
+            trivariate function, followed by a column for each field.
+        """
+        return self._instance.evaluate_fields(
+            np.asarray(x), np.asarray(y), np.asarray(z),
+            [np.asarray(item) for item in fields],
+            self._n_variate_interpolator(interpolator, **kwargs), bounds_error,
+            num_threads, interface._core_schedule(schedule), chunk_size,
+            reorder)
@@ -55,6 +55,31 @@ class TextAxis(unittest.TestCase):
         self.assertTrue(np.all(a[:] == np.arange(0, 360)))
         self.assertEqual(len(a), 360)
 
+    def test_find_indexes(self):
+        for axis in [
+                core.Axis(-180, 179, 360, is_circle=True),
+                core.Axis(np.linspace(-90, 90, 181)),
+                core.Axis(MERCATOR_LATITUDES)
+        ]:
+            coordinates = np.linspace(-200, 200, 4001)
+            i0, i1, weight, mask = axis.find_indexes(coordinates)
+            self.assertEqual(mask.dtype, np.bool_)
+            self.assertTrue(np.all(i0[mask] == -1))
+            self.assertTrue(np.all(i1[mask] == -1))
+            self.assertTrue(np.all(np.isnan(weight[mask])))
+            valid = ~mask
+            self.assertTrue(np.all((weight[valid] >= 0)
+                                   & (weight[valid] <= 1)))
+            x0 = axis[:][i0[valid]]
+            x1 = axis[:][i1[valid]]
+            dx = x1 - x0
+            expected = coordinates[valid]
+            if axis.is_circle:
+                dx = (dx + 180) % 360 - 180
+                expected = x0 + (expected - x0) % 360
+            self.assertTrue(
+                np.allclose(x0 + weight[valid] * dx, expected, atol=1e-9))
+
     def test_pickle(self):
         a = core.Axis(0, 359, 360, is_circle=False, is_radian=False)
         b = pickle.loads(pickle.dumps(a))
@@ -64,6 +89,27 @@ class TextAxis(unittest.TestCase):
         b = pickle.loads(pickle.dumps(a))
         self.assertEqual(a, b)
 
+        a = core.Axis(MERCATOR_LATITUDES, bucket_factor=0)
+        b = pickle.loads(pickle.dumps(a))
+        self.assertEqual(a, b)
+        self.assertEqual(b.lookup_table_size, 0)
+
+    def test_lookup_table(self):
+        a = core.Axis(MERCATOR_LATITUDES)
+        b = core.Axis(MERCATOR_LATITUDES, bucket_factor=0)
+        c = core.Axis(MERCATOR_LATITUDES, bucket_factor=16)
+        self.assertGreater(a.lookup_table_size, 0)
+        self.assertEqual(b.lookup_table_size, 0)
+        self.assertGreater(c.lookup_table_size, a.lookup_table_size)
+        self.assertEqual(core.Axis(0, 359, 360).lookup_table_size, 0)
+
+        coordinates = np.linspace(-90, 90, 1000)
+        expected = b.find_index(coordinates, bounded=True)
+        self.assertTrue(
+            np.all(a.find_index(coordinates, bounded=True) == expected))
+        self.assertTrue(
+            np.all(c.find_index(coordinates, bounded=True) == expected))
+
 
 if __name__ == "__main__":
     unittest.main()
\ No newline at end of file
@@ -29,6 +29,28 @@ def plot(x, y, z, filename):
                    pad_inches=0.4)
 
 
+def pack(array, scale_factor, add_offset, dtype=np.int16):
+    """Packs the values of an array into integers, the undefined values
+    being represented by the smallest integer"""
+    fill_value = np.iinfo(dtype).min
+    packed = np.round((array - add_offset) / scale_factor)
+    packed[np.isnan(array)] = fill_value
+    packed = packed.astype(dtype)
+    unpacked = packed * scale_factor + add_offset
+    unpacked[packed == fill_value] = float("nan")
+    return packed, unpacked, int(fill_value)
+
+
+class PythonBilinear2D(core.BivariateInterpolator2D):
+    """Bilinear interpolation written in Python, processing the values by
+    batches"""
+    def evaluate_batch(self, p, p0, p1, q00, q01, q10, q11):
+        t = (p[:, 0] - p0[:, 0]) / (p1[:, 0] - p0[:, 0])
+        u = (p[:, 1] - p0[:, 1]) / (p1[:, 1] - p0[:, 1])
+        return (1 - t) * (1 - u) * q00 + t * (1 - u) * q10 + (
+            1 - t) * u * q01 + t * u * q11
+
+
 class TestCase(unittest.TestCase):
     GRID = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..",
                         "dataset", "mss.nc")
@@ -58,9 +80,24 @@ class TestBivariate(TestCase):
                                 y.flatten(),
                                 interpolator,
                                 num_threads=1)
+        z2 = bivariate.evaluate(x.flatten(),
+                                y.flatten(),
+                                interpolator,
+                                num_threads=0,
+                                schedule=core.Schedule.Dynamic,
+                                chunk_size=1000)
+        z3 = bivariate.evaluate(x.flatten(),
+                                y.flatten(),
+                                interpolator,
+                                num_threads=0,
+                                reorder=True)
         z0 = np.ma.fix_invalid(z0)
         z1 = np.ma.fix_invalid(z1)
+        z2 = np.ma.fix_invalid(z2)
+        z3 = np.ma.fix_invalid(z3)
         self.assertTrue(np.all(z1 == z0))
+        self.assertTrue(np.all(z2 == z0))
+        self.assertTrue(np.all(z3 == z0))
         if HAVE_PLT:
             plot(x, y, z0.reshape((len(lon), len(lat))), filename)
 
@@ -81,6 +118,377 @@ class TestBivariate(TestCase):
         self.assertTrue((a - c).std() != 0)
         self.assertTrue((b - c).std() != 0)
 
+    def test_python_interpolator(self):
+        bivariate = self.load_data()
+        lon = np.arange(-180, 180, 1 / 3.0) + 1 / 3.0
+        lat = np.arange(-90, 90, 1 / 3.0) + 1 / 3.0
+        x, y = np.meshgrid(lon, lat, indexing="ij")
+        z0 = bivariate.evaluate(x.flatten(), y.flatten(), core.Bilinear2D())
+        z1 = bivariate.evaluate(x.flatten(), y.flatten(), PythonBilinear2D())
+        z2 = bivariate.evaluate(x.flatten(),
+                                y.flatten(),
+                                PythonBilinear2D(),
+                                num_threads=1)
+        self.assertTrue(np.allclose(z0, z1, equal_nan=True))
+        self.assertTrue(np.allclose(z0, z2, equal_nan=True))
+
+        with self.assertRaises(ValueError):
+            bivariate.evaluate(x.flatten(),
+                               y.flatten(),
+                               PythonBilinear2D(),
+                               bounds_error=True)
+
+    def test_fields(self):
+        bivariate = self.load_data()
+        lon = np.arange(-180, 180, 1 / 3.0) + 1 / 3.0
+        lat = np.arange(-90, 90, 1 / 3.0) + 1 / 3.0
+        x, y = np.meshgrid(lon, lat, indexing="ij")
+        fields = [bivariate.array * 2, np.asfortranarray(bivariate.array) + 1]
+        for interpolator in [
+                core.Nearest2D(),
+                core.Bilinear2D(),
+                core.InverseDistanceWeighting2D(),
+                PythonBilinear2D()
+        ]:
+            z = bivariate.evaluate_fields(x.flatten(), y.flatten(), fields,
+                                          interpolator)
+            self.assertEqual(z.shape, (x.size, 3))
+            z0 = bivariate.evaluate(x.flatten(), y.flatten(), interpolator)
+            self.assertTrue(np.allclose(z[:, 0], z0, equal_nan=True))
+            self.assertTrue(np.allclose(z[:, 1], z0 * 2, equal_nan=True))
+            self.assertTrue(np.allclose(z[:, 2], z0 + 1, equal_nan=True))
+
+        with self.assertRaises(ValueError):
+            bivariate.evaluate_fields(x.flatten(), y.flatten(),
+                                      [bivariate.array[1:, :]],
+                                      core.Bilinear2D())
+
+        with self.assertRaises(ValueError):
+            bivariate.evaluate_fields(x.flatten(),
+                                      y.flatten(),
+                                      fields,
+                                      core.Bilinear2D(),
+                                      bounds_error=True)
+
+    def test_gradient(self):
+        # The bilinear interpolation reproduces exactly a bilinear function,
+        # and its derivatives.
+        x_axis = core.Axis(np.array([0, 0.5, 2, 3, 4.5]))
+        y_axis = core.Axis(np.arange(-5, 5, 0.5))
+        for x_axis in [x_axis, core.Axis(np.arange(0, 5, 0.25))]:
+            mx, my = np.meshgrid(x_axis[:], y_axis[:], indexing="ij")
+            bivariate = core.BivariateFloat64(x_axis, y_axis,
+                                              2 * mx - my + mx * my)
+            x = np.random.uniform(0, 4.5, 1000)
+            y = np.random.uniform(-5, 4.5, 1000)
+            z = bivariate.evaluate_gradient(x, y)
+            self.assertEqual(z.shape, (1000, 3))
+            self.assertTrue(np.allclose(z[:, 0], 2 * x - y + x * y))
+            self.assertTrue(np.allclose(z[:, 1], 2 + y))
+            self.assertTrue(np.allclose(z[:, 2], x - 1))
+            self.assertTrue(
+                np.allclose(z[:, 0],
+                            bivariate.evaluate(x, y, core.Bilinear2D())))
+
+        z = bivariate.evaluate_gradient(np.array([10.0]), np.array([0.0]))
+        self.assertTrue(np.all(np.isnan(z)))
+        with self.assertRaises(ValueError):
+            bivariate.evaluate_gradient(np.array([10.0]),
+                                        np.array([0.0]),
+                                        bounds_error=True)
+
+    def test_plan(self):
+        bivariate = self.load_data()
+        lon = np.arange(-180, 180, 1 / 3.0) + 1 / 3.0
+        lat = np.arange(-90, 90, 1 / 3.0) + 1 / 3.0
+        x, y = np.meshgrid(lon, lat, indexing="ij")
+        for interpolator in [
+                core.Nearest2D(),
+                core.Bilinear2D(),
+                core.InverseDistanceWeighting2D()
+        ]:
+            plan = bivariate.plan(x.flatten(), y.flatten(), interpolator)
+            self.assertEqual(len(plan), x.size)
+            self.assertEqual(plan.grid_shape, bivariate.array.shape)
+            z0 = bivariate.evaluate(x.flatten(), y.flatten(), interpolator)
+            z1 = plan.apply(bivariate.array)
+            defined = ~np.isnan(z0)
+            self.assertTrue(np.allclose(z0[defined], z1[defined]))
+
+            # Stack of arrays, whatever the memory layout
+            stack = np.stack([bivariate.array, bivariate.array * 2])
+            z2 = plan.apply(stack.transpose(1, 2, 0), num_threads=1)
+            self.assertEqual(z2.shape, (x.size, 2))
+            self.assertTrue(np.allclose(z2[:, 0], z1, equal_nan=True))
+            self.assertTrue(np.allclose(z2[:, 1], z1 * 2, equal_nan=True))
+
+            other = pickle.loads(pickle.dumps(plan))
+            self.assertTrue(np.all(other.indptr == plan.indptr))
+            self.assertTrue(np.all(other.indices == plan.indices))
+            self.assertTrue(np.all(other.weights == plan.weights))
+            self.assertTrue(
+                np.allclose(other.apply(bivariate.array), z1, equal_nan=True))
+
+        with self.assertRaises(ValueError):
+            plan.apply(bivariate.array[1:, :])
+
+        with self.assertRaises(ValueError):
+            bivariate.plan(x.flatten(), y.flatten(), PythonBilinear2D())
+
+        with self.assertRaises(ValueError):
+            bivariate.plan(x.flatten(),
+                           y.flatten(),
+                           core.Bilinear2D(),
+                           bounds_error=True)
+
+    def test_regrid(self):
+        bivariate = self.load_data()
+        lon = np.arange(-180, 180, 1 / 3.0) + 1 / 3.0
+        lat = np.arange(-90, 90, 1 / 3.0) + 1 / 3.0
+        x, y = np.meshgrid(lon, lat, indexing="ij")
+        for interpolator in [
+                core.Nearest2D(),
+                core.Bilinear2D(),
+                core.InverseDistanceWeighting2D(),
+                PythonBilinear2D()
+        ]:
+            z0 = bivariate.evaluate(x.flatten(), y.flatten(), interpolator)
+            z1 = bivariate.regrid(core.Axis(lon), core.Axis(lat),
+                                  interpolator)
+            self.assertEqual(z1.shape, (len(lon), len(lat)))
+            self.assertTrue(np.allclose(z0, z1.flatten(), equal_nan=True))
+            z2 = bivariate.regrid(core.Axis(lon),
+                                  core.Axis(lat),
+                                  interpolator,
+                                  num_threads=1)
+            self.assertTrue(np.allclose(z1, z2, equal_nan=True))
+
+        with self.assertRaises(ValueError):
+            bivariate.regrid(core.Axis(lon),
+                             core.Axis(lat),
+                             core.Bilinear2D(),
+                             bounds_error=True)
+
+    def test_ndarray(self):
+        bivariate = self.load_data()
+        lon = np.arange(-180, 180, 1 / 3.0) + 1 / 3.0
+        lat = np.arange(-90, 90, 1 / 3.0) + 1 / 3.0
+        x, y = np.meshgrid(lon, lat, indexing="ij")
+        for interpolator in [
+                core.Nearest2D(),
+                core.Bilinear2D(),
+                PythonBilinear2D()
+        ]:
+            z0 = bivariate.evaluate(x.flatten(), y.flatten(), interpolator)
+            z0 = z0.reshape(x.shape)
+            # Coordinates broadcast together
+            z1 = bivariate.evaluate(lon[:, np.newaxis], lat, interpolator)
+            self.assertEqual(z1.shape, x.shape)
+            self.assertTrue(np.allclose(z0, z1, equal_nan=True))
+            # Coordinates stored in Fortran order, or strided
+            z1 = bivariate.evaluate(np.asfortranarray(x),
+                                    np.asfortranarray(y),
+                                    interpolator,
+                                    reorder=True)
+            self.assertTrue(np.allclose(z0, z1, equal_nan=True))
+            z1 = bivariate.evaluate(x[::2, ::3], y[::2, ::3], interpolator)
+            self.assertTrue(np.allclose(z0[::2, ::3], z1, equal_nan=True))
+            # Values written in a non-contiguous view
+            buffer = np.zeros((len(lon), 2 * len(lat)))
+            out = buffer[:, ::2]
+            z1 = bivariate.evaluate(x, y, interpolator, out=out)
+            self.assertTrue(np.shares_memory(z1, buffer))
+            self.assertTrue(np.allclose(z0, buffer[:, ::2], equal_nan=True))
+            self.assertTrue(np.all(buffer[:, 1::2] == 0))
+
+        self.assertEqual(
+            bivariate.evaluate(np.array(0.5), np.array(0.5),
+                               core.Bilinear2D()).shape, ())
+        with self.assertRaises(ValueError):
+            bivariate.evaluate(x, y[:, :-1], core.Bilinear2D())
+        with self.assertRaises(ValueError):
+            bivariate.evaluate(x,
+                               y,
+                               core.Bilinear2D(),
+                               out=np.empty(x.size))
+        with self.assertRaises(TypeError):
+            bivariate.evaluate(x,
+                               y,
+                               core.Bilinear2D(),
+                               out=np.empty(x.shape, dtype=np.float32))
+
+    def test_masked(self):
+        bivariate = self.load_data()
+        lon = np.arange(-180, 180, 1 / 3.0) + 1 / 3.0
+        lat = np.arange(-90, 90, 1 / 3.0) + 1 / 3.0
+        x, y = np.meshgrid(lon, lat, indexing="ij")
+        z0 = bivariate.evaluate(x, y, core.Bilinear2D())
+        z1 = bivariate.evaluate(x, y, core.Bilinear2D(min_valid=4))
+        self.assertTrue(np.all(np.isnan(z0) == np.isnan(z1)))
+        # The values interpolated from the four corners are unchanged, the
+        # others are interpolated from the corners defined.
+        z1 = bivariate.evaluate(x, y, core.Bilinear2D(min_valid=1))
+        defined = ~np.isnan(z0)
+        self.assertTrue(np.allclose(z0[defined], z1[defined]))
+        self.assertLess(np.isnan(z1).sum(), np.isnan(z0).sum())
+        z2 = bivariate.evaluate(x, y, core.Bilinear2D(min_valid=3))
+        self.assertLessEqual(np.isnan(z1).sum(), np.isnan(z2).sum())
+        self.assertLessEqual(np.isnan(z2).sum(), np.isnan(z0).sum())
+        # The interpolation of the fields, and the regridding, drop the same
+        # corners.
+        z2 = bivariate.evaluate_fields(x.flatten(), y.flatten(),
+                                       [bivariate.array * 2],
+                                       core.Bilinear2D(min_valid=1))
+        self.assertTrue(np.allclose(z2[:, 0], z1.flatten(), equal_nan=True))
+        self.assertTrue(
+            np.allclose(z2[:, 1], z1.flatten() * 2, equal_nan=True))
+        z2 = bivariate.regrid(core.Axis(lon, is_circle=True), core.Axis(lat),
+                              core.Bilinear2D(min_valid=1))
+        self.assertTrue(np.allclose(z2, z1, equal_nan=True))
+        with self.assertRaises(ValueError):
+            core.Bilinear2D(min_valid=5)
+        interpolator = pickle.loads(pickle.dumps(core.Bilinear2D(3)))
+        self.assertEqual(interpolator.min_valid, 3)
+
+    def test_single_precision(self):
+        lon = np.arange(-180, 180, 1 / 3.0) + 1 / 3.0
+        lat = np.arange(-90, 90, 1 / 3.0) + 1 / 3.0
+        x, y = np.meshgrid(lon, lat, indexing="ij")
+        bivariate = self.load_data('BivariateFloat32')
+        single = self.load_data('BivariateFloat32Float32')
+        self.assertEqual(bivariate.dtype, np.float64)
+        self.assertEqual(single.dtype, np.float32)
+        for interpolator, other in [
+            (core.Bilinear2D(), core.Bilinear2DFloat32()),
+            (core.Nearest2D(), core.Nearest2DFloat32()),
+        ]:
+            z0 = bivariate.evaluate(x, y, interpolator)
+            z1 = single.evaluate(x.astype(np.float32), y.astype(np.float32),
+                                 other)
+            self.assertEqual(z1.dtype, np.float32)
+            # Rounding the coordinates to single precision may select
+            # another grid element for the positions close to a cell edge.
+            mismatch = ~np.isclose(z0, z1, atol=1e-3, equal_nan=True)
+            self.assertLess(np.count_nonzero(mismatch), z0.size // 1000)
+        out = np.empty(x.shape, dtype=np.float32)
+        z1 = single.evaluate(x.astype(np.float32),
+                             y.astype(np.float32),
+                             core.Bilinear2DFloat32(),
+                             out=out)
+        self.assertTrue(np.shares_memory(z1, out))
+        with self.assertRaises(TypeError):
+            single.evaluate(x, y, core.Bilinear2D())
+
+    def test_packed(self):
+        bivariate = self.load_data()
+        packed, unpacked, fill_value = pack(bivariate.array, 0.01, 5)
+        other = core.BivariateInt16(bivariate.x,
+                                    bivariate.y,
+                                    packed,
+                                    scale_factor=0.01,
+                                    add_offset=5,
+                                    fill_value=fill_value)
+        self.assertEqual(other.scale_factor, 0.01)
+        self.assertEqual(other.add_offset, 5)
+        self.assertEqual(other.fill_value, fill_value)
+        # The values are decoded on the fly, as if the grid had been unpacked.
+        bivariate = core.BivariateFloat64(bivariate.x, bivariate.y, unpacked)
+        lon = np.arange(-180, 180, 1 / 3.0) + 1 / 3.0
+        lat = np.arange(-90, 90, 1 / 3.0) + 1 / 3.0
+        x, y = np.meshgrid(lon, lat, indexing="ij")
+        for interpolator in [
+                core.Bilinear2D(),
+                core.Bilinear2D(min_valid=1),
+                core.Nearest2D(),
+                core.InverseDistanceWeighting2D()
+        ]:
+            z0 = bivariate.evaluate(x, y, interpolator)
+            z1 = other.evaluate(x, y, interpolator)
+            self.assertTrue(np.allclose(z0, z1, equal_nan=True))
+        z0 = bivariate.evaluate_gradient(x.flatten(), y.flatten())
+        z1 = other.evaluate_gradient(x.flatten(), y.flatten())
+        self.assertTrue(np.allclose(z0, z1, equal_nan=True))
+        z0 = bivariate.evaluate_fields(x.flatten(), y.flatten(), [unpacked],
+                                       core.Bilinear2D())
+        z1 = other.evaluate_fields(x.flatten(), y.flatten(), [packed],
+                                   core.Bilinear2D())
+        self.assertTrue(np.allclose(z0, z1, equal_nan=True))
+        # Without fill value, all the integers represent a value.
+        z1 = core.BivariateInt16(other.x, other.y, packed).evaluate(
+            x, y, core.Nearest2D())
+        self.assertFalse(np.isnan(z1).any())
+        other = pickle.loads(pickle.dumps(other))
+        self.assertEqual(other.fill_value, fill_value)
+        self.assertTrue(
+            np.allclose(bivariate.evaluate(x, y, core.Bilinear2D()),
+                        other.evaluate(x, y, core.Bilinear2D()),
+                        equal_nan=True))
+
+    def test_axes(self):
+        bivariate = self.load_data()
+        # Array stored as (lat, lon), as in the NetCDF file.
+        array = np.ascontiguousarray(bivariate.array.T)
+        other = core.BivariateFloat64(bivariate.x,
+                                      bivariate.y,
+                                      array,
+                                      axes=(1, 0))
+        # The grid is a view of the array: it is not copied.
+        self.assertTrue(np.shares_memory(other.array, array))
+        self.assertEqual(other.array.shape, bivariate.array.shape)
+        lon = np.arange(-180, 180, 1 / 3.0) + 1 / 3.0
+        lat = np.arange(-90, 90, 1 / 3.0) + 1 / 3.0
+        x, y = np.meshgrid(lon, lat, indexing="ij")
+        for interpolator in [core.Bilinear2D(), core.Nearest2D()]:
+            z0 = bivariate.evaluate(x, y, interpolator)
+            z1 = other.evaluate(x, y, interpolator)
+            self.assertTrue(np.allclose(z0, z1, equal_nan=True))
+        other = pickle.loads(pickle.dumps(other))
+        self.assertTrue(
+            np.allclose(bivariate.evaluate(x, y, core.Bilinear2D()),
+                        other.evaluate(x, y, core.Bilinear2D()),
+                        equal_nan=True))
+
+        for axes in [(0, 0), (0, 1, 2), (1, 2)]:
+            with self.assertRaises(ValueError):
+                core.BivariateFloat64(bivariate.x,
+                                      bivariate.y,
+                                      array,
+                                      axes=axes)
+        with self.assertRaises(ValueError):
+            core.BivariateFloat64(bivariate.x, bivariate.y, array)
+
+    def test_axes_fields(self):
+        # On a square grid, a field read in the wrong order has the right
+        # shape: only its values reveal the error.
+        x = core.Axis(np.arange(0, 20, 1.0))
+        y = core.Axis(np.arange(0, 20, 1.0))
+        array = np.random.random((len(y), len(x)))
+        field = np.random.random((len(y), len(x)))
+        bivariate = core.BivariateFloat64(x, y, array, axes=(1, 0))
+        expected = core.BivariateFloat64(x, y, field.T.copy())
+
+        mx, my = np.meshgrid(np.arange(0, 19, 0.3),
+                             np.arange(0, 19, 0.7),
+                             indexing="ij")
+        mx, my = mx.flatten(), my.flatten()
+        z = expected.evaluate(mx, my, core.Bilinear2D())
+
+        for item in [bivariate, pickle.loads(pickle.dumps(bivariate))]:
+            values = item.evaluate_fields(mx, my, [field], core.Bilinear2D())
+            self.assertTrue(
+                np.allclose(values[:, 0],
+                            item.evaluate(mx, my, core.Bilinear2D())))
+            self.assertTrue(np.allclose(values[:, 1], z))
+
+            plan = item.plan(mx, my, core.Bilinear2D())
+            self.assertTrue(plan.transposed)
+            self.assertTrue(np.allclose(plan.apply(field), z))
+            self.assertTrue(
+                np.allclose(
+                    plan.apply(np.stack([field, array], axis=-1))[:, 0], z))
+            plan = pickle.loads(pickle.dumps(plan))
+            self.assertTrue(np.allclose(plan.apply(field), z))
+
     def test_pickle(self):
         interpolator = self.load_data()
         other = pickle.loads(pickle.dumps(interpolator))
@@ -125,6 +533,91 @@ class TestBicubic(TestCase):
                                   bounds_error=True,
                                   num_threads=0)
 
+    def test_regrid(self):
+        interpolator = self.load_data('BicubicFloat64')
+        lon = np.arange(-180, 180, 1 / 3.0) + 1 / 3.0
+        lat = np.arange(-90, 90, 1 / 3.0) + 1 / 3.0
+        x, y = np.meshgrid(lon, lat, indexing="ij")
+        for boundary in [core.Axis.Boundary.Undef, core.Axis.Boundary.Sym]:
+            z0 = interpolator.evaluate(x.flatten(),
+                                       y.flatten(),
+                                       fitting_model=core.FittingModel.Akima,
+                                       boundary=boundary)
+            z1 = interpolator.regrid(core.Axis(lon),
+                                     core.Axis(lat),
+                                     fitting_model=core.FittingModel.Akima,
+                                     boundary=boundary)
+            self.assertEqual(z1.shape, (len(lon), len(lat)))
+            self.assertTrue(np.allclose(z0, z1.flatten(), equal_nan=True))
+
+        with self.assertRaises(ValueError):
+            interpolator.regrid(core.Axis(lon),
+                                core.Axis(lat),
+                                bounds_error=True)
+
+    def test_gradient(self):
+        # The splines reproduce exactly a linear function, and its
+        # derivatives.
+        x_axis = core.Axis(np.arange(0, 10, 0.5))
+        y_axis = core.Axis(np.arange(-5, 5, 0.25))
+        mx, my = np.meshgrid(x_axis[:], y_axis[:], indexing="ij")
+        bicubic = core.BicubicFloat64(x_axis, y_axis, 2 * mx - 3 * my)
+        x = np.random.uniform(2, 7, 1000)
+        y = np.random.uniform(-3, 3, 1000)
+        z = bicubic.evaluate_gradient(x, y)
+        self.assertEqual(z.shape, (1000, 3))
+        self.assertTrue(np.allclose(z[:, 0], bicubic.evaluate(x, y)))
+        self.assertTrue(np.allclose(z[:, 0], 2 * x - 3 * y))
+        self.assertTrue(np.allclose(z[:, 1], 2))
+        self.assertTrue(np.allclose(z[:, 2], -3))
+
+    def test_ndarray(self):
+        interpolator = self.load_data('BicubicFloat64')
+        lon = np.arange(-180, 180, 1) + 1 / 3.0
+        lat = np.arange(-80, 80, 1) + 1 / 3.0
+        x, y = np.meshgrid(lon, lat, indexing="ij")
+        z0 = interpolator.evaluate(x.flatten(), y.flatten())
+        z1 = interpolator.evaluate(lon[:, np.newaxis], lat)
+        self.assertEqual(z1.shape, x.shape)
+        self.assertTrue(np.allclose(z0.reshape(x.shape), z1, equal_nan=True))
+        out = np.empty(x.shape, order="F")
+        z1 = interpolator.evaluate(x, y, out=out)
+        self.assertTrue(z1 is out or np.shares_memory(z1, out))
+        self.assertTrue(np.allclose(z0.reshape(x.shape), out, equal_nan=True))
+        with self.assertRaises(ValueError):
+            interpolator.evaluate(x, y, out=np.empty(y.T.shape))
+
+    def test_single_precision(self):
+        lon = np.arange(-180, 180, 1) + 1 / 3.0
+        lat = np.arange(-80, 80, 1) + 1 / 3.0
+        x, y = np.meshgrid(lon, lat, indexing="ij")
+        z0 = self.load_data('BicubicFloat32').evaluate(x, y)
+        interpolator = self.load_data('BicubicFloat32Float32')
+        self.assertEqual(interpolator.dtype, np.float32)
+        z1 = interpolator.evaluate(x.astype(np.float32),
+                                   y.astype(np.float32))
+        self.assertEqual(z1.dtype, np.float32)
+        self.assertTrue(np.allclose(z0, z1, atol=1e-3, equal_nan=True))
+
+    def test_packed(self):
+        interpolator = self.load_data('BicubicFloat64')
+        packed, unpacked, fill_value = pack(interpolator.array, 0.01, 5)
+        other = core.BicubicInt16(interpolator.x,
+                                  interpolator.y,
+                                  packed,
+                                  scale_factor=0.01,
+                                  add_offset=5,
+                                  fill_value=fill_value)
+        interpolator = core.BicubicFloat64(interpolator.x, interpolator.y,
+                                           unpacked)
+        lon = np.arange(-180, 180, 1) + 1 / 3.0
+        lat = np.arange(-80, 80, 1) + 1 / 3.0
+        x, y = np.meshgrid(lon, lat, indexing="ij")
+        self.assertTrue(
+            np.allclose(interpolator.evaluate(x, y),
+                        other.evaluate(x, y),
+                        equal_nan=True))
+
     def test_pickle(self):
         interpolator = self.load_data('BicubicFloat64')
         other = pickle.loads(pickle.dumps(interpolator))
@@ -0,0 +1,29 @@
+# Copyright (c) 2019 CNES
+#
+# All rights reserved. Use of this source code is governed by a
+# BSD-style license that can be found in the LICENSE file.
+import unittest
+import pyinterp.core as core
+
+
+class TestThread(unittest.TestCase):
+    def test_grain_size(self):
+        default = core.get_grain_size()
+        self.assertGreater(default, 0)
+        core.set_grain_size(16)
+        self.assertEqual(core.get_grain_size(), 16)
+        core.set_grain_size(0)
+        self.assertEqual(core.get_grain_size(), default)
+
+    def test_max_threads(self):
+        cpus = core.cpu_count()
+        self.assertGreater(cpus, 0)
+        self.assertEqual(core.get_max_threads(), cpus)
+        core.set_max_threads(2)
+        self.assertEqual(core.get_max_threads(), 2)
+        core.set_max_threads(0)
+        self.assertEqual(core.get_max_threads(), cpus)
+
+
+if __name__ == "__main__":
+    unittest.main()
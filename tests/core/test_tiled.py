@@ -0,0 +1,113 @@
+# Copyright (c) 2019 CNES
+#
+# All rights reserved. Use of this source code is governed by a
+# BSD-style license that can be found in the LICENSE file.
+import os
+import unittest
+import netCDF4
+import numpy as np
+import pyinterp.core as core
+
+
+class TestTiledBivariate(unittest.TestCase):
+    GRID = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..",
+                        "dataset", "mss.nc")
+
+    def setUp(self):
+        with netCDF4.Dataset(self.GRID) as ds:
+            z = ds.variables['mss'][:].T
+            z[z.mask] = float("nan")
+            self.x = core.Axis(ds.variables['lon'][:], is_circle=True)
+            self.y = core.Axis(ds.variables['lat'][:])
+            self.z = z.data
+        self.loaded = []
+
+    def provider(self, index):
+        self.loaded.append(index)
+        return self.z[index]
+
+    def test_evaluate(self):
+        bivariate = core.BivariateFloat64(self.x, self.y, self.z)
+        tiled = core.TiledBivariateFloat64(self.x,
+                                           self.y,
+                                           self.provider,
+                                           tile_shape=(64, 64))
+        self.assertEqual(tuple(tiled.tile_shape), (64, 64))
+        self.assertEqual(tiled.cache_size, 256)
+
+        lon = np.arange(-180, 180, 1 / 3.0) + 1 / 3.0
+        lat = np.arange(-80, 80, 1 / 3.0) + 1 / 3.0
+        x, y = np.meshgrid(lon, lat, indexing="ij")
+        for interpolator in [
+                core.Bilinear2D(),
+                core.Nearest2D(),
+                core.InverseDistanceWeighting2D()
+        ]:
+            z0 = bivariate.evaluate(x, y, interpolator)
+            z1 = tiled.evaluate(x,
+                                y,
+                                interpolator,
+                                num_threads=1,
+                                reorder=True)
+            self.assertTrue(np.allclose(z0, z1, equal_nan=True))
+
+        # Each tile is loaded once, the following accesses use the cache.
+        statistics = tiled.cache_statistics()
+        self.assertEqual(statistics.misses, len(self.loaded))
+        self.assertEqual(len(set(str(item) for item in self.loaded)),
+                         len(self.loaded))
+        self.assertGreater(statistics.hits, 0)
+        self.assertEqual(statistics.evictions, 0)
+
+        tiled.clear_cache()
+        statistics = tiled.cache_statistics()
+        self.assertEqual(statistics.hits, 0)
+        self.assertEqual(statistics.misses, 0)
+
+    def test_eviction(self):
+        tiled = core.TiledBivariateFloat64(self.x,
+                                           self.y,
+                                           self.provider,
+                                           tile_shape=(32, 32),
+                                           cache_size=1)
+        lon = np.arange(-180, 180, 1.0)
+        z = tiled.evaluate(lon, np.full(lon.shape, 45.0), core.Nearest2D())
+        self.assertEqual(z.shape, lon.shape)
+        self.assertGreater(tiled.cache_statistics().evictions, 0)
+
+        with self.assertRaises(ValueError):
+            tiled.evaluate(np.array([0.0]),
+                           np.array([100.0]),
+                           core.Bilinear2D(),
+                           bounds_error=True)
+
+    def test_provider_error(self):
+        tiled = core.TiledBivariateFloat64(self.x, self.y,
+                                           lambda index: np.zeros((1, 1)),
+                                           (16, 16))
+        with self.assertRaises(ValueError):
+            tiled.evaluate(np.array([0.0]), np.array([0.0]),
+                           core.Bilinear2D())
+
+
+class TestTiledTrivariate(unittest.TestCase):
+    def test_evaluate(self):
+        x = core.Axis(np.arange(0, 10, 0.5))
+        y = core.Axis(np.arange(-5, 5, 0.25))
+        z = core.Axis(np.arange(0, 6, 1.0))
+        values = np.random.random((len(x), len(y), len(z)))
+        trivariate = core.TrivariateFloat64(x, y, z, values)
+        tiled = core.TiledTrivariateFloat64(x, y, z,
+                                            lambda index: values[index],
+                                            (7, 7, 2))
+        mx, my, mz = np.meshgrid(np.arange(0, 9, 0.3),
+                                 np.arange(-4, 4, 0.3),
+                                 np.arange(0, 5, 0.7),
+                                 indexing="ij")
+        z0 = trivariate.evaluate(mx, my, mz, core.Bilinear3D())
+        z1 = tiled.evaluate(mx, my, mz, core.Bilinear3D())
+        self.assertTrue(np.allclose(z0, z1))
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -29,6 +29,16 @@ def plot(x, y, z, filename):
                    pad_inches=0.4)
 
 
+class PythonBilinear3D(core.BivariateInterpolator3D):
+    """Bilinear interpolation written in Python, processing the values by
+    batches"""
+    def evaluate_batch(self, p, p0, p1, q00, q01, q10, q11):
+        t = (p[:, 0] - p0[:, 0]) / (p1[:, 0] - p0[:, 0])
+        u = (p[:, 1] - p0[:, 1]) / (p1[:, 1] - p0[:, 1])
+        return (1 - t) * (1 - u) * q00 + t * (1 - u) * q10 + (
+            1 - t) * u * q01 + t * u * q11
+
+
 class TestCase(unittest.TestCase):
     GRID = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..",
                         "dataset", "tcw.nc")
@@ -59,10 +69,18 @@ class TestCase(unittest.TestCase):
                                  t.flatten(),
                                  interpolator,
                                  num_threads=1)
+        z2 = trivariate.evaluate(x.flatten(),
+                                 y.flatten(),
+                                 t.flatten(),
+                                 interpolator,
+                                 num_threads=0,
+                                 reorder=True)
         shape = (len(lon), len(lat))
         z0 = np.ma.fix_invalid(z0)
         z1 = np.ma.fix_invalid(z1)
+        z2 = np.ma.fix_invalid(z2)
         self.assertTrue(np.all(z1 == z0))
+        self.assertTrue(np.all(z2 == z0))
         if HAVE_PLT:
             plot(x.reshape(shape), y.reshape(shape), z0.reshape(shape),
                  filename)
@@ -96,6 +114,105 @@ class TestCase(unittest.TestCase):
         self.assertTrue((a - c).std() != 0)
         self.assertTrue((b - c).std() != 0)
 
+    def test_python_interpolator(self):
+        trivariate = self.load_data()
+        lon = np.arange(-180, 180, 1 / 3.0) + 1 / 3.0
+        lat = np.arange(-90, 90, 1 / 3.0) + 1 / 3.0
+        time = 898500 + 3
+        x, y, t = np.meshgrid(lon, lat, time, indexing="ij")
+        z0 = trivariate.evaluate(x.flatten(), y.flatten(), t.flatten(),
+                                 core.Bilinear3D())
+        z1 = trivariate.evaluate(x.flatten(), y.flatten(), t.flatten(),
+                                 PythonBilinear3D())
+        self.assertTrue(np.allclose(z0, z1, equal_nan=True))
+
+    def test_fields(self):
+        trivariate = self.load_data()
+        lon = np.arange(-180, 180, 1 / 3.0) + 1 / 3.0
+        lat = np.arange(-90, 90, 1 / 3.0) + 1 / 3.0
+        time = 898500 + 3
+        x, y, t = np.meshgrid(lon, lat, time, indexing="ij")
+        fields = [trivariate.array * 2]
+        for interpolator in [
+                core.Nearest3D(),
+                core.Bilinear3D(),
+                PythonBilinear3D()
+        ]:
+            z = trivariate.evaluate_fields(x.flatten(), y.flatten(),
+                                           t.flatten(), fields, interpolator)
+            self.assertEqual(z.shape, (x.size, 2))
+            z0 = trivariate.evaluate(x.flatten(), y.flatten(), t.flatten(),
+                                     interpolator)
+            self.assertTrue(np.allclose(z[:, 0], z0, equal_nan=True))
+            self.assertTrue(np.allclose(z[:, 1], z0 * 2, equal_nan=True))
+
+    def test_masked(self):
+        trivariate = self.load_data()
+        lon = np.arange(-180, 180, 1 / 3.0) + 1 / 3.0
+        lat = np.arange(-90, 90, 1 / 3.0) + 1 / 3.0
+        time = 898500 + 3
+        x, y, t = np.meshgrid(lon, lat, time, indexing="ij")
+        z0 = trivariate.evaluate(x, y, t, core.Bilinear3D())
+        self.assertEqual(core.Bilinear3D().min_valid, 8)
+        z1 = trivariate.evaluate(x, y, t, core.Bilinear3D(min_valid=1))
+        defined = ~np.isnan(z0)
+        self.assertTrue(np.allclose(z0[defined], z1[defined]))
+        self.assertLessEqual(np.isnan(z1).sum(), np.isnan(z0).sum())
+        z2 = trivariate.evaluate_fields(x.flatten(), y.flatten(),
+                                        t.flatten(), [trivariate.array],
+                                        core.Bilinear3D(min_valid=1))
+        self.assertTrue(np.allclose(z2[:, 1], z1.flatten(), equal_nan=True))
+        with self.assertRaises(ValueError):
+            core.Bilinear3D(min_valid=9)
+
+    def test_packed(self):
+        trivariate = self.load_data()
+        array = trivariate.array
+        fill_value = np.iinfo(np.uint16).max
+        packed = np.round(array / 0.01)
+        packed[np.isnan(array)] = fill_value
+        packed = packed.astype(np.uint16)
+        unpacked = packed * 0.01
+        unpacked[packed == fill_value] = float("nan")
+        other = core.TrivariateUInt16(trivariate.x,
+                                      trivariate.y,
+                                      trivariate.z,
+                                      packed,
+                                      scale_factor=0.01,
+                                      fill_value=fill_value)
+        trivariate = core.TrivariateFloat64(trivariate.x, trivariate.y,
+                                            trivariate.z, unpacked)
+        lon = np.arange(-180, 180, 1 / 3.0) + 1 / 3.0
+        lat = np.arange(-90, 90, 1 / 3.0) + 1 / 3.0
+        time = 898500 + 3
+        x, y, t = np.meshgrid(lon, lat, time, indexing="ij")
+        for interpolator in [core.Bilinear3D(), core.Nearest3D()]:
+            z0 = trivariate.evaluate(x, y, t, interpolator)
+            z1 = other.evaluate(x, y, t, interpolator)
+            self.assertTrue(np.allclose(z0, z1, equal_nan=True))
+        other = pickle.loads(pickle.dumps(other))
+        self.assertEqual(other.scale_factor, 0.01)
+        self.assertEqual(other.add_offset, 0)
+
+    def test_axes(self):
+        trivariate = self.load_data()
+        # Array stored as (time, lat, lon), as in the NetCDF file.
+        array = np.ascontiguousarray(trivariate.array.transpose(2, 1, 0))
+        other = core.TrivariateFloat64(trivariate.x,
+                                       trivariate.y,
+                                       trivariate.z,
+                                       array,
+                                       axes=(2, 1, 0))
+        self.assertTrue(np.shares_memory(other.array, array))
+        lon = np.arange(-180, 180, 1 / 3.0) + 1 / 3.0
+        lat = np.arange(-90, 90, 1 / 3.0) + 1 / 3.0
+        time = 898500 + 3
+        x, y, t = np.meshgrid(lon, lat, time, indexing="ij")
+        for interpolator in [core.Bilinear3D(), core.Nearest3D()]:
+            z0 = trivariate.evaluate(x, y, t, interpolator)
+            z1 = other.evaluate(x, y, t, interpolator)
+            self.assertTrue(np.allclose(z0, z1, equal_nan=True))
+
     def test_pickle(self):
         interpolator = self.load_data()
         other = pickle.loads(pickle.dumps(interpolator))
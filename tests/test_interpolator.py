@@ -79,6 +79,35 @@ class Bivariate(unittest.TestCase):
                                   bounds_error=True,
                                   boundary="sym")
 
+    def test_packed(self):
+        dataset = xr.open_dataset(self.GRID)
+        values = np.round(dataset.mss.values / 0.01)
+        values[np.isnan(values)] = -32768
+        dataset["packed"] = (dataset.mss.dims, values.astype(np.int16),
+                             dict(scale_factor=0.01, _FillValue=-32768))
+        interpolator = pyinterp.backends.xarray.Bivariate(dataset, "packed")
+        # The integers are interpolated without being converted.
+        self.assertEqual(interpolator.array.dtype, np.int16)
+        other = pickle.loads(pickle.dumps(interpolator))
+
+        lon = np.arange(-180, 180, 1) + 1 / 3.0
+        lat = np.arange(-90, 90, 1) + 1 / 3.0
+        x, y = np.meshgrid(lon, lat, indexing="ij")
+        coords = collections.OrderedDict(lon=x.flatten(), lat=y.flatten())
+        z0 = pyinterp.backends.xarray.Bivariate(dataset,
+                                                "mss").evaluate(coords)
+        z1 = interpolator.evaluate(coords)
+        self.assertTrue(np.allclose(z0, z1, atol=0.01, equal_nan=True))
+        self.assertTrue(np.all(np.isnan(z0) == np.isnan(z1)))
+        z2 = other.evaluate(coords)
+        self.assertTrue(np.allclose(z1, z2, equal_nan=True))
+
+        with self.assertRaises(ValueError):
+            pyinterp.bivariate.Bivariate(interpolator.x,
+                                         interpolator.y,
+                                         dataset.mss.values,
+                                         scale_factor=0.01)
+
 
 class Trivariate(unittest.TestCase):
     GRID = os.path.join(os.path.dirname(os.path.abspath(__file__)), "dataset",
@@ -0,0 +1,84 @@
+# Copyright (c) 2019 CNES
+#
+# All rights reserved. Use of this source code is governed by a
+# BSD-style license that can be found in the LICENSE file.
+import pickle
+import unittest
+import numpy as np
+import pyinterp.bivariate
+import pyinterp.core
+import pyinterp.interface
+import pyinterp.rtree
+import pyinterp.trivariate
+
+
+@unittest.skipIf(pyinterp.interface.PickleBuffer is None,
+                 "the pickle protocol 5 is not available")
+class OutOfBand(unittest.TestCase):
+    @staticmethod
+    def round_trip(instance):
+        buffers = []
+        data = pickle.dumps(instance,
+                            protocol=5,
+                            buffer_callback=buffers.append)
+        return pickle.loads(data, buffers=buffers), data, buffers
+
+    def test_bivariate(self):
+        x = pyinterp.core.Axis(np.arange(-180, 180, 0.25), is_circle=True)
+        y = pyinterp.core.Axis(np.arange(-90, 90, 0.25))
+        values = np.random.random((len(x), len(y)))
+        interpolator = pyinterp.bivariate.Bivariate(x, y, values)
+        other, data, buffers = self.round_trip(interpolator)
+
+        # The values are not copied into the pickle stream.
+        self.assertLess(len(data), values.nbytes // 100)
+        self.assertEqual(sum(item.raw().nbytes for item in buffers),
+                         values.nbytes)
+        self.assertTrue(np.shares_memory(other.array, values))
+        self.assertEqual(other.x, x)
+        self.assertEqual(other.y, y)
+
+        mx, my = np.meshgrid(np.arange(-180, 180, 1.0),
+                             np.arange(-80, 80, 1.0),
+                             indexing="ij")
+        np.testing.assert_array_equal(interpolator.evaluate(mx, my),
+                                      other.evaluate(mx, my))
+
+        # The buffers transmitted in band are read-only.
+        other = pickle.loads(pickle.dumps(interpolator, protocol=5))
+        np.testing.assert_array_equal(other.array, values)
+        np.testing.assert_array_equal(interpolator.evaluate(mx, my),
+                                      other.evaluate(mx, my))
+
+    def test_transposed(self):
+        x = pyinterp.core.Axis(np.arange(0, 10, 0.5))
+        y = pyinterp.core.Axis(np.arange(-5, 5, 0.25))
+        z = pyinterp.core.Axis(np.arange(0, 6, 1.0))
+        values = np.random.random((len(z), len(x), len(y)))
+        interpolator = pyinterp.trivariate.Trivariate(x,
+                                                      y,
+                                                      z,
+                                                      values,
+                                                      axes=(1, 2, 0))
+        other, _, buffers = self.round_trip(interpolator)
+        self.assertEqual(len(buffers), 1)
+        self.assertTrue(np.shares_memory(other.array, values))
+        np.testing.assert_array_equal(other.array, interpolator.array)
+
+    def test_rtree(self):
+        mesh = pyinterp.rtree.RTree()
+        lon = np.random.uniform(-180, 180, 1000)
+        lat = np.random.uniform(-90, 90, 1000)
+        mesh.packing(np.vstack((lon, lat)).T, np.random.random(1000))
+        other, data, buffers = self.round_trip(mesh)
+        self.assertEqual(len(buffers), 4)
+        self.assertIsInstance(other, pyinterp.rtree.RTree)
+
+        coordinates = np.vstack((lon[:10], lat[:10])).T
+        for expected, item in zip(mesh.query(coordinates),
+                                  other.query(coordinates)):
+            np.testing.assert_array_equal(expected, item)
+
+
+if __name__ == "__main__":
+    unittest.main()
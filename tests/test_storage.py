@@ -0,0 +1,110 @@
+# Copyright (c) 2019 CNES
+#
+# All rights reserved. Use of this source code is governed by a
+# BSD-style license that can be found in the LICENSE file.
+import collections
+import os
+import tempfile
+import unittest
+import numpy as np
+import xarray as xr
+import pyinterp.backends.xarray
+import pyinterp.bicubic
+import pyinterp.bivariate
+import pyinterp.core
+import pyinterp.storage
+import pyinterp.trivariate
+
+
+class Storage(unittest.TestCase):
+    GRID = os.path.join(os.path.dirname(os.path.abspath(__file__)), "dataset",
+                        "mss.nc")
+
+    def setUp(self):
+        self.directory = tempfile.TemporaryDirectory()
+        self.path = os.path.join(self.directory.name, "grid.bin")
+
+    def tearDown(self):
+        self.directory.cleanup()
+
+    def test_bivariate(self):
+        interpolator = pyinterp.backends.xarray.Bivariate(
+            xr.open_dataset(self.GRID), "mss")
+        pyinterp.storage.save(interpolator, self.path)
+        other = pyinterp.storage.open(self.path)
+        self.assertIsInstance(other, pyinterp.backends.xarray.Bivariate)
+        self.assertEqual(other.x, interpolator.x)
+        self.assertEqual(other.y, interpolator.y)
+        # The values are read from the file, without being copied.
+        self.assertFalse(other.array.flags.writeable)
+        np.testing.assert_array_equal(other.array, interpolator.array)
+
+        lon = np.arange(-180, 180, 1) + 1 / 3.0
+        lat = np.arange(-90, 90, 1) + 1 / 3.0
+        x, y = np.meshgrid(lon, lat, indexing="ij")
+        coords = collections.OrderedDict(lon=x.flatten(), lat=y.flatten())
+        np.testing.assert_array_equal(interpolator.evaluate(coords),
+                                      other.evaluate(coords))
+
+    def test_packed(self):
+        x = pyinterp.core.Axis(np.array([0.0, 1.0, 3.0, 7.0]))
+        y = pyinterp.core.Axis(np.arange(0.0, 20.0, 2.0))
+        values = np.arange(40, dtype=np.int16).reshape(4, 10)
+        interpolator = pyinterp.bivariate.Bivariate(x,
+                                                    y,
+                                                    values.T,
+                                                    scale_factor=0.5,
+                                                    add_offset=1,
+                                                    fill_value=0,
+                                                    axes=(1, 0))
+        pyinterp.storage.save(interpolator, self.path)
+        other = pyinterp.storage.open(self.path)
+        self.assertIsInstance(other, pyinterp.bivariate.Bivariate)
+        self.assertEqual(other.x, x)
+        self.assertEqual(other.y, y)
+        self.assertTrue(np.array_equal(other.array, values))
+
+        mx, my = np.meshgrid(np.arange(0, 7, 0.5),
+                             np.arange(0, 18, 0.5),
+                             indexing="ij")
+        np.testing.assert_array_equal(interpolator.evaluate(mx, my),
+                                      other.evaluate(mx, my))
+
+    def test_trivariate(self):
+        x = pyinterp.core.Axis(np.arange(0, 10, 0.5))
+        y = pyinterp.core.Axis(np.arange(-5, 5, 0.25))
+        z = pyinterp.core.Axis(np.arange(0, 6, 1.0))
+        values = np.random.random((len(x), len(y), len(z)))
+        interpolator = pyinterp.trivariate.Trivariate(x, y, z, values)
+        pyinterp.storage.save(interpolator, self.path)
+        other = pyinterp.storage.open(self.path)
+        self.assertIsInstance(other, pyinterp.trivariate.Trivariate)
+        self.assertEqual(other.z, z)
+        self.assertTrue(np.array_equal(other.array, values))
+
+    def test_invalid(self):
+        with open(self.path, "wb") as stream:
+            stream.write(b"NOTAGRID" + b"\0" * 32)
+        with self.assertRaises(ValueError):
+            pyinterp.storage.open(self.path)
+        with self.assertRaises(TypeError):
+            pyinterp.storage.save(object(), self.path)
+
+    def test_foreign_module(self):
+        x = pyinterp.core.Axis(np.arange(0, 10, 1.0))
+        y = pyinterp.core.Axis(np.arange(0, 10, 1.0))
+        interpolator = pyinterp.bivariate.Bivariate(x, y, np.zeros((10, 10)))
+        pyinterp.storage.save(interpolator, self.path)
+        with open(self.path, "rb") as stream:
+            data = stream.read()
+        # The names replaced have the same length, so that the description
+        # remains valid.
+        for module in [b'"xyzzy.bivariate.xx"', b'"pyinterp_bivariate"']:
+            with open(self.path, "wb") as stream:
+                stream.write(data.replace(b'"pyinterp.bivariate"', module))
+            with self.assertRaises(ValueError):
+                pyinterp.storage.open(self.path)
+
+
+if __name__ == "__main__":
+    unittest.main()